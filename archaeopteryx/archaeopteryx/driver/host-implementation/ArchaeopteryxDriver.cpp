@@ -7,6 +7,19 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/driver/interface/SimulatorKnobs.h>
 #include <archaeopteryx/driver/host-interface/ArchaeopteryxDriver.h>
+
+#ifdef ARCHAEOPTERYX_HOST
+
+// Standard Library Includes
+#include <vector>
+#include <cstring>
+
+// The device driver entry point is linked in directly
+extern "C" void archaeopteryxDriver(const void* knobs, bool* passed);
+
+#else
+
+// Archaeopteryx Includes
 #include <archaeopteryx/util/host-interface/HostReflectionHost.h>
 
 // Ocelot Includes
@@ -18,13 +31,15 @@ const char ArchaeopteryxModule[] = {
 	#include <ArchaeopteryxModule.inc>
 };
 
+#endif
+
 namespace archaeopteryx
 {
 
 namespace driver
 {
 
-void ArchaeopteryxDriver::runSimulation(const std::string& traceFileName,
+bool ArchaeopteryxDriver::runSimulation(const std::string& traceFileName,
 	const KnobList& knobs)
 {
 	_knobs = knobs;
@@ -33,9 +48,11 @@ void ArchaeopteryxDriver::runSimulation(const std::string& traceFileName,
 	
 	_loadArchaeopteryxDeviceCode();
 	
-	_runSimulation();
+	bool passed = _runSimulation();
 	
 	_unloadArchaeopteryxDeviceCode();
+	
+	return passed;
 }
 	
 void ArchaeopteryxDriver::_loadTraceFile(const std::string& traceFileName)
@@ -43,6 +60,33 @@ void ArchaeopteryxDriver::_loadTraceFile(const std::string& traceFileName)
 	_knobs.push_back(std::make_pair("TraceFileName", traceFileName));
 }
 
+#ifdef ARCHAEOPTERYX_HOST
+
+void ArchaeopteryxDriver::_loadArchaeopteryxDeviceCode()
+{
+
+}
+
+bool ArchaeopteryxDriver::_runSimulation()
+{
+	SimulatorKnobs* knobs = _createDeviceKnobs();
+
+	bool passed = false;
+
+	archaeopteryxDriver(knobs, &passed);
+
+	_freeDeviceKnobs(knobs);
+
+	return passed;
+}
+
+void ArchaeopteryxDriver::_unloadArchaeopteryxDeviceCode()
+{
+
+}
+
+#else
+
 void ArchaeopteryxDriver::_loadArchaeopteryxDeviceCode()
 {
 	std::stringstream stream(ArchaeopteryxModule);
@@ -51,17 +95,31 @@ void ArchaeopteryxDriver::_loadArchaeopteryxDeviceCode()
 	archaeopteryx::util::HostReflectionHost::create("ArchaeopteryxModule");
 }
 
-void ArchaeopteryxDriver::_runSimulation()
+bool ArchaeopteryxDriver::_runSimulation()
 {
 	cudaConfigureCall(dim3(1, 1, 1), dim3(1, 1, 1), 0, 0);
 
 	SimulatorKnobs* deviceKnobs = _createDeviceKnobs();
 
-	cudaSetupArgument(&deviceKnobs, 8, 0 );
+	bool* devicePassed = 0;
+	
+	cudaMalloc((void**)&devicePassed, sizeof(bool));
+	cudaMemset(devicePassed, 0, sizeof(bool));
+
+	cudaSetupArgument(&deviceKnobs,  8, 0 );
+	cudaSetupArgument(&devicePassed, 8, 8 );
 	
 	ocelot::launch("ArchaeopteryxModule", "archaeopteryxDriver");
 
+	bool passed = false;
+	
+	cudaMemcpy(&passed, devicePassed, sizeof(bool), cudaMemcpyDeviceToHost);
+
+	cudaFree(devicePassed);
+
 	_freeDeviceKnobs(deviceKnobs);
+	
+	return passed;
 }
 
 void ArchaeopteryxDriver::_unloadArchaeopteryxDeviceCode()
@@ -71,6 +129,8 @@ void ArchaeopteryxDriver::_unloadArchaeopteryxDeviceCode()
 	ocelot::unregisterModule("ArchaeopteryxModule");
 }
 
+#endif
+
 SimulatorKnobs* ArchaeopteryxDriver::_createDeviceKnobs()
 {
 	typedef std::vector<SimulatorKnobs::KnobOffsetPair> OffsetVector;
@@ -96,7 +156,11 @@ SimulatorKnobs* ArchaeopteryxDriver::_createDeviceKnobs()
 
 	SimulatorKnobs* devicePointer = 0;
 
+#ifdef ARCHAEOPTERYX_HOST
+	devicePointer = reinterpret_cast<SimulatorKnobs*>(new char[size]);
+#else
 	cudaMalloc((void**)&devicePointer, size);
+#endif
 
 	// serialize the knobs
 	SimulatorKnobs simulatorKnobs;
@@ -106,6 +170,28 @@ SimulatorKnobs* ArchaeopteryxDriver::_createDeviceKnobs()
 	// 1) serialize the header
 	char* deviceIterator = (char*) devicePointer;
 
+#ifdef ARCHAEOPTERYX_HOST
+	std::memcpy(deviceIterator, &simulatorKnobs, sizeof(SimulatorKnobs));
+	deviceIterator += sizeof(SimulatorKnobs);
+
+	// 2) serialize the offsets
+	std::memcpy(deviceIterator, offsets.data(),
+		sizeof(SimulatorKnobs::KnobOffsetPair) * offsets.size());
+	deviceIterator += sizeof(SimulatorKnobs::KnobOffsetPair) * offsets.size();
+
+	// 3) serialize the knobs themselves
+	for(auto knob = _knobs.begin(); knob != _knobs.end(); ++knob)
+	{
+		std::memcpy(deviceIterator, knob->first.c_str(),
+			knob->first.size() + 1);
+		deviceIterator += knob->first.size() + 1;
+
+		std::memcpy(deviceIterator, knob->second.c_str(),
+			knob->second.size() + 1);
+		deviceIterator += knob->second.size() + 1;
+	}
+#else
+
 	cudaMemcpy(deviceIterator, &simulatorKnobs, sizeof(SimulatorKnobs),
 		cudaMemcpyHostToDevice);
 	deviceIterator += sizeof(SimulatorKnobs);
@@ -127,13 +213,18 @@ SimulatorKnobs* ArchaeopteryxDriver::_createDeviceKnobs()
 				knob->second.size() + 1, cudaMemcpyHostToDevice);
 			deviceIterator += knob->second.size() + 1;
 	}
+#endif
 
 	return devicePointer;
 }
 
 void ArchaeopteryxDriver::_freeDeviceKnobs(SimulatorKnobs* knobs)
 {
+#ifdef ARCHAEOPTERYX_HOST
+	delete[] reinterpret_cast<char*>(knobs);
+#else
 	cudaFree(knobs);
+#endif
 }
 
 }
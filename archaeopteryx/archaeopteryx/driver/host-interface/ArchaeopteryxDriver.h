@@ -27,12 +27,14 @@ public:
 	typedef std::list<Knob> KnobList;
 
 public:
-	void runSimulation(const std::string& traceFileName, const KnobList& knobs);
+	/*! \brief Simulate a trace, returns false if the final contents of
+		memory did not match the trace */
+	bool runSimulation(const std::string& traceFileName, const KnobList& knobs);
 
 private:
 	void _loadTraceFile(const std::string& traceFileName);
 	void _loadArchaeopteryxDeviceCode();
-	void _runSimulation();
+	bool _runSimulation();
 	void _unloadArchaeopteryxDeviceCode();
 
 private:
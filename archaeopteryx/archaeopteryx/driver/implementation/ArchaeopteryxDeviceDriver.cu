@@ -56,6 +56,16 @@ __device__ static void loadDefaultKnobs()
 		new util::Knob("simulator-registers-per-thread", "64"));
 	util::KnobDatabase::addKnob(
 		new util::Knob("simulated-link-register", "63"));
+
+	// the local region of the vanaheimr ABI, a window per thread
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulated-local-memory-address", "0x40000000"));
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulated-local-memory-per-thread", "4096"));
+
+	// host builds only, 0 runs one worker on each core
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-worker-threads", "0"));
 }
 
 __device__ void ArchaeopteryxDeviceDriver::loadKnobs(
@@ -84,13 +94,14 @@ __device__ void ArchaeopteryxDeviceDriver::loadKnobs(
 	}
 }
 
-__device__ void ArchaeopteryxDeviceDriver::runSimulation()
+__device__ bool ArchaeopteryxDeviceDriver::runSimulation()
 {
 	_loadFile();
 	_extractSimulatorParameters();
 	_loadInitialMemoryContents();
 	_runSimulation();
-	_verifyMemoryContents();
+	
+	return _verifyMemoryContents();
 }
 
 __device__ void ArchaeopteryxDeviceDriver::_loadFile()
@@ -295,7 +306,7 @@ __device__ static bool verifyAllocation(const util::string& data,
 	return !anyErrors;
 }
 
-__device__ void ArchaeopteryxDeviceDriver::_verifyMemoryContents()
+__device__ bool ArchaeopteryxDeviceDriver::_verifyMemoryContents()
 {
 	std::printf("Verifying the final contents of memory.\n");
 	
@@ -316,28 +327,31 @@ __device__ void ArchaeopteryxDeviceDriver::_verifyMemoryContents()
 		
 		util::string contents = binary->getSymbolDataAsString(name->c_str());
 		
-		anyErrors |= verifyAllocation(contents, physicalAddress, address);
+		anyErrors |= !verifyAllocation(contents, physicalAddress, address);
 	}
 	
 	if(anyErrors)
 	{
-		std::printf("Memory check passed!\n");
+		std::printf("Memory check failed.\n");
 	}
 	else
 	{
-		std::printf("Memory check failed.\n");
+		std::printf("Memory check passed!\n");
 	}
+	
+	return !anyErrors;
 }
 
 }
 
 }
 
-extern "C" __global__ void archaeopteryxDriver(const void* knobs)
+extern "C" __global__ void archaeopteryxDriver(const void* knobs,
+	bool* passed)
 {
 	archaeopteryx::driver::ArchaeopteryxDeviceDriver driver;
 
 	driver.loadKnobs(knobs);
-	driver.runSimulation();
+	*passed = driver.runSimulation();
 }
 
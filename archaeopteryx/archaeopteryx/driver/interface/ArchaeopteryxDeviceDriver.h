@@ -20,14 +20,16 @@ public:
 
 public:
 	__device__ void loadKnobs(const void* serializedKnobs);
-	__device__ void runSimulation();
+	/*! \brief Run the simulation, returns false if the final contents of
+		memory did not match the trace */
+	__device__ bool runSimulation();
 
 private:
 	__device__ void _loadFile();
 	__device__ void _extractSimulatorParameters();
 	__device__ void _loadInitialMemoryContents();
 	__device__ void _runSimulation();
-	__device__ void _verifyMemoryContents();
+	__device__ bool _verifyMemoryContents();
 
 };
 
@@ -0,0 +1,165 @@
+/*! \file   CTAScheduler.cu
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the CTAScheduler class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/CTAScheduler.h>
+
+#include <archaeopteryx/util/interface/HostCompatibility.h>
+#include <archaeopteryx/util/interface/debug.h>
+
+// Preprocessor Defines
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ CTAScheduler::CTAScheduler()
+: m_ranges(0), m_hardwareBlocks(0)
+{
+
+}
+
+__device__ CTAScheduler::~CTAScheduler()
+{
+	delete[] m_ranges;
+}
+
+__device__ void CTAScheduler::setup(unsigned int simulatedBlocks,
+	unsigned int hardwareBlocks)
+{
+	device_assert(hardwareBlocks > 0);
+
+	if(m_hardwareBlocks != hardwareBlocks)
+	{
+		delete[] m_ranges;
+
+		m_ranges         = new Range[hardwareBlocks];
+		m_hardwareBlocks = hardwareBlocks;
+	}
+
+	unsigned int share     = simulatedBlocks / hardwareBlocks;
+	unsigned int remainder = simulatedBlocks % hardwareBlocks;
+	unsigned int begin     = 0;
+
+	for(unsigned int block = 0; block < hardwareBlocks; ++block)
+	{
+		unsigned int end = begin + share + (block < remainder ? 1 : 0);
+
+		m_ranges[block] = _pack(begin, end);
+
+		begin = end;
+	}
+
+	__threadfence();
+}
+
+__device__ bool CTAScheduler::next(unsigned int hardwareBlock,
+	unsigned int& simulatedBlock)
+{
+	while(true)
+	{
+		if(_take(hardwareBlock, simulatedBlock))
+		{
+			device_report("Hardware CTA %d running simulated CTA %d\n",
+				hardwareBlock, simulatedBlock);
+
+			return true;
+		}
+
+		if(!_steal(hardwareBlock)) return false;
+	}
+}
+
+__device__ bool CTAScheduler::_take(unsigned int hardwareBlock,
+	unsigned int& simulatedBlock)
+{
+	Range* share = m_ranges + hardwareBlock;
+
+	Range range = atomicLoad(share);
+
+	while(_begin(range) < _end(range))
+	{
+		Range taken    = _pack(_begin(range) + 1, _end(range));
+		Range previous = atomicCAS(share, range, taken);
+
+		if(previous == range)
+		{
+			simulatedBlock = _begin(range);
+
+			return true;
+		}
+
+		range = previous;
+	}
+
+	return false;
+}
+
+__device__ bool CTAScheduler::_steal(unsigned int hardwareBlock)
+{
+	for(unsigned int i = 1; i < m_hardwareBlocks; ++i)
+	{
+		unsigned int victim = (hardwareBlock + i) % m_hardwareBlocks;
+
+		Range* share = m_ranges + victim;
+
+		Range range = atomicLoad(share);
+
+		while(_begin(range) < _end(range))
+		{
+			unsigned int remaining = _end(range) - _begin(range);
+			unsigned int middle    = _begin(range) + remaining / 2;
+
+			Range kept     = _pack(_begin(range), middle);
+			Range previous = atomicCAS(share, range, kept);
+
+			if(previous == range)
+			{
+				device_report("Hardware CTA %d stole simulated CTAs "
+					"[%d, %d) from %d\n", hardwareBlock, middle,
+					_end(range), victim);
+
+				// only the owner adds to an empty share
+				atomicExch(m_ranges + hardwareBlock,
+					_pack(middle, _end(range)));
+
+				return true;
+			}
+
+			range = previous;
+		}
+	}
+
+	return false;
+}
+
+__device__ CTAScheduler::Range CTAScheduler::_pack(unsigned int begin,
+	unsigned int end)
+{
+	return (Range)begin | ((Range)end << 32);
+}
+
+__device__ unsigned int CTAScheduler::_begin(Range range)
+{
+	return range & 0xffffffffULL;
+}
+
+__device__ unsigned int CTAScheduler::_end(Range range)
+{
+	return range >> 32;
+}
+
+}
+
+}
+
@@ -8,6 +8,7 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/executive/interface/CoreSimBlock.h>
 #include <archaeopteryx/executive/interface/CoreSimKernel.h>
+#include <archaeopteryx/executive/interface/DecodedInstruction.h>
 
 #include <archaeopteryx/util/interface/debug.h>
 
@@ -22,7 +23,7 @@
 #undef REPORT_BASE
 #endif
 
-#define REPORT_BASE 1
+#define REPORT_BASE 0
 
 namespace archaeopteryx
 {
@@ -30,6 +31,40 @@ namespace archaeopteryx
 namespace executive
 {
 
+__device__ CoreSimBlock::CoreSimBlock()
+: m_registerFiles(0), m_threads(0), m_warp(0), m_kernel(0),
+	m_registerFileSize(0), m_threadCapacity(0)
+{
+	m_blockState.blockId              = 0;
+	m_blockState.registersPerThread   = 0;
+	m_blockState.localMemoryPerThread = 0;
+	m_blockState.threadsPerBlock      = 0;
+	m_blockState.sharedMemoryPerBlock = 0;
+	m_blockState.binary               = 0;
+}
+
+__device__ CoreSimBlock::CoreSimBlock(const CoreSimBlock& block)
+: m_registerFiles(0), m_blockState(block.m_blockState), m_threads(0),
+	m_warp(0), m_kernel(block.m_kernel), m_registerFileSize(0),
+	m_threadCapacity(0)
+{
+
+}
+
+__device__ CoreSimBlock& CoreSimBlock::operator=(const CoreSimBlock& block)
+{
+	m_blockState = block.m_blockState;
+	m_kernel     = block.m_kernel;
+
+	return *this;
+}
+
+__device__ CoreSimBlock::~CoreSimBlock()
+{
+	delete[] m_registerFiles;
+	delete[] m_threads;
+}
+
 __device__ void CoreSimBlock::setupCoreSimBlock(unsigned int blockId,
 	unsigned int registers, const CoreSimKernel* kernel)
 {
@@ -40,16 +75,31 @@ __device__ void CoreSimBlock::setupCoreSimBlock(unsigned int blockId,
 	device_report("Setting up core sim block %p, %d threads, %d registers\n",
 		this, m_blockState.threadsPerBlock, m_blockState.registersPerThread);
 
-	m_registerFiles = new Register[m_blockState.registersPerThread *
-		m_blockState.threadsPerBlock];
-		
-	m_threads = new CoreSimThread[m_blockState.threadsPerBlock];
-	m_warp    = m_threads + (threadIdx.x - getThreadIdInWarp());
+	// grow the arena if this simulated CTA does not fit
+	unsigned int registerFileSize = m_blockState.registersPerThread *
+		m_blockState.threadsPerBlock;
+
+	if(m_registerFileSize < registerFileSize)
+	{
+		delete[] m_registerFiles;
+
+		m_registerFiles    = new Register[registerFileSize];
+		m_registerFileSize = registerFileSize;
+	}
+
+	if(m_threadCapacity < m_blockState.threadsPerBlock)
+	{
+		delete[] m_threads;
+
+		m_threads        = new CoreSimThread[m_blockState.threadsPerBlock];
+		m_threadCapacity = m_blockState.threadsPerBlock;
+	}
+
+	m_warp = m_threads + (threadIdx.x - getThreadIdInWarp());
 	
 	for(unsigned i = 0; i < m_blockState.threadsPerBlock; ++i)
 	{
-		m_threads[i].setParentBlock(this);
-		m_threads[i].setThreadId(i);
+		m_threads[i] = CoreSimThread(this, i);
 	}
 }
 
@@ -63,6 +113,23 @@ __device__ ir::Binary* CoreSimBlock::binary()
 	return m_blockState.binary;
 }
 
+#ifdef ARCHAEOPTERYX_HOST
+
+__device__ bool CoreSimBlock::areAllThreadsFinished()
+{
+	for (unsigned int lane = 0; lane < getThreadsInWarp(); ++lane)
+	{
+		if (!m_warp[lane].finished)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#else
+
 __device__ bool CoreSimBlock::areAllThreadsFinished()
 {
 	__shared__ bool tempFinished[WARP_SIZE];
@@ -94,6 +161,8 @@ __device__ bool CoreSimBlock::areAllThreadsFinished()
 	return finished;
 }
 
+#endif
+
 __device__ void CoreSimBlock::roundRobinScheduler()
 {
 	if (getThreadIdInWarp() == 0)
@@ -116,6 +185,36 @@ __device__ void CoreSimBlock::roundRobinScheduler()
 	//barrier
 }
 
+#ifdef ARCHAEOPTERYX_HOST
+
+__device__ unsigned int CoreSimBlock::findNextPC(unsigned int& returnPriority)
+{
+	unsigned int maxPriority = 0;
+	unsigned int maxPC       = 0;
+
+	device_report("Getting next PC\n");
+
+	// threads waiting at a barrier have no priority
+	for (unsigned int lane = 0; lane < getThreadsInWarp(); ++lane)
+	{
+		if (m_warp[lane].barrierBit) continue;
+
+		if (m_warp[lane].instructionPriority > maxPriority)
+		{
+			maxPriority = m_warp[lane].instructionPriority;
+			maxPC       = m_warp[lane].pc;
+		}
+	}
+
+	cta_report(" max priority is %d, max pc is %d\n", maxPriority, maxPC);
+
+	returnPriority = maxPriority;
+
+	return maxPC;
+}
+
+#else
+
 __device__ unsigned int CoreSimBlock::findNextPC(unsigned int& returnPriority)
 {
 	__shared__ uint2 priority[WARP_SIZE];
@@ -173,27 +272,40 @@ __device__ unsigned int CoreSimBlock::findNextPC(unsigned int& returnPriority)
 	return maxPC;
 }
 
+#endif
+
 __device__ bool CoreSimBlock::setPredicateMaskForWarp(PC pc)
 {
 	//TO DO - evaluate a predicate over the entire warp
 	return pc == m_warp[getThreadIdInWarp()].pc;
 }
 
-__device__ CoreSimBlock::InstructionContainer CoreSimBlock::fetchInstruction(
-	PC pc)
+// The code section is decoded once per kernel, threads read the cached
+//  instruction directly instead of copying it from the binary
+__device__ const DecodedInstruction* CoreSimBlock::fetchInstruction(PC pc)
 {
-	__shared__ InstructionContainer instruction;
-	
-	if (getThreadIdInWarp() == 0)
+	return m_kernel->instructions.get(pc);
+}
+
+#ifdef ARCHAEOPTERYX_HOST
+
+__device__ void CoreSimBlock::executeWarp(
+	const DecodedInstruction* instruction, PC pc)
+{
+	for (unsigned int lane = 0; lane < getThreadsInWarp(); ++lane)
 	{
-		m_blockState.binary->copyCode(&instruction, pc, 1);
+		if (m_warp[lane].pc != pc) continue;
+
+		PC newPC = m_warp[lane].executeInstruction(*instruction, pc);
+		m_warp[lane].pc = newPC;
+		m_warp[lane].instructionPriority = newPC + 1;
 	}
-	// barrier
-	return instruction;
 }
 
+#else
+
 __device__ void CoreSimBlock::executeWarp(
-	InstructionContainer* instruction, PC pc)
+	const DecodedInstruction* instruction, PC pc)
 {
 	bool predicateMask = setPredicateMaskForWarp(pc);	
 	
@@ -201,17 +313,31 @@ __device__ void CoreSimBlock::executeWarp(
 	if (predicateMask)
 	{
 		PC newPC = m_warp[getThreadIdInWarp()].executeInstruction(
-			&instruction->asInstruction, pc);
+			*instruction, pc);
 		m_warp[getThreadIdInWarp()].pc = newPC;
 		m_warp[getThreadIdInWarp()].instructionPriority = newPC + 1;
 	}
 }
 
+#endif
+
 __device__ unsigned int CoreSimBlock::getThreadIdInWarp()
 {
 	return (threadIdx.x % WARP_SIZE);
 }
 
+#ifdef ARCHAEOPTERYX_HOST
+
+__device__ unsigned int CoreSimBlock::getThreadsInWarp()
+{
+	unsigned int remaining =
+		m_blockState.threadsPerBlock - (m_warp - m_threads);
+
+	return remaining < WARP_SIZE ? remaining : WARP_SIZE;
+}
+
+#endif
+
 __device__ void CoreSimBlock::initializeSpecialRegisters()
 {
 	cta_report("Intializing special registers for %d threads\n", 
@@ -222,7 +348,8 @@ __device__ void CoreSimBlock::initializeSpecialRegisters()
 		// r32 is parameter memory (0x00000000 for now)
 		setRegister(tid, 32, 0);
 		// r33 is the global thread id 
-		setRegister(tid, 33, tid);
+		setRegister(tid, 33,
+			m_blockState.blockId * m_blockState.threadsPerBlock + tid);
 	}
 
 	cta_report(" done\n");
@@ -259,8 +386,8 @@ __device__ void CoreSimBlock::initializeSpecialRegisters()
 		// only execute if all threads in this warp are NOT waiting on a barrier
 		if (priority != 0)
 		{
-			 InstructionContainer instruction = fetchInstruction(nextPC);
-			 executeWarp(&instruction, nextPC);
+			 const DecodedInstruction* instruction = fetchInstruction(nextPC);
+			 executeWarp(instruction, nextPC);
 			 ++executedCount;
 		}
 
@@ -335,6 +462,18 @@ __device__ unsigned int CoreSimBlock::getSimulatedBlockCount() const
 	return m_kernel->simulatedBlocks;
 }
 
+#ifdef ARCHAEOPTERYX_HOST
+
+__device__ void CoreSimBlock::clearAllBarrierBits()
+{
+	for (unsigned int i = 0; i < m_blockState.threadsPerBlock; ++i)
+	{
+		m_threads[i].barrierBit = false;
+	}
+}
+
+#else
+
 __device__ void CoreSimBlock::clearAllBarrierBits()
 {
 	for (unsigned int i = 0 ; i < (m_blockState.threadsPerBlock)/WARP_SIZE ; ++i)
@@ -346,6 +485,8 @@ __device__ void CoreSimBlock::clearAllBarrierBits()
 	//barrier -> we gurantee that we wont clobber values (blocks are not overlapping)
 }
 
+#endif
+
 __device__ void CoreSimBlock::setNumberOfThreadsPerBlock(unsigned int threads)
 {
 	m_blockState.threadsPerBlock = threads;
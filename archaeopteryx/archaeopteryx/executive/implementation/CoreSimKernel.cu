@@ -24,19 +24,30 @@ __device__ void CoreSimKernel::launchKernel(CoreSimBlock* blocks,
 	unsigned int registerCount = util::KnobDatabase::getKnob<unsigned int>(
 			"simulator-registers-per-thread");
 
-	for (unsigned int simulatedBlock = blockIdx.x;
-		simulatedBlock < simulatedBlocks; simulatedBlock += gridDim.x)
+	__shared__ unsigned int simulatedBlock;
+	__shared__ bool         scheduled;
+
+	while (true)
 	{
 		if(threadIdx.x == 0)
 		{
-			blocks[blockIdx.x].setupBinary(binary);
-			blocks[blockIdx.x].setupCoreSimBlock(simulatedBlock,
-				registerCount, this);
+			scheduled = scheduler.next(blockIdx.x, simulatedBlock);
+
+			if(scheduled)
+			{
+				blocks[blockIdx.x].setupBinary(binary);
+				blocks[blockIdx.x].setupCoreSimBlock(simulatedBlock,
+					registerCount, this);
+			}
 		}
 
 		__syncthreads();
 
+		if(!scheduled) break;
+
 		blocks[blockIdx.x].runBlock();
+
+		__syncthreads();
 	}
 }
 
@@ -8,10 +8,13 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/executive/interface/CoreSimThread.h>
 #include <archaeopteryx/executive/interface/CoreSimBlock.h>
+#include <archaeopteryx/executive/interface/DecodedInstruction.h>
 #include <archaeopteryx/executive/interface/Intrinsics.h>
 #include <archaeopteryx/executive/interface/OperandAccess.h>
 
+#include <archaeopteryx/util/interface/HostCompatibility.h>
 #include <archaeopteryx/util/interface/debug.h>
+#include <archaeopteryx/util/interface/type_traits.h>
 
 // Vanaheimr Includes
 #include <vanaheimr/asm/interface/Operand.h>
@@ -21,7 +24,7 @@
 #undef REPORT_BASE
 #endif
 
-#define REPORT_BASE 1
+#define REPORT_BASE 0
 
 namespace archaeopteryx
 {
@@ -84,124 +87,201 @@ __device__ static T bitcast(const F& from)
 
 template<typename T>
 static __device__ CoreSimThread::FValue getOperandAs(
-	const OperandContainer& operandContainer,
+	const DecodedOperand& operand,
 	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	CoreSimThread::FValue value = getOperand(operandContainer,
+	CoreSimThread::FValue value = getOperand(operand,
 		parentBlock, threadId);
 
 	return bitcast<T>(value);
 }
 
-static __device__ ir::Binary::PC executeAdd(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeAdd(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Add Add;
-
-	Add* add = static_cast<Add*>(instruction);
-
-	Value a = getOperand(add->a, parentBlock, threadId);
-	Value b = getOperand(add->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	Value d = a + b;
 
-	setRegister(add->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeAnd(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeAnd(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::And And;
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
-	And* andd = static_cast<And*>(instruction);
+	Value d = a & b;
 
-	Value a = getOperand(andd->a, parentBlock, threadId);
-	Value b = getOperand(andd->b, parentBlock, threadId);
+	setRegister(instruction.d, parentBlock, threadId, d);
+	return pc + 1;
+}
 
-	Value d = a & b;
+static __device__ ir::Binary::PC executeAshr(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
+{
+	SValue a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
+
+	SValue d = a >> b;
 
-	setRegister(andd->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeAshr(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+// All atomic operations are built on CAS, it is available for 32 and 64 bit
+//  words on every device and on the host
+template<typename T>
+static __device__ T atomicOperation(T* address,
+	vanaheimr::as::Atom::Operation operation, T b, T c)
 {
-	typedef vanaheimr::as::Ashr Ashr;
+	typedef vanaheimr::as::Atom Atom;
+	typedef typename util::conditional<sizeof(T) == sizeof(int64_t),
+		int64_t, int32_t>::type S;
 
-	Ashr* ashr = static_cast<Ashr*>(instruction);
+	T current = atomicLoad(address);
 
-	SValue a = getOperand(ashr->a, parentBlock, threadId);
-	Value b = getOperand(ashr->b, parentBlock, threadId);
+	while(true)
+	{
+		T value = current;
 
-	SValue d = a >> b;
+		switch(operation)
+		{
+		case Atom::AtomicAnd:  value = current & b;                     break;
+		case Atom::AtomicOr:   value = current | b;                     break;
+		case Atom::AtomicXor:  value = current ^ b;                     break;
+		case Atom::AtomicCas:  value = current == b ? c : current;      break;
+		case Atom::AtomicExch: value = b;                               break;
+		case Atom::AtomicAdd:  value = current + b;                     break;
+		case Atom::AtomicInc:  value = current >= b ? 0 : current + 1;  break;
+		case Atom::AtomicDec:
+		{
+			value = (current == 0 || current > b) ? b : current - 1;
+			break;
+		}
+		case Atom::AtomicMin:
+		{
+			value = (S)current < (S)b ? current : b;
+			break;
+		}
+		case Atom::AtomicMax:
+		{
+			value = (S)current > (S)b ? current : b;
+			break;
+		}
+		default:
+		{
+			device_assert_m(false, "Invalid atomic operation.");
+			break;
+		}
+		}
 
-	setRegister(ashr->d, parentBlock, threadId, d);
-	return pc + 1;
+		T previous = atomicCAS(address, current, value);
+
+		if(previous == current) return previous;
+
+		current = previous;
+	}
 }
 
-static __device__ ir::Binary::PC executeAtom(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeAtom(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
 	typedef vanaheimr::as::Atom Atom;
 
-	Atom* atom = static_cast<Atom*>(instruction);
+	Atom::Operation operation = instruction.encoded.asAtom.operation;
+
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
+	Value c = 0;
 
-	Value a = getOperand(atom->a, parentBlock, threadId);
-	Value b = getOperand(atom->b, parentBlock, threadId);
+	// only compare and swap has a third source
+	if(operation == Atom::AtomicCas)
+	{
+		c = getOperand(instruction.c, parentBlock, threadId);
+	}
 
 	Value physical = parentBlock->translateVirtualToPhysical(a);
 
-	//TO DO
-	device_assert_m(false, "Atomic operations not supported yet.");
-	Value d = 0; //atomicAdd(bitcast<long long int*>(physical), b);
+	Value d = 0;
+
+	// other hardware CTAs may be running on other host threads, the update
+	//  must be atomic in simulator memory, not only within the warp
+	switch(instruction.d.type)
+	{
+		case vanaheimr::as::i32:
+		{
+			d = atomicOperation<unsigned int>(
+				bitcast<unsigned int*>(physical), operation, b, c);
+			break;
+		}
+		case vanaheimr::as::i64:
+		{
+			d = atomicOperation<unsigned long long>(
+				bitcast<unsigned long long*>(physical), operation, b, c);
+			break;
+		}
+		default:
+		{
+			device_assert_m(false, "Atomic operations are only supported "
+				"on 32 and 64 bit integers.");
+			break;
+		}
+	}
 
-	setRegister(atom->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeBar(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeBar(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
 	parentBlock->barrier(threadId);
 
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeBitcast(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeBitcast(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Bitcast Bitcast;
-
-	Bitcast* bitcast = static_cast<Bitcast*>(instruction);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
-	Value a = getOperand(bitcast->a, parentBlock, threadId);
-
-	setRegister(bitcast->d, parentBlock, threadId, a);
+	setRegister(instruction.d, parentBlock, threadId, a);
 
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeBra(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeBra(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Bra Bra;
-
-	Bra* bra = static_cast<Bra*>(instruction);
-
-	Value a = getOperand(bra->target, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	//TO DO
 	return a;
 }
 
-static __device__ ir::Binary::PC executeCall(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeDirectBra(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Call Call;
+	return instruction.target;
+}
 
-	Call* call = static_cast<Call*>(instruction);
+static __device__ ir::Binary::PC executeCall(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
+{
+	const vanaheimr::as::Call* call = &instruction.encoded.asCall;
 
 	if(Intrinsics::isIntrinsic(call, parentBlock))
 	{
@@ -210,146 +290,123 @@ static __device__ ir::Binary::PC executeCall(Instruction* instruction,
 		return pc + 1;
 	}
 
-	Value a = getOperand(call->target, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	setRegister(parentBlock->getLinkRegister(), parentBlock, threadId, pc + 1);
 
 	return a;
 }
 
-static __device__ ir::Binary::PC executeFdiv(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeFdiv(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Fdiv Fdiv;
-
-	Fdiv* div = static_cast<Fdiv*>(instruction);
-
-	FValue a = getOperandAs<FValue>(div->a, parentBlock, threadId);
-	FValue b = getOperandAs<FValue>(div->b, parentBlock, threadId);
+	FValue a = getOperandAs<FValue>(instruction.a, parentBlock, threadId);
+	FValue b = getOperandAs<FValue>(instruction.b, parentBlock, threadId);
 
 	FValue d = a / b;
 
-	setRegister(div->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeFmul(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeFmul(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Fmul Fmul;
-
-	Fmul* mul = static_cast<Fmul*>(instruction);
-
-	FValue a = getOperandAs<FValue>(mul->a, parentBlock, threadId);
-	FValue b = getOperandAs<FValue>(mul->b, parentBlock, threadId);
+	FValue a = getOperandAs<FValue>(instruction.a, parentBlock, threadId);
+	FValue b = getOperandAs<FValue>(instruction.b, parentBlock, threadId);
 
 	FValue d = a * b;
 
-	setRegister(mul->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeFpext(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeFpext(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Fpext Fpext;
-
-	Fpext* fpext = static_cast<Fpext*>(instruction);
-
-	Value a = getOperand(fpext->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	float temp = bitcast<float>(a); 
 	double d = temp;
 
-	setRegister(fpext->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeFptosi(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeFptosi(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Fptosi Fptosi;
-
-	Fptosi* fptosi = static_cast<Fptosi*>(instruction);
-
-	Value a = getOperand(fptosi->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	float temp = bitcast<float>(a);
 	SValue d   = temp;
 
-	setRegister(fptosi->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeFptoui(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeFptoui(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Fptoui Fptoui;
-
-	Fptoui* fptoui = static_cast<Fptoui*>(instruction);
-
-	Value a = getOperand(fptoui->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	float temp = bitcast<float>(a);
 	Value d	= temp;
 
-	setRegister(fptoui->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeFpTrunc(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeFpTrunc(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Fptrunc Fptrunc;
-
-	Fptrunc* fptrunc = static_cast<Fptrunc*>(instruction);
-
-	Value a = getOperand(fptrunc->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	double temp = bitcast<double>(a);
 	float d	 = temp;
 
-	setRegister(fptrunc->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 	
-static __device__ ir::Binary::PC executeFrem(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeFrem(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Frem Frem;
-
-	Frem* rem = static_cast<Frem*>(instruction);
-
-	FValue a = getOperandAs<FValue>(rem->a, parentBlock, threadId);
-	FValue b = getOperandAs<FValue>(rem->b, parentBlock, threadId);
+	FValue a = getOperandAs<FValue>(instruction.a, parentBlock, threadId);
+	FValue b = getOperandAs<FValue>(instruction.b, parentBlock, threadId);
 
 	// TODO: implement this
 	device_assert_m(false, "Floating point mod not implemented.");
 	FValue d = 0.0f;//a % b;
 
-	setRegister(rem->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeLaunch(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeLaunch(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
 	device_assert_m(false, "Device-side kernel launch not implemented yet.");
 
 	return pc;
 }
 
-static __device__ ir::Binary::PC executeLd(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeLd(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Ld Ld;
-	
-	Ld* ld = static_cast<Ld*>(instruction);
-
-	Value a = getOperand(ld->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	Value physical = parentBlock->translateVirtualToPhysical(a);
 
@@ -358,7 +415,8 @@ static __device__ ir::Binary::PC executeLd(Instruction* instruction,
 
 	Value d = 0;
 	
-	switch(ld->d.asIndirect.type)
+	// the access size is the type of the destination register
+	switch(instruction.d.type)
 	{
 		case vanaheimr::as::i1:
 		case vanaheimr::as::i8:
@@ -386,181 +444,154 @@ static __device__ ir::Binary::PC executeLd(Instruction* instruction,
 		default: break;
 	}
 
-	setRegister(ld->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeLshr(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeLshr(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Lshr Lshr;
-	
-	Lshr* lshr = static_cast<Lshr*>(instruction);
-
-	Value a = getOperand(lshr->a, parentBlock, threadId);
-	Value b = getOperand(lshr->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	Value d = a >> b;
 
-	setRegister(lshr->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeMembar(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeMembar(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
 	//__threadfence_block();
 	
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeMul(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeMul(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Mul Mul;
-	
-	Mul* mul = static_cast<Mul*>(instruction);
-
-	Value a = getOperand(mul->a, parentBlock, threadId);
-	Value b = getOperand(mul->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	Value d = a * b;
 
-	setRegister(mul->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeOr(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeOr(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Or Or;
-	
-	Or* orr = static_cast<Or*>(instruction);
-
-	Value a = getOperand(orr->a, parentBlock, threadId);
-	Value b = getOperand(orr->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	Value d = a | b;
 
-	setRegister(orr->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeRet(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeRet(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
 	return parentBlock->returned(threadId, pc); 
 }
 
-static __device__ ir::Binary::PC executeSetp(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeSetp(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Setp Setp;
-	
-	Setp* setp = static_cast<Setp*>(instruction);
-
-	Value a = getOperand(setp->a, parentBlock, threadId);
-	Value b = getOperand(setp->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	//TO DO
 	Value d = a > b ? 1 : 0 ;
-	setRegister(setp->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeSext(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeSext(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Sext Sext;
-	
-	Sext* sext = static_cast<Sext*>(instruction);
-
-	Value a = getOperand(sext->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	int temp = bitcast<int>(a);
 	SValue d = temp;
 
-	setRegister(sext->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeSdiv(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeSdiv(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Sdiv Sdiv;
-	
-	Sdiv* sdiv = static_cast<Sdiv*>(instruction);
-
-	Value a = getOperand(sdiv->a, parentBlock, threadId);
-	Value b = getOperand(sdiv->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	//TO DO
 	SValue d = (SValue) a / (SValue) b;
-	setRegister(sdiv->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeShl(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeShl(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Shl Shl;
-	
-	Shl* shl = static_cast<Shl*>(instruction);
-
-	Value a = getOperand(shl->a, parentBlock, threadId);
-	Value b = getOperand(shl->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	Value d = a << b;
 
-	setRegister(shl->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeSitofp(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeSitofp(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Sitofp Sitofp;
-	
-	Sitofp* sitofp = static_cast<Sitofp*>(instruction);
-
-	Value a = getOperand(sitofp->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	//TO DO
 	float d = (SValue)a;
 
-	setRegister(sitofp->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeSrem(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeSrem(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Srem Srem;
-	
-	Srem* srem = static_cast<Srem*>(instruction);
-
-	SValue a = getOperand(srem->a, parentBlock, threadId);
-	SValue b = getOperand(srem->b, parentBlock, threadId);
+	SValue a = getOperand(instruction.a, parentBlock, threadId);
+	SValue b = getOperand(instruction.b, parentBlock, threadId);
 
 	SValue d = a % b;
 
-	setRegister(srem->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeSt(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeSt(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::St St;
-	
-	St* st = static_cast<St*>(instruction);
-
-	Value d = getOperand(st->d, parentBlock, threadId);
+	Value d = getOperand(instruction.d, parentBlock, threadId);
 	Value physical = parentBlock->translateVirtualToPhysical(d);
 
-	Value a = getOperand(st->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
-	switch(st->a.asIndirect.type)
+	// the access size is the type of the value being stored
+	switch(instruction.a.type)
 	{
 		case vanaheimr::as::i1:
 		case vanaheimr::as::i8:
@@ -591,120 +622,99 @@ static __device__ ir::Binary::PC executeSt(Instruction* instruction,
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeSub(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeSub(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Sub Sub;
-	
-	Sub* sub = static_cast<Sub*>(instruction);
-
-	Value a = getOperand(sub->a, parentBlock, threadId);
-	Value b = getOperand(sub->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	Value d = a - b;
 
-	setRegister(sub->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeTrunc(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeTrunc(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Trunc Trunc;
-	
-	Trunc* trunc = static_cast<Trunc*>(instruction);
-
-	Value a = getOperand(trunc->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	//TO DO
 	Value d = unsigned (a & 0x00000000FFFFFFFFULL); 
 
-	setRegister(trunc->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeUdiv(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeUdiv(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Udiv Udiv;
-	
-	Udiv* udiv = static_cast<Udiv*>(instruction);
-
-	Value a = getOperand(udiv->a, parentBlock, threadId);
-	Value b = getOperand(udiv->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	//TO DO
 	Value d = a / b;
 
-	setRegister(udiv->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeUitofp(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeUitofp(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Uitofp Uitofp;
-	
-	Uitofp* uitofp = static_cast<Uitofp*>(instruction);
-
-	Value a = getOperand(uitofp->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	//TO DO
 	float d = a;
 
-	setRegister(uitofp->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeUrem(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeUrem(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Urem Urem;
-	
-	Urem* urem = static_cast<Urem*>(instruction);
-
-	Value a = getOperand(urem->a, parentBlock, threadId);
-	Value b = getOperand(urem->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	//TO DO
 	Value d = a % b;
-	setRegister(urem->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeXor(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeXor(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Xor Xor;
-	
-	Xor* xorr = static_cast<Xor*>(instruction);
-
-	Value a = getOperand(xorr->a, parentBlock, threadId);
-	Value b = getOperand(xorr->b, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
+	Value b = getOperand(instruction.b, parentBlock, threadId);
 
 	Value d = a ^ b;
 
-	setRegister(xorr->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
-static __device__ ir::Binary::PC executeZext(Instruction* instruction,
-	ir::Binary::PC pc, CoreSimBlock* parentBlock, unsigned threadId)
+static __device__ ir::Binary::PC executeZext(
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	typedef vanaheimr::as::Zext Zext;
-	
-	Zext* zext = static_cast<Zext*>(instruction);
-
-	Value a = getOperand(zext->a, parentBlock, threadId);
+	Value a = getOperand(instruction.a, parentBlock, threadId);
 
 	//TO DO
 	Value d = (unsigned int)a;
-	setRegister(zext->d, parentBlock, threadId, d);
+	setRegister(instruction.d, parentBlock, threadId, d);
 	return pc + 1;
 }
 
 static __device__ ir::Binary::PC executePhi(
-	Instruction* instruction, ir::Binary::PC pc,
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
 	CoreSimBlock* parentBlock, unsigned threadId)
 {
 	device_assert_m(false, "PHI instructions are not valid in machine code.");
@@ -713,7 +723,7 @@ static __device__ ir::Binary::PC executePhi(
 }
 
 static __device__ ir::Binary::PC executePsi(
-	Instruction* instruction, ir::Binary::PC pc,
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
 	CoreSimBlock* parentBlock, unsigned threadId)
 {
 	device_assert_m(false, "PSI instructions are not valid in machine code.");
@@ -722,7 +732,7 @@ static __device__ ir::Binary::PC executePsi(
 }
 
 static __device__ ir::Binary::PC executeInvalidOpcode(
-	Instruction* instruction, ir::Binary::PC pc,
+	const DecodedInstruction& instruction, ir::Binary::PC pc,
 	CoreSimBlock* parentBlock, unsigned threadId)
 {
 	device_assert_m(false, "Executed instruction with invalid opcode.");
@@ -731,8 +741,7 @@ static __device__ ir::Binary::PC executeInvalidOpcode(
 	return pc + 1;
 }
 
-typedef ir::Binary::PC (*JumpTablePointer)(Instruction*,
-	ir::Binary::PC, CoreSimBlock*, unsigned);
+typedef DecodedInstruction::Handler JumpTablePointer;
 
 static __device__ JumpTablePointer decodeTable[] = 
 {
@@ -825,15 +834,108 @@ static __device__ const char* toString(Instruction::Opcode opcode)
 	return "invalid_instruction";
 }
 
+__device__ void CoreSimThread::decodeInstruction(DecodedInstruction& decoded,
+	const Binary::InstructionContainer& instruction)
+{
+	Instruction::Opcode opcode = instruction.asInstruction.opcode;
+
+	if((unsigned int)opcode > Instruction::InvalidOpcode)
+	{
+		opcode = Instruction::InvalidOpcode;
+	}
+
+	decoded.execute = decodeTable[opcode];
+	decoded.target  = 0;
+	decoded.encoded = instruction;
+
+	OperandContainer none;
+
+	none.asOperand.mode = Operand::InvalidOperand;
+
+	decodeOperand(decoded.d, none);
+	decodeOperand(decoded.a, none);
+	decodeOperand(decoded.b, none);
+	decodeOperand(decoded.c, none);
+
+	// only the operands that the handler reads are decoded
+	switch(opcode)
+	{
+	case Instruction::Atom:
+	{
+		decodeOperand(decoded.d, instruction.asAtom.d);
+		decodeOperand(decoded.a, instruction.asAtom.a);
+		decodeOperand(decoded.b, instruction.asAtom.b);
+		decodeOperand(decoded.c, instruction.asAtom.c);
+		break;
+	}
+	case Instruction::Add:
+	case Instruction::And:
+	case Instruction::Ashr:
+	case Instruction::Fdiv:
+	case Instruction::Fmul:
+	case Instruction::Frem:
+	case Instruction::Lshr:
+	case Instruction::Mul:
+	case Instruction::Or:
+	case Instruction::Setp:
+	case Instruction::Sdiv:
+	case Instruction::Shl:
+	case Instruction::Srem:
+	case Instruction::Sub:
+	case Instruction::Udiv:
+	case Instruction::Urem:
+	case Instruction::Xor:
+	{
+		decodeOperand(decoded.d, instruction.asBinaryInstruction.d);
+		decodeOperand(decoded.a, instruction.asBinaryInstruction.a);
+		decodeOperand(decoded.b, instruction.asBinaryInstruction.b);
+		break;
+	}
+	case Instruction::Bitcast:
+	case Instruction::Fpext:
+	case Instruction::Fptosi:
+	case Instruction::Fptoui:
+	case Instruction::Fptrunc:
+	case Instruction::Ld:
+	case Instruction::Sext:
+	case Instruction::Sitofp:
+	case Instruction::St:
+	case Instruction::Trunc:
+	case Instruction::Uitofp:
+	case Instruction::Zext:
+	{
+		decodeOperand(decoded.d, instruction.asUnaryInstruction.d);
+		decodeOperand(decoded.a, instruction.asUnaryInstruction.a);
+		break;
+	}
+	case Instruction::Bra:
+	{
+		decodeOperand(decoded.a, instruction.asBra.target);
+
+		// most branches go to a fixed PC, resolve it now
+		if(instruction.asBra.target.asOperand.mode == Operand::Immediate)
+		{
+			decoded.execute = executeDirectBra;
+			decoded.target  = decoded.a.value;
+		}
+		break;
+	}
+	case Instruction::Call:
+	{
+		decodeOperand(decoded.a, instruction.asCall.target);
+		break;
+	}
+	default: break;
+	}
+}
+
 __device__ ir::Binary::PC CoreSimThread::executeInstruction(
-	Instruction* instruction, ir::Binary::PC pc)
+	const DecodedInstruction& instruction, ir::Binary::PC pc)
 {
-	JumpTablePointer decoderFunction = decodeTable[instruction->opcode];
-	
 	device_report("Thread %d, executing instruction[%d] '%s'\n", m_tId, (int)pc,
-		toString(instruction->opcode));
+		toString(instruction.encoded.asInstruction.opcode));
 	
-	return decoderFunction(instruction, pc, m_parentBlock, m_tId);
+	return instruction.execute(instruction, pc, m_parentBlock, m_tId);
 }
 
 }
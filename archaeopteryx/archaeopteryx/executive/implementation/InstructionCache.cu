@@ -0,0 +1,97 @@
+/*! \file   InstructionCache.cu
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the InstructionCache class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/InstructionCache.h>
+#include <archaeopteryx/executive/interface/CoreSimThread.h>
+
+#include <archaeopteryx/util/interface/debug.h>
+
+// Preprocessor Defines
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ InstructionCache::InstructionCache()
+: m_binary(0), m_instructions(0), m_size(0)
+{
+
+}
+
+__device__ InstructionCache::~InstructionCache()
+{
+	clear();
+}
+
+__device__ void InstructionCache::build(ir::Binary* binary)
+{
+	if(binary == m_binary) return;
+
+	clear();
+
+	typedef ir::Binary::InstructionContainer InstructionContainer;
+
+	const PC instructionsPerPage = sizeof(ir::Binary::PageDataType) /
+		sizeof(InstructionContainer);
+
+	PC pages = binary->code_end() - binary->code_begin();
+
+	device_report("Decoding %d code pages\n", (int)pages);
+
+	m_size         = pages * instructionsPerPage;
+	m_instructions = new DecodedInstruction[m_size];
+
+	InstructionContainer* page = new InstructionContainer[instructionsPerPage];
+
+	for(PC pc = 0; pc < m_size; pc += instructionsPerPage)
+	{
+		binary->copyCode(page, pc, instructionsPerPage);
+
+		for(PC offset = 0; offset < instructionsPerPage; ++offset)
+		{
+			CoreSimThread::decodeInstruction(m_instructions[pc + offset],
+				page[offset]);
+		}
+	}
+
+	delete[] page;
+
+	m_binary = binary;
+}
+
+__device__ void InstructionCache::clear()
+{
+	delete[] m_instructions;
+
+	m_binary       = 0;
+	m_instructions = 0;
+	m_size         = 0;
+}
+
+__device__ const DecodedInstruction* InstructionCache::get(PC pc) const
+{
+	device_assert(pc < m_size);
+
+	return m_instructions + pc;
+}
+
+__device__ InstructionCache::PC InstructionCache::size() const
+{
+	return m_size;
+}
+
+}
+
+}
+
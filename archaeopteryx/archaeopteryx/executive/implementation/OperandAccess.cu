@@ -7,6 +7,7 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/executive/interface/OperandAccess.h>
 #include <archaeopteryx/executive/interface/CoreSimBlock.h>
+#include <archaeopteryx/executive/interface/DecodedInstruction.h>
 
 // Vanaheimr Includes
 #include <vanaheimr/asm/interface/Operand.h>
@@ -147,6 +148,83 @@ __device__ uint64_t getOperand(const vanaheimr::as::Call* call,
 	return getOperand(operand, block, threadId);
 }
 
+__device__ uint64_t getDecodedRegisterOperand(
+	const DecodedOperand& operand, CoreSimBlock* block, unsigned threadId)
+{
+	return block->getRegister(threadId, operand.reg);
+}
+
+__device__ uint64_t getDecodedImmediateOperand(
+	const DecodedOperand& operand, CoreSimBlock* block, unsigned threadId)
+{
+	return operand.value;
+}
+
+__device__ uint64_t getDecodedIndirectOperand(
+	const DecodedOperand& operand, CoreSimBlock* block, unsigned threadId)
+{
+	return block->getRegister(threadId, operand.reg) + operand.value;
+}
+
+__device__ uint64_t getDecodedInvalidOperand(
+	const DecodedOperand& operand, CoreSimBlock* block, unsigned threadId)
+{
+	device_assert_m(false, "Symbol operands not supported in emulator, "
+		"they should have been lowered!");
+
+	return 0;
+}
+
+__device__ void decodeOperand(DecodedOperand& decoded,
+	const OperandContainer& operandContainer)
+{
+	decoded.read  = getDecodedInvalidOperand;
+	decoded.reg   = 0;
+	decoded.type  = vanaheimr::as::InvalidDataType;
+	decoded.value = 0;
+
+	switch(operandContainer.asOperand.mode)
+	{
+	case Operand::Register:
+	{
+		decoded.read = getDecodedRegisterOperand;
+		decoded.reg  = operandContainer.asRegister.reg;
+		decoded.type = operandContainer.asRegister.type;
+		break;
+	}
+	case Operand::Immediate:
+	{
+		decoded.read  = getDecodedImmediateOperand;
+		decoded.type  = operandContainer.asImmediate.type;
+		decoded.value = operandContainer.asImmediate.uint;
+		break;
+	}
+	case Operand::Predicate:
+	{
+		// modifiers are not applied yet, see getPredicateOperand
+		decoded.read = getDecodedRegisterOperand;
+		decoded.reg  = operandContainer.asPredicate.reg;
+		decoded.type = vanaheimr::as::i1;
+		break;
+	}
+	case Operand::Indirect:
+	{
+		decoded.read  = getDecodedIndirectOperand;
+		decoded.reg   = operandContainer.asIndirect.reg;
+		decoded.type  = operandContainer.asIndirect.type;
+		decoded.value = operandContainer.asIndirect.offset;
+		break;
+	}
+	default: break;
+	}
+}
+
+__device__ uint64_t getOperand(const DecodedOperand& operand,
+	CoreSimBlock* parentBlock, unsigned threadId)
+{
+	return operand.read(operand, parentBlock, threadId);
+}
+
 __device__ void setRegister(OperandContainer& operandContainer,
 	CoreSimBlock* parentBlock, unsigned threadId, uint64_t result)
 {
@@ -161,6 +239,12 @@ __device__ void setRegister(unsigned int reg, CoreSimBlock* parentBlock,
 	parentBlock->setRegister(threadId, reg, result);
 }
 
+__device__ void setRegister(const DecodedOperand& operand,
+	CoreSimBlock* parentBlock, unsigned threadId, uint64_t result)
+{
+	parentBlock->setRegister(threadId, operand.reg, result);
+}
+
 }
 
 }
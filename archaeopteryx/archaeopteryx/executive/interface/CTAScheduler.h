@@ -0,0 +1,61 @@
+/*! \file   CTAScheduler.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the CTAScheduler class.
+*/
+
+#pragma once
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief Distributes simulated CTAs over the hardware CTAs.
+
+	Each hardware CTA starts with an even share of the simulated CTAs and
+	takes them in order.  When its share runs out it steals the upper half
+	of the share of another hardware CTA.  A share is a range packed into
+	a single word, so taking and stealing are both a single CAS.
+*/
+class CTAScheduler
+{
+public:
+	__device__ CTAScheduler();
+	__device__ ~CTAScheduler();
+
+public:
+	/*! \brief Split the simulated CTAs evenly among the hardware CTAs */
+	__device__ void setup(unsigned int simulatedBlocks,
+		unsigned int hardwareBlocks);
+
+	/*! \brief Get the next simulated CTA for a hardware CTA,
+		returns false once all simulated CTAs have been handed out */
+	__device__ bool next(unsigned int hardwareBlock,
+		unsigned int& simulatedBlock);
+
+private:
+	/*! \brief [begin, end) in the low and high halves */
+	typedef unsigned long long Range;
+
+private:
+	__device__ bool _take(unsigned int hardwareBlock,
+		unsigned int& simulatedBlock);
+	__device__ bool _steal(unsigned int hardwareBlock);
+
+private:
+	__device__ static Range _pack(unsigned int begin, unsigned int end);
+	__device__ static unsigned int _begin(Range range);
+	__device__ static unsigned int _end(Range range);
+
+private:
+	Range*       m_ranges;
+	unsigned int m_hardwareBlocks;
+
+};
+
+}
+
+}
+
@@ -12,7 +12,8 @@
 #include <archaeopteryx/executive/interface/CoreSimThread.h>
 
 // Forward declarations
-namespace archaeopteryx { namespace executive { class CoreSimKernel; } }
+namespace archaeopteryx { namespace executive { class CoreSimKernel;      } }
+namespace archaeopteryx { namespace executive { class DecodedInstruction; } }
 
 // Preprocessor Macros
 #define WARP_SIZE	 32
@@ -28,7 +29,6 @@ class CoreSimBlock
 {
 	typedef ir::Binary::PC PC;
 	typedef ir::Binary::InstructionContainer InstructionContainer;
-	typedef char SharedMemory;
 	typedef char LocalMemory;
 
 	public:
@@ -55,23 +55,42 @@ class CoreSimBlock
 		bool m_predicateMask[WARP_SIZE]; 
 		const CoreSimKernel* m_kernel;
 
+		// The arena of each hardware CTA is reused by every simulated
+		//  CTA that runs on it
+		unsigned int m_registerFileSize;
+		unsigned int m_threadCapacity;
+
 	private:
 		__device__ void clearAllBarrierBits();
 		__device__ bool areAllThreadsFinished();
 		__device__ void roundRobinScheduler();
 		__device__ unsigned int findNextPC(unsigned int&);
 		__device__ bool setPredicateMaskForWarp(PC pc);
-		__device__ InstructionContainer fetchInstruction(PC pc);
-		__device__ void executeWarp(InstructionContainer* instruction, PC pc);
+		__device__ const DecodedInstruction* fetchInstruction(PC pc);
+		__device__ void executeWarp(const DecodedInstruction* instruction,
+			PC pc);
 		__device__ unsigned int getThreadIdInWarp();
 		__device__ void initializeSpecialRegisters();
 
+#ifdef ARCHAEOPTERYX_HOST
+		// Host builds loop over the lanes of the current warp
+		__device__ unsigned int getThreadsInWarp();
+#endif
+
+	public:
+		__device__ CoreSimBlock();
+		// Copies get their own arena
+		__device__ CoreSimBlock(const CoreSimBlock&);
+		__device__ CoreSimBlock& operator=(const CoreSimBlock&);
+		__device__ ~CoreSimBlock();
+
 	public:
 		// Initializes the state of the block
 		//  1) Register file
-		//  2) shared memory 
-		//  3) local memory for each thread
-		//  4) thread contexts
+		//  2) local memory for each thread
+		//  3) thread contexts
+		// Shared memory is not simulated, loads and stores only address
+		//  the global space
 		__device__ void setupCoreSimBlock(unsigned int blockId,
 			unsigned int registers, const CoreSimKernel* kernel);
 		__device__ void setupBinary(ir::Binary* binary);
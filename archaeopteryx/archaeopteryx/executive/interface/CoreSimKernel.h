@@ -7,6 +7,10 @@
 
 #pragma once
 
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/CTAScheduler.h>
+#include <archaeopteryx/executive/interface/InstructionCache.h>
+
 // Vanaheimr Includes
 #include <vanaheimr/util/interface/IntTypes.h>
 
@@ -38,6 +42,12 @@ public:
 	unsigned int linkRegister;
 	unsigned int simulatedBlocks;
 
+	/*! \brief Hands out simulated CTAs to hardware CTAs */
+	CTAScheduler scheduler;
+
+	/*! \brief The decoded code section of the binary being simulated */
+	InstructionCache instructions;
+
 };
 
 }
@@ -13,8 +13,9 @@
 #include <archaeopteryx/util/interface/IntTypes.h>
 
 // Forward Declarations
-namespace archaeopteryx { namespace executive { class CoreSimBlock; } }
-namespace vanaheimr     { namespace as        { class Instruction;  } }
+namespace archaeopteryx { namespace executive { class CoreSimBlock;       } }
+namespace archaeopteryx { namespace executive { class DecodedInstruction; } }
+namespace vanaheimr     { namespace as        { class Instruction;        } }
 
 namespace archaeopteryx
 {
@@ -38,7 +39,12 @@ class CoreSimThread
 	public:
         __device__ CoreSimThread(CoreSimBlock* parentBlock = 0,
         	unsigned threadId = 0, unsigned priority = 1, bool barrier = false);
-        __device__ PC executeInstruction(Instruction*, PC);
+        __device__ PC executeInstruction(const DecodedInstruction&, PC);
+
+	public:
+		/*! \brief Resolve the handler and operands of an instruction */
+		__device__ static void decodeInstruction(DecodedInstruction& decoded,
+			const Binary::InstructionContainer& instruction);
 
 	public:
 		__device__ void setParentBlock(CoreSimBlock* parentBlock);
@@ -0,0 +1,74 @@
+/*! \file   DecodedInstruction.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the DecodedInstruction class.
+*/
+
+#pragma once
+
+// Archaeopteryx Includes
+#include <archaeopteryx/ir/interface/Binary.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/asm/interface/Instruction.h>
+
+// Forward Declarations
+namespace archaeopteryx { namespace executive { class CoreSimBlock; } }
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief An operand with its accessor resolved from the operand mode */
+class DecodedOperand
+{
+public:
+	typedef uint64_t (*Accessor)(const DecodedOperand&, CoreSimBlock*,
+		unsigned);
+
+public:
+	/*! \brief Reads the value of the operand for a thread */
+	Accessor read;
+	/*! \brief The register, or the base register of an indirect operand */
+	unsigned int reg;
+	/*! \brief The data type, the access size of loads and stores */
+	vanaheimr::as::DataType type;
+	/*! \brief An immediate value, or the offset of an indirect operand */
+	uint64_t value;
+};
+
+/*! \brief An instruction with its handler and operands resolved, the
+	simulator executes these instead of decoding the binary at every PC */
+class DecodedInstruction
+{
+public:
+	typedef ir::Binary::PC PC;
+	typedef ir::Binary::InstructionContainer InstructionContainer;
+
+	typedef PC (*Handler)(const DecodedInstruction&, PC, CoreSimBlock*,
+		unsigned);
+
+public:
+	/*! \brief Executes the instruction for a thread, returns the next PC */
+	Handler execute;
+
+	/*! \brief The destination and source operands */
+	DecodedOperand d;
+	DecodedOperand a;
+	DecodedOperand b;
+	DecodedOperand c;
+
+	/*! \brief The target of a branch to an immediate PC */
+	PC target;
+
+	/*! \brief The instruction as it appears in the binary, used for the
+		fields that are not decoded (call arguments, atomic operations) */
+	InstructionContainer encoded;
+};
+
+}
+
+}
+
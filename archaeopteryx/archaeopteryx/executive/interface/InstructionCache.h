@@ -0,0 +1,59 @@
+/*! \file   InstructionCache.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the InstructionCache class.
+*/
+
+#pragma once
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/DecodedInstruction.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief The decoded code section of the binary being simulated.
+
+	Every instruction is copied out of the binary and decoded once before
+	the kernel starts, the simulated CTAs then index the array by PC
+	instead of copying and decoding an instruction at every warp step.
+	The array is only read while the kernel runs, so the hardware CTAs
+	share it without locking.
+*/
+class InstructionCache
+{
+public:
+	typedef ir::Binary::PC PC;
+
+public:
+	__device__ InstructionCache();
+	__device__ ~InstructionCache();
+
+public:
+	/*! \brief Decode the code section of a binary, does nothing if the
+		binary is already cached */
+	__device__ void build(ir::Binary* binary);
+	/*! \brief Drop the decoded instructions */
+	__device__ void clear();
+
+public:
+	/*! \brief Get the decoded instruction at a PC */
+	__device__ const DecodedInstruction* get(PC pc) const;
+
+	/*! \brief The number of decoded instructions */
+	__device__ PC size() const;
+
+private:
+	ir::Binary*         m_binary;
+	DecodedInstruction* m_instructions;
+	PC                  m_size;
+
+};
+
+}
+
+}
+
@@ -10,7 +10,8 @@
 #include <vanaheimr/asm/interface/Operand.h>
 
 // Forward Declarations
-namespace archaeopteryx { namespace executive { class CoreSimBlock; } }
+namespace archaeopteryx { namespace executive { class CoreSimBlock;   } }
+namespace archaeopteryx { namespace executive { class DecodedOperand; } }
 
 namespace vanaheimr { namespace as { class Call; } }
 
@@ -34,6 +35,13 @@ __device__ unsigned int getReturnRegister(const vanaheimr::as::Call* call,
 __device__ uint64_t getOperand(const vanaheimr::as::Call* call,
 	CoreSimBlock* parentBlock, unsigned threadId, unsigned int index);
 
+// Decoded Operand Access
+__device__ void decodeOperand(DecodedOperand& decoded,
+	const vanaheimr::as::OperandContainer& operandContainer);
+
+__device__ uint64_t getOperand(const DecodedOperand& operand,
+	CoreSimBlock* parentBlock, unsigned threadId);
+
 // Register Access
 __device__ void setRegister(vanaheimr::as::OperandContainer& operandContainer,
 	CoreSimBlock* parentBlock, unsigned threadId, uint64_t result);
@@ -41,6 +49,9 @@ __device__ void setRegister(vanaheimr::as::OperandContainer& operandContainer,
 __device__ void setRegister(unsigned int reg, CoreSimBlock* parentBlock,
 	unsigned threadId, uint64_t result);
 
+__device__ void setRegister(const DecodedOperand& operand,
+	CoreSimBlock* parentBlock, unsigned threadId, uint64_t result);
+
 }
 
 }
@@ -0,0 +1,243 @@
+/*! \file   TraceWriter.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the helpers that the executive tests use to
+		assemble VIR into a trace.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/asm/interface/BinaryHeader.h>
+#include <vanaheimr/asm/interface/SymbolTableEntry.h>
+#include <vanaheimr/asm/interface/Instruction.h>
+
+// Standard Library Includes
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+typedef vanaheimr::as::BinaryHeader         BinaryHeader;
+typedef vanaheimr::as::SymbolTableEntry     SymbolTableEntry;
+typedef vanaheimr::as::Instruction          Instruction;
+typedef vanaheimr::as::InstructionContainer InstructionContainer;
+typedef vanaheimr::as::OperandContainer     OperandContainer;
+typedef vanaheimr::as::Operand              Operand;
+typedef vanaheimr::as::PredicateOperand     PredicateOperand;
+typedef vanaheimr::as::DataType             DataType;
+
+typedef std::vector<InstructionContainer> InstructionVector;
+
+inline OperandContainer reg(unsigned int r, DataType type)
+{
+	OperandContainer operand;
+
+	std::memset(&operand, 0, sizeof(OperandContainer));
+
+	operand.asRegister.mode = Operand::Register;
+	operand.asRegister.reg  = r;
+	operand.asRegister.type = type;
+
+	return operand;
+}
+
+inline OperandContainer imm(uint64_t value, DataType type)
+{
+	OperandContainer operand;
+
+	std::memset(&operand, 0, sizeof(OperandContainer));
+
+	operand.asImmediate.mode = Operand::Immediate;
+	operand.asImmediate.uint = value;
+	operand.asImmediate.type = type;
+
+	return operand;
+}
+
+inline OperandContainer indirect(unsigned int r, uint64_t offset)
+{
+	OperandContainer operand;
+
+	std::memset(&operand, 0, sizeof(OperandContainer));
+
+	operand.asIndirect.mode   = Operand::Indirect;
+	operand.asIndirect.reg    = r;
+	operand.asIndirect.offset = offset;
+	operand.asIndirect.type   = vanaheimr::as::i64;
+
+	return operand;
+}
+
+inline InstructionContainer instruction(Instruction::Opcode opcode)
+{
+	InstructionContainer container;
+
+	std::memset(&container, 0, sizeof(InstructionContainer));
+
+	container.asInstruction.opcode = opcode;
+
+	container.asInstruction.guard.mode     = Operand::Predicate;
+	container.asInstruction.guard.modifier = PredicateOperand::PredicateTrue;
+
+	return container;
+}
+
+inline InstructionContainer unary(Instruction::Opcode opcode,
+	const OperandContainer& d, const OperandContainer& a)
+{
+	InstructionContainer container = instruction(opcode);
+
+	container.asUnaryInstruction.d = d;
+	container.asUnaryInstruction.a = a;
+
+	return container;
+}
+
+inline InstructionContainer binary(Instruction::Opcode opcode,
+	const OperandContainer& d, const OperandContainer& a,
+	const OperandContainer& b)
+{
+	InstructionContainer container = instruction(opcode);
+
+	container.asBinaryInstruction.d = d;
+	container.asBinaryInstruction.a = a;
+	container.asBinaryInstruction.b = b;
+
+	return container;
+}
+
+/*! \brief Assembles a single function and its data into a VIR binary */
+class TraceWriter
+{
+public:
+	void addFunction(const std::string& name, const InstructionVector& code)
+	{
+		_addSymbol(name, SymbolTableEntry::FunctionType,
+			_code.size() * sizeof(InstructionContainer),
+			code.size() * sizeof(InstructionContainer));
+
+		_code.insert(_code.end(), code.begin(), code.end());
+	}
+
+	void addVariable(const std::string& name, const std::string& data)
+	{
+		_addSymbol(name, SymbolTableEntry::VariableType, _data.size(),
+			data.size());
+
+		_data += data;
+	}
+
+	template<typename T>
+	void addVariable(const std::string& name, const T& value)
+	{
+		std::stringstream stream;
+
+		stream << value;
+
+		addVariable(name, stream.str());
+	}
+
+	void write(const std::string& filename)
+	{
+		const uint64_t pageSize = BinaryHeader::PageSize;
+
+		BinaryHeader header;
+
+		std::memset(&header, 0, sizeof(BinaryHeader));
+
+		header.magic       = BinaryHeader::MagicNumber;
+		header.dataPages   = _pages(_data.size());
+		header.codePages   = _pages(_code.size() *
+			sizeof(InstructionContainer));
+		header.symbols     = _symbols.size();
+		header.stringPages = _pages(_strings.size());
+
+		header.symbolOffset  = sizeof(BinaryHeader);
+		header.dataOffset    = _pages(header.symbolOffset +
+			_symbols.size() * sizeof(SymbolTableEntry)) * pageSize;
+		header.codeOffset    = header.dataOffset + header.dataPages * pageSize;
+		header.stringsOffset = header.codeOffset + header.codePages * pageSize;
+
+		// symbol offsets are absolute
+		for(auto symbol = _symbols.begin(); symbol != _symbols.end(); ++symbol)
+		{
+			if(symbol->type == SymbolTableEntry::FunctionType)
+			{
+				symbol->offset += header.codeOffset;
+			}
+			else
+			{
+				symbol->offset += header.dataOffset;
+			}
+		}
+
+		std::string binary(header.stringsOffset +
+			header.stringPages * pageSize, '\0');
+
+		std::memcpy(&binary[0], &header, sizeof(BinaryHeader));
+		std::memcpy(&binary[header.symbolOffset], _symbols.data(),
+			_symbols.size() * sizeof(SymbolTableEntry));
+		std::memcpy(&binary[header.dataOffset], _data.data(), _data.size());
+		std::memcpy(&binary[header.codeOffset], _code.data(),
+			_code.size() * sizeof(InstructionContainer));
+		std::memcpy(&binary[header.stringsOffset], _strings.data(),
+			_strings.size());
+
+		std::ofstream file(filename.c_str(), std::ios::binary);
+
+		file.write(binary.data(), binary.size());
+	}
+
+private:
+	void _addSymbol(const std::string& name, unsigned int type,
+		uint64_t offset, uint64_t size)
+	{
+		SymbolTableEntry symbol;
+
+		std::memset(&symbol, 0, sizeof(SymbolTableEntry));
+
+		symbol.type         = type;
+		symbol.stringOffset = _strings.size();
+		symbol.offset       = offset;
+		symbol.size         = size;
+
+		_symbols.push_back(symbol);
+
+		_strings += name;
+		_strings.push_back('\0');
+	}
+
+	static uint64_t _pages(uint64_t bytes)
+	{
+		return (bytes + BinaryHeader::PageSize - 1) / BinaryHeader::PageSize;
+	}
+
+private:
+	std::vector<SymbolTableEntry> _symbols;
+	InstructionVector             _code;
+	std::string                   _data;
+	std::string                   _strings;
+};
+
+template<typename T>
+inline std::string toBytes(const T* data, size_t elements)
+{
+	return std::string((const char*)data, elements * sizeof(T));
+}
+
+inline std::string toHexAddress(uint64_t address)
+{
+	std::stringstream stream;
+
+	stream << "0x" << std::hex << address;
+
+	return stream.str();
+}
+
+}
+
@@ -0,0 +1,181 @@
+/*! \file   saxpy-stress.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A stress test for the simulator worker threads, a large saxpy
+		that also counts its threads with a global atomic is simulated with
+		different numbers of workers.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/driver/host-interface/ArchaeopteryxDriver.h>
+
+#include <archaeopteryx/executive/test/TraceWriter.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define ARRAY_LENGTH   (1 << 18)
+#define THREADS_PER_CTA 64
+#define ALPHA           2
+
+#define PARAMETER_ADDRESS 0x0
+#define Y_ADDRESS         0x100000
+#define X_ADDRESS         0x200000
+#define COUNTER_ADDRESS   0x400000
+
+/*
+saxpy(int* y, int* x, int a, int* counter)
+
+	Begin:
+		...saxpy, see saxpy.cpp...
+
+		ld      r13, [r11+24]; // r13 is counter
+		atom.add r14, [r13], 1;
+
+		ret;
+*/
+
+namespace test
+{
+
+static InstructionVector createSaxpyWithCounter()
+{
+	using namespace vanaheimr::as;
+
+	InstructionVector vir;
+
+	vir.push_back(unary(Instruction::Bitcast,  reg(11, i64), reg(32, i64)));
+	vir.push_back(unary(Instruction::Ld,       reg( 0, i64), indirect(11, 0)));
+	vir.push_back(unary(Instruction::Ld,       reg( 1, i64), indirect(11, 8)));
+	vir.push_back(unary(Instruction::Ld,       reg( 2, i32),
+		indirect(11, 16)));
+	vir.push_back(unary(Instruction::Bitcast,  reg( 3, i32), reg(33, i32)));
+	vir.push_back(unary(Instruction::Zext,     reg(12, i64), reg( 3, i32)));
+	vir.push_back(binary(Instruction::Mul,     reg( 4, i64), reg(12, i64),
+		imm(4, i64)));
+	vir.push_back(binary(Instruction::Add,     reg( 5, i64), reg( 4, i64),
+		reg( 0, i64)));
+	vir.push_back(binary(Instruction::Add,     reg( 6, i64), reg( 4, i64),
+		reg( 1, i64)));
+	vir.push_back(unary(Instruction::Ld,       reg( 7, i32), indirect(5, 0)));
+	vir.push_back(unary(Instruction::Ld,       reg( 8, i32), indirect(6, 0)));
+	vir.push_back(binary(Instruction::Mul,     reg( 9, i32), reg( 8, i32),
+		reg( 2, i32)));
+	vir.push_back(binary(Instruction::Add,     reg(10, i32), reg( 7, i32),
+		reg( 9, i32)));
+	vir.push_back(unary(Instruction::St,       indirect(5, 0), reg(10, i32)));
+	vir.push_back(unary(Instruction::Ld,       reg(13, i64),
+		indirect(11, 24)));
+
+	InstructionContainer atom = binary(Instruction::Atom, reg(14, i32),
+		reg(13, i64), imm(1, i32));
+
+	atom.asAtom.operation = Atom::AtomicAdd;
+
+	vir.push_back(atom);
+	vir.push_back(instruction(Instruction::Ret));
+
+	return vir;
+}
+
+void writeSaxpyStressTrace(const std::string& filename)
+{
+	TraceWriter writer;
+
+	writer.addFunction("saxpy", createSaxpyWithCounter());
+
+	// saxpy(y, x, a, counter)
+	uint64_t parameters[4] = {Y_ADDRESS, X_ADDRESS, ALPHA, COUNTER_ADDRESS};
+
+	writer.addVariable("simulated-ctas", ARRAY_LENGTH / THREADS_PER_CTA);
+	writer.addVariable("simulated-threads-per-cta", THREADS_PER_CTA);
+	writer.addVariable("simulated-shared-memory-per-cta", 0);
+	writer.addVariable("simulated-kernel-name", std::string("saxpy"));
+	writer.addVariable("simulated-parameter-memory-address",
+		toHexAddress(PARAMETER_ADDRESS));
+	writer.addVariable("simulated-parameter-memory-size",
+		sizeof(parameters));
+	writer.addVariable("simulated-parameter-memory",
+		toBytes(parameters, 4));
+
+	std::vector<int> x(ARRAY_LENGTH);
+	std::vector<int> y(ARRAY_LENGTH);
+	std::vector<int> result(ARRAY_LENGTH);
+
+	for(unsigned int i = 0; i < ARRAY_LENGTH; ++i)
+	{
+		x[i] = i;
+		y[i] = i;
+
+		result[i] = y[i] + ALPHA * x[i];
+	}
+
+	// every simulated thread increments the counter once
+	unsigned int counter = 0;
+	unsigned int threads = ARRAY_LENGTH;
+
+	writer.addVariable("simulated-allocation-" + toHexAddress(X_ADDRESS),
+		toBytes(x.data(), x.size()));
+	writer.addVariable("simulated-allocation-" + toHexAddress(Y_ADDRESS),
+		toBytes(y.data(), y.size()));
+	writer.addVariable("simulated-allocation-" +
+		toHexAddress(COUNTER_ADDRESS), toBytes(&counter, 1));
+	writer.addVariable("simulated-verify-allocation-" +
+		toHexAddress(Y_ADDRESS), toBytes(result.data(), result.size()));
+	writer.addVariable("simulated-verify-allocation-" +
+		toHexAddress(COUNTER_ADDRESS), toBytes(&threads, 1));
+
+	writer.write(filename);
+}
+
+static bool runSaxpyStress(const std::string& trace,
+	const std::string& workers)
+{
+	typedef archaeopteryx::driver::ArchaeopteryxDriver ArchaeopteryxDriver;
+
+	ArchaeopteryxDriver::KnobList knobs;
+
+	knobs.push_back(std::make_pair("simulator-worker-threads", workers));
+
+	ArchaeopteryxDriver driver;
+
+	bool passed = driver.runSimulation(trace, knobs);
+
+	std::cout << "saxpy stress test with " << workers << " worker threads "
+		<< (passed ? "Passed" : "Failed") << "\n";
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	std::string trace = "saxpy-stress.vir";
+
+	test::writeSaxpyStressTrace(trace);
+
+	// the number of worker threads may be given, otherwise try a few
+	std::vector<std::string> workers;
+
+	if(argc > 1)
+	{
+		workers.push_back(argv[1]);
+	}
+	else
+	{
+		workers = {"1", "4", "16"};
+	}
+
+	bool passed = true;
+
+	for(auto& count : workers)
+	{
+		passed &= test::runSaxpyStress(trace, count);
+	}
+
+	return passed ? 0 : -1;
+}
+
@@ -0,0 +1,147 @@
+/*! \file   saxpy.cpp
+	\date   Saturday Feburary 26, 2011
+	\author Gregory Diamos and Sudnya Padalikar
+		<gregory.diamos@gatech.edu, mailsudnya@gmail.com>
+	\brief  A test for VIR and the simulator core, saxpy is written to a
+		trace and simulated end to end.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/driver/host-interface/ArchaeopteryxDriver.h>
+
+#include <archaeopteryx/executive/test/TraceWriter.h>
+
+// Standard Library Includes
+#include <string>
+#include <vector>
+
+#define ARRAY_LENGTH   256
+#define THREADS_PER_CTA 64
+#define ALPHA           2
+
+#define PARAMETER_ADDRESS 0x0
+#define Y_ADDRESS         0x1000
+#define X_ADDRESS         0x2000
+
+/*
+saxpy(int* y, int* x, int a)
+
+	Begin:
+		bitcast r11, "parameter_base";   // get address
+		ld      r0, [r11]; // r0 is base of y
+		ld      r1, [r11+8]; // r1 is base of x
+		ld      r2, [r11+16]; // r2 is alpha
+
+		bitcast r3,  "global_thread_id";
+		zext    r12, r3;
+		mul,    r4,  r12, 4;
+
+		add     r5, r4, r0; // r5 is y[i]
+		add     r6, r4, r1; // r6 is x[i]
+
+		ld      r7, [r5];
+		ld      r8, [r6];
+
+		mul     r9,  r8, r2;
+		add     r10, r7, r9;
+
+		st      [r5], r10;
+
+		ret;
+*/
+
+namespace test
+{
+
+static InstructionVector createSaxpy()
+{
+	using namespace vanaheimr::as;
+
+	InstructionVector vir;
+
+	vir.push_back(unary(Instruction::Bitcast,  reg(11, i64), reg(32, i64)));
+	vir.push_back(unary(Instruction::Ld,       reg( 0, i64), indirect(11, 0)));
+	vir.push_back(unary(Instruction::Ld,       reg( 1, i64), indirect(11, 8)));
+	vir.push_back(unary(Instruction::Ld,       reg( 2, i32),
+		indirect(11, 16)));
+	vir.push_back(unary(Instruction::Bitcast,  reg( 3, i32), reg(33, i32)));
+	vir.push_back(unary(Instruction::Zext,     reg(12, i64), reg( 3, i32)));
+	vir.push_back(binary(Instruction::Mul,     reg( 4, i64), reg(12, i64),
+		imm(4, i64)));
+	vir.push_back(binary(Instruction::Add,     reg( 5, i64), reg( 4, i64),
+		reg( 0, i64)));
+	vir.push_back(binary(Instruction::Add,     reg( 6, i64), reg( 4, i64),
+		reg( 1, i64)));
+	vir.push_back(unary(Instruction::Ld,       reg( 7, i32), indirect(5, 0)));
+	vir.push_back(unary(Instruction::Ld,       reg( 8, i32), indirect(6, 0)));
+	vir.push_back(binary(Instruction::Mul,     reg( 9, i32), reg( 8, i32),
+		reg( 2, i32)));
+	vir.push_back(binary(Instruction::Add,     reg(10, i32), reg( 7, i32),
+		reg( 9, i32)));
+	vir.push_back(unary(Instruction::St,       indirect(5, 0), reg(10, i32)));
+	vir.push_back(instruction(Instruction::Ret));
+
+	return vir;
+}
+
+void writeSaxpyTrace(const std::string& filename)
+{
+	TraceWriter writer;
+
+	writer.addFunction("saxpy", createSaxpy());
+
+	// saxpy(y, x, a)
+	uint64_t parameters[3] = {Y_ADDRESS, X_ADDRESS, ALPHA};
+
+	writer.addVariable("simulated-ctas", ARRAY_LENGTH / THREADS_PER_CTA);
+	writer.addVariable("simulated-threads-per-cta", THREADS_PER_CTA);
+	writer.addVariable("simulated-shared-memory-per-cta", 0);
+	writer.addVariable("simulated-kernel-name", std::string("saxpy"));
+	writer.addVariable("simulated-parameter-memory-address",
+		toHexAddress(PARAMETER_ADDRESS));
+	writer.addVariable("simulated-parameter-memory-size",
+		sizeof(parameters));
+	writer.addVariable("simulated-parameter-memory",
+		toBytes(parameters, 3));
+
+	std::vector<int> x(ARRAY_LENGTH);
+	std::vector<int> y(ARRAY_LENGTH);
+	std::vector<int> result(ARRAY_LENGTH);
+
+	for(unsigned int i = 0; i < ARRAY_LENGTH; ++i)
+	{
+		x[i] = i;
+		y[i] = i;
+
+		result[i] = y[i] + ALPHA * x[i];
+	}
+
+	writer.addVariable("simulated-allocation-" + toHexAddress(X_ADDRESS),
+		toBytes(x.data(), x.size()));
+	writer.addVariable("simulated-allocation-" + toHexAddress(Y_ADDRESS),
+		toBytes(y.data(), y.size()));
+	writer.addVariable("simulated-verify-allocation-" +
+		toHexAddress(Y_ADDRESS), toBytes(result.data(), result.size()));
+
+	writer.write(filename);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	std::string trace = "saxpy.vir";
+
+	test::writeSaxpyTrace(trace);
+
+	archaeopteryx::driver::ArchaeopteryxDriver driver;
+
+	if(!driver.runSimulation(trace,
+		archaeopteryx::driver::ArchaeopteryxDriver::KnobList()))
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
@@ -9,6 +9,7 @@
 
 #include <archaeopteryx/util/interface/File.h>
 
+#include <archaeopteryx/util/interface/HostCompatibility.h>
 #include <archaeopteryx/util/interface/debug.h>
 #include <archaeopteryx/util/interface/cstring.h>
 
@@ -68,6 +69,7 @@ __device__ Binary::~Binary()
 	device_report(" deleting symbol tables...\n");
 
 	delete[] _symbolTable;
+	delete[] _symbolHash;
 	delete[] _codeSection;
 	delete[] _dataSection;
 	delete[] _stringSection;
@@ -81,6 +83,25 @@ __device__ Binary::SymbolTableEntry* Binary::findSymbol(const char* name)
 {
 	_loadSymbolTable();
 	
+	if(_symbolHash != 0)
+	{
+		uint32_t i = _symbolHash[_hash(name) % _header.symbolHashBuckets];
+		
+		for(; i != Header::InvalidSymbol;
+			i = _symbolHash[_header.symbolHashBuckets + i])
+		{
+			SymbolTableEntry* symbol = _symbolTable + i;
+			
+			if(_strcmp(_header.stringsOffset + symbol->stringOffset,
+				name) == 0)
+			{
+				return symbol;
+			}
+		}
+		
+		return 0;
+	}
+	
 	for(unsigned int i = 0; i < _header.symbols; ++i)
 	{
 		SymbolTableEntry* symbol = _symbolTable + i;
@@ -313,7 +334,7 @@ __device__ Binary::page_iterator Binary::string_end()
 
 __device__ Binary::PageDataType* Binary::getCodePage(page_iterator page)
 {
-	while(*page == 0)
+	while(atomicLoad(page) == 0)
 	{
 		if(!_lock(page)) continue;
 	
@@ -321,22 +342,20 @@ __device__ Binary::PageDataType* Binary::getCodePage(page_iterator page)
 
 		device_report("Loading code page (%p) at offset (%p) now...\n",
 			page, offset);
-	
-		_file->seekg(offset);
-		*page = (PageDataType*)new PageDataType;
-		_file->read(*page, sizeof(PageDataType));
+
+		_loadPage(page, offset);
 
 		_unlock(page);
 	
 		break;
 	}
 	
-	return *page;
+	return atomicLoad(page);
 }
 
 __device__ Binary::PageDataType* Binary::getDataPage(page_iterator page)
 {
-	while(*page == 0)
+	while(atomicLoad(page) == 0)
 	{
 		if(!_lock(page)) continue;
 		
@@ -345,23 +364,21 @@ __device__ Binary::PageDataType* Binary::getDataPage(page_iterator page)
 		device_report("Loading data page (%p) at offset (%p) now...\n",
 			page, offset);
 
-		_file->seekg(offset);
-		*page = (PageDataType*)new PageDataType;
-		_file->read(*page, sizeof(PageDataType));
+		_loadPage(page, offset);
 		
 		_unlock(page);
 
 		break;
 	}
 	
-	return *page;
+	return atomicLoad(page);
 }
 
 __device__ Binary::PageDataType* Binary::getStringPage(page_iterator page)
 {
 	device_assert(page < string_end());
 
-	while(*page == 0)
+	while(atomicLoad(page) == 0)
 	{
 		if(!_lock(page)) continue;
 		
@@ -370,16 +387,14 @@ __device__ Binary::PageDataType* Binary::getStringPage(page_iterator page)
 		device_report("Loading string page (%p) at offset (%p) now...\n",
 			page, offset);
 
-		_file->seekg(offset);
-		*page = (PageDataType*)new PageDataType;
-		_file->read(*page, sizeof(PageDataType));
+		_loadPage(page, offset);
 		
 		_unlock(page);
 		
 		break;
 	}
 	
-	return *page;
+	return atomicLoad(page);
 }
 
 
@@ -396,6 +411,7 @@ __device__ void Binary::_loadHeader()
 	_stringSection = new PagePointer[_header.stringPages];
 
 	_symbolTable = 0;
+	_symbolHash  = 0;
 
 	util::memset(_dataSection,   0, _header.dataPages   * sizeof(PagePointer));
 	util::memset(_codeSection,   0, _header.codePages   * sizeof(PagePointer));
@@ -440,6 +456,18 @@ __device__ void Binary::_loadSymbolTable()
 	_file->read(_symbolTable, _header.symbols * sizeof(SymbolTableEntry));
 
 	device_report("   loaded %d symbols...\n", _header.symbols);
+
+	if(_header.symbolHashBuckets == 0) return;
+
+	unsigned int entries = _header.symbolHashBuckets + _header.symbols;
+
+	_symbolHash = new uint32_t[entries];
+
+	_file->seekg(_header.symbolHashOffset);
+	_file->read(_symbolHash, entries * sizeof(uint32_t));
+
+	device_report("   loaded %d symbol hash buckets...\n",
+		_header.symbolHashBuckets);
 }
 
 __device__ size_t Binary::_getCodePageOffset(page_iterator page)
@@ -494,6 +522,19 @@ __device__ int Binary::_strcmp(unsigned int stringTableOffset,
 	return 0;
 }
 
+__device__ uint32_t Binary::_hash(const char* string)
+{
+	uint32_t hash = Header::FnvOffsetBasis;
+	
+	for(; *string != '\0'; ++string)
+	{
+		hash ^= (uint8_t)*string;
+		hash *= Header::FnvPrime;
+	}
+	
+	return hash;
+}
+
 __device__ void Binary::_datacpy(char* string, unsigned int dataOffset,
 	unsigned int size)
 {
@@ -649,6 +690,26 @@ __device__ bool Binary::_unlock(page_iterator page)
 	return lock->second.unlock();
 }
 
+__device__ void Binary::_loadPage(page_iterator page, size_t offset)
+{
+	// another thread may have loaded the page before the lock was taken
+	if(atomicLoad(page) != 0) return;
+
+	PagePointer data = (PagePointer)new PageDataType;
+
+	while(!_fileLock.lock());
+
+	_file->seekg(offset);
+	_file->read(data, sizeof(PageDataType));
+
+	_fileLock.unlock();
+
+	// the page must be complete before other threads can see it
+	__threadfence();
+
+	atomicStore(page, data);
+}
+
 __device__ Binary::Lock::Lock()
 {
 	_lock = 0xffffffff;
@@ -148,6 +148,7 @@ private:
 
 private:
 	__device__ int _strcmp(unsigned int stringTableOffset, const char* string);
+	__device__ uint32_t _hash(const char* string);
 	__device__ void _strcpy(char* string, unsigned int stringTableOffset);
 	__device__ int _strlen(unsigned int stringTableOffset);
 	__device__ void _datacpy(char* string, unsigned int dataOffset,
@@ -172,6 +173,8 @@ private:
 	__device__ bool _lock(page_iterator);
 	/*! \brief Attempt to unlock a page */
 	__device__ bool _unlock(page_iterator);
+	/*! \brief Read a page from the file, the page must be locked */
+	__device__ void _loadPage(page_iterator page, size_t offset);
 	
 
 private:
@@ -194,6 +197,8 @@ private:
 
 	/*! \brief The actual symbol table */
 	SymbolTableEntry* _symbolTable;
+	/*! \brief The symbol hash buckets and chains, 0 if there are none */
+	uint32_t* _symbolHash;
 
 private:
 	class Lock
@@ -217,6 +222,8 @@ private:
 
 private:
 	LockMap _locks;
+	/*! \brief The file has one get pointer shared by all page loads */
+	Lock _fileLock;
 
 
 };
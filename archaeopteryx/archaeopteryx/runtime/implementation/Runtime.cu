@@ -16,6 +16,11 @@
 #include <archaeopteryx/util/interface/Knob.h>
 #include <archaeopteryx/util/interface/debug.h>
 
+// Standard Library Includes
+#ifdef ARCHAEOPTERYX_HOST
+#include <thread>
+#endif
+
 // Preprocessor Defines
 #ifdef REPORT_BASE
 #undef REPORT_BASE
@@ -104,10 +109,27 @@ __device__ Runtime::Address
 	return state->memory.translate((size_t) virtualAddress);
 }
 
+// Host builds run one hardware CTA on each worker thread
+__device__ static unsigned int getHardwareCTACount()
+{
+#ifdef ARCHAEOPTERYX_HOST
+	unsigned int workers = util::KnobDatabase::getKnob<unsigned int>(
+		"simulator-worker-threads");
+
+	if(workers == 0)
+	{
+		workers = std::thread::hardware_concurrency();
+	}
+
+	return workers == 0 ? 1 : workers;
+#else
+	return util::KnobDatabase::getKnob<unsigned int>("simulator-ctas");
+#endif
+}
+
 __device__ void Runtime::loadKnobs()
 {
-	unsigned int ctas =
-		util::KnobDatabase::getKnob<unsigned int>("simulator-ctas");
+	unsigned int ctas = getHardwareCTACount();
 	state->hardwareCTAs.resize(ctas);
 
 	state->kernel.simulatedBlocks = ctas;
@@ -133,6 +155,27 @@ __device__ void Runtime::loadKnobs()
 		state->parameterMemoryAddress);
 }
 
+// Spill code addresses a private window of local memory in each thread,
+//  reserve the windows of every simulated thread so that no allocation
+//  overlaps them
+__device__ static void reserveLocalMemory(unsigned int threads)
+{
+	Runtime::Address address = util::KnobDatabase::getKnob<Runtime::Address>(
+		"simulated-local-memory-address");
+	size_t bytesPerThread = util::KnobDatabase::getKnob<size_t>(
+		"simulated-local-memory-per-thread");
+
+	// a previous launch may have reserved windows for fewer threads
+	Runtime::munmap(address);
+
+	device_report("Reserving local memory for %d threads at address %p\n",
+		threads, address);
+
+	bool success = Runtime::mmap(threads * bytesPerThread, address);
+
+	device_assert(success);
+}
+
 // The Runtime class owns all of the simulator state, it should have allocated
 //       it in the constructor
 //  a) simulated state is CoreSimKernel/Block/Thread and other classes
@@ -148,6 +191,8 @@ __device__ void Runtime::setupLaunchConfig(unsigned int totalCtas,
     {
         cta->setNumberOfThreadsPerBlock(threadsPerCta);
     }
+
+	reserveLocalMemory(totalCtas * threadsPerCta);
 }
 
 // Similar to the previous call, this sets the memory sizes
@@ -193,23 +238,58 @@ __global__ void launchSimulationInParallel()
     	Runtime::getSelectedBinary());    
 }
 
+#ifdef ARCHAEOPTERYX_HOST
+static void launchSimulationOnWorker(unsigned int cta, unsigned int ctas)
+{
+	gridDim     = dim3(ctas);
+	blockDim    = dim3(1);
+	blockIdx.x  = cta;
+	threadIdx.x = 0;
+
+	launchSimulationInParallel();
+}
+#endif
+
 // Start a new asynchronous kernel with the right number of HW CTAs/threads
 __device__ void Runtime::launchSimulation()
 {
-	unsigned int ctas    =
-		util::KnobDatabase::getKnob<unsigned int>("simulator-ctas");
+	unsigned int ctas = getHardwareCTACount();
+	
+	state->kernel.simulatedBlocks = state->simulatedBlockCount;
+	state->kernel.scheduler.setup(state->simulatedBlockCount, ctas);
+	state->kernel.instructions.build(getSelectedBinary());
+
+#ifdef ARCHAEOPTERYX_HOST
+	// Each hardware CTA is simulated by one thread that loops over its lanes
+	std::thread* workers = new std::thread[ctas];
+
+	for(unsigned int cta = 0; cta < ctas; ++cta)
+	{
+		workers[cta] = std::thread(launchSimulationOnWorker, cta, ctas);
+	}
+
+	for(unsigned int cta = 0; cta < ctas; ++cta)
+	{
+		workers[cta].join();
+	}
+
+	delete[] workers;
+#else
 	unsigned int threads =
 		util::KnobDatabase::getKnob<unsigned int>("simulator-threads-per-cta");
-	
-	state->kernel.simulatedBlocks = ctas;
+
 	launchSimulationInParallel<<<ctas, threads>>>();
 	cudaDeviceSynchronize();
+#endif
 
     kernel_report("Parallel simulation finished.\n");
 }
 
 __device__ void Runtime::unloadBinaries()
 {
+	// a new binary may be loaded at the same address
+	state->kernel.instructions.clear();
+
 	for(RuntimeState::BinaryMap::iterator binary = state->binaries.begin();
 		binary != state->binaries.end(); ++binary)
 	{
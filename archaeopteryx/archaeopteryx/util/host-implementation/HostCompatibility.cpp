@@ -0,0 +1,18 @@
+/*! \file   HostCompatibility.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the CUDA built-ins used by host builds.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/util/interface/HostCompatibility.h>
+
+#ifdef ARCHAEOPTERYX_HOST
+
+thread_local uint3 threadIdx = {0, 0, 0};
+thread_local uint3 blockIdx  = {0, 0, 0};
+thread_local dim3  blockDim;
+thread_local dim3  gridDim;
+
+#endif
+
@@ -11,6 +11,11 @@
 
 #include <archaeopteryx/util/interface/algorithm.h>
 
+// Standard Library Includes
+#ifdef ARCHAEOPTERYX_HOST
+#include <cstdio>
+#endif
+
 // Preprocessor Macros
 #ifdef REPORT_BASE
 #undef REPORT_BASE
@@ -24,6 +29,64 @@ namespace archaeopteryx
 namespace util
 {
 
+#ifdef ARCHAEOPTERYX_HOST
+
+// Host builds open the file directly rather than through host reflection
+__device__ File::File(const char* fileName, const char* mode)
+{
+	device_report("Opening file '%s' with mode '%s' on the host\n",
+		fileName, mode);
+
+	FILE* file = 0;
+
+	if(util::strcmp(mode, "r") == 0)
+	{
+		file = std::fopen(fileName, "rb");
+	}
+	else if(util::strcmp(mode, "w") == 0)
+	{
+		file = std::fopen(fileName, "w+b");
+	}
+	else
+	{
+		file = std::fopen(fileName, "r+b");
+
+		if(file == 0)
+		{
+			file = std::fopen(fileName, "w+b");
+		}
+	}
+
+	_handle = (Handle)file;
+	_size   = 0;
+	_put    = 0;
+	_get    = 0;
+
+	if(_handle == 0)
+	{
+		device_report(" failed to open file...\n");
+	
+		device_assert(_handle != 0);
+	}
+	else
+	{
+		std::fseek(file, 0, SEEK_END);
+		_size = std::ftell(file);
+	}
+	
+	device_report(" file opened, current size is %d\n", _size);
+}
+
+__device__ File::~File()
+{
+	if(_handle != (Handle)-1 && _handle != 0)
+	{
+		std::fclose((FILE*)_handle);
+	}
+}
+
+#else
+
 __device__ File::File(const char* fileName, const char* mode)
 {
 	device_report("Opening file '%s' with mode '%s' on the gpu\n",
@@ -62,6 +125,8 @@ __device__ File::~File()
 	}
 }
 
+#endif
+
 __device__ void File::write(const void* data, size_t bytes)
 {
 	const char* pointer = reinterpret_cast<const char*>(data);
@@ -75,6 +140,30 @@ __device__ void File::write(const void* data, size_t bytes)
 	}
 }
 
+#ifdef ARCHAEOPTERYX_HOST
+
+__device__ size_t File::writeSome(const void* data, size_t bytes)
+{
+	FILE* file = (FILE*)_handle;
+
+	std::fseek(file, _put, SEEK_SET);
+
+	size_t written = std::fwrite(data, 1, bytes, file);
+
+	device_assert(written == bytes);
+
+	_put += written;
+	
+	if(_put > _size)
+	{
+		_size = _put;
+	}
+	
+	return written;
+}
+
+#else
+
 __device__ size_t File::writeSome(const void* data, size_t bytes)
 {	
 	size_t attemptedSize =
@@ -98,6 +187,8 @@ __device__ size_t File::writeSome(const void* data, size_t bytes)
 	return attemptedSize;
 }
 
+#endif
+
 __device__ void File::read(void* data, size_t bytes)
 {
 	if(_get + bytes > size())
@@ -119,6 +210,30 @@ __device__ void File::read(void* data, size_t bytes)
 	}
 }
 
+#ifdef ARCHAEOPTERYX_HOST
+
+__device__ size_t File::readSome(void* data, size_t bytes)
+{
+	if(_get + bytes > size())
+	{
+		bytes = size() - _get;
+	}
+
+	FILE* file = (FILE*)_handle;
+
+	std::fseek(file, _get, SEEK_SET);
+
+	size_t bytesRead = std::fread(data, 1, bytes, file);
+
+	device_assert(bytesRead == bytes);
+
+	_get += bytesRead;
+	
+	return bytesRead;
+}
+
+#else
+
 __device__ size_t File::readSome(void* data, size_t bytes)
 {
 	if(_get + bytes > size())
@@ -148,6 +263,8 @@ __device__ size_t File::readSome(void* data, size_t bytes)
 	return attemptedSize;
 }
 
+#endif
+
 __device__ size_t File::size() const
 {
 	return _size;
@@ -185,6 +302,8 @@ __device__ void File::seekp(size_t p)
 	_put = p;
 }
 
+#ifndef ARCHAEOPTERYX_HOST
+
 __device__ File::OpenMessage::OpenMessage(const char* f, const char* m)
 {
 	util::memset(_filename, 0, payloadSize());
@@ -368,6 +487,8 @@ __device__ HostReflectionDevice::HandlerId File::ReadReply::handler() const
 	return HostReflectionDevice::FileReadReplyHandler;
 }
 
+#endif
+
 }
 
 }
@@ -10,6 +10,10 @@
 // Standard Library Includes
 #include <cstdio> 
 
+#ifdef ARCHAEOPTERYX_HOST
+#include <cstdlib>
+#endif
+
 namespace archaeopteryx
 {
 
@@ -22,7 +26,11 @@ __device__ void _assert(bool condition, const char* expression,
 	if(!condition)
 	{
 		printf("%s:%i - assertion '%s' failed!\n", filename, line, expression);
+#ifdef ARCHAEOPTERYX_HOST
+		std::abort();
+#else
 		asm("trap;");
+#endif
 	}
 }
 
@@ -0,0 +1,139 @@
+/*! \file   HostCompatibility.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the CUDA built-ins used by host builds.
+*/
+
+#pragma once
+
+/*! \brief Host builds (scons host=1) compile the device sources with the
+	host compiler, this header is force-included in every translation unit
+	and provides the parts of the CUDA language that they use.
+
+	Device sources include it directly for the helpers, like atomicLoad()
+	and atomicStore(), that have a different implementation on each side.
+
+	A host thread simulates one hardware CTA with a single CUDA thread,
+	the executive loops over the lanes of a warp instead of reducing
+	across CUDA threads.
+*/
+#ifdef ARCHAEOPTERYX_HOST
+
+// Standard Library Includes
+#include <stddef.h>
+#include <stdint.h>
+#include <cstdio>
+#include <new>
+
+// Preprocessor Macros
+#define __device__
+#define __host__
+#define __global__
+#define __shared__
+#define __forceinline__ inline
+
+/*! \brief A CUDA built-in vector type */
+struct uint2
+{
+	unsigned int x;
+	unsigned int y;
+};
+
+/*! \brief A CUDA built-in vector type */
+struct uint3
+{
+	unsigned int x;
+	unsigned int y;
+	unsigned int z;
+};
+
+/*! \brief A CUDA launch dimension */
+struct dim3
+{
+	dim3(unsigned int x = 1, unsigned int y = 1, unsigned int z = 1)
+	: x(x), y(y), z(z)
+	{
+
+	}
+
+	unsigned int x;
+	unsigned int y;
+	unsigned int z;
+};
+
+/*! \brief The launch state of the calling host thread */
+extern thread_local uint3 threadIdx;
+extern thread_local uint3 blockIdx;
+extern thread_local dim3  blockDim;
+extern thread_local dim3  gridDim;
+
+/*! \brief There is one CUDA thread per CTA */
+inline void __syncthreads()
+{
+
+}
+
+inline void __threadfence()
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+inline void __threadfence_block()
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+template<typename T>
+inline T atomicCAS(T* address, T compare, T value)
+{
+	__atomic_compare_exchange_n(address, &compare, value, false,
+		__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+
+	return compare;
+}
+
+template<typename T>
+inline T atomicAdd(T* address, T value)
+{
+	return __atomic_fetch_add(address, value, __ATOMIC_SEQ_CST);
+}
+
+template<typename T>
+inline T atomicExch(T* address, T value)
+{
+	return __atomic_exchange_n(address, value, __ATOMIC_SEQ_CST);
+}
+
+/*! \brief Read a value that other threads update concurrently */
+template<typename T>
+inline T atomicLoad(const T* address)
+{
+	return __atomic_load_n(address, __ATOMIC_SEQ_CST);
+}
+
+/*! \brief Publish a value that other threads read with atomicLoad() */
+template<typename T>
+inline void atomicStore(T* address, T value)
+{
+	__atomic_store_n(address, value, __ATOMIC_SEQ_CST);
+}
+
+#else
+
+/*! \brief Read a value that other threads update concurrently, a volatile
+	read is enough on the device */
+template<typename T>
+__device__ inline T atomicLoad(const T* address)
+{
+	return *(const volatile T*)address;
+}
+
+/*! \brief Publish a value that other threads read with atomicLoad() */
+template<typename T>
+__device__ inline void atomicStore(T* address, T value)
+{
+	*(volatile T*)address = value;
+}
+
+#endif
+
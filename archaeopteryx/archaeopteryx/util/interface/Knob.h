@@ -47,22 +47,9 @@ public:
 
 };
 
+/*! \brief Knob values are parsed by specializations for each type */
 template<typename T>
-class TypeConverter
-{
-public:
-	__device__ T operator()(const util::string& value)
-	{
-		T result;
-
-		util::stringstream stream;
-
-		stream << value;
-
-		result >> value;
-	} 
-
-};
+class TypeConverter;
 
 template<>
 class TypeConverter<util::string>
@@ -1856,6 +1856,11 @@ partition_point(_ForwardIterator __first, _ForwardIterator __last, _Predicate __
     return __first;
 }
 
+// The buffered algorithms need unique_ptr and the temporary buffers from
+//  <memory>, which util does not provide.  nvcc ignores the unused
+//  templates, host compilers do not.
+#ifndef ARCHAEOPTERYX_HOST
+
 // stable_partition
 
 template <class _Predicate, class _ForwardIterator, class _Distance, class _Pair>
@@ -2137,6 +2142,8 @@ stable_partition(_ForwardIterator __first, _ForwardIterator __last, _Predicate _
                              (__first, __last, __pred, typename iterator_traits<_ForwardIterator>::iterator_category());
 }
 
+#endif
+
 // is_sorted_until
 
 template <class _ForwardIterator, class _Compare>
@@ -2384,6 +2391,8 @@ __insertion_sort_incomplete(_RandomAccessIterator __first, _RandomAccessIterator
     return true;
 }
 
+#ifndef ARCHAEOPTERYX_HOST
+
 template <class _Compare, class _BirdirectionalIterator>
 __device__ void
 __insertion_sort_move(_BirdirectionalIterator __first1, _BirdirectionalIterator __last1,
@@ -2419,6 +2428,8 @@ __insertion_sort_move(_BirdirectionalIterator __first1, _BirdirectionalIterator
     }
 }
 
+#endif
+
 template <class _Compare, class _RandomAccessIterator>
 __device__ void
 __sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
@@ -2931,6 +2942,8 @@ merge(_InputIterator1 __first1, _InputIterator1 __last1,
     return merge(__first1, __last1, __first2, __last2, __result, __less<__v1, __v2>());
 }
 
+#ifndef ARCHAEOPTERYX_HOST
+
 // inplace_merge
 
 template <class _Compare, class _BidirectionalIterator>
@@ -3309,6 +3322,8 @@ stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last)
     util::stable_sort(__first, __last, __less<typename iterator_traits<_RandomAccessIterator>::value_type>());
 }
 
+#endif
+
 // is_heap_until
 
 template <class _RandomAccessIterator, class _Compare>
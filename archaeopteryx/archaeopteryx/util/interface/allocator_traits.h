@@ -46,7 +46,7 @@ public:
 
 struct allocator_arg_t { };
 
-allocator_arg_t allocator_arg = allocator_arg_t();
+const allocator_arg_t allocator_arg = allocator_arg_t();
 
 template <class T, class Alloc> struct uses_allocator;
 
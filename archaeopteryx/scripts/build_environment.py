@@ -8,6 +8,14 @@ import re
 import subprocess
 from SCons import SConf
 
+def haveOcelot():
+	try:
+		which('OcelotConfig')
+		
+		return True
+	except:
+		return False
+
 def getOcelotPaths():
 	"""Determines Ocelot {bin,lib,include,cflags,lflags,libs} paths
 	
@@ -173,6 +181,21 @@ def getNVCCFLAGS(mode, arch):
 		pass
 	return result
 
+def getHostNVCCFLAGS(mode):
+	"""Flags for compiling .cu files with the host compiler
+	
+	The CUDA built-ins are provided by a force-included header
+	"""
+	result = ['-std=c++0x',
+		'-include', 'archaeopteryx/util/interface/HostCompatibility.h']
+
+	if mode == 'release':
+		result.append('-O2')
+	elif mode == 'debug':
+		result.append('-g')
+
+	return result
+
 def getLINKFLAGS(mode, LINK):
 	result = []
 	if mode == 'debug':
@@ -183,8 +206,11 @@ def getLINKFLAGS(mode, LINK):
 
 	return result
 
-def getLIBS():
-	result = ['-lboost_thread-mt', '-locelot']
+def getLIBS(host):
+	if host:
+		result = ['-lpthread']
+	else:
+		result = ['-lboost_thread-mt', '-locelot']
 	return result
 
 def importEnvironment():
@@ -227,6 +253,10 @@ def Environment():
 		'Build the unit tests at the given test level', 'full',
 		allowed_values = ('none', 'basic', 'full')))
 
+	# add a variable to build the simulator for the host
+	vars.Add(BoolVariable('host',
+		'Build a host-native simulator that does not need CUDA', 0))
+
 	# add a variable to determine the install path
 	vars.Add(PathVariable('install_path', 'The archaeopteryx install path',
 		'/usr/local'))
@@ -243,20 +273,26 @@ def Environment():
 	env.AppendUnique(CPPPATH = [os.path.abspath(os.path.join(thisDir, '..'))])
 
 	# get the path to vanaheimr
-	env.AppendUnique(CPPPATH = [os.path.abspath(os.path.join(thisDir,
-		'../../vanaheimr'))])
+	env.Replace(VANAHEIMR_PATH = os.path.abspath(os.path.join(thisDir,
+		'../../vanaheimr')))
+	env.AppendUnique(CPPPATH = [env['VANAHEIMR_PATH']])
 	
 	# set the build path
 	env.Replace(BUILD_ROOT = str(env.Dir('.')))
 
-	# get ocelot paths
-	(ocelot_exe_path,ocelot_lib_path,ocelot_inc_path,ocelot_cflags,\
-		ocelot_lflags,ocelot_libs) = getOcelotPaths()
-	env.AppendUnique(LIBPATH = ocelot_lib_path)
-	env.AppendUnique(CPPPATH = ocelot_inc_path)
-	env.AppendUnique(CXXFLAGS = ocelot_cflags)
-	env.AppendUnique(LINKFLAGS = ocelot_lflags)
-	env.AppendUnique(EXTRA_LIBS = ocelot_libs)
+	# get ocelot paths, host builds only use hydrazine from ocelot and
+	#  build it from the vanaheimr sources when ocelot is not installed
+	if not env['host'] or haveOcelot():
+		(ocelot_exe_path,ocelot_lib_path,ocelot_inc_path,ocelot_cflags,\
+			ocelot_lflags,ocelot_libs) = getOcelotPaths()
+		env.AppendUnique(LIBPATH = ocelot_lib_path)
+		env.AppendUnique(CPPPATH = ocelot_inc_path)
+		env.AppendUnique(CXXFLAGS = ocelot_cflags)
+		env.AppendUnique(LINKFLAGS = ocelot_lflags)
+		env.AppendUnique(EXTRA_LIBS = ocelot_libs)
+		env.Replace(HAVE_OCELOT=True)
+	else:
+		env.Replace(HAVE_OCELOT=False)
 
 	# enable nvcc
 	env.Tool('nvcc', toolpath = [os.path.join(thisDir)])
@@ -266,7 +302,16 @@ def Environment():
 		env['Werror'], env.subst('$CC')))
 
 	# get NVCC compiler switches
-	env.Append(NVCCFLAGS = getNVCCFLAGS(env['mode'], env['arch']))
+	if env['host']:
+		# compile .cu files as C++ with the host compiler
+		env.Replace(NVCCCOM = '$CXX -o $TARGET -c -x c++ $NVCCFLAGS ' + \
+			'$CCFLAGS $_CCCOMCOM $SOURCES')
+		env.Replace(SHNVCCCOM = '$SHCXX -o $TARGET -c -x c++ $NVCCFLAGS ' + \
+			'$SHCCFLAGS $_CCCOMCOM $SOURCES')
+		env.Append(NVCCFLAGS = getHostNVCCFLAGS(env['mode']))
+		env.AppendUnique(CPPDEFINES = ['ARCHAEOPTERYX_HOST'])
+	else:
+		env.Append(NVCCFLAGS = getNVCCFLAGS(env['mode'], env['arch']))
 
 	# get CXX compiler switches
 	env.AppendUnique(CXXFLAGS = getCXXFLAGS(env['mode'], env['Wall'],
@@ -278,7 +323,7 @@ def Environment():
 	env.AppendUnique(LIBPATH = os.path.abspath(env['BUILD_ROOT']))
 		
 	# set extra libraries
-	env.AppendUnique(EXTRA_LIBS=getLIBS())
+	env.AppendUnique(EXTRA_LIBS=getLIBS(env['host']))
 
 	# generate help text
 	Help(vars.GenerateHelpText(env))
@@ -68,7 +68,7 @@ gCompilerOptions = {
 		'g++' : {'warn_all' : '-Wall',
 			'warn_errors' : '-Werror',
 			'optimization' : '-O2', 'debug' : '-g', 
-			'exception_handling' : '', 'standard': '-std=c++0x'},
+			'exception_handling' : '', 'standard': ['-std=c++0x', '-pthread']},
 		'c++' : {'warn_all' : '-Wall',
 			'warn_errors' : '-Werror',
 			'optimization' : '-O2', 'debug' : '-g',
@@ -181,7 +181,7 @@ def getExtraLibs():
 	if os.name == 'nt':
 		return []
 	else:
-		return []
+		return ['-lpthread']
 
 def getVersion(base):
 	try:
@@ -288,6 +288,11 @@ def Environment():
 	# add a variable to treat warnings as errors
 	vars.Add(BoolVariable('Werror', 'Treat warnings as errors', 1))
 	
+	# add a variable to compile the unit tests
+	vars.Add(EnumVariable('test_level',
+		'Build the unit tests at the given test level', 'none',
+		allowed_values = ('none', 'basic', 'full')))
+
 	# add a variable to build against ocelot 
 	vars.Add(BoolVariable('with_ocelot', 'Compile with ocelot', 0))
 
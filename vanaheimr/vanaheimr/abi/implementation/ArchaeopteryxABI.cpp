@@ -25,6 +25,12 @@ ApplicationBinaryInterface* getArchaeopteryxABI()
 	// Memory Regions
 	archaeopteryxABI->insert(new FixedAddressRegion(
 		"parameter", 1024, 8, ir::Global::Shared, 4096));
+	
+	// A private window per thread, holds spilled registers, the window of
+	//  thread i starts at 0x40000000 + i * 4096, above the allocations of
+	//  the program.  The runtime reserves the windows before a launch.
+	archaeopteryxABI->insert(new FixedAddressRegion(
+		"local", 4096, 8, ir::Global::Thread, 0x40000000));
 
 	// Bound Variables
 	archaeopteryxABI->insert(new RegisterBoundVariable(
@@ -35,6 +41,12 @@ ApplicationBinaryInterface* getArchaeopteryxABI()
 	archaeopteryxABI->insert(new RegisterBoundVariable(
 		"ctaid_x", compiler::Compiler::getSingleton()->getType("i16"), "r33"));
 	
+	// The simulator sets register 33 to the global thread id before the
+	//  kernel starts
+	archaeopteryxABI->insert(new RegisterBoundVariable(
+		"global_tid", compiler::Compiler::getSingleton()->getType("i64"),
+		"rf33"));
+	
 	
 	return archaeopteryxABI;
 }
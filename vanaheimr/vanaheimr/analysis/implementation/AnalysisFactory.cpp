@@ -11,10 +11,12 @@
 #include <vanaheimr/analysis/interface/ControlFlowGraph.h>
 #include <vanaheimr/analysis/interface/DataflowAnalysis.h>
 #include <vanaheimr/analysis/interface/DominatorAnalysis.h>
+#include <vanaheimr/analysis/interface/PostDominatorAnalysis.h>
 #include <vanaheimr/analysis/interface/ReversePostOrderTraversal.h>
 #include <vanaheimr/analysis/interface/DependenceAnalysis.h>
 #include <vanaheimr/analysis/interface/LiveRangeAnalysis.h>
 #include <vanaheimr/analysis/interface/InterferenceAnalysis.h>
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
 
 namespace vanaheimr
 {
@@ -39,6 +41,10 @@ Analysis* AnalysisFactory::createAnalysis(const std::string& name,
 	{
 		analysis = new DominatorAnalysis;
 	}
+	else if (name == "PostDominatorAnalysis")
+	{
+		analysis = new PostDominatorAnalysis;
+	}
 	else if (name == "ReversePostOrderTraversal")
 	{
 		analysis = new ReversePostOrderTraversal;
@@ -55,6 +61,10 @@ Analysis* AnalysisFactory::createAnalysis(const std::string& name,
 	{
 		analysis = new InterferenceAnalysis;
 	}
+	else if (name == "LoopAnalysis")
+	{
+		analysis = new LoopAnalysis;
+	}
 
 	if(analysis != nullptr)
 	{
@@ -7,6 +7,8 @@
 // Vanaheimr Includes
 #include <vanaheimr/analysis/interface/DataflowAnalysis.h>
 #include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/DataflowSolver.h>
+#include <vanaheimr/analysis/interface/ReversePostOrderTraversal.h>
 
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/BasicBlock.h>
@@ -16,6 +18,7 @@
 
 // Standard Library Includes
 #include <cassert>
+#include <algorithm>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -31,21 +34,23 @@ namespace analysis
 {
 
 DataflowAnalysis::DataflowAnalysis()
-: FunctionAnalysis("DataflowAnalysis", StringVector(1, "ControlFlowGraph"))
+: FunctionAnalysis("DataflowAnalysis", StringVector({"ControlFlowGraph",
+	"ReversePostOrderTraversal"})), _livenessIterations(0),
+	_reachingDefinitionIterations(0)
 {
 
 }
 
-DataflowAnalysis::VirtualRegisterSet
-	DataflowAnalysis::getLiveIns(const BasicBlock& block)
+const DataflowAnalysis::VirtualRegisterBitSet&
+	DataflowAnalysis::getLiveIns(const BasicBlock& block) const
 {
 	assert(block.id() < _liveins.size());
 	
 	return _liveins[block.id()];
 }
 
-DataflowAnalysis::VirtualRegisterSet
-	DataflowAnalysis::getLiveOuts(const BasicBlock& block)
+const DataflowAnalysis::VirtualRegisterBitSet&
+	DataflowAnalysis::getLiveOuts(const BasicBlock& block) const
 {
 	assert(block.id() < _liveouts.size());
 	
@@ -57,14 +62,46 @@ DataflowAnalysis::InstructionSet
 {
 	DataflowAnalysis::InstructionSet definitions;
 	
-	for(auto write : instruction.writes)
+	auto block = instruction.block;
+	
+	assert(block->id() < _reachingDefinitionIns.size());
+	
+	// start from the block live-ins, and step forward to the instruction
+	auto reaching = _reachingDefinitionIns[block->id()];
+	auto site     = _firstDefinitionSite[block->id()];
+	
+	for(auto predecessor : *block)
+	{
+		if(predecessor == &instruction) break;
+		
+		for(auto write : predecessor->writes)
+		{
+			if(!write->isRegister()) continue;
+			
+			auto value = static_cast<ir::RegisterOperand*>(
+				write)->virtualRegister;
+			
+			for(auto killed : _registerDefinitionSites[value->id])
+			{
+				reaching.erase(killed);
+			}
+			
+			reaching.insert(site++);
+		}
+	}
+	
+	for(auto read : instruction.reads)
 	{
-		auto writeOperand = static_cast<ir::RegisterOperand*>(write);
+		if(!read->isRegister()) continue;
 	
-		auto localDefinitions = getReachingDefinitions(
-			*writeOperand->virtualRegister);
+		auto value = static_cast<ir::RegisterOperand*>(read)->virtualRegister;
 	
-		definitions.insert(localDefinitions.begin(), localDefinitions.end());
+		for(auto definition : _registerDefinitionSites[value->id])
+		{
+			if(!reaching.contains(definition)) continue;
+			
+			definitions.insert(_definitionSites[definition].instruction);
+		}
 	}
 	
 	return definitions;
@@ -90,7 +127,7 @@ DataflowAnalysis::InstructionSet
 }
 
 void DataflowAnalysis::setLiveOuts(const BasicBlock& block,
-	const VirtualRegisterSet& liveOuts)
+	const VirtualRegisterBitSet& liveOuts)
 {
 	assert(block.id() < _liveouts.size());
 	
@@ -119,32 +156,99 @@ DataflowAnalysis::InstructionSet
 	return _reachedUses[value.id];
 }
 
+size_t DataflowAnalysis::getLivenessIterations() const
+{
+	return _livenessIterations;
+}
+
+size_t DataflowAnalysis::getReachingDefinitionIterations() const
+{
+	return _reachingDefinitionIterations;
+}
+
 void DataflowAnalysis::analyze(Function& function)
 {
-	     _analyzeLiveInsAndOuts(function);
-	_analyzeReachingDefinitions(function);
+	_numberRegisters(function);
+
+	      _analyzeLiveInsAndOuts(function);
+	 _analyzeReachingDefinitions(function);
+	_analyzeDefinitionAndUseSets(function);
+	
+	hydrazine::log("DataflowAnalysis") << "Function '" << function.name()
+		<< "': liveness converged after " << _livenessIterations
+		<< " block visits, reaching definitions after "
+		<< _reachingDefinitionIterations << ", over " << function.size()
+		<< " blocks\n";
 }
 
 void DataflowAnalysis::_analyzeLiveInsAndOuts(Function& function)
 {
-	 _liveins.resize(function.size());
-	_liveouts.resize(function.size());
+	 _liveins.assign(function.size(), VirtualRegisterBitSet(&_registers));
+	_liveouts.assign(function.size(), VirtualRegisterBitSet(&_registers));
 	
-	BasicBlockSet worklist;
+	util::BitVector emptyBitVector(_registers.size());
+
+	_upwardExposedUses.assign(function.size(), emptyBitVector);
+	 _blockDefinitions.assign(function.size(), emptyBitVector);
 	
 	// should be for-all
 	for(auto block = function.begin(); block != function.end(); ++block)
 	{
-		worklist.insert(&*block);
+		_computeLocalUsesAndDefinitions(&*block);
 	}
 	
-	while(!worklist.empty())
+	DataflowSolver solver(DataflowSolver::Backward,
+		static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph")),
+		static_cast<ReversePostOrderTraversal*>(
+			getAnalysis("ReversePostOrderTraversal")));
+	
+	solver.solve(function, [this](BasicBlock* block)
 	{
-		_computeLocalLiveInsAndOuts(worklist);
-	}
+		return _recomputeLiveInsAndOutsForBlock(block);
+	});
+	
+	_livenessIterations = solver.iterations();
+	
+	// the local sets are only needed to reach the fixed point
+	_upwardExposedUses.clear();
+	 _blockDefinitions.clear();
 }
 
 void DataflowAnalysis::_analyzeReachingDefinitions(Function& function)
+{
+	_numberDefinitionSites(function);
+	
+	util::BitVector emptyBitVector(_definitionSites.size());
+	
+	 _reachingDefinitionIns.assign(function.size(), emptyBitVector);
+	_reachingDefinitionOuts.assign(function.size(), emptyBitVector);
+	
+	_generatedDefinitions.assign(function.size(), emptyBitVector);
+	   _killedDefinitions.assign(function.size(), emptyBitVector);
+
+	// should be for-all
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		_computeLocalReachingDefinitions(&*block);
+	}
+	
+	DataflowSolver solver(DataflowSolver::Forward,
+		static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph")),
+		static_cast<ReversePostOrderTraversal*>(
+			getAnalysis("ReversePostOrderTraversal")));
+	
+	solver.solve(function, [this](BasicBlock* block)
+	{
+		return _recomputeReachingDefinitionsForBlock(block);
+	});
+	
+	_reachingDefinitionIterations = solver.iterations();
+	
+	_generatedDefinitions.clear();
+	   _killedDefinitions.clear();
+}
+
+void DataflowAnalysis::_analyzeDefinitionAndUseSets(Function& function)
 {
 	// For each instruction, create a writer set and a reader set
 	//  gather them together 
@@ -152,8 +256,8 @@ void DataflowAnalysis::_analyzeReachingDefinitions(Function& function)
 	_reachingDefinitions.clear();
 	        _reachedUses.clear();
 	
-	_reachingDefinitions.resize(function.register_size());
-	        _reachedUses.resize(function.register_size());
+	_reachingDefinitions.resize(_registers.size());
+	        _reachedUses.resize(_registers.size());
 	
 	
 	// parallel for-all
@@ -199,80 +303,150 @@ void DataflowAnalysis::_analyzeReachingDefinitions(Function& function)
 	}
 }
 
-void DataflowAnalysis::_computeLocalLiveInsAndOuts(BasicBlockSet& worklist)
+void DataflowAnalysis::_numberRegisters(Function& function)
 {
-	BasicBlockSet newList;
+	_registers.assign(function.register_id_bound(), nullptr);
 
-	// should be for-all
-	for(auto block : worklist)
+	for(auto value = function.register_begin();
+		value != function.register_end(); ++value)
 	{
-		bool changed = _recomputeLiveInsAndOutsForBlock(block);
-
-		if(changed)
-		{
-			// TODO: queue up predecessors
-			newList.insert(block);
-		}
+		_registers[value->id] = &*value;
 	}
+}
 
-	// gather blocks to form the new worklist
-	worklist = std::move(newList);
-}	
-
-bool DataflowAnalysis::_recomputeLiveInsAndOutsForBlock(BasicBlock* block)
+void DataflowAnalysis::_numberDefinitionSites(Function& function)
 {
-	// live outs is the union of live-ins of all successors
-	VirtualRegisterSet liveout;
-
-	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));	
-
-	auto successors = cfg->getSuccessors(*block);
-
-	for(auto successor : successors)
+	_definitionSites.clear();
+	
+	_registerDefinitionSites.assign(_registers.size(), IndexVector());
+	_firstDefinitionSite.assign(function.size(), 0);
+	
+	// sites within a block are numbered consecutively, in program order
+	for(auto block = function.begin(); block != function.end(); ++block)
 	{
-		auto livein = getLiveIns(*successor);
-
-		liveout.insert(livein.begin(), livein.end());
+		_firstDefinitionSite[block->id()] = _definitionSites.size();
+		
+		for(auto instruction : *block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(!write->isRegister()) continue;
+			
+				auto value = static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister;
+				
+				_registerDefinitionSites[value->id].push_back(
+					_definitionSites.size());
+				
+				_definitionSites.push_back(DefinitionSite(instruction, value));
+			}
+		}
 	}
+}
 
-	_liveouts[block->id()] = liveout;
-
-	VirtualRegisterSet livein = std::move(liveout);
+void DataflowAnalysis::_computeLocalUsesAndDefinitions(BasicBlock* block)
+{
+	auto& uses        = _upwardExposedUses[block->id()];
+	auto& definitions =  _blockDefinitions[block->id()];
 
-	// apply def/use rules in reverse order
-	for(auto instruction = block->rbegin(); instruction != block->rend();
-		++instruction)
+	// a read is upward exposed if it is not preceded by a def in the block
+	for(auto instruction : *block)
 	{
-		// spawn on uses
-		for(auto read : (*instruction)->reads)
+		for(auto read : instruction->reads)
 		{
 			if(!read->isRegister()) continue;
 		
 			auto reg = static_cast<ir::RegisterOperand*>(read);
 
-			livein.insert(reg->virtualRegister);
+			auto id = reg->virtualRegister->id;
+
+			if(!definitions.contains(id)) uses.insert(id);
 		}
 
-		// kill on defs
-		for(auto write : (*instruction)->writes)
+		for(auto write : instruction->writes)
 		{
 			if(!write->isRegister()) continue;
 		
 			auto reg = static_cast<ir::RegisterOperand*>(write);
 
-			livein.erase(reg->virtualRegister);
+			definitions.insert(reg->virtualRegister->id);
 		}
 	}
+}
 
-	bool changed = _liveins[block->id()] != livein;
-
-	_liveins[block->id()] = std::move(livein);
+void DataflowAnalysis::_computeLocalReachingDefinitions(BasicBlock* block)
+{
+	auto& generated = _generatedDefinitions[block->id()];
+	auto& killed    =    _killedDefinitions[block->id()];
 	
-	return changed;
+	auto site = _firstDefinitionSite[block->id()];
+	
+	// a site is generated if it is the last write to its register
+	for(auto instruction : *block)
+	{
+		for(auto write : instruction->writes)
+		{
+			if(!write->isRegister()) continue;
+			
+			auto value = static_cast<ir::RegisterOperand*>(
+				write)->virtualRegister;
+			
+			for(auto other : _registerDefinitionSites[value->id])
+			{
+				generated.erase(other);
+				   killed.insert(other);
+			}
+			
+			generated.insert(site++);
+		}
+	}
 }
 
+bool DataflowAnalysis::_recomputeLiveInsAndOutsForBlock(BasicBlock* block)
+{
+	// live outs is the union of live-ins of all successors
+	auto& liveout = _liveouts[block->id()].bits();
+
+	liveout.clear();
+
+	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));	
+
+	auto successors = cfg->getSuccessors(*block);
+
+	for(auto successor : successors)
+	{
+		liveout.merge(_liveins[successor->id()].bits());
+	}
+
+	// live ins are upward exposed uses plus live outs that are not defined
+	return _liveins[block->id()].bits().assignTransfer(
+		_upwardExposedUses[block->id()], liveout,
+		_blockDefinitions[block->id()]);
+}
+
+bool DataflowAnalysis::_recomputeReachingDefinitionsForBlock(BasicBlock* block)
+{
+	// reaching ins are the union of reaching outs of all predecessors
+	auto& in = _reachingDefinitionIns[block->id()];
+
+	in.clear();
+
+	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));	
+
+	auto predecessors = cfg->getPredecessors(*block);
+
+	for(auto predecessor : predecessors)
+	{
+		in.merge(_reachingDefinitionOuts[predecessor->id()]);
+	}
+
+	// reaching outs are local definitions plus reaching ins not overwritten
+	return _reachingDefinitionOuts[block->id()].assignTransfer(
+		_generatedDefinitions[block->id()], in,
+		_killedDefinitions[block->id()]);
 }
 
 }
 
+}
 
@@ -0,0 +1,147 @@
+/*! \file   DataflowSolver.cpp
+	\date   Wednesday October 14, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the DataflowSolver class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/DataflowSolver.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/ReversePostOrderTraversal.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <cassert>
+#include <algorithm>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+DataflowSolver::DataflowSolver(Direction d, ControlFlowGraph* cfg,
+	const ReversePostOrderTraversal* traversal)
+: _direction(d), _cfg(cfg), _traversal(traversal), _iterations(0)
+{
+
+}
+
+void DataflowSolver::solve(Function& function, const TransferFunction& transfer)
+{
+	_iterations = 0;
+
+	_assignPriorities(function);
+
+	// every block must be visited at least once
+	_worklist.resize(function.size());
+
+	for(auto block : _blocks)
+	{
+		_push(block);
+	}
+
+	while(!_worklist.empty())
+	{
+		auto block = _pop();
+
+		++_iterations;
+
+		report(" visiting block " << block->name());
+
+		if(!transfer(block)) continue;
+
+		auto neighbors = _direction == Forward ?
+			_cfg->getSuccessors(*block) : _cfg->getPredecessors(*block);
+
+		for(auto neighbor : neighbors)
+		{
+			_push(neighbor);
+		}
+	}
+}
+
+size_t DataflowSolver::iterations() const
+{
+	return _iterations;
+}
+
+void DataflowSolver::_assignPriorities(Function& function)
+{
+	_blocks.clear();
+	_blocks.reserve(function.size());
+
+	_priorities.assign(function.size(), function.size());
+
+	for(auto block : _traversal->order)
+	{
+		assert(block->id() < _priorities.size());
+
+		if(_priorities[block->id()] != function.size()) continue;
+
+		_priorities[block->id()] = _blocks.size();
+
+		_blocks.push_back(block);
+	}
+
+	// blocks missing from the traversal are unreachable, they are visited
+	//  last so that every block has a place in the worklist
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		assert(block->id() < _priorities.size());
+
+		if(_priorities[block->id()] != function.size()) continue;
+
+		_priorities[block->id()] = _blocks.size();
+
+		_blocks.push_back(&*block);
+	}
+
+	assert(_blocks.size() == function.size());
+
+	// backward problems converge fastest in post order
+	if(_direction == Backward)
+	{
+		std::reverse(_blocks.begin(), _blocks.end());
+
+		for(unsigned int priority = 0; priority < _blocks.size(); ++priority)
+		{
+			_priorities[_blocks[priority]->id()] = priority;
+		}
+	}
+}
+
+void DataflowSolver::_push(BasicBlock* block)
+{
+	assert(block->id() < _priorities.size());
+
+	_worklist.insert(_priorities[block->id()]);
+}
+
+DataflowSolver::BasicBlock* DataflowSolver::_pop()
+{
+	auto priority = *_worklist.begin();
+
+	_worklist.erase(priority);
+
+	return _blocks[priority];
+}
+
+}
+
+}
+
+
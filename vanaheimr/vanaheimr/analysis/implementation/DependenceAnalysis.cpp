@@ -130,34 +130,55 @@ void DependenceAnalysis::_setLocalDependences(BasicBlock& block)
 	}
 }
 
-static bool hasDataflowDependence(const ir::Instruction& predecessor,
-	const ir::Instruction& successor)
-{
-	typedef util::SmallSet<ir::VirtualRegister*> VirtualRegisterSet;
+typedef util::SmallSet<ir::VirtualRegister*> VirtualRegisterSet;
 
-	VirtualRegisterSet writes;
-
-	for(auto write : predecessor.writes)
+static void addRegisters(VirtualRegisterSet& registers,
+	const ir::Instruction::OperandVector& operands)
+{
+	for(auto operand : operands)
 	{
-		if(!write->isRegister()) continue;
+		if(operand == nullptr || !operand->isRegister()) continue;
 	
-		auto registerOperand = static_cast<ir::RegisterOperand*>(write);
+		auto registerOperand = static_cast<ir::RegisterOperand*>(operand);
 	
-		writes.insert(registerOperand->virtualRegister);
+		registers.insert(registerOperand->virtualRegister);
 	}
-	
-	for(auto read : successor.reads)
+}
+
+static bool anyRegisters(const VirtualRegisterSet& registers,
+	const ir::Instruction::OperandVector& operands)
+{
+	for(auto operand : operands)
 	{
-		if(!read->isRegister()) continue;
+		if(operand == nullptr || !operand->isRegister()) continue;
 	
-		auto registerOperand = static_cast<ir::RegisterOperand*>(read);
+		auto registerOperand = static_cast<ir::RegisterOperand*>(operand);
 	
-		if(writes.count(registerOperand->virtualRegister) != 0) return true;
+		if(registers.count(registerOperand->virtualRegister) != 0) return true;
 	}
 	
 	return false;
 }
 
+static bool hasDataflowDependence(const ir::Instruction& predecessor,
+	const ir::Instruction& successor)
+{
+	VirtualRegisterSet writes;
+
+	addRegisters(writes, predecessor.writes);
+	
+	// true and output dependences
+	if(anyRegisters(writes, successor.reads))  return true;
+	if(anyRegisters(writes, successor.writes)) return true;
+	
+	// anti dependences, a value must be read before it is overwritten
+	VirtualRegisterSet reads;
+	
+	addRegisters(reads, predecessor.reads);
+	
+	return anyRegisters(reads, successor.writes);
+}
+
 static bool hasControlflowDependence(const ir::Instruction& predecessor,
 	const ir::Instruction& successor)
 {
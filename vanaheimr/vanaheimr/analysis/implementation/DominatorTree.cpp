@@ -0,0 +1,369 @@
+/*! \file   DominatorTree.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the DominatorTree class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/DominatorTree.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <cassert>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+const unsigned int DominatorTree::InvalidId;
+
+DominatorTree::DominatorTree()
+: _hasDominanceFrontiers(false)
+{
+
+}
+
+typedef std::vector<unsigned int> IntVector;
+
+/*! \brief The ancestor forest used to evaluate semidominators, in
+	depth-first numbering */
+class SemidominatorForest
+{
+public:
+	static const unsigned int Unlinked = (unsigned int)-1;
+
+public:
+	SemidominatorForest(IntVector& s)
+	: semi(s), label(s.size()), ancestor(s.size(), Unlinked)
+	{
+		for(unsigned int v = 0; v < label.size(); ++v) label[v] = v;
+	}
+
+public:
+	void link(unsigned int parent, unsigned int v)
+	{
+		ancestor[v] = parent;
+	}
+
+	/*! \brief The vertex with the minimum semidominator on the path from v
+		to the root of its tree (excluding the root) */
+	unsigned int eval(unsigned int v)
+	{
+		if(ancestor[v] == Unlinked) return v;
+
+		_compress(v);
+
+		return label[v];
+	}
+
+private:
+	void _compress(unsigned int v)
+	{
+		path.clear();
+
+		for(auto x = v; ancestor[ancestor[x]] != Unlinked; x = ancestor[x])
+		{
+			path.push_back(x);
+		}
+
+		// update from the top of the path down
+		for(auto x = path.rbegin(); x != path.rend(); ++x)
+		{
+			auto a = ancestor[*x];
+
+			if(semi[label[a]] < semi[label[*x]]) label[*x] = label[a];
+
+			ancestor[*x] = ancestor[a];
+		}
+	}
+
+private:
+	IntVector& semi;
+	IntVector  label;
+	IntVector  ancestor;
+	IntVector  path;
+};
+
+const unsigned int SemidominatorForest::Unlinked;
+
+void DominatorTree::build(Function& function, ControlFlowGraph& cfg,
+	Direction direction)
+{
+	size_t blockCount = function.size();
+
+	_blocks.assign(blockCount, nullptr);
+	_predecessors.assign(blockCount, IntVector());
+
+	IntVectorVector successors(blockCount);
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		assert(block->id() < blockCount);
+
+		_blocks[block->id()] = &*block;
+
+		for(auto successor : cfg.getSuccessors(*block))
+		{
+			successors[block->id()].push_back(successor->id());
+			_predecessors[successor->id()].push_back(block->id());
+		}
+	}
+
+	if(direction == Reverse) std::swap(successors, _predecessors);
+
+	unsigned int root = direction == Forward ?
+		function.entry_block()->id() : function.exit_block()->id();
+
+	report("Building " << (direction == Forward ? "dominator" :
+		"post-dominator") << " tree for function " << function.name());
+
+	// Number the blocks in depth-first preorder from the root
+	IntVector number(blockCount, InvalidId);
+	IntVector vertex;
+	IntVector parent;
+
+	vertex.reserve(blockCount);
+	parent.reserve(blockCount);
+
+	{
+		typedef std::pair<unsigned int, unsigned int> StackEntry;
+		typedef std::vector<StackEntry>               Stack;
+
+		Stack stack;
+
+		number[root] = 0;
+		vertex.push_back(root);
+		parent.push_back(0);
+
+		stack.push_back(StackEntry(root, 0));
+
+		while(!stack.empty())
+		{
+			auto& top = stack.back();
+
+			auto& edges = successors[top.first];
+
+			if(top.second == edges.size())
+			{
+				stack.pop_back();
+				continue;
+			}
+
+			auto block = edges[top.second++];
+
+			if(number[block] != InvalidId) continue;
+
+			number[block] = vertex.size();
+
+			parent.push_back(number[top.first]);
+			vertex.push_back(block);
+
+			stack.push_back(StackEntry(block, 0));
+		}
+	}
+
+	size_t reachableCount = vertex.size();
+
+	// Compute semidominators in reverse preorder
+	IntVector semi(reachableCount);
+
+	for(unsigned int v = 0; v < reachableCount; ++v) semi[v] = v;
+
+	SemidominatorForest forest(semi);
+
+	for(unsigned int w = reachableCount - 1; w > 0; --w)
+	{
+		for(auto predecessor : _predecessors[vertex[w]])
+		{
+			if(number[predecessor] == InvalidId) continue;
+
+			auto u = forest.eval(number[predecessor]);
+
+			semi[w] = std::min(semi[w], semi[u]);
+		}
+
+		forest.link(parent[w], w);
+	}
+
+	// The immediate dominator is the nearest common ancestor of the parent
+	//  and the semidominator in the depth first tree
+	IntVector idom(reachableCount, 0);
+
+	for(unsigned int w = 1; w < reachableCount; ++w)
+	{
+		auto dominator = parent[w];
+
+		while(dominator > semi[w]) dominator = idom[dominator];
+
+		idom[w] = dominator;
+	}
+
+	// Translate back to block ids
+	_immediateDominators.assign(blockCount, InvalidId);
+	_children.assign(blockCount, IntVector());
+	_dominatedBlocks.assign(blockCount, BasicBlockSet());
+
+	_immediateDominators[root] = root;
+
+	for(unsigned int w = 1; w < reachableCount; ++w)
+	{
+		auto block     = vertex[w];
+		auto dominator = vertex[idom[w]];
+
+		_immediateDominators[block] = dominator;
+
+		_children[dominator].push_back(block);
+		_dominatedBlocks[dominator].insert(_blocks[block]);
+	}
+
+	_computeTreeNumbers();
+
+	_dominanceFrontiers.clear();
+	_hasDominanceFrontiers = false;
+}
+
+bool DominatorTree::dominates(const BasicBlock& dominator,
+	const BasicBlock& b) const
+{
+	if(!isReachable(dominator) || !isReachable(b)) return false;
+
+	return _preorder[dominator.id()] <= _preorder[b.id()] &&
+		_postorder[b.id()] <= _postorder[dominator.id()];
+}
+
+bool DominatorTree::isReachable(const BasicBlock& b) const
+{
+	assert(b.id() < _immediateDominators.size());
+
+	return _immediateDominators[b.id()] != InvalidId;
+}
+
+DominatorTree::BasicBlock* DominatorTree::getDominator(
+	const BasicBlock& b) const
+{
+	if(!isReachable(b)) return nullptr;
+
+	return _blocks[_immediateDominators[b.id()]];
+}
+
+const DominatorTree::BasicBlockSet& DominatorTree::getDominatedBlocks(
+	const BasicBlock& b) const
+{
+	assert(b.id() < _dominatedBlocks.size());
+
+	return _dominatedBlocks[b.id()];
+}
+
+const DominatorTree::BasicBlockSet& DominatorTree::getDominanceFrontier(
+	const BasicBlock& b)
+{
+	if(!_hasDominanceFrontiers) _computeDominanceFrontiers();
+
+	assert(b.id() < _dominanceFrontiers.size());
+
+	return _dominanceFrontiers[b.id()];
+}
+
+void DominatorTree::_computeTreeNumbers()
+{
+	_preorder.assign(_blocks.size(), InvalidId);
+	_postorder.assign(_blocks.size(), InvalidId);
+
+	typedef std::pair<unsigned int, unsigned int> StackEntry;
+	typedef std::vector<StackEntry>               Stack;
+
+	unsigned int preorder  = 0;
+	unsigned int postorder = 0;
+
+	Stack stack;
+
+	for(unsigned int block = 0; block < _blocks.size(); ++block)
+	{
+		// start from the root, its own immediate dominator
+		if(_immediateDominators[block] != block) continue;
+
+		_preorder[block] = preorder++;
+
+		stack.push_back(StackEntry(block, 0));
+
+		while(!stack.empty())
+		{
+			auto& top = stack.back();
+
+			auto& children = _children[top.first];
+
+			if(top.second == children.size())
+			{
+				_postorder[top.first] = postorder++;
+
+				stack.pop_back();
+				continue;
+			}
+
+			auto child = children[top.second++];
+
+			_preorder[child] = preorder++;
+
+			stack.push_back(StackEntry(child, 0));
+		}
+	}
+}
+
+void DominatorTree::_computeDominanceFrontiers()
+{
+	// "A simple and fast dominance algorithm" by
+	//	Keith D. Cooper, Timothy J. Harvey, and Ken Kennedy
+	_dominanceFrontiers.assign(_blocks.size(), BasicBlockSet());
+
+	for(unsigned int block = 0; block < _blocks.size(); ++block)
+	{
+		if(_immediateDominators[block] == InvalidId) continue;
+
+		auto& predecessors = _predecessors[block];
+
+		if(predecessors.size() < 2) continue;
+
+		for(auto predecessor : predecessors)
+		{
+			if(_immediateDominators[predecessor] == InvalidId) continue;
+
+			auto runner = predecessor;
+
+			while(runner != _immediateDominators[block])
+			{
+				_dominanceFrontiers[runner].insert(_blocks[block]);
+
+				auto dominator = _immediateDominators[runner];
+
+				// stop at the root
+				if(dominator == runner) break;
+
+				runner = dominator;
+			}
+		}
+	}
+
+	_hasDominanceFrontiers = true;
+}
+
+}
+
+}
+
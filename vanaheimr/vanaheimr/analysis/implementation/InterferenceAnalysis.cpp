@@ -11,6 +11,9 @@
 
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+#include <vanaheimr/util/interface/ParallelFor.h>
 
 // Standard Library Includes
 #include <cassert>
@@ -28,135 +31,216 @@ InterferenceAnalysis::InterferenceAnalysis()
 
 }
 
+static size_t matrixIndex(unsigned int one, unsigned int two)
+{
+	size_t high = std::max(one, two);
+	size_t low  = std::min(one, two);
+
+	return high * (high - 1) / 2 + low;
+}
+
 bool InterferenceAnalysis::doLiveRangesInterfere(const VirtualRegister& one,
 	const VirtualRegister& two) const
 {
-	const VirtualRegisterSet& interferences = getInterferences(one);
-
-	return interferences.count(const_cast<VirtualRegister*>(&two)) != 0;
+	return doLiveRangesInterfere(one.id, two.id);
 }
 
-InterferenceAnalysis::VirtualRegisterSet&
-	InterferenceAnalysis::getInterferences(
-		const VirtualRegister& virtualRegister)
+bool InterferenceAnalysis::doLiveRangesInterfere(RegisterId one,
+	RegisterId two) const
 {
-	assert(virtualRegister.id < _interferences.size());
+	if(one == two) return false;
+
+	assert(matrixIndex(one, two) < _matrix.universe());
+
+	return _matrix.contains(matrixIndex(one, two));
+}
 
-	return _interferences[virtualRegister.id];
+InterferenceAnalysis::InterferenceList InterferenceAnalysis::getInterferences(
+	const VirtualRegister& virtualRegister) const
+{
+	return getInterferences(virtualRegister.id);
 }
 
-const InterferenceAnalysis::VirtualRegisterSet&
-	InterferenceAnalysis::getInterferences(
-		const VirtualRegister& virtualRegister) const
+InterferenceAnalysis::InterferenceList InterferenceAnalysis::getInterferences(
+	RegisterId id) const
 {
-	assert(virtualRegister.id < _interferences.size());
+	assert(id + 1 < _adjacencyOffsets.size());
 
-	return _interferences[virtualRegister.id];
+	auto base = _adjacency.data();
+
+	return InterferenceList(base + _adjacencyOffsets[id],
+		base + _adjacencyOffsets[id + 1]);
 }
 
-typedef std::pair<ir::BasicBlock*, LiveRange*> BlockToRange;
-typedef std::vector<BlockToRange> BlockToRangeVector;
-typedef BlockToRangeVector::iterator RangeIterator;
-typedef std::pair<RangeIterator, RangeIterator> Range;
-typedef std::vector<Range> RangeVector;
+typedef LiveRangeAnalysis::Interval Interval;
+
+typedef std::pair<Interval, unsigned int> IntervalToRegister;
+typedef std::vector<IntervalToRegister> IntervalToRegisterVector;
+typedef std::vector<IntervalToRegisterVector> IntervalToRegisterVectorVector;
 
-static BlockToRangeVector mapBlocksToLiveRanges(LiveRangeAnalysis*);
-static RangeVector partition(BlockToRangeVector&);
-static void checkIntersectionsInOverlappingRanges(InterferenceAnalysis*,
-	const RangeVector&);
+typedef std::pair<unsigned int, unsigned int> RegisterIdPair;
+typedef std::vector<RegisterIdPair> RegisterIdPairVector;
+typedef std::vector<RegisterIdPairVector> RegisterIdPairVectorVector;
+
+static IntervalToRegisterVectorVector partition(ir::Function& function,
+	LiveRangeAnalysis*);
+static RegisterIdPairVectorVector findOverlappingIntervals(
+	IntervalToRegisterVectorVector&);
 
-// TODO: Segregate ranges into fully covered and partially covered sets.
-//       Processor them independently to reduce the complexity of the cross
-//       product
 void InterferenceAnalysis::analyze(Function& function)
 {
 	auto ranges = static_cast<LiveRangeAnalysis*>(
 		getAnalysis("LiveRangeAnalysis"));
 	assert(ranges != nullptr);
 
-	_interferences.resize(function.register_size());
+	size_t values = function.register_id_bound();
 
-	// map live ranges into partiions that are alive in the same blocks
-	auto blocksToRanges = mapBlocksToLiveRanges(ranges);
+	_matrix = util::BitVector(values < 2 ? 0 : values * (values - 1) / 2);
 
-	auto partitions = partition(blocksToRanges);
+	// split the live intervals at block boundaries
+	auto partitions = partition(function, ranges);
 
-	// compute intersections among live ranges in the same partition
-	checkIntersectionsInOverlappingRanges(this, partitions);
-}
-	
-static BlockToRangeVector mapBlocksToLiveRanges(LiveRangeAnalysis* ranges)
-{
-	BlockToRangeVector blocksToRanges;
-	
-	// TODO: for all
-	for(auto range = ranges->begin(); range != ranges->end(); ++range)
+	// sweep over the intervals in each block independently
+	auto overlaps = findOverlappingIntervals(partitions);
+
+	// the matrix removes pairs that overlap in more than one block
+	RegisterIdPairVector edges;
+
+	for(auto& blockOverlaps : overlaps)
 	{
-		// Add an entry for each block used by the range
-		auto blocks = range->allBlocksWithLiveValue();
-		
-		for(auto block : blocks)
+		for(auto& pair : blockOverlaps)
 		{
-			blocksToRanges.push_back(std::make_pair(block, &*range));
+			if(_matrix.insert(matrixIndex(pair.first, pair.second)))
+			{
+				edges.push_back(pair);
+			}
 		}
 	}
-	
-	return blocksToRanges;
+
+	_buildAdjacency(edges, values);
+}
+
+void InterferenceAnalysis::_buildAdjacency(const RegisterIdPairVector& edges,
+	size_t values)
+{
+	_adjacencyOffsets.assign(values + 1, 0);
+
+	for(auto& edge : edges)
+	{
+		++_adjacencyOffsets[edge.first  + 1];
+		++_adjacencyOffsets[edge.second + 1];
+	}
+
+	for(size_t i = 0; i < values; ++i)
+	{
+		_adjacencyOffsets[i + 1] += _adjacencyOffsets[i];
+	}
+
+	_adjacency.resize(_adjacencyOffsets.back());
+
+	RegisterIdVector position(_adjacencyOffsets.begin(),
+		_adjacencyOffsets.end() - 1);
+
+	for(auto& edge : edges)
+	{
+		_adjacency[position[edge.first ]++] = edge.second;
+		_adjacency[position[edge.second]++] = edge.first;
+	}
 }
 
-static RangeVector partition(BlockToRangeVector& blocksToRanges)
+static IntervalToRegisterVectorVector partition(ir::Function& function,
+	LiveRangeAnalysis* ranges)
 {
-	// Group live ranges by blocks that they reference 
-	std::sort(blocksToRanges.begin(), blocksToRanges.end());
+	typedef std::vector<unsigned int> PositionVector;
 
-	// Partition the live ranges by blocks that they reference
-	RangeVector blockRanges;
+	// the blocks occupy consecutive positions in layout order
+	PositionVector blockStarts;
+	
+	for(auto& block : function)
+	{
+		blockStarts.push_back(ranges->getBlockStart(block));
+	}
 	
-	Range currentRange(blocksToRanges.begin(), blocksToRanges.begin());
+	IntervalToRegisterVectorVector partitions(blockStarts.size());
 	
-	// TODO: Partition the array in parallel using recursive binary search
-	for(auto blockToRange = blocksToRanges.begin();
-		blockToRange != blocksToRanges.end(); ++blockToRange)
+	for(auto& range : *ranges)
 	{
-		currentRange.second = blockToRange;
-		
-		if(currentRange.first->first != currentRange.second->first)
+		if(range.virtualRegister() == nullptr) continue;
+	
+		unsigned int id = range.virtualRegister()->id;
+	
+		for(auto& interval : range.intervals)
 		{
-			// We found a new block
-			blockRanges.push_back(currentRange);
+			size_t block = std::upper_bound(blockStarts.begin(),
+				blockStarts.end(), interval.start) - blockStarts.begin() - 1;
 			
-			currentRange.first = currentRange.second;
+			for(; block < blockStarts.size() &&
+				blockStarts[block] < interval.end; ++block)
+			{
+				unsigned int start = std::max(interval.start,
+					blockStarts[block]);
+				unsigned int end = interval.end;
+
+				if(block + 1 < blockStarts.size())
+				{
+					end = std::min(end, blockStarts[block + 1]);
+				}
+				
+				if(start >= end) continue;
+				
+				partitions[block].push_back(IntervalToRegister(
+					Interval(start, end), id));
+			}
 		}
 	}
 	
-	blockRanges.push_back(currentRange);
-	
-	return blockRanges;
+	return partitions;
 }
 
-
-static void checkIntersectionsInOverlappingRanges(
-	InterferenceAnalysis* interefernceAnalysis,
-	const RangeVector& partitions)
+static RegisterIdPairVectorVector findOverlappingIntervals(
+	IntervalToRegisterVectorVector& partitions)
 {
-	// check all partitions (TODO in parallel)
-	for(auto partition : partitions)
+	RegisterIdPairVectorVector overlaps(partitions.size());
+
+	// inside a pass manager worker this only uses the worker's share of
+	//  threads, which is usually one
+	util::parallelFor(partitions.size(), 0, [&](size_t p)
 	{
-		for(auto one = partition.first; one != partition.second; ++one)
+		auto& intervals = partitions[p];
+		auto& pairs     = overlaps[p];
+		
+		std::sort(intervals.begin(), intervals.end(),
+			[](const IntervalToRegister& left,
+				const IntervalToRegister& right)
+			{
+				return left.first.start < right.first.start;
+			});
+		
+		// intervals that are still live at the current start
+		IntervalToRegisterVector active;
+		
+		for(auto& interval : intervals)
 		{
-			for(auto two = partition.first; two != partition.second; ++two)
+			auto expired = std::remove_if(active.begin(), active.end(),
+				[&](const IntervalToRegister& live)
+				{
+					return live.first.end <= interval.first.start;
+				});
+			
+			active.erase(expired, active.end());
+			
+			for(auto& live : active)
 			{
-				if(one == two) continue;
+				if(live.second == interval.second) continue;
 
-				if(one->second->interferesWith(*two->second))
-				{
-					interefernceAnalysis->getInterferences(
-						*one->second->virtualRegister()).insert(
-							two->second->virtualRegister());
-				}
+				pairs.push_back(RegisterIdPair(live.second, interval.second));
 			}
+			
+			active.push_back(interval);
 		}
-	}
+	});
+
+	return overlaps;
 }
 
 }
@@ -13,10 +13,14 @@
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/VirtualRegister.h>
 
+#include <vanaheimr/util/interface/LargeMap.h>
+#include <vanaheimr/util/interface/ParallelFor.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
+#include <algorithm>
 #include <cassert>
 
 namespace vanaheimr
@@ -25,6 +29,22 @@ namespace vanaheimr
 namespace analysis
 {
 
+LiveRangeAnalysis::Interval::Interval(unsigned int s, unsigned int e)
+: start(s), end(e)
+{
+
+}
+
+bool LiveRangeAnalysis::Interval::empty() const
+{
+	return start >= end;
+}
+
+bool LiveRangeAnalysis::Interval::overlaps(const Interval& interval) const
+{
+	return std::max(start, interval.start) < std::min(end, interval.end);
+}
+
 LiveRange::LiveRange(LiveRangeAnalysis* liveRangeAnalysis, VirtualRegister* vr)
 : _analysis(liveRangeAnalysis), _virtualRegister(vr)
 {
@@ -62,53 +82,34 @@ LiveRangeAnalysis::BasicBlockSet
 
 bool LiveRangeAnalysis::LiveRange::interferesWith(const LiveRange& range) const
 {
-	// easy case, live ranges intersect in fully covered blocks
-	for(auto block : range.fullyCoveredBlocks)
-	{
-		if(fullyCoveredBlocks.count(block) != 0) return true;
-	}
+	// merge the sorted intervals, stepping past whichever ends first
+	auto one = intervals.begin();
+	auto two = range.intervals.begin();
 	
-	// hard case, live ranges intersect in a partially covered block
-	for(auto instruction : range.usingInstructions)
+	while(one != intervals.end() && two != range.intervals.end())
 	{
-		auto block = instruction->block;
-	
-		if(fullyCoveredBlocks.count(block) != 0) return true;
-		
-		auto user = ir::BasicBlock::reverse_iterator(
-			block->getIterator(instruction));
-		
-		while(user != block->rend())
-		{
-			if(range.definingInstructions.count(*user) != 0) break;
+		if(one->overlaps(*two)) return true;
 		
-			if(usingInstructions.count(*user) != 0)    return true;
-			if(definingInstructions.count(*user) != 0) return true;
-
-			++user;
-		}
+		if(one->end < two->end) ++one;
+		else ++two;
 	}
-
-	for(auto instruction : range.definingInstructions)
-	{
-		auto block = instruction->block;
 	
-		if(fullyCoveredBlocks.count(block) != 0) return true;
-		
-		auto definer = block->getIterator(instruction);
-		
-		while(definer != block->end())
+	return false;
+}
+
+bool LiveRangeAnalysis::LiveRange::covers(unsigned int position) const
+{
+	auto interval = std::upper_bound(intervals.begin(), intervals.end(),
+		position, [](unsigned int position, const Interval& interval)
 		{
-			if(range.usingInstructions.count(*definer) != 0) break;
-		
-			if(usingInstructions.count(*definer) != 0)    return true;
-			if(definingInstructions.count(*definer) != 0) return true;
-		
-			++definer;
-		}
-	}
+			return position < interval.start;
+		});
 	
-	return false;
+	if(interval == intervals.begin()) return false;
+	
+	--interval;
+	
+	return position < interval->end;
 }
 
 LiveRangeAnalysis::LiveRangeAnalysis()
@@ -134,9 +135,6 @@ LiveRangeAnalysis::LiveRange* LiveRangeAnalysis::getLiveRange(
 	return &_liveRanges[virtualRegister.id];
 }
 
-static void findLiveRange(LiveRangeAnalysis::LiveRange& liveRange,
-	DataflowAnalysis* dfg, ControlFlowGraph* );
-
 void LiveRangeAnalysis::analyze(Function& function)
 {
 	hydrazine::log("LiveRangeAnalysis") << "Running analysis on function '"
@@ -149,16 +147,50 @@ void LiveRangeAnalysis::analyze(Function& function)
 	assert(cfg != nullptr);
 
 	_initializeLiveRanges(function);
+	_numberInstructions(function);
 
 	hydrazine::log("LiveRangeAnalysis") << " Discovering live ranges\n";
 	
-	// compute the live range for each variable in parallel (for all)
-	// TODO: use an algorithm that merges partial results
-	for(auto virtualRegister = function.register_begin();
-		virtualRegister != function.register_end(); ++virtualRegister)
+	for(auto& liveRange : _liveRanges)
 	{
-		findLiveRange(*getLiveRange(*virtualRegister), dfg, cfg);
+		auto vr = liveRange.virtualRegister();
+	
+		if(vr == nullptr) continue;
+
+		liveRange.definingInstructions = dfg->getReachingDefinitions(*vr);
+		liveRange.usingInstructions    = dfg->getReachedUses(*vr);
 	}
+
+	_computeIntervals(function);
+}
+
+unsigned int LiveRangeAnalysis::getBlockStart(const BasicBlock& block) const
+{
+	assert(block.id() < _blockStarts.size());
+	
+	return _blockStarts[block.id()];
+}
+
+unsigned int LiveRangeAnalysis::getBlockEnd(const BasicBlock& block) const
+{
+	assert(block.id() < _blockEnds.size());
+	
+	return _blockEnds[block.id()];
+}
+
+unsigned int LiveRangeAnalysis::getReadPosition(
+	const Instruction& instruction) const
+{
+	auto position = _instructionPositions.find(&instruction);
+	assert(position != _instructionPositions.end());
+	
+	return position->second;
+}
+
+unsigned int LiveRangeAnalysis::getWritePosition(
+	const Instruction& instruction) const
+{
+	return getReadPosition(instruction) + 1;
 }
 
 LiveRangeAnalysis::iterator LiveRangeAnalysis::begin()
@@ -193,117 +225,198 @@ size_t LiveRangeAnalysis::size() const
 
 void LiveRangeAnalysis::_initializeLiveRanges(Function& function)
 {
-	_liveRanges.clear();
-	_liveRanges.reserve(function.register_size());
+	_liveRanges.assign(function.register_id_bound(), LiveRange(this, nullptr));
 
 	hydrazine::log("LiveRangeAnalysis") << " Creating live ranges\n";
 	
 	for(auto virtualRegister = function.register_begin();
 		virtualRegister != function.register_end(); ++virtualRegister)
 	{
-		_liveRanges.push_back(LiveRange(this, &*virtualRegister));
+		_liveRanges[virtualRegister->id] = LiveRange(this, &*virtualRegister);
 	}
 }
 
-typedef ir::BasicBlock BasicBlock;
-
-static bool isLiveOut(LiveRange& liveRange, BasicBlock* block,
-	DataflowAnalysis* dfg)
-{
-	auto liveOuts = dfg->getLiveOuts(*block);
-
-	return liveOuts.count(liveRange.virtualRegister()) != 0;
-}
-
-static bool blockHasDefinitions(BasicBlock* block, const LiveRange& liveRange)
+void LiveRangeAnalysis::_numberInstructions(Function& function)
 {
-	for(auto definition : liveRange.definingInstructions)
+	unsigned int blockIds = 0;
+	
+	for(auto& block : function)
 	{
-		if(definition->block == block) return true;
+		blockIds = std::max(blockIds, block.id() + 1);
+	}
+	
+	_blockStarts.assign(blockIds, 0);
+	_blockEnds.assign(blockIds, 0);
+	
+	_instructionPositions.clear();
+	
+	unsigned int position = 0;
+	
+	for(auto& block : function)
+	{
+		_blockStarts[block.id()] = position;
+		
+		for(auto instruction : block)
+		{
+			_instructionPositions.insert(std::make_pair(instruction,
+				position));
+			
+			position += 2;
+		}
+		
+		_blockEnds[block.id()] = position;
 	}
-
-	return false;
 }
 
-typedef LiveRangeAnalysis::BasicBlockSet BasicBlockSet;
+typedef ir::BasicBlock BasicBlock;
+typedef ir::Instruction Instruction;
+typedef LiveRangeAnalysis::Interval Interval;
+
+typedef std::pair<unsigned int, Interval> RegisterInterval;
+typedef std::vector<RegisterInterval>     RegisterIntervalVector;
+typedef std::vector<unsigned int>         RegisterIdVector;
 
-static void walkUpPredecessor(BasicBlockSet& visited, LiveRange& liveRange,
-	BasicBlock* block, DataflowAnalysis* dfg, ControlFlowGraph* cfg)
+/*! \brief The intervals of values within a single block */
+class BlockLiveness
 {
-	// early exit when a node is already visited
-	if(!visited.insert(block).second) return;
-
-	// skip nodes for which the value is not live-out
-	if(!isLiveOut(liveRange, block, dfg)) return;
+public:
+	RegisterIntervalVector intervals;
+	RegisterIdVector       fullyCoveredValues;
+};
 
-	// skip nodes that define the value, starting the live range
-	if(blockHasDefinitions(block, liveRange)) return;
+typedef std::vector<BlockLiveness> BlockLivenessVector;
 
-	// add the block to the live range
-	liveRange.fullyCoveredBlocks.insert(block);
+static unsigned int getRegisterId(const ir::Operand* operand)
+{
+	return static_cast<const ir::RegisterOperand*>(
+		operand)->virtualRegister->id;
+}
 
-	hydrazine::log("LiveRangeAnalysis") << "   fully covered block '"
-		<< block->name() << "'\n";
+static void computeBlockLiveness(BlockLiveness& liveness,
+	const BasicBlock& block, unsigned int start, const DataflowAnalysis& dfg)
+{
+	typedef util::LargeMap<unsigned int, unsigned int> EndMap;
+	
+	unsigned int end = start + 2 * block.size();
+	
+	// walk backwards, tracking where each live value stops being live
+	EndMap liveValues;
+	
+	for(auto value : dfg.getLiveOuts(block))
+	{
+		liveValues.insert(std::make_pair(value->id, end));
+	}
 
-	// recurse on predecessors with the value as a live out
-	auto predecessors = cfg->getPredecessors(*block);
+	RegisterIdVector defined;
 	
-	for(auto predecessor : predecessors)
+	unsigned int position = end;
+	
+	for(auto instruction = block.rbegin();
+		instruction != block.rend(); ++instruction)
 	{
-		walkUpPredecessor(visited, liveRange, predecessor, dfg, cfg);
+		position -= 2;
+	
+		for(auto write : (*instruction)->writes)
+		{
+			if(!write->isRegister()) continue;
+			
+			unsigned int id = getRegisterId(write);
+			
+			defined.push_back(id);
+			
+			auto live = liveValues.find(id);
+			
+			// dead definitions still occupy a register when written
+			if(live == liveValues.end())
+			{
+				liveness.intervals.push_back(RegisterInterval(id,
+					Interval(position + 1, position + 2)));
+				continue;
+			}
+			
+			liveness.intervals.push_back(RegisterInterval(id,
+				Interval(position + 1, live->second)));
+			
+			liveValues.erase(live);
+		}
+		
+		for(auto read : (*instruction)->reads)
+		{
+			if(!read->isRegister()) continue;
+			
+			liveValues.insert(std::make_pair(getRegisterId(read),
+				position + 1));
+		}
 	}
 	
-}
-
-typedef ir::Instruction Instruction;
+	for(auto& live : liveValues)
+	{
+		if(live.second == start) continue;
 
-static bool blockHasPriorDefinitions(LiveRange& liveRange, Instruction* user)
-{
-	for(auto definition : liveRange.definingInstructions)
+		liveness.intervals.push_back(RegisterInterval(live.first,
+			Interval(start, live.second)));
+	}
+	
+	// each value was visited in decreasing order, restore increasing order
+	std::reverse(liveness.intervals.begin(), liveness.intervals.end());
+	
+	std::sort(defined.begin(), defined.end());
+	
+	for(auto value : dfg.getLiveOuts(block))
 	{
-		// Is there a definition in the same block
-		if(definition->block != user->block) continue;
+		if(std::binary_search(defined.begin(), defined.end(), value->id))
+		{
+			continue;
+		}
 		
-		// Does the definition occur prior to this use?
-		if(definition->index() < user->index()) return true;
+		liveness.fullyCoveredValues.push_back(value->id);
 	}
-
-	return false;
 }
 
-static void walkUpDataflowGraph(LiveRange& liveRange,
-	DataflowAnalysis* dfg, ControlFlowGraph* cfg, Instruction* user)
+void LiveRangeAnalysis::_computeIntervals(Function& function)
 {
-	BasicBlockSet visited;
-
-	visited.insert(user->block);
-
-	// skip blocks that start the live range
-	if(blockHasPriorDefinitions(liveRange, user)) return;
-
-	auto predecessors = cfg->getPredecessors(*user->block);
+	auto dfg = static_cast<DataflowAnalysis*>(getAnalysis("DataflowAnalysis"));
+	
+	typedef std::vector<BasicBlock*> BasicBlockVector;
+	
+	BasicBlockVector blocks;
 	
-	for(auto predecessor : predecessors)
+	for(auto& block : function)
 	{
-		walkUpPredecessor(visited, liveRange, predecessor, dfg, cfg);
+		blocks.push_back(&block);
 	}
-}
-
-static void findLiveRange(LiveRangeAnalysis::LiveRange& liveRange,
-	DataflowAnalysis* dfg, ControlFlowGraph* cfg)
-{
-	auto vr = liveRange.virtualRegister();
-
-	liveRange.definingInstructions = dfg->getReachingDefinitions(*vr);
-	liveRange.usingInstructions    = dfg->getReachedUses(*vr);
-
-	hydrazine::log("LiveRangeAnalysis") << "  Discovering live range for '"
-		<< liveRange.virtualRegister()->toString() << "'\n";
-
-	// in parallel
-	for(auto use : liveRange.usingInstructions)
+	
+	// blocks are independent given the live-outs, inside a pass manager
+	//  worker they only use the worker's share of threads
+	BlockLivenessVector liveness(blocks.size());
+	
+	util::parallelFor(blocks.size(), 0, [&](size_t i)
 	{
-		walkUpDataflowGraph(liveRange, dfg, cfg, use);
+		computeBlockLiveness(liveness[i], *blocks[i],
+			getBlockStart(*blocks[i]), *dfg);
+	});
+	
+	// merge the partial results in layout order, which keeps them sorted
+	for(size_t i = 0; i < blocks.size(); ++i)
+	{
+		for(auto& registerInterval : liveness[i].intervals)
+		{
+			auto& intervals = _liveRanges[registerInterval.first].intervals;
+			auto& interval  = registerInterval.second;
+			
+			if(!intervals.empty() && intervals.back().end == interval.start)
+			{
+				intervals.back().end = interval.end;
+				continue;
+			}
+			
+			intervals.push_back(interval);
+		}
+		
+		for(auto id : liveness[i].fullyCoveredValues)
+		{
+			_liveRanges[id].fullyCoveredBlocks.insert(blocks[i]);
+		}
 	}
 }
 
@@ -0,0 +1,797 @@
+/*! \file   LoopAnalysis.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the LoopAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/DominatorAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+#include <vanaheimr/util/interface/BitVector.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Trip counts are found by running the exit test, give up after
+	this many iterations */
+static const unsigned int MaxTripCount = 1 << 16;
+
+LoopAnalysis::InductionVariable::InductionVariable(VirtualRegister* v,
+	Instruction* u, int64_t s)
+: value(v), update(u), step(s), hasConstantStart(false), start(0)
+{
+
+}
+
+LoopAnalysis::Loop::Loop(BasicBlock* h)
+: header(h), parent(nullptr), depth(1), tripCount(0)
+{
+
+}
+
+bool LoopAnalysis::Loop::contains(const BasicBlock& block) const
+{
+	return blocks.count(const_cast<BasicBlock*>(&block)) != 0;
+}
+
+bool LoopAnalysis::Loop::isInnermost() const
+{
+	return children.empty();
+}
+
+const LoopAnalysis::InductionVariable*
+	LoopAnalysis::Loop::getInductionVariable(
+	const VirtualRegister& value) const
+{
+	for(auto& variable : inductionVariables)
+	{
+		if(variable.value == &value) return &variable;
+	}
+
+	return nullptr;
+}
+
+LoopAnalysis::LoopAnalysis()
+: FunctionAnalysis("LoopAnalysis",
+	StringVector({"ControlFlowGraph", "DominatorAnalysis"}))
+{
+
+}
+
+LoopAnalysis::Loop* LoopAnalysis::getLoop(const BasicBlock& block) const
+{
+	if(block.id() >= _innermostLoops.size()) return nullptr;
+
+	return _innermostLoops[block.id()];
+}
+
+unsigned int LoopAnalysis::getLoopDepth(const BasicBlock& block) const
+{
+	auto loop = getLoop(block);
+
+	if(loop == nullptr) return 0;
+
+	return loop->depth;
+}
+
+const LoopAnalysis::LoopVector& LoopAnalysis::getTopLevelLoops() const
+{
+	return _topLevelLoops;
+}
+
+void LoopAnalysis::analyze(Function& function)
+{
+	report("Running loop analysis over function " << function.name());
+
+	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	auto dominators = static_cast<DominatorAnalysis*>(
+		getAnalysis("DominatorAnalysis"));
+	assert(dominators != nullptr);
+
+	_loops.clear();
+	_topLevelLoops.clear();
+	_innermostLoops.assign(function.size(), nullptr);
+	_definitions.assign(function.register_id_bound(), InstructionVector());
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(!write->isRegister()) continue;
+
+				_definitions[static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister->id].push_back(instruction);
+			}
+		}
+	}
+
+	_findLoops(function, *cfg, *dominators);
+	_buildForest();
+
+	for(auto& loop : _loops)
+	{
+		_findInductionVariables(loop, *cfg, *dominators);
+		_computeTripCount(loop);
+
+		report(" loop at " << loop.header->name() << ", depth "
+			<< loop.depth << ", " << loop.blocks.size() << " blocks, "
+			<< loop.inductionVariables.size() << " induction variables, "
+			<< "trip count " << loop.tripCount);
+	}
+}
+
+LoopAnalysis::iterator LoopAnalysis::begin()
+{
+	return _loops.begin();
+}
+
+LoopAnalysis::const_iterator LoopAnalysis::begin() const
+{
+	return _loops.begin();
+}
+
+LoopAnalysis::iterator LoopAnalysis::end()
+{
+	return _loops.end();
+}
+
+LoopAnalysis::const_iterator LoopAnalysis::end() const
+{
+	return _loops.end();
+}
+
+bool LoopAnalysis::empty() const
+{
+	return _loops.empty();
+}
+
+size_t LoopAnalysis::size() const
+{
+	return _loops.size();
+}
+
+void LoopAnalysis::_findLoops(Function& function, ControlFlowGraph& cfg,
+	const DominatorAnalysis& dominators)
+{
+	for(auto& header : function)
+	{
+		BasicBlockVector latches;
+
+		for(auto predecessor : cfg.getPredecessors(header))
+		{
+			if(dominators.dominates(*predecessor, header))
+			{
+				latches.push_back(predecessor);
+			}
+		}
+
+		if(latches.empty()) continue;
+
+		_loops.push_back(Loop(&header));
+
+		auto& loop = _loops.back();
+
+		loop.latches = latches;
+
+		// walk backwards from the latches, every block in the loop is
+		//  dominated by the header, which also excludes unreachable blocks
+		util::BitVector visited(function.size());
+
+		visited.insert(header.id());
+
+		BasicBlockVector blocks(1, &header);
+		BasicBlockVector stack;
+
+		for(auto latch : latches)
+		{
+			if(visited.insert(latch->id())) stack.push_back(latch);
+		}
+
+		while(!stack.empty())
+		{
+			auto block = stack.back();
+			stack.pop_back();
+
+			blocks.push_back(block);
+
+			for(auto predecessor : cfg.getPredecessors(*block))
+			{
+				if(!dominators.dominates(*predecessor, header)) continue;
+
+				if(visited.insert(predecessor->id()))
+				{
+					stack.push_back(predecessor);
+				}
+			}
+		}
+
+		loop.blocks.insert(blocks.begin(), blocks.end());
+
+		for(auto block : loop.blocks)
+		{
+			for(auto successor : cfg.getSuccessors(*block))
+			{
+				if(loop.contains(*successor)) continue;
+
+				loop.exits.push_back(Edge(block, successor));
+			}
+		}
+	}
+}
+
+void LoopAnalysis::_buildForest()
+{
+	// loops with different headers are either nested or disjoint, so
+	//  visiting larger loops first finds each parent before its children
+	LoopVector loops;
+
+	for(auto& loop : _loops)
+	{
+		loops.push_back(&loop);
+	}
+
+	std::stable_sort(loops.begin(), loops.end(),
+		[](const Loop* left, const Loop* right)
+		{
+			return left->blocks.size() > right->blocks.size();
+		});
+
+	for(auto loop : loops)
+	{
+		loop->parent = _innermostLoops[loop->header->id()];
+
+		if(loop->parent == nullptr)
+		{
+			_topLevelLoops.push_back(loop);
+		}
+		else
+		{
+			loop->parent->children.push_back(loop);
+			loop->depth = loop->parent->depth + 1;
+		}
+
+		for(auto block : loop->blocks)
+		{
+			_innermostLoops[block->id()] = loop;
+		}
+	}
+}
+
+static unsigned int getBits(const ir::Type* type)
+{
+	if(type == nullptr || !type->isInteger()) return 0;
+
+	return static_cast<const ir::IntegerType*>(type)->bits();
+}
+
+static uint64_t truncate(uint64_t value, unsigned int bits)
+{
+	if(bits >= 64) return value;
+
+	return value & ((((uint64_t)1) << bits) - 1);
+}
+
+static int64_t signExtend(uint64_t value, unsigned int bits)
+{
+	if(bits >= 64) return value;
+
+	uint64_t sign = ((uint64_t)1) << (bits - 1);
+
+	return (int64_t)((truncate(value, bits) ^ sign) - sign);
+}
+
+static const ir::VirtualRegister* getRegister(const ir::Operand* operand)
+{
+	if(operand->mode() != ir::Operand::Register) return nullptr;
+
+	return static_cast<const ir::RegisterOperand*>(operand)->virtualRegister;
+}
+
+static bool getImmediate(uint64_t& value, const ir::Operand* operand)
+{
+	if(operand->mode() != ir::Operand::Immediate) return false;
+
+	auto immediate = static_cast<const ir::ImmediateOperand*>(operand);
+
+	if(getBits(immediate->dataType) == 0) return false;
+
+	value = immediate->uint;
+
+	return true;
+}
+
+/*! \brief Is an instruction value = value +/- constant? */
+static bool getStep(int64_t& step, const ir::Instruction& update,
+	const ir::VirtualRegister& value)
+{
+	if(!update.guard()->isAlwaysTrue()) return false;
+
+	if(update.opcode != ir::Instruction::Add &&
+		update.opcode != ir::Instruction::Sub)
+	{
+		return false;
+	}
+
+	auto& binary = static_cast<const ir::BinaryInstruction&>(update);
+
+	unsigned int bits = getBits(value.type);
+
+	if(bits == 0) return false;
+
+	uint64_t constant = 0;
+
+	if(getRegister(binary.a()) == &value && getImmediate(constant, binary.b()))
+	{
+		step = signExtend(constant, bits);
+	}
+	else if(update.opcode == ir::Instruction::Add &&
+		getRegister(binary.b()) == &value &&
+		getImmediate(constant, binary.a()))
+	{
+		step = signExtend(constant, bits);
+	}
+	else
+	{
+		return false;
+	}
+
+	if(update.opcode == ir::Instruction::Sub) step = -step;
+
+	return true;
+}
+
+/*! \brief Get the value written by an instruction with constant sources */
+static bool getConstant(uint64_t& value, const ir::Instruction& instruction)
+{
+	if(!instruction.guard()->isAlwaysTrue()) return false;
+	if(instruction.writes.size() != 1)        return false;
+
+	auto destination = getRegister(instruction.writes.front());
+
+	if(destination == nullptr) return false;
+
+	unsigned int bits = getBits(destination->type);
+
+	if(bits == 0) return false;
+
+	if(instruction.opcode == ir::Instruction::Bitcast)
+	{
+		auto& unary = static_cast<const ir::UnaryInstruction&>(instruction);
+
+		if(!getImmediate(value, unary.a())) return false;
+	}
+	else if(instruction.opcode == ir::Instruction::Add ||
+		instruction.opcode == ir::Instruction::Sub)
+	{
+		auto& binary = static_cast<const ir::BinaryInstruction&>(instruction);
+
+		uint64_t a = 0;
+		uint64_t b = 0;
+
+		if(!getImmediate(a, binary.a())) return false;
+		if(!getImmediate(b, binary.b())) return false;
+
+		value = instruction.opcode == ir::Instruction::Add ? a + b : a - b;
+	}
+	else
+	{
+		return false;
+	}
+
+	value = truncate(value, bits);
+
+	return true;
+}
+
+/*! \brief Is the update of a value killed by its initial definition on
+	every path to the entries of a loop?  An irreducible cycle can leave
+	the loop and enter it again without running the initial definition. */
+static bool onlyInitialReachesEntries(const LoopAnalysis::Loop& loop,
+	const ir::Instruction& initial, const ir::Instruction& update,
+	ControlFlowGraph& cfg)
+{
+	util::BitVector visited(loop.header->function()->size());
+
+	LoopAnalysis::BasicBlockVector stack;
+
+	for(auto predecessor : cfg.getPredecessors(*loop.header))
+	{
+		if(loop.contains(*predecessor)) continue;
+
+		if(visited.insert(predecessor->id())) stack.push_back(predecessor);
+	}
+
+	// walk backwards from the entries, stopping at the initial definition
+	while(!stack.empty())
+	{
+		auto block = stack.back();
+		stack.pop_back();
+
+		if(block == update.block)  return false;
+		if(block == initial.block) continue;
+
+		for(auto predecessor : cfg.getPredecessors(*block))
+		{
+			if(visited.insert(predecessor->id())) stack.push_back(predecessor);
+		}
+	}
+
+	return true;
+}
+
+void LoopAnalysis::_findInductionVariables(Loop& loop, ControlFlowGraph& cfg,
+	const DominatorAnalysis& dominators)
+{
+	// SSA form: value = phi(start, value + step)
+	for(auto instruction : *loop.header)
+	{
+		if(!instruction->isPhi()) break;
+
+		auto phi = static_cast<ir::Phi*>(instruction);
+
+		VirtualRegister* start = nullptr;
+		VirtualRegister* next  = nullptr;
+
+		auto sources = phi->sources();
+		auto blocks  = phi->blocks();
+
+		bool isUniform = true;
+
+		for(unsigned int i = 0; i < sources.size(); ++i)
+		{
+			auto& source = loop.contains(*blocks[i]) ? next : start;
+
+			if(source != nullptr && source != sources[i]->virtualRegister)
+			{
+				isUniform = false;
+			}
+
+			source = sources[i]->virtualRegister;
+		}
+
+		if(!isUniform || start == nullptr || next == nullptr) continue;
+
+		if(_definitions[next->id].size() != 1) continue;
+
+		auto update = _definitions[next->id].front();
+		auto value  = phi->d()->virtualRegister;
+
+		int64_t step = 0;
+
+		if(!loop.contains(*update->block))    continue;
+		if(!getStep(step, *update, *value)) continue;
+
+		InductionVariable variable(value, update, step);
+
+		if(_definitions[start->id].size() == 1)
+		{
+			variable.hasConstantStart = getConstant(variable.start,
+				*_definitions[start->id].front());
+		}
+
+		loop.inductionVariables.push_back(variable);
+	}
+
+	// Translator form: value = value + step, once in each iteration
+	typedef std::unordered_map<unsigned int, unsigned int> CountMap;
+
+	CountMap definitionsInLoop;
+
+	for(auto block : loop.blocks)
+	{
+		for(auto instruction : *block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(!write->isRegister()) continue;
+
+				++definitionsInLoop[static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister->id];
+			}
+		}
+	}
+
+	for(auto block : loop.blocks)
+	{
+		// updates in nested loops may run more than once per iteration
+		if(getLoop(*block) != &loop) continue;
+
+		bool dominatesLatches = true;
+
+		for(auto latch : loop.latches)
+		{
+			if(!dominators.dominates(*latch, *block)) dominatesLatches = false;
+		}
+
+		if(!dominatesLatches) continue;
+
+		for(auto instruction : *block)
+		{
+			if(instruction->writes.size() != 1) continue;
+
+			auto value = const_cast<VirtualRegister*>(
+				getRegister(instruction->writes.front()));
+
+			if(value == nullptr) continue;
+
+			if(definitionsInLoop[value->id] != 1) continue;
+
+			int64_t step = 0;
+
+			if(!getStep(step, *instruction, *value)) continue;
+
+			InductionVariable variable(value, instruction, step);
+
+			// the start is known if the only other definition runs
+			//  every time the loop is entered, including from enclosing
+			//  loops and irreducible cycles
+			auto& definitions = _definitions[value->id];
+
+			if(definitions.size() == 2)
+			{
+				auto initial = definitions.front() == instruction ?
+					definitions.back() : definitions.front();
+
+				bool runsOnEntry =
+					dominators.dominates(*loop.header, *initial->block) &&
+					onlyInitialReachesEntries(loop, *initial, *instruction,
+					cfg);
+
+				if(runsOnEntry)
+				{
+					variable.hasConstantStart = getConstant(variable.start,
+						*initial);
+				}
+			}
+
+			loop.inductionVariables.push_back(variable);
+		}
+	}
+}
+
+/*! \brief Compare two integers, the sign of a comparison is not recorded,
+	so relational comparisons only have a result if the signed and
+	unsigned comparisons agree */
+static bool compare(bool& result,
+	ir::ComparisonInstruction::Comparison comparison,
+	uint64_t a, uint64_t b, unsigned int bits)
+{
+	typedef ir::ComparisonInstruction ComparisonInstruction;
+
+	int64_t signedA = signExtend(a, bits);
+	int64_t signedB = signExtend(b, bits);
+
+	bool unsignedResult = false;
+	bool signedResult   = false;
+
+	switch(comparison)
+	{
+	case ComparisonInstruction::OrderedEqual:
+	case ComparisonInstruction::UnorderedEqual:
+	{
+		result = a == b;
+		return true;
+	}
+	case ComparisonInstruction::OrderedNotEqual:
+	case ComparisonInstruction::UnorderedNotEqual:
+	{
+		result = a != b;
+		return true;
+	}
+	case ComparisonInstruction::OrderedLessThan:
+	case ComparisonInstruction::UnorderedLessThan:
+	{
+		unsignedResult = a < b;
+		signedResult   = signedA < signedB;
+		break;
+	}
+	case ComparisonInstruction::OrderedLessOrEqual:
+	case ComparisonInstruction::UnorderedLessOrEqual:
+	{
+		unsignedResult = a <= b;
+		signedResult   = signedA <= signedB;
+		break;
+	}
+	case ComparisonInstruction::OrderedGreaterThan:
+	case ComparisonInstruction::UnorderedGreaterThan:
+	{
+		unsignedResult = a > b;
+		signedResult   = signedA > signedB;
+		break;
+	}
+	case ComparisonInstruction::OrderedGreaterOrEqual:
+	case ComparisonInstruction::UnorderedGreaterOrEqual:
+	{
+		unsignedResult = a >= b;
+		signedResult   = signedA >= signedB;
+		break;
+	}
+	default: return false;
+	}
+
+	if(unsignedResult != signedResult) return false;
+
+	result = unsignedResult;
+
+	return true;
+}
+
+void LoopAnalysis::_computeTripCount(Loop& loop)
+{
+	// only loops that exit from the bottom:
+	//  latch: p = setp iv, bound; @p bra header
+	if(loop.latches.size() != 1) return;
+
+	auto latch = loop.latches.front();
+
+	for(auto& exit : loop.exits)
+	{
+		if(exit.first != latch) return;
+	}
+
+	auto terminator = latch->terminator();
+
+	if(terminator == nullptr || terminator->opcode != ir::Instruction::Bra)
+	{
+		return;
+	}
+
+	auto branch = static_cast<ir::Bra*>(terminator);
+
+	if(!branch->target()->isBasicBlock())          return;
+	if(branch->targetBasicBlock() != loop.header) return;
+
+	auto guard = branch->guard();
+
+	if(guard->modifier != ir::PredicateOperand::StraightPredicate &&
+		guard->modifier != ir::PredicateOperand::InversePredicate)
+	{
+		return;
+	}
+
+	auto& predicateDefinitions = _definitions[guard->virtualRegister->id];
+
+	if(predicateDefinitions.size() != 1) return;
+
+	auto setp = predicateDefinitions.front();
+
+	if(setp->opcode != ir::Instruction::Setp) return;
+	if(setp->block != latch || !setp->guard()->isAlwaysTrue()) return;
+
+	auto& comparison = static_cast<const ir::ComparisonInstruction&>(*setp);
+
+	// find the side that is an induction variable
+	const InductionVariable* variable = nullptr;
+
+	bool isPostIncrement = false;
+	bool isSwapped       = false;
+
+	const ir::Operand* boundOperand = nullptr;
+
+	for(unsigned int side = 0; side < 2 && variable == nullptr; ++side)
+	{
+		auto operand = side == 0 ? comparison.a() : comparison.b();
+		auto other   = side == 0 ? comparison.b() : comparison.a();
+
+		auto value = getRegister(operand);
+
+		if(value == nullptr) continue;
+
+		for(auto& candidate : loop.inductionVariables)
+		{
+			if(!candidate.hasConstantStart) continue;
+
+			auto updated = getRegister(candidate.update->writes.front());
+
+			if(candidate.value == value)
+			{
+				// in the translator form, the update may come first
+				if(updated == value)
+				{
+					isPostIncrement = candidate.update->block != latch ||
+						candidate.update->index() < setp->index();
+				}
+			}
+			else if(updated == value)
+			{
+				isPostIncrement = true;
+			}
+			else
+			{
+				continue;
+			}
+
+			variable     = &candidate;
+			isSwapped    = side == 1;
+			boundOperand = other;
+
+			break;
+		}
+	}
+
+	if(variable == nullptr) return;
+
+	unsigned int bits = getBits(variable->value->type);
+
+	uint64_t bound = 0;
+
+	if(!getImmediate(bound, boundOperand))
+	{
+		auto boundValue = getRegister(boundOperand);
+
+		if(boundValue == nullptr) return;
+
+		auto& definitions = _definitions[boundValue->id];
+
+		if(definitions.size() != 1)                   return;
+		if(!getConstant(bound, *definitions.front())) return;
+	}
+
+	bound = truncate(bound, bits);
+
+	// run the exit test until it fails
+	uint64_t value = variable->start;
+
+	for(unsigned int trip = 1; trip <= MaxTripCount; ++trip)
+	{
+		uint64_t compared = truncate(isPostIncrement ?
+			value + variable->step : value, bits);
+
+		bool condition = false;
+
+		if(!compare(condition, comparison.comparison,
+			isSwapped ? bound : compared, isSwapped ? compared : bound, bits))
+		{
+			return;
+		}
+
+		if(guard->modifier == ir::PredicateOperand::InversePredicate)
+		{
+			condition = !condition;
+		}
+
+		if(!condition)
+		{
+			loop.tripCount = trip;
+			return;
+		}
+
+		value = truncate(value + variable->step, bits);
+	}
+}
+
+}
+
+}
+
@@ -0,0 +1,75 @@
+/*! \file   PostDominatorAnalysis.cpp
+	\author Gregory Diamos <gregory.diamos@gatech.edu>
+	\date   Friday October 16, 2026
+	\file   The source file for the PostDominatorAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/PostDominatorAnalysis.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+PostDominatorAnalysis::PostDominatorAnalysis()
+: FunctionAnalysis("PostDominatorAnalysis",
+	StringVector(1, "ControlFlowGraph"))
+{
+
+}
+
+bool PostDominatorAnalysis::postDominates(const BasicBlock& b,
+	const BasicBlock& potentialPostDominator) const
+{
+	return _tree.dominates(potentialPostDominator, b);
+}
+
+PostDominatorAnalysis::BasicBlock* PostDominatorAnalysis::getPostDominator(
+	const BasicBlock& b) const
+{
+	return _tree.getDominator(b);
+}
+
+const PostDominatorAnalysis::BasicBlockSet&
+	PostDominatorAnalysis::getPostDominatedBlocks(const BasicBlock& b) const
+{
+	return _tree.getDominatedBlocks(b);
+}
+
+const PostDominatorAnalysis::BasicBlockSet&
+	PostDominatorAnalysis::getPostDominanceFrontier(const BasicBlock& b)
+{
+	return _tree.getDominanceFrontier(b);
+}
+
+void PostDominatorAnalysis::analyze(Function& function)
+{
+	report("Running post-dominator analysis over function "
+		<< function.name());
+
+	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));
+
+	_tree.build(function, *cfg, DominatorTree::Reverse);
+}
+
+}
+
+}
+
@@ -0,0 +1,101 @@
+/*! \file   RegisterBitSet.cpp
+	\date   Tuesday October 13, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the RegisterBitSet class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/RegisterBitSet.h>
+
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+RegisterBitSet::RegisterBitSet(const VirtualRegisterVector* registers)
+: _registers(registers),
+  _bits(registers == nullptr ? 0 : registers->size())
+{
+
+}
+
+bool RegisterBitSet::contains(const VirtualRegister* value) const
+{
+	if(value->id >= _bits.universe()) return false;
+
+	return _bits.contains(value->id);
+}
+
+RegisterBitSet::size_type RegisterBitSet::count(
+	const VirtualRegister* value) const
+{
+	return contains(value) ? 1 : 0;
+}
+
+bool RegisterBitSet::insert(const VirtualRegister* value)
+{
+	if(value->id >= _bits.universe()) return false;
+
+	return _bits.insert(value->id);
+}
+
+RegisterBitSet::size_type RegisterBitSet::erase(const VirtualRegister* value)
+{
+	if(value->id >= _bits.universe()) return 0;
+
+	return _bits.erase(value->id) ? 1 : 0;
+}
+
+void RegisterBitSet::clear()
+{
+	_bits.clear();
+}
+
+RegisterBitSet::size_type RegisterBitSet::size() const
+{
+	return _bits.count();
+}
+
+bool RegisterBitSet::empty() const
+{
+	return _bits.empty();
+}
+
+RegisterBitSet::const_iterator RegisterBitSet::begin() const
+{
+	return const_iterator(_bits.begin(), _registers);
+}
+
+RegisterBitSet::const_iterator RegisterBitSet::end() const
+{
+	return const_iterator(_bits.end(), _registers);
+}
+
+RegisterBitSet::BitVector& RegisterBitSet::bits()
+{
+	return _bits;
+}
+
+const RegisterBitSet::BitVector& RegisterBitSet::bits() const
+{
+	return _bits;
+}
+
+bool RegisterBitSet::operator==(const RegisterBitSet& set) const
+{
+	return _bits == set._bits;
+}
+
+bool RegisterBitSet::operator!=(const RegisterBitSet& set) const
+{
+	return _bits != set._bits;
+}
+
+}
+
+}
+
+
@@ -16,8 +16,9 @@
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Include
-#include <stack>
 #include <algorithm>
+#include <cassert>
+#include <stack>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -42,7 +43,9 @@ ReversePostOrderTraversal::ReversePostOrderTraversal()
 void ReversePostOrderTraversal::analyze(Function& function)
 {
 	typedef util::LargeSet<BasicBlock*> BlockSet;
-	typedef std::stack<BasicBlock*>     BlockStack;
+	typedef ControlFlowGraph::BasicBlockSet BasicBlockSet;
+	typedef std::pair<BasicBlock*, BasicBlockSet> BlockAndSuccessors;
+	typedef std::stack<BlockAndSuccessors> BlockStack;
 
 	order.clear();
 	
@@ -55,73 +58,45 @@ void ReversePostOrderTraversal::analyze(Function& function)
 	report("Creating reverse post order traversal over function '" +
 		function.name() + "'");
 
-	// reverse post order is reversed topological order
-	stack.push(&*function.entry_block());
+	// reverse post order is a topological order (ignoring back edges), a
+	//  block is finished once all of its successors are finished
+	auto entry = &*function.entry_block();
+	
+	visited.insert(entry);
+	stack.push(BlockAndSuccessors(entry, cfg->getSuccessors(*entry)));
 	
-	while(order.size() != function.size())
+	while(!stack.empty())
 	{
-		if(stack.empty())
-		{
-			for(auto block : order)
-			{
-				auto successors = cfg->getSuccessors(*block);
-				
-				for(auto successor : successors)
-				{
-					if(visited.insert(successor).second)
-					{
-						stack.push(successor);
-						break;
-					}
-				}
-				
-				if(!stack.empty()) break;
-			}
-		}
-		
-		assertM(!stack.empty(), (function.size() - order.size())
-			<< " blocks are not connected.");
+		auto& top = stack.top();
 		
-		while(!stack.empty())
+		if(top.second.empty())
 		{
-			BasicBlock* top = stack.top();
+			order.push_back(top.first);
 			stack.pop();
+			continue;
+		}
 		
-			auto successors = cfg->getSuccessors(*top);
-			
-			for(auto successor : successors)
-			{
-				assert(successor != nullptr);
-				
-				auto predecessors = cfg->getPredecessors(*successor);
-				
-				bool allPredecessorsVisited = true;
+		auto successor = *top.second.begin();
+		top.second.erase(top.second.begin());
 		
-				for(auto predecessor : predecessors)
-				{
-					if(visited.count(predecessor) == 0)
-					{
-						allPredecessorsVisited = false;
-						break;
-					}
-				}
-				
-				if(!allPredecessorsVisited) continue;
-				
-				if(visited.insert(successor).second)
-				{
-					stack.push(successor);
-				}
-			}
-
-			order.push_back(top);
+		assert(successor != nullptr);
 		
-			report(" " << top->name());
+		if(visited.insert(successor).second)
+		{
+			stack.push(BlockAndSuccessors(successor,
+				cfg->getSuccessors(*successor)));
 		}
 	}
 	
-	// reverse the order
+	assertM(order.size() == function.size(), (function.size() - order.size())
+		<< " blocks are not connected.");
+
 	std::reverse(order.begin(), order.end());
+	
+	for(auto block : order)
+	{
+		report(" " << block->name());
+	}
 }
 
 }
@@ -8,9 +8,9 @@
 
 // Vanaheimr Includes
 #include <vanaheimr/analysis/interface/Analysis.h>
+#include <vanaheimr/analysis/interface/RegisterBitSet.h>
 
 #include <vanaheimr/util/interface/SmallSet.h>
-#include <vanaheimr/util/interface/LargeSet.h>
 
 // Forward Declarations
 namespace vanaheimr { namespace ir       { class VirtualRegister;  } }
@@ -24,7 +24,11 @@ namespace vanaheimr
 namespace analysis
 {
 
-/*! \brief A class for performing dataflow analysis */	
+/*! \brief A class for performing dataflow analysis.
+
+	Liveness (backward) and reaching definitions (forward) are both solved
+	over dense bit vectors with the priority worklist in DataflowSolver.
+*/
 class DataflowAnalysis : public FunctionAnalysis
 {
 public:
@@ -36,50 +40,107 @@ public:
 	typedef util::SmallSet<VirtualRegister*> VirtualRegisterSet;
 	typedef util::SmallSet<Instruction*>     InstructionSet;
 
+	typedef RegisterBitSet VirtualRegisterBitSet;
+
 
 public:
 	DataflowAnalysis();
 	
 public:
-	VirtualRegisterSet  getLiveIns(const BasicBlock&);
-	VirtualRegisterSet getLiveOuts(const BasicBlock&);
+	const VirtualRegisterBitSet&  getLiveIns(const BasicBlock&) const;
+	const VirtualRegisterBitSet& getLiveOuts(const BasicBlock&) const;
 
 public:
+	/*! \brief Definitions that reach the registers read by an instruction */
 	InstructionSet getReachingDefinitions(const Instruction&);
 	InstructionSet getReachedUses(const Instruction&);
 
 public:
-	void setLiveOuts(const BasicBlock&, const VirtualRegisterSet&);
+	void setLiveOuts(const BasicBlock&, const VirtualRegisterBitSet&);
 
 public:
 	void addReachingDefinition(VirtualRegister&, Instruction&);
 	
 public:
+	/*! \brief All definitions of a register, regardless of control flow */
 	InstructionSet getReachingDefinitions(const VirtualRegister&);
 	InstructionSet getReachedUses(const VirtualRegister&);
-	
+
+public:
+	/*! \brief Blocks visited by the solver before liveness converged */
+	size_t getLivenessIterations() const;
+	/*! \brief Blocks visited by the solver before reaching
+		definitions converged */
+	size_t getReachingDefinitionIterations() const;
+
 public:
 	virtual void analyze(Function& function);
 	
 private:
-	typedef std::vector<VirtualRegisterSet> VirtualRegisterSetVector;
-	typedef std::vector<InstructionSet>     InstructionSetVector;
-	typedef util::LargeSet<BasicBlock*>     BasicBlockSet;
-		
+	typedef std::vector<VirtualRegisterBitSet>    VirtualRegisterBitSetVector;
+	typedef std::vector<InstructionSet>           InstructionSetVector;
+	typedef RegisterBitSet::VirtualRegisterVector VirtualRegisterVector;
+	typedef std::vector<util::BitVector>          BitVectorVector;
+	typedef std::vector<unsigned int>             IndexVector;
+	typedef std::vector<IndexVector>              IndexVectorVector;
+
+	/*! \brief A single register write, the unit of reaching definitions */
+	class DefinitionSite
+	{
+	public:
+		DefinitionSite(Instruction* i, VirtualRegister* v)
+		: instruction(i), value(v)
+		{
+
+		}
+
+	public:
+		Instruction*     instruction;
+		VirtualRegister* value;
+	};
+
+	typedef std::vector<DefinitionSite> DefinitionSiteVector;
+
 private:
 	void _analyzeLiveInsAndOuts(Function& function);
 	void _analyzeReachingDefinitions(Function& function);
+	void _analyzeDefinitionAndUseSets(Function& function);
 
 private:
-	void _computeLocalLiveInsAndOuts(BasicBlockSet& worklist);
+	void _numberRegisters(Function& function);
+	void _numberDefinitionSites(Function& function);
+	void _computeLocalUsesAndDefinitions(BasicBlock* block);
+	void _computeLocalReachingDefinitions(BasicBlock* block);
 	bool _recomputeLiveInsAndOutsForBlock(BasicBlock* block);
+	bool _recomputeReachingDefinitionsForBlock(BasicBlock* block);
+
+private:
+	VirtualRegisterVector _registers; // indexed by VirtualRegister::id
+
+	VirtualRegisterBitSetVector _liveins;
+	VirtualRegisterBitSetVector _liveouts;
+
+	BitVectorVector _upwardExposedUses; // gen, per block
+	BitVectorVector _blockDefinitions;  // kill, per block
+
+private:
+	DefinitionSiteVector _definitionSites;
+	IndexVectorVector    _registerDefinitionSites; // indexed by register id
+	IndexVector          _firstDefinitionSite;     // indexed by block id
+
+	BitVectorVector _reachingDefinitionIns;
+	BitVectorVector _reachingDefinitionOuts;
+
+	BitVectorVector _generatedDefinitions; // gen, per block
+	BitVectorVector _killedDefinitions;    // kill, per block
 
 private:
-	VirtualRegisterSetVector _liveins;
-	VirtualRegisterSetVector _liveouts;
-	
 	InstructionSetVector _reachingDefinitions;
 	InstructionSetVector _reachedUses;
+
+private:
+	size_t _livenessIterations;
+	size_t _reachingDefinitionIterations;
 };
 
 }
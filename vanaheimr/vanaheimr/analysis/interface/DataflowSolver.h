@@ -0,0 +1,95 @@
+/*! \file   DataflowSolver.h
+	\date   Wednesday October 14, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the DataflowSolver class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/BitVector.h>
+
+// Standard Library Includes
+#include <functional>
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir       { class Function;                  } }
+namespace vanaheimr { namespace ir       { class BasicBlock;                } }
+namespace vanaheimr { namespace analysis { class ControlFlowGraph;          } }
+namespace vanaheimr { namespace analysis { class ReversePostOrderTraversal; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief A generic iterative solver for block-level dataflow problems.
+
+	Blocks are visited from a priority worklist: in reverse post order
+	for forward problems, and in post order for backward problems, so that
+	each block sees as many up-to-date inputs as possible.  A bit vector
+	keeps a block from being queued more than once.
+
+	The client supplies the transfer function, which recomputes the facts
+	for one block and returns true if its output changed.  The solver then
+	queues successors (forward) or predecessors (backward).
+*/
+class DataflowSolver
+{
+public:
+	enum Direction
+	{
+		Forward,
+		Backward
+	};
+
+public:
+	typedef ir::Function   Function;
+	typedef ir::BasicBlock BasicBlock;
+
+	typedef std::function<bool(BasicBlock*)> TransferFunction;
+
+public:
+	DataflowSolver(Direction direction, ControlFlowGraph* cfg,
+		const ReversePostOrderTraversal* traversal);
+
+public:
+	/*! \brief Apply the transfer function until a fixed point is reached */
+	void solve(Function& function, const TransferFunction& transfer);
+
+public:
+	/*! \brief The number of transfer function evaluations in the last solve */
+	size_t iterations() const;
+
+private:
+	typedef std::vector<BasicBlock*>  BasicBlockVector;
+	typedef std::vector<unsigned int> PriorityVector;
+
+private:
+	void _assignPriorities(Function& function);
+
+	void        _push(BasicBlock* block);
+	BasicBlock* _pop();
+
+private:
+	Direction _direction;
+
+	ControlFlowGraph*                _cfg;
+	const ReversePostOrderTraversal* _traversal;
+
+	PriorityVector   _priorities; // indexed by block id
+	BasicBlockVector _blocks;     // indexed by priority
+
+	util::BitVector _worklist;    // indexed by priority
+
+	size_t _iterations;
+
+};
+
+}
+
+}
+
+
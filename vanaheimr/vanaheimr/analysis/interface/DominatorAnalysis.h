@@ -8,6 +8,7 @@
 
 // Vanaheimr Includes
 #include <vanaheimr/analysis/interface/Analysis.h>
+#include <vanaheimr/analysis/interface/DominatorTree.h>
 
 #include <vanaheimr/util/interface/SmallSet.h>
 
@@ -20,13 +21,7 @@ namespace vanaheimr
 namespace analysis
 {
 
-/*! \brief Dominator analysis using the algorithm described in:
-
-	"A simple and fast dominance algorithm" by 
-		Keith D. Cooper, Timothy J. Harvey, and Ken Kennedy
-		
-	Simple extensions for parallelism.
- */
+/*! \brief Dominator analysis, see DominatorTree for the algorithm */
 class DominatorAnalysis : public FunctionAnalysis
 {
 public:
@@ -38,13 +33,14 @@ public:
 
 public:
 	/*! \brief Is a block dominated by another? */
-	bool dominates(const BasicBlock& b, const BasicBlock& potentialDominator);
+	bool dominates(const BasicBlock& b,
+		const BasicBlock& potentialDominator) const;
 
 	/*! \brief Find the immediate dominator of a given block */
-	BasicBlock* getDominator(const BasicBlock& b);
+	BasicBlock* getDominator(const BasicBlock& b) const;
 	
 	/*! \brief Get the set of blocks immediately dominated by this block */
-	const BasicBlockSet& getDominatedBlocks(const BasicBlock& b);
+	const BasicBlockSet& getDominatedBlocks(const BasicBlock& b) const;
 
 	/*! \brief Get the set of blocks in the dominance frontier of
 		a specified block */
@@ -54,18 +50,7 @@ public:
 	virtual void analyze(Function& function);
 
 private:
-	void _determineImmediateDominators(Function& function);
-	void _determineDominatedSets(Function& function);
-	void _determineDominanceFrontiers(Function& function);
-
-private:
-	typedef std::vector<BasicBlock*>   BasicBlockVector;
-	typedef std::vector<BasicBlockSet> BasicBlockSetVector;
-	
-private:
-	BasicBlockVector    _immediateDominators;
-	BasicBlockSetVector _dominatedBlocks;
-	BasicBlockSetVector _dominanceFrontiers;
+	DominatorTree _tree;
 
 };
 
@@ -0,0 +1,112 @@
+/*! \file   DominatorTree.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the DominatorTree class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir       { class BasicBlock;       } }
+namespace vanaheimr { namespace ir       { class Function;         } }
+namespace vanaheimr { namespace analysis { class ControlFlowGraph; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief A dominator tree over the blocks of a function, built with the
+	Semi-NCA algorithm described in:
+
+	"Finding Dominators in Practice" by
+		Loukas Georgiadis, Renato F. Werneck, Robert E. Tarjan,
+		Spyridon Triantafyllis, and David I. August
+
+	The tree may be built over the CFG (dominators) or over the reversed
+	CFG (post-dominators).  Dominance queries are constant time using
+	preorder/postorder numbers of the tree.  Dominance frontiers are
+	only computed when they are first requested.
+
+	Blocks that are not reachable from the root have no dominator.
+*/
+class DominatorTree
+{
+public:
+	typedef ir::BasicBlock              BasicBlock;
+	typedef ir::Function                Function;
+	typedef util::SmallSet<BasicBlock*> BasicBlockSet;
+
+	enum Direction
+	{
+		Forward, // rooted at the entry block, following successors
+		Reverse  // rooted at the exit block, following predecessors
+	};
+
+public:
+	DominatorTree();
+
+public:
+	/*! \brief Build the tree for a function */
+	void build(Function& function, ControlFlowGraph& cfg,
+		Direction direction);
+
+public:
+	/*! \brief Does one block dominate another (blocks dominate themselves) */
+	bool dominates(const BasicBlock& dominator, const BasicBlock& b) const;
+
+	/*! \brief Is there a path from the root to the block? */
+	bool isReachable(const BasicBlock& b) const;
+
+	/*! \brief Find the immediate dominator of a block, the root is its
+		own dominator */
+	BasicBlock* getDominator(const BasicBlock& b) const;
+
+	/*! \brief Get the children of a block in the tree */
+	const BasicBlockSet& getDominatedBlocks(const BasicBlock& b) const;
+
+	/*! \brief Get the dominance frontier of a block */
+	const BasicBlockSet& getDominanceFrontier(const BasicBlock& b);
+
+private:
+	void _computeTreeNumbers();
+	void _computeDominanceFrontiers();
+
+private:
+	typedef std::vector<unsigned int>  IntVector;
+	typedef std::vector<IntVector>     IntVectorVector;
+	typedef std::vector<BasicBlock*>   BasicBlockVector;
+	typedef std::vector<BasicBlockSet> BasicBlockSetVector;
+
+private:
+	static const unsigned int InvalidId = (unsigned int)-1;
+
+private:
+	BasicBlockVector _blocks;
+
+	// Indexed by block id
+	IntVector _immediateDominators;
+	IntVector _preorder;
+	IntVector _postorder;
+
+	// Edges into each block, following the direction of the tree
+	IntVectorVector _predecessors;
+	IntVectorVector _children;
+
+	BasicBlockSetVector _dominatedBlocks;
+	BasicBlockSetVector _dominanceFrontiers;
+	bool                _hasDominanceFrontiers;
+
+};
+
+}
+
+}
+
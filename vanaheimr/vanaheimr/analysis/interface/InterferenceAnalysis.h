@@ -9,7 +9,10 @@
 // Vanaheimr Includes
 #include <vanaheimr/analysis/interface/Analysis.h>
 
-#include <vanaheimr/util/interface/SmallSet.h>
+#include <vanaheimr/util/interface/BitVector.h>
+
+// Standard Library Includes
+#include <vector>
 
 // Forward Declarations
 namespace vanaheimr { namespace ir { class VirtualRegister;  } }
@@ -20,24 +23,57 @@ namespace vanaheimr
 namespace analysis
 {
 
-/*! \brief A class for performing interference analysis */	
+/*! \brief A class for performing interference analysis
+
+	Values are identified by virtual register id.  The graph is stored
+	twice: as a triangular bit-matrix for constant time queries, and as
+	compact adjacency arrays for walking the neighbors of a value.
+*/
 class InterferenceAnalysis : public FunctionAnalysis
 {
 public:
 	typedef ir::VirtualRegister VirtualRegister;
 
-	typedef util::SmallSet<VirtualRegister*> VirtualRegisterSet;
+	typedef unsigned int              RegisterId;
+	typedef std::vector<RegisterId>   RegisterIdVector;
+
+	/*! \brief The ids of the values that interfere with one value */
+	class InterferenceList
+	{
+	public:
+		typedef const RegisterId* const_iterator;
+
+	public:
+		InterferenceList(const_iterator begin, const_iterator end)
+		: _begin(begin), _end(end)
+		{
+
+		}
+
+	public:
+		const_iterator begin() const { return _begin; }
+		const_iterator   end() const { return _end;   }
+
+	public:
+		size_t size()  const { return _end - _begin;  }
+		bool   empty() const { return _end == _begin; }
+
+	private:
+		const_iterator _begin;
+		const_iterator _end;
+	};
 
 public:
 	InterferenceAnalysis();
-	
+
 public:
 	bool doLiveRangesInterfere(const VirtualRegister&,
 		const VirtualRegister&) const;
+	bool doLiveRangesInterfere(RegisterId, RegisterId) const;
 
 public:
-	VirtualRegisterSet&       getInterferences(const VirtualRegister&);
-	const VirtualRegisterSet& getInterferences(const VirtualRegister&) const;	
+	InterferenceList getInterferences(const VirtualRegister&) const;
+	InterferenceList getInterferences(RegisterId) const;
 
 public:
 	virtual void analyze(Function& function);
@@ -45,12 +81,21 @@ public:
 public:
 	InterferenceAnalysis(const InterferenceAnalysis& ) = delete;
 	InterferenceAnalysis& operator=(const InterferenceAnalysis& ) = delete;
-	
+
+private:
+	typedef std::pair<RegisterId, RegisterId> RegisterIdPair;
+	typedef std::vector<RegisterIdPair>       RegisterIdPairVector;
+
 private:
-	typedef std::vector<VirtualRegisterSet> VirtualRegisterSetVector;
+	void _buildAdjacency(const RegisterIdPairVector& edges, size_t values);
 
 private:
-	VirtualRegisterSetVector _interferences;
+	/*! \brief The lower triangle of the interference matrix */
+	util::BitVector _matrix;
+
+	/*! \brief Neighbors of value i are in [offsets[i], offsets[i + 1]) */
+	RegisterIdVector _adjacencyOffsets;
+	RegisterIdVector _adjacency;
 
 };
 
@@ -58,6 +103,3 @@ private:
 
 }
 
-
-
-
@@ -11,6 +11,10 @@
 
 #include <vanaheimr/util/interface/SmallSet.h>
 
+// Standard Library Includes
+#include <unordered_map>
+#include <vector>
+
 // Forward Declarations
 namespace vanaheimr { namespace ir { class VirtualRegister;  } }
 namespace vanaheimr { namespace ir { class Instruction;      } }
@@ -22,7 +26,14 @@ namespace vanaheimr
 namespace analysis
 {
 
-/*! \brief A class for performing live range analysis */	
+/*! \brief A class for performing live range analysis
+
+	Instructions are numbered linearly in block layout order.  Each
+	instruction has two positions, its reads happen at the first and its
+	writes at the second, so a value that dies at an instruction does not
+	overlap the value that the instruction defines.  A live range is the
+	sorted list of position intervals where its value is live.
+*/
 class LiveRangeAnalysis : public FunctionAnalysis
 {
 public:
@@ -33,6 +44,25 @@ public:
 	typedef util::SmallSet<Instruction*> InstructionSet;
 	typedef util::SmallSet<BasicBlock*>  BasicBlockSet;
 
+	/*! \brief A half-open range of positions, [start, end) */
+	class Interval
+	{
+	public:
+		Interval(unsigned int start = 0, unsigned int end = 0);
+
+	public:
+		bool empty() const;
+
+		/*! \brief Do the intervals share a position? */
+		bool overlaps(const Interval& interval) const;
+
+	public:
+		unsigned int start;
+		unsigned int end;
+	};
+
+	typedef std::vector<Interval> IntervalVector;
+
 	class LiveRange
 	{
 	public:
@@ -49,6 +79,13 @@ public:
 		/* \brief Do live ranges interfere? */
 		bool interferesWith(const LiveRange& range) const;
 
+		/*! \brief Is the value live at a position? */
+		bool covers(unsigned int position) const;
+
+	public:
+		/*! \brief Sorted, disjoint, and non-adjacent intervals */
+		IntervalVector intervals;
+
 	public:
 		BasicBlockSet fullyCoveredBlocks;
 
@@ -61,6 +98,8 @@ public:
 		VirtualRegister*   _virtualRegister;
 	};
 
+	/*! \brief Indexed by register id, ids without a register hold an
+		empty range with a null virtual register */
 	typedef std::vector<LiveRange> LiveRangeVector;
 
 	typedef LiveRangeVector::iterator       iterator;
@@ -73,6 +112,14 @@ public:
 	const LiveRange* getLiveRange(const VirtualRegister&) const;
 	      LiveRange* getLiveRange(const VirtualRegister&);
 	
+public:
+	/*! \brief The positions of a block are [start, end) */
+	unsigned int getBlockStart(const BasicBlock&) const;
+	unsigned int   getBlockEnd(const BasicBlock&) const;
+
+	unsigned int  getReadPosition(const Instruction&) const;
+	unsigned int getWritePosition(const Instruction&) const;
+
 public:
 	virtual void analyze(Function& function);
 
@@ -93,10 +140,22 @@ public:
 
 private:
 	void _initializeLiveRanges(ir::Function& );
+	void _numberInstructions(ir::Function& );
+	void _computeIntervals(ir::Function& );
+
+private:
+	typedef std::vector<unsigned int> PositionVector;
+	typedef std::unordered_map<const Instruction*, unsigned int>
+		InstructionPositionMap;
 
 private:
 	LiveRangeVector _liveRanges;
 
+private:
+	PositionVector         _blockStarts;
+	PositionVector         _blockEnds;
+	InstructionPositionMap _instructionPositions;
+
 };
 
 typedef LiveRangeAnalysis::LiveRange LiveRange;
@@ -1 +1,183 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   LoopAnalysis.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the LoopAnalysis class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/Analysis.h>
+
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Standard Library Includes
+#include <list>
+#include <vector>
+#include <cstdint>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class VirtualRegister; } }
+namespace vanaheimr { namespace ir { class Instruction;     } }
+namespace vanaheimr { namespace ir { class BasicBlock;      } }
+
+namespace vanaheimr { namespace analysis { class DominatorAnalysis; } }
+namespace vanaheimr { namespace analysis { class ControlFlowGraph;  } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Finds the natural loops of a function and arranges them in a
+	forest by nesting.
+
+	A back edge is an edge whose tail dominates its head, the loop of a
+	header is every block that reaches one of its back edges without
+	passing through the header.  Induction variables are found in both
+	SSA form (a phi in the header) and in the form produced by the
+	translator (a register that is updated once per iteration).
+*/
+class LoopAnalysis : public FunctionAnalysis
+{
+public:
+	typedef      ir::BasicBlock BasicBlock;
+	typedef     ir::Instruction Instruction;
+	typedef ir::VirtualRegister VirtualRegister;
+
+	typedef std::vector<BasicBlock*>            BasicBlockVector;
+	typedef util::SmallSet<BasicBlock*>         BasicBlockSet;
+	typedef std::pair<BasicBlock*, BasicBlock*> Edge;
+	typedef std::vector<Edge>                   EdgeVector;
+
+	class Loop;
+
+	typedef std::vector<Loop*> LoopVector;
+
+	/*! \brief A value that changes by a constant step in each iteration */
+	class InductionVariable
+	{
+	public:
+		InductionVariable(VirtualRegister* value = nullptr,
+			Instruction* update = nullptr, int64_t step = 0);
+
+	public:
+		/*! \brief The value at the start of an iteration */
+		VirtualRegister* value;
+		/*! \brief The instruction that adds the step */
+		Instruction* update;
+
+		int64_t step;
+
+	public:
+		/*! \brief Is the value on entry to the loop a known constant? */
+		bool     hasConstantStart;
+		uint64_t start;
+	};
+
+	typedef std::vector<InductionVariable> InductionVariableVector;
+
+	class Loop
+	{
+	public:
+		explicit Loop(BasicBlock* header = nullptr);
+
+	public:
+		bool contains(const BasicBlock& block) const;
+		bool isInnermost() const;
+
+	public:
+		const InductionVariable* getInductionVariable(
+			const VirtualRegister& value) const;
+
+	public:
+		BasicBlock* header;
+
+		/*! \brief The blocks with a back edge to the header */
+		BasicBlockVector latches;
+		/*! \brief All blocks in the loop, including nested loops */
+		BasicBlockSet blocks;
+		/*! \brief Edges from a block in the loop to a block outside */
+		EdgeVector exits;
+
+	public:
+		Loop*      parent;
+		LoopVector children;
+
+		/*! \brief 1 for outermost loops */
+		unsigned int depth;
+
+	public:
+		InductionVariableVector inductionVariables;
+
+		/*! \brief The number of times the header executes each time
+			the loop is entered, 0 if it is not known */
+		unsigned int tripCount;
+	};
+
+	typedef std::list<Loop> LoopList;
+
+	typedef LoopList::iterator       iterator;
+	typedef LoopList::const_iterator const_iterator;
+
+public:
+	LoopAnalysis();
+
+public:
+	/*! \brief Get the innermost loop containing a block, or nullptr */
+	Loop* getLoop(const BasicBlock& block) const;
+
+	/*! \brief The number of loops containing a block */
+	unsigned int getLoopDepth(const BasicBlock& block) const;
+
+	/*! \brief Get the loops that are not nested in other loops */
+	const LoopVector& getTopLevelLoops() const;
+
+public:
+	virtual void analyze(Function& function);
+
+public:
+	LoopAnalysis(const LoopAnalysis& ) = delete;
+	LoopAnalysis& operator=(const LoopAnalysis& ) = delete;
+
+public:
+	      iterator begin();
+	const_iterator begin() const;
+
+	      iterator end();
+	const_iterator end() const;
+
+public:
+	bool   empty() const;
+	size_t  size() const;
+
+private:
+	void _findLoops(Function& function, ControlFlowGraph& cfg,
+		const DominatorAnalysis& dominators);
+	void _buildForest();
+
+	void _findInductionVariables(Loop& loop, ControlFlowGraph& cfg,
+		const DominatorAnalysis& dominators);
+	void _computeTripCount(Loop& loop);
+
+private:
+	typedef std::vector<Instruction*>      InstructionVector;
+	typedef std::vector<InstructionVector> InstructionVectorVector;
+
+private:
+	LoopList   _loops;
+	LoopVector _topLevelLoops;
+
+	/*! \brief The innermost loop containing each block, by id */
+	LoopVector _innermostLoops;
+
+	/*! \brief The instructions that write each value, by id */
+	InstructionVectorVector _definitions;
+
+};
+
+}
+
+}
+
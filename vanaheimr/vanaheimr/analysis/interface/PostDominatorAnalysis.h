@@ -7,7 +7,13 @@
 #pragma once
 
 // Vanaheimr Includes
-#include <vanaheimr/analysis/includes/Analysis.h>
+#include <vanaheimr/analysis/interface/Analysis.h>
+#include <vanaheimr/analysis/interface/DominatorTree.h>
+
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Forward Declaration
+namespace vanaheimr { namespace ir { class BasicBlock; } }
 
 namespace vanaheimr
 {
@@ -15,25 +21,38 @@ namespace vanaheimr
 namespace analysis
 {
 
+/*! \brief Post-dominator analysis, the dominator tree of the reversed CFG
+	rooted at the exit block */
 class PostDominatorAnalysis : public FunctionAnalysis
 {
 public:
+	typedef              ir::BasicBlock BasicBlock;
 	typedef util::SmallSet<BasicBlock*> BasicBlockSet;
-	
+
+public:
+	PostDominatorAnalysis();
+
 public:
 	/*! \brief Is a block post-dominated by another? */
 	bool postDominates(const BasicBlock& b,
-		const BasicBlock& potentialPostDominator);
+		const BasicBlock& potentialPostDominator) const;
 
 	/*! \brief Find the immediate post dominator of a given block */
-	BasicBlock* getPostDominator(const BasicBlock& b);
+	BasicBlock* getPostDominator(const BasicBlock& b) const;
 	
 	/*! \brief Get the set of blocks immediately post-dominated by this block */
-	BlockSet getPostDominatedBlocks(const BasicBlock& b);
+	const BasicBlockSet& getPostDominatedBlocks(const BasicBlock& b) const;
+
+	/*! \brief Get the set of blocks in the post-dominance frontier of
+		a specified block */
+	const BasicBlockSet& getPostDominanceFrontier(const BasicBlock& b);
 	
 public:
 	virtual void analyze(Function& function);
 
+private:
+	DominatorTree _tree;
+
 };
 
 }
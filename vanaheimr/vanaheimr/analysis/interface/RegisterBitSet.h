@@ -0,0 +1,129 @@
+/*! \file   RegisterBitSet.h
+	\date   Tuesday October 13, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the RegisterBitSet class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/BitVector.h>
+
+// Standard Library Includes
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class VirtualRegister; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief A set of virtual registers stored as a dense bit vector indexed
+	by VirtualRegister::id.
+
+	All sets built over the same register table share a universe, so
+	they can be combined with word-wide bit operations.
+*/
+class RegisterBitSet
+{
+public:
+	typedef ir::VirtualRegister           VirtualRegister;
+	typedef std::vector<VirtualRegister*> VirtualRegisterVector;
+	typedef util::BitVector               BitVector;
+	typedef BitVector::size_type          size_type;
+
+public:
+	/*! \brief Visits the registers in the set in id order */
+	class const_iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef VirtualRegister*          value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef VirtualRegister* const*   pointer;
+		typedef VirtualRegister*          reference;
+
+	public:
+		const_iterator(BitVector::const_iterator bit,
+			const VirtualRegisterVector* registers)
+		: _bit(bit), _registers(registers)
+		{
+
+		}
+
+	public:
+		VirtualRegister* operator*() const
+		{
+			return (*_registers)[*_bit];
+		}
+
+		const_iterator& operator++()
+		{
+			++_bit;
+
+			return *this;
+		}
+
+		bool operator==(const const_iterator& i) const
+		{
+			return _bit == i._bit;
+		}
+
+		bool operator!=(const const_iterator& i) const
+		{
+			return _bit != i._bit;
+		}
+
+	private:
+		BitVector::const_iterator    _bit;
+		const VirtualRegisterVector* _registers;
+	};
+
+public:
+	/*! \brief Create an empty set over a register table (indexed by id) */
+	explicit RegisterBitSet(const VirtualRegisterVector* registers = nullptr);
+
+public:
+	/*! \brief Registers created after the table, with ids outside the
+		universe, are never members, inserting them returns false */
+	bool      contains(const VirtualRegister*) const;
+	size_type    count(const VirtualRegister*) const;
+
+	bool      insert(const VirtualRegister*);
+	size_type  erase(const VirtualRegister*);
+
+	void clear();
+
+public:
+	size_type size()  const;
+	bool      empty() const;
+
+public:
+	const_iterator begin() const;
+	const_iterator end()   const;
+
+public:
+	/*! \brief Direct access to the underlying bits for bulk operations */
+	      BitVector& bits();
+	const BitVector& bits() const;
+
+public:
+	bool operator==(const RegisterBitSet&) const;
+	bool operator!=(const RegisterBitSet&) const;
+
+private:
+	const VirtualRegisterVector* _registers;
+	BitVector                    _bits;
+
+};
+
+}
+
+}
+
+
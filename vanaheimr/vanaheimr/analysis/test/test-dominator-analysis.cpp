@@ -0,0 +1,227 @@
+/*! \file   test-dominator-analysis.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for the dominator and post-dominator trees.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/DominatorAnalysis.h>
+#include <vanaheimr/analysis/interface/PostDominatorAnalysis.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <string>
+
+namespace test
+{
+
+typedef vanaheimr::analysis::DominatorAnalysis     DominatorAnalysis;
+typedef vanaheimr::analysis::PostDominatorAnalysis PostDominatorAnalysis;
+
+typedef DominatorAnalysis::BasicBlockSet BasicBlockSet;
+
+/*! \brief Create a diamond followed by a loop
+
+	entry -> A, A -> B | C, B -> D, C -> D, D -> E, E -> D | F, F -> exit
+*/
+static BasicBlockMap generateFunction(Module& module)
+{
+	auto test = newTestFunction(module, "diamond-and-loop");
+
+	newValues(test, "i1", {"predicate"});
+	newBlocks(test, {"A", "B", "C", "D", "E", "F"});
+
+	auto& blocks = test.blocks;
+
+	blocks["entry"] = &*test.function->entry_block();
+	blocks["exit"]  = &*test.function->exit_block();
+
+	auto predicate = test.values["predicate"];
+
+	// blocks fall through to the next one in layout order
+	branch(blocks["A"], blocks["C"], predicate);
+	branch(blocks["B"], blocks["D"]);
+	branch(blocks["E"], blocks["D"], predicate);
+
+	return blocks;
+}
+
+static bool isSet(const BasicBlockSet& set, const BasicBlockMap& blocks,
+	std::initializer_list<const char*> names)
+{
+	if(set.size() != names.size()) return false;
+
+	for(auto name : names)
+	{
+		if(set.count(blocks.find(name)->second) == 0) return false;
+	}
+
+	return true;
+}
+
+/*! \brief Checks both trees of the function built by generateFunction */
+class DominatorTestPass : public CheckPass
+{
+public:
+	DominatorTestPass(const BasicBlockMap& b)
+	: CheckPass({"DominatorAnalysis", "PostDominatorAnalysis"},
+		"DominatorTestPass"), blocks(b)
+	{
+
+	}
+
+public:
+	void runOnFunction(const Function& function)
+	{
+		auto dominators = static_cast<DominatorAnalysis*>(
+			getAnalysis("DominatorAnalysis"));
+		auto postDominators = static_cast<PostDominatorAnalysis*>(
+			getAnalysis("PostDominatorAnalysis"));
+
+		_checkDominator(*dominators, "A", "entry");
+		_checkDominator(*dominators, "B", "A");
+		_checkDominator(*dominators, "C", "A");
+		_checkDominator(*dominators, "D", "A");
+		_checkDominator(*dominators, "E", "D");
+		_checkDominator(*dominators, "F", "E");
+		_checkDominator(*dominators, "exit", "F");
+
+		_check(dominators->dominates(*_block("F"), *_block("A")),
+			"A dominates F");
+		_check(!dominators->dominates(*_block("D"), *_block("B")),
+			"B does not dominate D");
+
+		_check(isSet(dominators->getDominatedBlocks(*_block("A")), blocks,
+			{"B", "C", "D"}), "A immediately dominates B, C and D");
+
+		_checkFrontier(dominators->getDominanceFrontier(*_block("A")), "A",
+			{});
+		_checkFrontier(dominators->getDominanceFrontier(*_block("B")), "B",
+			{"D"});
+		_checkFrontier(dominators->getDominanceFrontier(*_block("C")), "C",
+			{"D"});
+		_checkFrontier(dominators->getDominanceFrontier(*_block("D")), "D",
+			{"D"});
+		_checkFrontier(dominators->getDominanceFrontier(*_block("E")), "E",
+			{"D"});
+
+		_checkPostDominator(*postDominators, "entry", "A");
+		_checkPostDominator(*postDominators, "A", "D");
+		_checkPostDominator(*postDominators, "B", "D");
+		_checkPostDominator(*postDominators, "C", "D");
+		_checkPostDominator(*postDominators, "D", "E");
+		_checkPostDominator(*postDominators, "E", "F");
+		_checkPostDominator(*postDominators, "F", "exit");
+
+		_check(postDominators->postDominates(*_block("A"), *_block("F")),
+			"F post-dominates A");
+		_check(!postDominators->postDominates(*_block("A"), *_block("B")),
+			"B does not post-dominate A");
+
+		_checkFrontier(postDominators->getPostDominanceFrontier(
+			*_block("B")), "B (post)", {"A"});
+		_checkFrontier(postDominators->getPostDominanceFrontier(
+			*_block("D")), "D (post)", {"E"});
+		_checkFrontier(postDominators->getPostDominanceFrontier(
+			*_block("E")), "E (post)", {"E"});
+		_checkFrontier(postDominators->getPostDominanceFrontier(
+			*_block("F")), "F (post)", {});
+	}
+
+	vanaheimr::transforms::Pass* clone() const
+	{
+		return new DominatorTestPass(blocks);
+	}
+
+public:
+	BasicBlockMap blocks;
+
+private:
+	BasicBlock* _block(const std::string& name) const
+	{
+		return blocks.find(name)->second;
+	}
+
+	void _checkDominator(const DominatorAnalysis& dominators,
+		const std::string& block, const std::string& dominator)
+	{
+		_check(dominators.getDominator(*_block(block)) == _block(dominator),
+			"the immediate dominator of " + block + " is " + dominator);
+	}
+
+	void _checkPostDominator(const PostDominatorAnalysis& postDominators,
+		const std::string& block, const std::string& postDominator)
+	{
+		_check(postDominators.getPostDominator(*_block(block)) ==
+			_block(postDominator), "the immediate post-dominator of " +
+			block + " is " + postDominator);
+	}
+
+	void _checkFrontier(const BasicBlockSet& frontier,
+		const std::string& block, std::initializer_list<const char*> names)
+	{
+		std::string expected;
+
+		for(auto name : names)
+		{
+			if(!expected.empty()) expected += ", ";
+
+			expected += name;
+		}
+
+		_check(isSet(frontier, blocks, names), "the frontier of " + block +
+			" is {" + expected + "}");
+	}
+};
+
+static bool testDominatorAnalysis()
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-dominator-analysis");
+
+	auto blocks = generateFunction(*module);
+
+	bool passed = runCheckPass(*module, new DominatorTestPass(blocks));
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program builds the dominator and post-dominator "
+		"trees of a diamond followed by a loop and checks them.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testDominatorAnalysis())
+	{
+		std::cout << "Dominator analysis test Failed\n";
+		return -1;
+	}
+
+	std::cout << "Dominator analysis test Passed\n";
+
+	return 0;
+}
+
@@ -0,0 +1,193 @@
+/*! \file   test-interference-analysis.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for the interference graph bit-matrix and adjacency lists.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/InterferenceAnalysis.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+
+namespace test
+{
+
+typedef vanaheimr::analysis::InterferenceAnalysis InterferenceAnalysis;
+
+typedef std::pair<std::string, std::string> NamePair;
+typedef std::set<NamePair>                  NamePairSet;
+
+/*! \brief Three blocks that fall through, with values live across them
+
+	A: x = 1 + 1; p = 2 + 2; q = p + 1
+	B: y = 3 + 3; w = y + 1
+	C: r = x + q; s = r + w; t = 5 + 5; u = t + s
+*/
+static VirtualRegisterMap generateFunction(Module& module)
+{
+	auto test = newTestFunction(module, "three-blocks");
+
+	newValues(test, "i32", {"x", "p", "q", "y", "w", "r", "s", "t", "u"});
+	newBlocks(test, {"A", "B", "C"});
+
+	auto& values = test.values;
+	auto& blocks = test.blocks;
+
+	add(blocks["A"], values, "x", "1", "1");
+	add(blocks["A"], values, "p", "2", "2");
+	add(blocks["A"], values, "q", "p", "1");
+
+	add(blocks["B"], values, "y", "3", "3");
+	add(blocks["B"], values, "w", "y", "1");
+
+	add(blocks["C"], values, "r", "x", "q");
+	add(blocks["C"], values, "s", "r", "w");
+	add(blocks["C"], values, "t", "5", "5");
+	add(blocks["C"], values, "u", "t", "s");
+
+	return values;
+}
+
+/*! \brief Checks the graph against the pairs that are live together */
+class InterferenceTestPass : public CheckPass
+{
+public:
+	InterferenceTestPass(const VirtualRegisterMap& v,
+		const NamePairSet& e)
+	: CheckPass({"InterferenceAnalysis"}, "InterferenceTestPass"),
+		values(v), expected(e)
+	{
+
+	}
+
+public:
+	void runOnFunction(const Function& function)
+	{
+		auto interferences = static_cast<InterferenceAnalysis*>(
+			getAnalysis("InterferenceAnalysis"));
+
+		for(auto& one : values)
+		{
+			std::set<std::string> neighbors;
+
+			for(auto& two : values)
+			{
+				bool interferes = interferences->doLiveRangesInterfere(
+					*one.second, *two.second);
+
+				bool shouldInterfere =
+					expected.count(NamePair(one.first, two.first)) != 0 ||
+					expected.count(NamePair(two.first, one.first)) != 0;
+
+				if(interferes != shouldInterfere)
+				{
+					std::cout << " " << one.first << " and " << two.first
+						<< (interferes ? " interfere" : " do not interfere")
+						<< "\n";
+					passed = false;
+				}
+
+				if(interferes) neighbors.insert(two.first);
+			}
+
+			std::multiset<std::string> adjacent;
+
+			for(auto id : interferences->getInterferences(*one.second))
+			{
+				adjacent.insert(_name(id));
+			}
+
+			if(adjacent != std::multiset<std::string>(neighbors.begin(),
+				neighbors.end()))
+			{
+				std::cout << " the interference list of " << one.first
+					<< " does not match the matrix\n";
+				passed = false;
+			}
+		}
+	}
+
+	vanaheimr::transforms::Pass* clone() const
+	{
+		return new InterferenceTestPass(values, expected);
+	}
+
+public:
+	VirtualRegisterMap values;
+	NamePairSet        expected;
+
+private:
+	std::string _name(unsigned int id) const
+	{
+		for(auto& value : values)
+		{
+			if(value.second->id == id) return value.first;
+		}
+
+		return "unknown";
+	}
+};
+
+static bool testInterferenceAnalysis()
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-interference-analysis");
+
+	auto values = generateFunction(*module);
+
+	// a value that dies at an instruction does not interfere with the
+	//  value it defines
+	NamePairSet expected = {
+		NamePair("x", "p"), NamePair("x", "q"), NamePair("x", "y"),
+		NamePair("x", "w"), NamePair("q", "y"), NamePair("q", "w"),
+		NamePair("w", "r"), NamePair("s", "t")};
+
+	bool passed = runCheckPass(*module,
+		new InterferenceTestPass(values, expected));
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program builds the interference graph of a "
+		"function with values live across blocks and checks it.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testInterferenceAnalysis())
+	{
+		std::cout << "Interference analysis test Failed\n";
+		return -1;
+	}
+
+	std::cout << "Interference analysis test Passed\n";
+
+	return 0;
+}
+
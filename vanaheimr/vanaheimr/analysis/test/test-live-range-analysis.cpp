@@ -0,0 +1,234 @@
+/*! \file   test-live-range-analysis.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for live ranges as intervals over numbered instructions.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/LiveRangeAnalysis.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace test
+{
+
+typedef vanaheimr::analysis::LiveRangeAnalysis LiveRangeAnalysis;
+
+typedef LiveRangeAnalysis::Interval       Interval;
+typedef LiveRangeAnalysis::IntervalVector IntervalVector;
+
+/*! \brief A branch around a use, followed by a loop
+
+	Each instruction takes two positions, offsets from the start of A:
+
+	A:  0 v = 1 + 1;  2 k = 2 + 2;  4 i = 0 + 0;  6 p = i < k;  8 bra p, C
+	B: 10 w = 3 + 3; 12 bra E
+	C: 14 y = v + 1
+	E: 16 i = i + 1; 18 p = i < k; 20 bra p, E
+	F: 22 z = k + i
+*/
+static TestFunction generateFunction(Module& module)
+{
+	auto test = newTestFunction(module, "branch-and-loop");
+
+	newValues(test, "i32", {"v", "k", "i", "w", "y", "z"});
+	newValues(test, "i1",  {"p"});
+	newBlocks(test, {"A", "B", "C", "E", "F"});
+
+	auto& values = test.values;
+	auto& blocks = test.blocks;
+
+	add(blocks["A"], values, "v", "1", "1");
+	add(blocks["A"], values, "k", "2", "2");
+	add(blocks["A"], values, "i", "0", "0");
+	setp(blocks["A"], values, "p", "i", "k");
+	branch(blocks["A"], blocks["C"], values["p"]);
+
+	add(blocks["B"], values, "w", "3", "3");
+	branch(blocks["B"], blocks["E"]);
+
+	add(blocks["C"], values, "y", "v", "1");
+
+	add(blocks["E"], values, "i", "i", "1");
+	setp(blocks["E"], values, "p", "i", "k");
+	branch(blocks["E"], blocks["E"], values["p"]);
+
+	add(blocks["F"], values, "z", "k", "i");
+
+	return test;
+}
+
+static std::string intervalsToString(const IntervalVector& intervals)
+{
+	std::stringstream stream;
+
+	for(auto& interval : intervals)
+	{
+		stream << "[" << interval.start << ", " << interval.end << ")";
+	}
+
+	return stream.str();
+}
+
+/*! \brief Checks the intervals of each value in the function */
+class LiveRangeTestPass : public CheckPass
+{
+public:
+	LiveRangeTestPass(const TestFunction& t)
+	: CheckPass({"LiveRangeAnalysis"}, "LiveRangeTestPass"), test(t)
+	{
+
+	}
+
+public:
+	void runOnFunction(const Function& function)
+	{
+		_ranges = static_cast<LiveRangeAnalysis*>(
+			getAnalysis("LiveRangeAnalysis"));
+
+		_base = _ranges->getBlockStart(*test.blocks["A"]);
+
+		// v is not live in B, which sits between its definition and use
+		_checkIntervals("v", {Interval(1, 10), Interval(14, 15)});
+
+		// k and i are live around the loop and merge into one interval
+		_checkIntervals("k", {Interval(3, 23)});
+		_checkIntervals("i", {Interval(5, 23)});
+
+		// p is redefined in the loop before it is read
+		_checkIntervals("p", {Interval(7, 9), Interval(19, 21)});
+
+		// dead definitions still occupy their write position
+		_checkIntervals("w", {Interval(11, 12)});
+		_checkIntervals("y", {Interval(15, 16)});
+		_checkIntervals("z", {Interval(23, 24)});
+
+		_check(!_range("v")->covers(_base + 11), "v is not live in B");
+		_check(_range("k")->covers(_base + 11), "k is live in B");
+
+		_checkFullyCovered("k", {"B", "C", "E"});
+		_checkFullyCovered("v", {});
+
+		_check(!_range("v")->interferesWith(*_range("w")),
+			"v and w do not interfere");
+		_check(!_range("v")->interferesWith(*_range("y")),
+			"v does not interfere with the value defined by its last use");
+		_check(_range("v")->interferesWith(*_range("p")),
+			"v and p interfere");
+		_check(_range("i")->interferesWith(*_range("k")),
+			"i and k interfere");
+		_check(!_range("z")->interferesWith(*_range("k")),
+			"z and k do not interfere");
+	}
+
+	vanaheimr::transforms::Pass* clone() const
+	{
+		return new LiveRangeTestPass(test);
+	}
+
+public:
+	TestFunction test;
+
+private:
+	const LiveRangeAnalysis::LiveRange* _range(const std::string& name)
+	{
+		return _ranges->getLiveRange(*test.values[name]);
+	}
+
+	void _checkIntervals(const std::string& name, IntervalVector expected)
+	{
+		for(auto& interval : expected)
+		{
+			interval.start += _base;
+			interval.end   += _base;
+		}
+
+		auto& intervals = _range(name)->intervals;
+
+		bool matches = intervals.size() == expected.size();
+
+		for(unsigned int i = 0; matches && i < intervals.size(); ++i)
+		{
+			matches = intervals[i].start == expected[i].start &&
+				intervals[i].end == expected[i].end;
+		}
+
+		_check(matches, "the intervals of " + name + " are " +
+			intervalsToString(intervals) + ", not " +
+			intervalsToString(expected));
+	}
+
+	void _checkFullyCovered(const std::string& name,
+		std::initializer_list<const char*> blocks)
+	{
+		auto& covered = _range(name)->fullyCoveredBlocks;
+
+		bool matches = covered.size() == blocks.size();
+
+		for(auto block : blocks)
+		{
+			matches &= covered.count(test.blocks[block]) != 0;
+		}
+
+		_check(matches, "the blocks fully covered by " + name);
+	}
+
+private:
+	LiveRangeAnalysis* _ranges;
+	unsigned int       _base;
+};
+
+static bool testLiveRangeAnalysis()
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-live-range-analysis");
+
+	auto test = generateFunction(*module);
+
+	bool passed = runCheckPass(*module, new LiveRangeTestPass(test));
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program computes the live intervals of a "
+		"function with a branch and a loop and checks them.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testLiveRangeAnalysis())
+	{
+		std::cout << "Live range analysis test Failed\n";
+		return -1;
+	}
+
+	std::cout << "Live range analysis test Passed\n";
+
+	return 0;
+}
+
@@ -11,11 +11,14 @@
 
 #include <vanaheimr/ir/interface/Module.h>
 
+#include <vanaheimr/util/interface/MappedFile.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/string.h>
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
+#include <cstring>
 #include <stdexcept>
 #include <unordered_set>
 
@@ -32,6 +35,19 @@ namespace vanaheimr
 namespace as
 {
 
+BinaryReader::BinaryReader()
+: _instructions(nullptr), _dataSection(nullptr), _stringTable(nullptr),
+  _symbolBegin(nullptr), _symbolEnd(nullptr), _instructionCount(0),
+  _function(nullptr)
+{
+
+}
+
+BinaryReader::~BinaryReader()
+{
+
+}
+
 ir::Module* BinaryReader::read(std::istream& stream, const std::string& name)
 {
 	      _readHeader(stream);
@@ -43,6 +59,8 @@ ir::Module* BinaryReader::read(std::istream& stream, const std::string& name)
 	ir::Module* module = new ir::Module(name,
 		compiler::Compiler::getSingleton());
 
+	util::MemoryPool::Scope scope(module->memoryPool());
+
 	_loadTypes();
 	_initializeModule(*module);
 	
@@ -51,6 +69,65 @@ ir::Module* BinaryReader::read(std::istream& stream, const std::string& name)
 	return module;
 }
 
+ir::Module* BinaryReader::map(const std::string& path)
+{
+	_mapFile(path);
+
+	ir::Module* module = new ir::Module(path,
+		compiler::Compiler::getSingleton());
+
+	util::MemoryPool::Scope scope(module->memoryPool());
+
+	_loadTypes();
+	_loadGlobals(*module);
+
+	for(auto symbol = _symbolBegin; symbol != _symbolEnd; ++symbol)
+	{
+		if(symbol->type != SymbolTableEntry::FunctionType) continue;
+
+		uint64_t symbolTableOffset = _getSymbolOffset(symbol);
+
+		auto function = static_cast<const ir::Function*>(
+			_getVariableAtSymbolOffset(symbolTableOffset));
+
+		_unmaterializedFunctions.insert(std::make_pair(function,
+			symbolTableOffset));
+	}
+
+	report("Finished mapping binary, " << _unmaterializedFunctions.size()
+		<< " functions are not loaded yet...");
+
+	return module;
+}
+
+void BinaryReader::materialize(ir::Function& function)
+{
+	auto unmaterialized = _unmaterializedFunctions.find(&function);
+
+	if(unmaterialized == _unmaterializedFunctions.end()) return;
+
+	auto& symbol = _getSymbolEntryAtOffset(unmaterialized->second);
+
+	_unmaterializedFunctions.erase(unmaterialized);
+
+	util::MemoryPool::Scope scope(function.module()->memoryPool());
+
+	_loadFunction(symbol);
+}
+
+void BinaryReader::materializeAll(ir::Module& module)
+{
+	for(auto& function : module)
+	{
+		materialize(function);
+	}
+}
+
+bool BinaryReader::isMaterialized(const ir::Function& function) const
+{
+	return _unmaterializedFunctions.count(&function) == 0;
+}
+
 void BinaryReader::_readHeader(std::istream& stream)
 {
 	report("Reading header...");
@@ -77,6 +154,8 @@ void BinaryReader::_readHeader(std::istream& stream)
 	report(" symbol offset: " << _header.symbolOffset);
 	report(" string offset: " << _header.stringsOffset);
 	report(" name offset:   " << _header.nameOffset);
+	report(" hash buckets:  " << _header.symbolHashBuckets);
+	report(" hash offset:   " << _header.symbolHashOffset);
 }
 
 void BinaryReader::_readDataSection(std::istream& stream)
@@ -85,15 +164,17 @@ void BinaryReader::_readDataSection(std::istream& stream)
 
 	stream.seekg(_header.dataOffset, std::ios::beg);
 
-	_dataSection.resize(dataSize);
+	_dataBuffer.resize(dataSize);
 
-	stream.read((char*) _dataSection.data(), dataSize);
+	stream.read((char*) _dataBuffer.data(), dataSize);
 
 	if((size_t)stream.gcount() != dataSize)
 	{
 		throw std::runtime_error("Failed to read binary data section, hit"
 			" EOF."); 
 	}
+
+	_dataSection = _dataBuffer.data();
 }
 
 void BinaryReader::_readStringTable(std::istream& stream)
@@ -102,14 +183,16 @@ void BinaryReader::_readStringTable(std::istream& stream)
 
 	stream.seekg(_header.stringsOffset, std::ios::beg);
 
-	_stringTable.resize(stringTableSize);
+	_stringBuffer.resize(stringTableSize);
 
-	stream.read((char*) _stringTable.data(), stringTableSize);
+	stream.read((char*) _stringBuffer.data(), stringTableSize);
 
 	if((size_t)stream.gcount() != stringTableSize)
 	{
 		throw std::runtime_error("Failed to read string table, hit EOF");
 	}
+
+	_stringTable = _stringBuffer.data();
 }
 
 void BinaryReader::_readSymbolTable(std::istream& stream)
@@ -118,39 +201,108 @@ void BinaryReader::_readSymbolTable(std::istream& stream)
 
 	stream.seekg(_header.symbolOffset, std::ios::beg);
 
-	_symbolTable.resize(_header.symbols);
+	_symbolBuffer.resize(_header.symbols);
 
-	stream.read((char*) _symbolTable.data(), symbolTableSize);
+	stream.read((char*) _symbolBuffer.data(), symbolTableSize);
 
 	if((size_t)stream.gcount() != symbolTableSize)
 	{
 		throw std::runtime_error("Failed to read symbol table, hit EOF");
 	}
+
+	_symbolBegin = _symbolBuffer.data();
+	_symbolEnd   = _symbolBegin + _symbolBuffer.size();
 }
 
 void BinaryReader::_readInstructions(std::istream& stream)
 {
 	size_t dataSize = BinaryHeader::PageSize * _header.codePages;
-	size_t sizeInInstructions = (dataSize + sizeof(InstructionContainer) - 1) /
-		sizeof(InstructionContainer);
 
-	_instructions.resize(sizeInInstructions);
+	// Only whole instructions are ever written to the code pages
+	_instructionCount = dataSize / sizeof(InstructionContainer);
+
+	_instructionBuffer.resize(_instructionCount);
 
-	// TODO obey page alignment
 	stream.seekg(_header.codeOffset, std::ios::beg);
 
-	stream.read((char*) _instructions.data(), dataSize);
+	size_t instructionBytes = _instructionCount * sizeof(InstructionContainer);
 
-	if((size_t)stream.gcount() != dataSize)
+	stream.read((char*) _instructionBuffer.data(), instructionBytes);
+
+	if((size_t)stream.gcount() != instructionBytes)
 	{
 		throw std::runtime_error("Failed to read code section, hit EOF.");
 	}
+
+	_instructions = _instructionBuffer.data();
+}
+
+void BinaryReader::_mapFile(const std::string& path)
+{
+	report("Mapping binary '" << path << "'...");
+
+	// Only the pages of materialized functions should be read, so
+	//  read ahead is disabled
+	_file.reset(new util::MappedFile(path, util::MappedFile::Random));
+
+	if(_file->size() < sizeof(BinaryHeader))
+	{
+		throw std::runtime_error("Failed to read binary "
+			"header, hit EOF.");
+	}
+
+	std::memcpy(&_header, _file->data(), sizeof(BinaryHeader));
+
+	if(_header.magic != BinaryHeader::MagicNumber)
+	{
+		throw std::runtime_error("Failed to read binary "
+			"header, invalid magic number.");
+	}
+
+	report(" data pages:    " << _header.dataPages);
+	report(" code pages:    " << _header.codePages);
+	report(" symbols:       " << _header.symbols);
+	report(" string pages:  " << _header.stringPages);
+
+	_dataSection = _getMappedSection(_header.dataOffset,
+		BinaryHeader::PageSize * (uint64_t)_header.dataPages, "data section");
+	_stringTable = _getMappedSection(_header.stringsOffset,
+		BinaryHeader::PageSize * (uint64_t)_header.stringPages,
+		"string table");
+
+	_symbolBegin = reinterpret_cast<symbol_iterator>(_getMappedSection(
+		_header.symbolOffset, sizeof(SymbolTableEntry) *
+		(uint64_t)_header.symbols, "symbol table"));
+	_symbolEnd = _symbolBegin + _header.symbols;
+
+	_instructionCount = BinaryHeader::PageSize * (uint64_t)_header.codePages /
+		sizeof(InstructionContainer);
+
+	_instructions = reinterpret_cast<const InstructionContainer*>(
+		_getMappedSection(_header.codeOffset,
+		_instructionCount * sizeof(InstructionContainer), "code section"));
+}
+
+const char* BinaryReader::_getMappedSection(uint64_t offset, uint64_t size,
+	const std::string& section) const
+{
+	if(offset % BinaryHeader::PageSize != 0)
+	{
+		throw std::runtime_error("Failed to map " + section +
+			", it does not start on a page boundary.");
+	}
+
+	if(offset > _file->size() || size > _file->size() - offset)
+	{
+		throw std::runtime_error("Failed to map " + section + ", hit EOF.");
+	}
+
+	return _file->data() + offset;
 }
 
 void BinaryReader::_loadTypes()
 {
-	for(auto symbol = _symbolTable.begin();
-		symbol != _symbolTable.end(); ++symbol)
+	for(auto symbol = _symbolBegin; symbol != _symbolEnd; ++symbol)
 	{
 		compiler::Compiler::getSingleton()->getOrInsertType(
 			_getSymbolTypeName(*symbol));
@@ -170,15 +322,12 @@ void BinaryReader::_loadGlobals(ir::Module& m)
 {
 	report(" Loading global variables from symbol table...");
 	
-	for(auto symbol = _symbolTable.begin();
-		symbol != _symbolTable.end(); ++symbol)
+	for(auto symbol = _symbolBegin; symbol != _symbolEnd; ++symbol)
 	{
 		if(symbol->type != SymbolTableEntry::VariableType &&
 			symbol->type != SymbolTableEntry::FunctionType) continue;
 
-		uint64_t symbolTableOffset = _header.symbolOffset +
-			sizeof(SymbolTableEntry) *
-			std::distance(_symbolTable.begin(), symbol);
+		uint64_t symbolTableOffset = _getSymbolOffset(symbol);
 		
 		report("  loaded " << _getSymbolName(*symbol)
 			<< " at offset " << symbol->offset
@@ -223,7 +372,7 @@ void BinaryReader::_loadGlobals(ir::Module& m)
 				}
 				
 				// Don't update the variable set
-				return;
+				continue;
 			}
 			else
 			{
@@ -256,148 +405,148 @@ void BinaryReader::_loadGlobals(ir::Module& m)
 
 void BinaryReader::_loadFunctions(ir::Module& m)
 {
-	typedef std::unordered_map<uint64_t, ir::BasicBlock*> PCToBasicBlockMap;
-
 	report(" Loading functions from symbol table...");
 
-	for(auto symbol = _symbolTable.begin();
-		symbol != _symbolTable.end(); ++symbol)
+	for(auto symbol = _symbolBegin; symbol != _symbolEnd; ++symbol)
 	{
 		if(symbol->type != SymbolTableEntry::FunctionType) continue;
 
-		report("  loaded function " << _getSymbolName(*symbol));
+		_loadFunction(*symbol);
+	}
+}
+
+void BinaryReader::_loadFunction(const SymbolTableEntry& symbol)
+{
+	typedef std::unordered_map<uint64_t, ir::BasicBlock*> PCToBasicBlockMap;
+
+	report("  loaded function " << _getSymbolName(symbol));
+
+	uint64_t symbolTableOffset = _getSymbolOffset(&symbol);
 
-		uint64_t symbolTableOffset = _header.symbolOffset +
-			sizeof(SymbolTableEntry) *
-			std::distance(_symbolTable.begin(), symbol);
+	ir::Variable* variable = _getVariableAtSymbolOffset(symbolTableOffset);
+	ir::Function* function = static_cast<ir::Function*>(variable);
 	
-		ir::Variable* variable = _getVariableAtSymbolOffset(symbolTableOffset);
-		ir::Function* function = static_cast<ir::Function*>(variable);
-		
-		_function = function;
-		
-		report("   loading arguments...");
+	_function = function;
+	
+	report("   loading arguments...");
 
-		for(auto argumentSymbol = _symbolTable.begin();
-			argumentSymbol != _symbolTable.end(); ++argumentSymbol)
+	for(auto argumentSymbol = _symbolBegin;
+		argumentSymbol != _symbolEnd; ++argumentSymbol)
+	{
+		if(argumentSymbol->type != SymbolTableEntry::ArgumentType)
 		{
-			if(argumentSymbol->type != SymbolTableEntry::ArgumentType)
-			{
-				continue;
-			}
-			
-			std::string functionName =
-				_getSymbolName(*argumentSymbol).substr(2,
-				function->name().size());
+			continue;
+		}
 		
-			if(functionName != function->name()) continue;
-
-			uint64_t symbolTableOffset = _header.symbolOffset +
-				sizeof(SymbolTableEntry) *
-				std::distance(_symbolTable.begin(), argumentSymbol);
+		std::string functionName =
+			_getSymbolName(*argumentSymbol).substr(2,
+			function->name().size());
+	
+		if(functionName != function->name()) continue;
 
-			std::string name = _getSymbolName(*argumentSymbol).substr(
-				2 + function->name().size());
+		uint64_t symbolTableOffset = _getSymbolOffset(argumentSymbol);
 
-			report("    loaded argument " << name
-				<< " at offset " << argumentSymbol->offset
-				<< ", symbol offset is " << symbolTableOffset);
+		std::string name = _getSymbolName(*argumentSymbol).substr(
+			2 + function->name().size());
 
-			auto type = _getSymbolType(*argumentSymbol);
+		report("    loaded argument " << name
+			<< " at offset " << argumentSymbol->offset
+			<< ", symbol offset is " << symbolTableOffset);
 
-			if(type == nullptr)
-			{
-				throw std::runtime_error("Could not find type with name '" +
-					_getSymbolTypeName(*argumentSymbol) + "' for symbol '" +
-					name + "'");
-			}
-	
-			auto argument = function->newArgument(type, name);
+		auto type = _getSymbolType(*argumentSymbol);
 
-			_arguments.insert(std::make_pair(symbolTableOffset,
-				&*argument));
+		if(type == nullptr)
+		{
+			throw std::runtime_error("Could not find type with name '" +
+				_getSymbolTypeName(*argumentSymbol) + "' for symbol '" +
+				name + "'");
 		}
 
-		BasicBlockDescriptorVector blocks = _getBasicBlocksInFunction(*symbol);
-	
-		PCToBasicBlockMap blockPCs;
+		auto argument = function->newArgument(type, name);
 
-		for(auto blockOffset : blocks)
-		{
-			ir::Function::iterator block = function->newBasicBlock(
-				function->end(), blockOffset.name);
+		_arguments.insert(std::make_pair(symbolTableOffset,
+			&*argument));
+	}
 
-			blockPCs.insert(std::make_pair(blockOffset.begin, &*block));
+	BasicBlockDescriptorVector blocks = _getBasicBlocksInFunction(symbol);
 
-			report("   adding basic block " << blockOffset.name
-				<< " using instructions [" 
-				<< blockOffset.begin << ", " << blockOffset.end << "]");
-		
-			for(unsigned int i = blockOffset.begin; i != blockOffset.end; ++i)
-			{
-				assert(i < _instructions.size());
-				_addInstruction(block, _instructions[i]);
-				report("    added instruction '" 
-					<< block->back()->toString() << "'");
-			}
-		}
+	PCToBasicBlockMap blockPCs;
+
+	for(auto blockOffset : blocks)
+	{
+		ir::Function::iterator block = function->newBasicBlock(
+			function->end(), blockOffset.name);
 
-		report("  resolving branch targets...");
+		blockPCs.insert(std::make_pair(blockOffset.begin, &*block));
 
-		for(auto unresolved : _unresolvedTargets)
+		report("   adding basic block " << blockOffset.name
+			<< " using instructions [" 
+			<< blockOffset.begin << ", " << blockOffset.end << "]");
+	
+		for(unsigned int i = blockOffset.begin; i != blockOffset.end; ++i)
 		{
-			// find the symbol with the specified offset
-			const SymbolTableEntry& targetSymbol =
-				_getSymbolEntryAtOffset(unresolved.first);
+			assert(i < _instructionCount);
+			_addInstruction(block, _instructions[i]);
+			report("    added instruction '" 
+				<< block->back()->toString() << "'");
+		}
+	}
 
-			uint64_t pc = (targetSymbol.offset - _header.codeOffset) /
-				sizeof(InstructionContainer);
-		
-			report("   for branch to pc " << pc);
+	report("  resolving branch targets...");
 
-			auto block = blockPCs.find(pc);
+	for(auto unresolved : _unresolvedTargets)
+	{
+		// find the symbol with the specified offset
+		const SymbolTableEntry& targetSymbol =
+			_getSymbolEntryAtOffset(unresolved.first);
 
-			if(block == blockPCs.end())
-			{
-				std::stringstream message;
+		uint64_t pc = (targetSymbol.offset - _header.codeOffset) /
+			sizeof(InstructionContainer);
+	
+		report("   for branch to pc " << pc);
 
-				message << "Could not find basic block starting at pc " << pc;
+		auto block = blockPCs.find(pc);
 
-				throw std::runtime_error(message.str());
-			}
-			
-			report("    setting target to " << block->second->name());
+		if(block == blockPCs.end())
+		{
+			std::stringstream message;
 
-			static_cast<ir::AddressOperand*>(unresolved.second)->globalValue =
-				block->second;
-		}
+			message << "Could not find basic block starting at pc " << pc;
 
-		_unresolvedTargets.clear();
-		_virtualRegisters.clear();
-		_arguments.clear();
-		
-		for(auto local = _locals.begin(); local != _locals.end(); ++local)
-		{
-			local->second = nullptr;
+			throw std::runtime_error(message.str());
 		}
+		
+		report("    setting target to " << block->second->name());
+
+		static_cast<ir::AddressOperand*>(unresolved.second)->globalValue =
+			block->second;
+	}
+
+	_unresolvedTargets.clear();
+	_virtualRegisters.clear();
+	_arguments.clear();
+	
+	for(auto local = _locals.begin(); local != _locals.end(); ++local)
+	{
+		local->second = nullptr;
 	}
 }
 
 std::string BinaryReader::_getSymbolName(const SymbolTableEntry& symbol) const
 {
-	return std::string((char*)_stringTable.data() + symbol.stringOffset);
+	return std::string(_stringTable + symbol.stringOffset);
 }
 
 std::string BinaryReader::_getSymbolTypeName(
 	const SymbolTableEntry& symbol) const
 {
-	return std::string((char*)_stringTable.data() + symbol.typeOffset);
+	return std::string(_stringTable + symbol.typeOffset);
 }
 
 std::string BinaryReader::_getSymbolAttributes(
 	const SymbolTableEntry& symbol) const
 {
-	return std::string((char*)_stringTable.data() + symbol.attributeOffset);
+	return std::string(_stringTable + symbol.attributeOffset);
 }
 
 ir::Type* BinaryReader::_getSymbolType(const SymbolTableEntry& symbol) const
@@ -534,6 +683,55 @@ BinaryReader::BasicBlockDescriptorVector
 	return blocks;
 }
 
+static ir::Instruction::Opcode convertOpcode(Instruction::Opcode opcode)
+{
+	switch(opcode)
+	{
+	case Instruction::Add:           return ir::Instruction::Add;
+	case Instruction::And:           return ir::Instruction::And;
+	case Instruction::Ashr:          return ir::Instruction::Ashr;
+	case Instruction::Atom:          return ir::Instruction::Atom;
+	case Instruction::Bar:           return ir::Instruction::Bar;
+	case Instruction::Bitcast:       return ir::Instruction::Bitcast;
+	case Instruction::Bra:           return ir::Instruction::Bra;
+	case Instruction::Call:          return ir::Instruction::Call;
+	case Instruction::Fdiv:          return ir::Instruction::Fdiv;
+	case Instruction::Fmul:          return ir::Instruction::Fmul;
+	case Instruction::Fpext:         return ir::Instruction::Fpext;
+	case Instruction::Fptosi:        return ir::Instruction::Fptosi;
+	case Instruction::Fptoui:        return ir::Instruction::Fptoui;
+	case Instruction::Fptrunc:       return ir::Instruction::Fptrunc;
+	case Instruction::Frem:          return ir::Instruction::Frem;
+	case Instruction::Launch:        return ir::Instruction::Launch;
+	case Instruction::Ld:            return ir::Instruction::Ld;
+	case Instruction::Lshr:          return ir::Instruction::Lshr;
+	case Instruction::Membar:        return ir::Instruction::Membar;
+	case Instruction::Mul:           return ir::Instruction::Mul;
+	case Instruction::Phi:           return ir::Instruction::Phi;
+	case Instruction::Psi:           return ir::Instruction::Psi;
+	case Instruction::Or:            return ir::Instruction::Or;
+	case Instruction::Ret:           return ir::Instruction::Ret;
+	case Instruction::Setp:          return ir::Instruction::Setp;
+	case Instruction::Sext:          return ir::Instruction::Sext;
+	case Instruction::Sdiv:          return ir::Instruction::Sdiv;
+	case Instruction::Shl:           return ir::Instruction::Shl;
+	case Instruction::Sitofp:        return ir::Instruction::Sitofp;
+	case Instruction::Srem:          return ir::Instruction::Srem;
+	case Instruction::St:            return ir::Instruction::St;
+	case Instruction::Sub:           return ir::Instruction::Sub;
+	case Instruction::Trunc:         return ir::Instruction::Trunc;
+	case Instruction::Udiv:          return ir::Instruction::Udiv;
+	case Instruction::Uitofp:        return ir::Instruction::Uitofp;
+	case Instruction::Urem:          return ir::Instruction::Urem;
+	case Instruction::Xor:           return ir::Instruction::Xor;
+	case Instruction::Zext:          return ir::Instruction::Zext;
+	case Instruction::InvalidOpcode: return ir::Instruction::InvalidOpcode;
+	default: assertM(false, "Invalid opcode.");
+	}
+
+	return ir::Instruction::InvalidOpcode;
+}
+
 void BinaryReader::_addInstruction(ir::Function::iterator block,
 	const InstructionContainer& container)
 {
@@ -542,8 +740,8 @@ void BinaryReader::_addInstruction(ir::Function::iterator block,
 	if(_addComplexInstruction(block, container))      return;
 
 	assertM(false, "Translation for instruction '" <<
-		ir::Instruction::toString((ir::Instruction::Opcode)
-		container.asInstruction.opcode) << "' not implemented.");
+		ir::Instruction::toString(convertOpcode(
+		container.asInstruction.opcode)) << "' not implemented.");
 }
 
 bool BinaryReader::_addSimpleBinaryInstruction(ir::Function::iterator block,
@@ -569,8 +767,8 @@ bool BinaryReader::_addSimpleBinaryInstruction(ir::Function::iterator block,
 	case Instruction::Xor:
 	{
 		auto instruction = static_cast<ir::BinaryInstruction*>(
-			ir::Instruction::create((ir::Instruction::Opcode)
-			container.asInstruction.opcode, &*block));
+			ir::Instruction::create(convertOpcode(
+			container.asInstruction.opcode), &*block));
 
 		instruction->setGuard(_translateOperand(
 			container.asBinaryInstruction.guard, instruction));
@@ -610,8 +808,8 @@ bool BinaryReader::_addSimpleUnaryInstruction(ir::Function::iterator block,
 	case Instruction::Zext:
 	{
 		auto instruction = static_cast<ir::UnaryInstruction*>(
-			ir::Instruction::create((ir::Instruction::Opcode)
-			container.asInstruction.opcode, &*block));
+			ir::Instruction::create(convertOpcode(
+			container.asInstruction.opcode), &*block));
 
 		instruction->setGuard(_translateOperand(
 			container.asUnaryInstruction.guard, instruction));
@@ -637,8 +835,8 @@ bool BinaryReader::_addComplexInstruction(ir::Function::iterator block,
 	if(container.asInstruction.opcode == Instruction::St)
 	{
 		auto instruction = static_cast<ir::St*>(
-			ir::Instruction::create((ir::Instruction::Opcode)
-			container.asInstruction.opcode, &*block));
+			ir::Instruction::create(convertOpcode(
+			container.asInstruction.opcode), &*block));
 
 		instruction->setGuard(_translateOperand(
 			container.asSt.guard, instruction));
@@ -656,8 +854,8 @@ bool BinaryReader::_addComplexInstruction(ir::Function::iterator block,
 	else if(container.asInstruction.opcode == Instruction::Setp)
 	{
 		auto instruction = static_cast<ir::Setp*>(
-			ir::Instruction::create((ir::Instruction::Opcode)
-			container.asInstruction.opcode, &*block));
+			ir::Instruction::create(convertOpcode(
+			container.asInstruction.opcode), &*block));
 
 		instruction->setGuard(_translateOperand(
 			container.asSetp.guard, instruction));
@@ -681,8 +879,8 @@ bool BinaryReader::_addComplexInstruction(ir::Function::iterator block,
 	else if(container.asInstruction.opcode == Instruction::Bra)
 	{
 		auto instruction = static_cast<ir::Bra*>(
-			ir::Instruction::create((ir::Instruction::Opcode)
-			container.asInstruction.opcode, &*block));
+			ir::Instruction::create(convertOpcode(
+			container.asInstruction.opcode), &*block));
 
 		instruction->setGuard(_translateOperand(
 			container.asBra.guard, instruction));
@@ -706,8 +904,8 @@ bool BinaryReader::_addComplexInstruction(ir::Function::iterator block,
 	else if(container.asInstruction.opcode == Instruction::Ret)
 	{
 		auto instruction = static_cast<ir::Ret*>(
-			ir::Instruction::create((ir::Instruction::Opcode)
-			container.asInstruction.opcode, &*block));
+			ir::Instruction::create(convertOpcode(
+			container.asInstruction.opcode), &*block));
 
 		instruction->setGuard(_translateOperand(
 			container.asRet.guard, instruction));
@@ -730,8 +928,8 @@ void BinaryReader::_addCallInstruction(ir::Function::iterator block,
 	const InstructionContainer& container)
 {
 	auto instruction = static_cast<ir::Call*>(
-		ir::Instruction::create((ir::Instruction::Opcode)
-			container.asInstruction.opcode, &*block));
+		ir::Instruction::create(convertOpcode(
+			container.asInstruction.opcode), &*block));
 
 	instruction->setGuard(_translateOperand(
 		container.asCall.guard, instruction));
@@ -745,7 +943,7 @@ void BinaryReader::_addCallInstruction(ir::Function::iterator block,
 		uint64_t offset = returned * sizeof(OperandContainer) +
 			container.asCall.returnArgumentOffset;
 		const OperandContainer* operand =
-			reinterpret_cast<OperandContainer*>(&_dataSection[offset]);
+			reinterpret_cast<const OperandContainer*>(&_dataSection[offset]);
 	
 		instruction->addReturn(_translateOperand(*operand, instruction));
 	}
@@ -756,7 +954,7 @@ void BinaryReader::_addCallInstruction(ir::Function::iterator block,
 		uint64_t offset = argument * sizeof(OperandContainer) +
 			container.asCall.argumentOffset;
 		const OperandContainer* operand =
-			reinterpret_cast<OperandContainer*>(&_dataSection[offset]);
+			reinterpret_cast<const OperandContainer*>(&_dataSection[offset]);
 	
 		instruction->addArgument(_translateOperand(*operand, instruction));
 	}
@@ -768,8 +966,8 @@ void BinaryReader::_addPhiInstruction(ir::Function::iterator block,
 	const InstructionContainer& container)
 {
 	auto instruction = static_cast<ir::Phi*>(
-		ir::Instruction::create((ir::Instruction::Opcode)
-			container.asInstruction.opcode, &*block));
+		ir::Instruction::create(convertOpcode(
+			container.asInstruction.opcode), &*block));
 
 	instruction->setGuard(_translateOperand(
 		container.asCall.guard, instruction));
@@ -788,9 +986,10 @@ void BinaryReader::_addPhiInstruction(ir::Function::iterator block,
 			container.asPhi.sourcesOffset;
 		
 		const OperandContainer* operandSource =
-			reinterpret_cast<OperandContainer*>(&_dataSection[offset]);
+			reinterpret_cast<const OperandContainer*>(&_dataSection[offset]);
 		const OperandContainer* operandBlock =
-			reinterpret_cast<OperandContainer*>(&_dataSection[blockOffset]);
+			reinterpret_cast<const OperandContainer*>(
+			&_dataSection[blockOffset]);
 			
 		auto registerSource = static_cast<ir::RegisterOperand*>(
 			_translateOperand(*operandSource, instruction));
@@ -1012,10 +1211,16 @@ const SymbolTableEntry& BinaryReader::_getSymbolEntryAtOffset(
 	uint64_t symbolOffset =
 		(offset - _header.symbolOffset) / sizeof(SymbolTableEntry);
 	
-	assertM(symbolOffset < _symbolTable.size(), "Invalid symbol "
-		<< symbolOffset << " out of " << _symbolTable.size());
+	assertM(symbolOffset < _header.symbols, "Invalid symbol "
+		<< symbolOffset << " out of " << _header.symbols);
 	
-	return _symbolTable[symbolOffset];
+	return _symbolBegin[symbolOffset];
+}
+
+uint64_t BinaryReader::_getSymbolOffset(symbol_iterator symbol) const
+{
+	return _header.symbolOffset +
+		sizeof(SymbolTableEntry) * std::distance(_symbolBegin, symbol);
 }
 
 BinaryReader::BasicBlockDescriptor::BasicBlockDescriptor(
@@ -44,6 +44,7 @@ void BinaryWriter::write(std::ostream& binary, const ir::Module& m)
 	populateData();
 	populateInstructions();
 	linkSymbols();
+	populateSymbolHash();
 	
 	populateHeader();
 
@@ -58,6 +59,8 @@ void BinaryWriter::write(std::ostream& binary, const ir::Module& m)
 	writePage(binary, (const char*)m_data.data(), getDataSize());
 	report(" writing string table");
 	writePage(binary, (const char*)m_stringTable.data(), getStringTableSize());
+	report(" writing symbol hash");
+	writePage(binary, (const char*)m_symbolHash.data(), getSymbolHashSize());
 }
 
 void BinaryWriter::writePage(std::ostream& binary, const void* data,
@@ -201,6 +204,48 @@ void BinaryWriter::linkSymbols()
 	}
 }
 
+static uint32_t hashSymbolName(const char* name)
+{
+	uint32_t hash = BinaryHeader::FnvOffsetBasis;
+
+	for(; *name != '\0'; ++name)
+	{
+		hash ^= (uint8_t)*name;
+		hash *= BinaryHeader::FnvPrime;
+	}
+
+	return hash;
+}
+
+void BinaryWriter::populateSymbolHash()
+{
+	m_symbolHash.clear();
+
+	if(m_symbolTable.empty()) return;
+
+	size_t buckets = 1;
+
+	while(buckets < m_symbolTable.size()) buckets <<= 1;
+
+	report(" Hashing " << m_symbolTable.size() << " symbols into "
+		<< buckets << " buckets.");
+
+	m_symbolHash.assign(buckets + m_symbolTable.size(),
+		(uint32_t)BinaryHeader::InvalidSymbol);
+
+	// Insert in reverse so that each chain is in symbol table order
+	for(size_t index = m_symbolTable.size(); index != 0; --index)
+	{
+		size_t symbol = index - 1;
+
+		uint32_t bucket = hashSymbolName(
+			&m_stringTable[m_symbolTable[symbol].stringOffset]) % buckets;
+
+		m_symbolHash[buckets + symbol] = m_symbolHash[bucket];
+		m_symbolHash[bucket]           = symbol;
+	}
+}
+
 void BinaryWriter::populateHeader()
 {
 	m_header.magic         = BinaryHeader::MagicNumber;
@@ -214,6 +259,10 @@ void BinaryWriter::populateHeader()
 	m_header.codeOffset    = getInstructionOffset();
 	m_header.symbolOffset  = getSymbolTableOffset();
 	m_header.stringsOffset = getStringTableOffset();
+
+	m_header.symbolHashBuckets = m_symbolHash.size() - m_symbolTable.size();
+	m_header.reserved          = 0;
+	m_header.symbolHashOffset  = getSymbolHashOffset();
 }
 
 size_t BinaryWriter::getHeaderOffset() const
@@ -241,6 +290,11 @@ size_t BinaryWriter::getStringTableOffset() const
 	return pageAlign(getDataSize() + getDataOffset());
 }
 
+size_t BinaryWriter::getSymbolHashOffset() const
+{
+	return pageAlign(getStringTableSize() + getStringTableOffset());
+}
+
 size_t BinaryWriter::getSymbolTableSize() const
 {
 	return m_symbolTable.size() * sizeof(SymbolTableEntry);
@@ -261,6 +315,11 @@ size_t BinaryWriter::getStringTableSize() const
 	return m_stringTable.size();
 }
 
+size_t BinaryWriter::getSymbolHashSize() const
+{
+	return m_symbolHash.size() * sizeof(uint32_t);
+}
+
 static Instruction::Opcode convertOpcode(
 	ir::Instruction::Opcode opcode)
 {
@@ -742,18 +801,11 @@ size_t BinaryWriter::getSymbolTableOffset(const std::string& name)
 BinaryWriter::SymbolTableEntryVector::iterator
 	BinaryWriter::getSymbol(const std::string& name)
 {
-	for(SymbolVector::iterator symbol = m_symbolTable.begin();
-		symbol != m_symbolTable.end(); ++symbol)
-	{
-		std::string symbolName(&m_stringTable[symbol->stringOffset]);
+	auto index = m_symbolIndices.find(name);
 
-		if(symbolName == name)
-		{
-			return symbol;
-		}
-	}
+	if(index == m_symbolIndices.end()) return m_symbolTable.end();
 
-	return m_symbolTable.end();
+	return m_symbolTable.begin() + index->second;
 }
 
 void BinaryWriter::addSymbol(unsigned int type, unsigned int linkage,
@@ -792,7 +844,8 @@ void BinaryWriter::addSymbol(unsigned int type, unsigned int linkage,
 		std::back_inserter(m_stringTable));
 	m_stringTable.push_back('\0');
 
-	// Add the symbol
+	// Add the symbol, lookups by name find the first one
+	m_symbolIndices.insert(std::make_pair(name, m_symbolTable.size()));
 	m_symbolTable.push_back(symbol);
 }
 
@@ -4,6 +4,8 @@
 	\brief  The header file for the specification of the header of the binary
 */
 
+#pragma once
+
 // Vanaheimr Includes
 #include <vanaheimr/util/interface/IntTypes.h>
 
@@ -15,12 +17,25 @@ namespace vanaheimr
 namespace as
 {
 
+/*! \brief The header at the start of a VIR binary
+
+	The optional symbol hash section holds 'symbolHashBuckets' bucket
+	entries followed by one chain entry per symbol, all 32-bit symbol
+	indices.  A name hashes (32-bit FNV-1a) to the bucket holding the
+	first symbol of its chain, the chain entry of a symbol holds the
+	next one.  Chains end in InvalidSymbol.  Binaries without the
+	section have zero buckets, readers fall back to a linear scan.
+*/
 class BinaryHeader
 {
 public:
 	static const unsigned int PageSize    = (1 << 15); // 32 KB
 	static const uint64_t     MagicNumber = 0x2E5649527F454C46ULL;
 
+	static const uint32_t InvalidSymbol   = 0xffffffff;
+	static const uint32_t FnvOffsetBasis  = 2166136261U;
+	static const uint32_t FnvPrime        = 16777619U;
+
 public:
 	uint64_t magic          : 64;
 	uint32_t dataPages      : 32;
@@ -32,6 +47,10 @@ public:
 	uint64_t symbolOffset   : 64;
 	uint64_t stringsOffset  : 64;
 	uint64_t nameOffset     : 64;
+
+	uint32_t symbolHashBuckets : 32;
+	uint32_t reserved          : 32;
+	uint64_t symbolHashOffset  : 64;
 };
 
 }
@@ -18,9 +18,11 @@
 // Standard Library Includes
 #include <istream>
 #include <vector>
+#include <memory>
 #include <unordered_map>
 
-namespace vanaheimr { namespace ir { class Constant; } }
+namespace vanaheimr { namespace ir   { class Constant;   } }
+namespace vanaheimr { namespace util { class MappedFile; } }
 
 namespace vanaheimr
 {
@@ -31,16 +33,41 @@ namespace as
 /*! \brief Reads in a vanaheimr bytecode file yielding a module. */
 class BinaryReader
 {
+public:
+	BinaryReader();
+	~BinaryReader();
+
 public:
 	/*! \brief Attempts to read from a binary stream, returns a module */
 	ir::Module* read(std::istream& stream, const std::string& name);
 
+public:
+	/*! \brief Maps a binary file into memory and returns a module with
+		every global and function declared.
+
+		Function bodies are only decoded by materialize(), so the pages
+		of the file that are never touched are never read.  The reader
+		must outlive any calls to materialize().
+	*/
+	ir::Module* map(const std::string& path);
+
+	/*! \brief Decode the body of a function declared by map() */
+	void materialize(ir::Function& function);
+	/*! \brief Decode the body of every function that is not yet loaded */
+	void materializeAll(ir::Module& module);
+
+	bool isMaterialized(const ir::Function& function) const;
+
+public:
+	BinaryReader(const BinaryReader&) = delete;
+	BinaryReader& operator=(const BinaryReader&) = delete;
+
 private:
 	typedef std::vector<InstructionContainer>       InstructionVector;
 	typedef std::vector<char>                       DataVector;
 	typedef std::vector<SymbolTableEntry>           SymbolVector;
 
-	typedef SymbolVector::iterator symbol_iterator;
+	typedef const SymbolTableEntry* symbol_iterator;
 
 	class BasicBlockDescriptor
 	{
@@ -63,11 +90,16 @@ private:
 	void _readSymbolTable(std::istream& stream);
 	void _readInstructions(std::istream& stream);
 
+	void _mapFile(const std::string& path);
+	const char* _getMappedSection(uint64_t offset, uint64_t size,
+		const std::string& section) const;
+
 private:
 	void _loadTypes();
 	void _initializeModule(ir::Module& m);
 	void _loadGlobals(ir::Module& m);
 	void _loadFunctions(ir::Module& m);
+	void _loadFunction(const SymbolTableEntry& symbol);
 	
 private:
 	std::string              _getSymbolName(
@@ -117,14 +149,28 @@ private:
 	ir::Variable* _getVariableAtSymbolOffset(uint64_t offset);
 	ir::Argument* _getArgumentAtSymbolOffset(uint64_t offset) const;
 	const SymbolTableEntry& _getSymbolEntryAtOffset(uint64_t offset) const; 
+	uint64_t _getSymbolOffset(symbol_iterator symbol) const;
 
 private:
 	BinaryHeader _header;
 
-	InstructionVector _instructions;
-	DataVector        _dataSection;
-	DataVector        _stringTable;
-	SymbolVector      _symbolTable;
+	/*! \brief Views of each section, in a mapped file or in the
+		buffers that a stream was read into */
+	const InstructionContainer* _instructions;
+	const char*                 _dataSection;
+	const char*                 _stringTable;
+	symbol_iterator             _symbolBegin;
+	symbol_iterator             _symbolEnd;
+
+	uint64_t _instructionCount;
+
+private:
+	InstructionVector _instructionBuffer;
+	DataVector        _dataBuffer;
+	DataVector        _stringBuffer;
+	SymbolVector      _symbolBuffer;
+
+	std::unique_ptr<util::MappedFile> _file;
 
 private:
 	typedef std::unordered_map<RegisterType,
@@ -143,6 +189,15 @@ private:
 	SymbolToVariableMap      _locals;
 	TargetToBranchOperandMap _unresolvedTargets;
 	ir::Function*            _function;
+
+private:
+	typedef std::unordered_map<const ir::Function*, uint64_t>
+		FunctionToSymbolMap;
+
+private:
+	/*! \brief The symbol offsets of functions declared by map() that
+		have not been decoded yet */
+	FunctionToSymbolMap _unmaterializedFunctions;
 };
 
 }
@@ -56,6 +56,7 @@ private:
 	void populateHeader();
 	void populateInstructions();
 	void populateData();
+	void populateSymbolHash();
 	void linkSymbols();
 
 private:
@@ -64,11 +65,13 @@ private:
 	size_t getDataOffset() const;
 	size_t getSymbolTableOffset() const;
 	size_t getStringTableOffset() const;
+	size_t getSymbolHashOffset() const;
 
 	size_t getSymbolTableSize() const;
 	size_t getInstructionStreamSize() const;
 	size_t getDataSize() const;
 	size_t getStringTableSize() const;
+	size_t getSymbolHashSize() const;
 	
 	void convertComplexInstruction(InstructionContainer& container,
 		const Instruction& instruction);
@@ -122,6 +125,8 @@ private:
 	typedef std::vector<SymbolTableEntry>             SymbolVector;
 	typedef std::unordered_map<std::string, uint64_t> OffsetMap;
 	typedef std::unordered_map<uint64_t, uint64_t>    OffsetToSymbolMap;
+	typedef std::unordered_map<std::string, size_t>   SymbolIndexMap;
+	typedef std::vector<uint32_t>                     SymbolHashVector;
 
 private:
 	const ir::Module*  m_module;
@@ -131,6 +136,11 @@ private:
 	DataVector        m_data;
 	SymbolVector      m_symbolTable;
 	DataVector        m_stringTable;
+	SymbolHashVector  m_symbolHash;
+
+private:
+	/*! \brief The index of the first symbol with each name */
+	SymbolIndexMap    m_symbolIndices;
 
 private:
 	OffsetMap         m_basicBlockOffsets;
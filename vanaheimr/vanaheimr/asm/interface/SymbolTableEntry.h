@@ -5,6 +5,8 @@
 	        the binary
 */
 
+#pragma once
+
 /*! \brief The wrapper namespace for Vanaheimr */
 namespace vanaheimr
 {
@@ -0,0 +1,330 @@
+/*! \file   test-binary-reader.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for mapping a binary and materializing functions lazily.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/asm/interface/BinaryReader.h>
+#include <vanaheimr/asm/interface/BinaryWriter.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+typedef std::vector<unsigned int>           OpcodeVector;
+typedef std::map<std::string, OpcodeVector> FunctionOpcodeMap;
+
+/*! \brief A function with 'adds' additions split over two blocks
+
+	first:  value = 0 + 1; value = 1 + 1; ...; bra second
+	second: value = i + 1; ...; ret
+*/
+static void addFunction(Module& module, const std::string& name,
+	unsigned int adds)
+{
+	auto test = newTestFunction(module, name);
+
+	test.function->interpretType();
+
+	newValues(test, "i32", {"value"});
+	newBlocks(test, {"first", "second"});
+
+	auto first  = test.blocks["first"];
+	auto second = test.blocks["second"];
+
+	for(unsigned int i = 0; i < adds; ++i)
+	{
+		auto block = i < adds / 2 ? first : second;
+
+		add(block, test.values, "value", std::to_string(i), "1");
+	}
+
+	branch(first, second);
+
+	auto ret = new vanaheimr::ir::Ret(second);
+
+	guard(ret);
+
+	second->push_back(ret);
+}
+
+static OpcodeVector getOpcodes(const Function& function)
+{
+	OpcodeVector opcodes;
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			opcodes.push_back(instruction->opcode);
+		}
+	}
+
+	return opcodes;
+}
+
+/*! \brief Write a module with several functions to a file */
+static FunctionOpcodeMap writeBinary(const std::string& path)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-binary-reader");
+
+	addFunction(*module, "small",  1);
+	addFunction(*module, "medium", 4);
+	addFunction(*module, "large",  9);
+
+	FunctionOpcodeMap opcodes;
+
+	for(auto& function : *module)
+	{
+		opcodes[function.name()] = getOpcodes(function);
+	}
+
+	std::ofstream file(path.c_str(), std::ios::binary);
+
+	vanaheimr::as::BinaryWriter writer;
+
+	writer.write(file, *module);
+
+	compiler->deleteModule(module);
+
+	return opcodes;
+}
+
+static bool checkMaterialized(const vanaheimr::as::BinaryReader& reader,
+	const Module& module, const FunctionOpcodeMap& expected,
+	const std::map<std::string, bool>& materialized)
+{
+	bool passed = true;
+
+	for(auto& state : materialized)
+	{
+		auto function = module.getFunction(state.first);
+
+		if(function == module.end())
+		{
+			std::cout << " function " << state.first
+				<< " was not declared\n";
+			passed = false;
+			continue;
+		}
+
+		if(reader.isMaterialized(*function) != state.second)
+		{
+			std::cout << " function " << state.first << " is "
+				<< (state.second ? "not " : "") << "materialized\n";
+			passed = false;
+		}
+
+		auto opcodes = getOpcodes(*function);
+
+		if(state.second ? opcodes != expected.at(state.first) :
+			!opcodes.empty())
+		{
+			std::cout << " function " << state.first << " has "
+				<< opcodes.size() << " instructions\n";
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+static bool testMap(const std::string& path,
+	const FunctionOpcodeMap& expected)
+{
+	vanaheimr::as::BinaryReader reader;
+
+	auto module = reader.map(path);
+
+	bool passed = true;
+
+	// functions are declared, but no instructions are decoded
+	passed &= checkMaterialized(reader, *module, expected,
+		{{"small", false}, {"medium", false}, {"large", false}});
+
+	reader.materialize(*module->getFunction("medium"));
+
+	passed &= checkMaterialized(reader, *module, expected,
+		{{"small", false}, {"medium", true}, {"large", false}});
+
+	// materializing twice does not decode the body again
+	reader.materialize(*module->getFunction("medium"));
+	reader.materializeAll(*module);
+
+	passed &= checkMaterialized(reader, *module, expected,
+		{{"small", true}, {"medium", true}, {"large", true}});
+
+	// the branch target is resolved to a decoded block
+	auto& medium = *module->getFunction("medium");
+
+	for(auto& block : medium)
+	{
+		for(auto instruction : block)
+		{
+			if(!instruction->isBranch()) continue;
+
+			auto bra = static_cast<vanaheimr::ir::Bra*>(instruction);
+
+			auto target = bra->targetBasicBlock();
+
+			if(target == nullptr || target->function() != &medium ||
+				target->empty() || !target->back()->isReturn())
+			{
+				std::cout << " the branch in medium does not target the "
+					"block with the return\n";
+				passed = false;
+			}
+		}
+	}
+
+	delete module;
+
+	return passed;
+}
+
+/*! \brief The stream reader decodes the same instructions */
+static bool testRead(const std::string& path,
+	const FunctionOpcodeMap& expected)
+{
+	std::ifstream file(path.c_str(), std::ios::binary);
+
+	vanaheimr::as::BinaryReader reader;
+
+	auto module = reader.read(file, path);
+
+	bool passed = true;
+
+	for(auto& function : expected)
+	{
+		auto read = module->getFunction(function.first);
+
+		if(read == module->end() || getOpcodes(*read) != function.second)
+		{
+			std::cout << " read() decoded " << function.first
+				<< " differently\n";
+			passed = false;
+		}
+	}
+
+	delete module;
+
+	return passed;
+}
+
+static bool throwsOnMap(const std::string& path)
+{
+	vanaheimr::as::BinaryReader reader;
+
+	try
+	{
+		delete reader.map(path);
+	}
+	catch(const std::runtime_error&)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+/*! \brief Truncated files and files that are not binaries are rejected */
+static bool testInvalid(const std::string& path)
+{
+	std::string bytes;
+
+	{
+		std::ifstream file(path.c_str(), std::ios::binary);
+
+		bytes.assign(std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>());
+	}
+
+	std::string invalid = path + ".invalid";
+
+	bool passed = true;
+
+	std::vector<std::pair<std::string, std::string>> files = {
+		{"a truncated binary",
+			bytes.substr(0, vanaheimr::as::BinaryHeader::PageSize)},
+		{"a header without a magic number", std::string(
+			sizeof(vanaheimr::as::BinaryHeader), 'x')}};
+
+	for(auto& file : files)
+	{
+		{
+			std::ofstream stream(invalid.c_str(), std::ios::binary);
+
+			stream << file.second;
+		}
+
+		if(!throwsOnMap(invalid))
+		{
+			std::cout << " " << file.first << " was mapped\n";
+			passed = false;
+		}
+	}
+
+	std::remove(invalid.c_str());
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+	std::string path;
+
+	parser.description("This program writes a binary, maps it back in, and "
+		"checks that functions are only decoded when they are "
+		"materialized.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse("-o", "--output", path, "test-binary-reader.vir",
+		"The path of the binary that is written and read back");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	auto expected = test::writeBinary(path);
+
+	bool passed = test::testMap(path, expected) &&
+		test::testRead(path, expected) && test::testInvalid(path);
+
+	std::remove(path.c_str());
+
+	if(!passed)
+	{
+		std::cout << "Binary reader test Failed\n";
+		return -1;
+	}
+
+	std::cout << "Binary reader test Passed\n";
+
+	return 0;
+}
+
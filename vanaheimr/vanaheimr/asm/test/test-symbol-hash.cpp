@@ -0,0 +1,330 @@
+/*! \file   test-symbol-hash.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for the symbol hash section of a written binary.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/asm/interface/BinaryWriter.h>
+#include <vanaheimr/asm/interface/BinaryHeader.h>
+#include <vanaheimr/asm/interface/SymbolTableEntry.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+typedef vanaheimr::as::BinaryHeader     BinaryHeader;
+typedef vanaheimr::as::SymbolTableEntry SymbolTableEntry;
+
+typedef std::vector<std::string> StringVector;
+
+/*! \brief The sections of a binary that was written to memory */
+class Binary
+{
+public:
+	Binary(const std::string& b)
+	: bytes(b)
+	{
+		std::memcpy(&header, bytes.data(), sizeof(BinaryHeader));
+	}
+
+public:
+	const SymbolTableEntry* symbols() const
+	{
+		return reinterpret_cast<const SymbolTableEntry*>(
+			bytes.data() + header.symbolOffset);
+	}
+
+	const uint32_t* hash() const
+	{
+		return reinterpret_cast<const uint32_t*>(
+			bytes.data() + header.symbolHashOffset);
+	}
+
+	const char* name(uint32_t symbol) const
+	{
+		return bytes.data() + header.stringsOffset +
+			symbols()[symbol].stringOffset;
+	}
+
+public:
+	std::string  bytes;
+	BinaryHeader header;
+};
+
+static uint32_t hashName(const std::string& name)
+{
+	uint32_t hash = BinaryHeader::FnvOffsetBasis;
+
+	for(auto character : name)
+	{
+		hash ^= (uint8_t)character;
+		hash *= BinaryHeader::FnvPrime;
+	}
+
+	return hash;
+}
+
+/*! \brief Walk the chain of the bucket that a name hashes to */
+static uint32_t findSymbol(const Binary& binary, const std::string& name)
+{
+	auto buckets = binary.header.symbolHashBuckets;
+
+	uint32_t symbol = binary.hash()[hashName(name) % buckets];
+
+	// a chain can not be longer than the symbol table
+	for(unsigned int i = 0; symbol != BinaryHeader::InvalidSymbol &&
+		i <= binary.header.symbols; ++i)
+	{
+		if(symbol >= binary.header.symbols) break;
+
+		if(name == binary.name(symbol)) return symbol;
+
+		symbol = binary.hash()[buckets + symbol];
+	}
+
+	return BinaryHeader::InvalidSymbol;
+}
+
+static void addFunction(Module& module, const std::string& name)
+{
+	auto test = newTestFunction(module, name);
+
+	test.function->newArgument(getType("i32"), "input");
+	test.function->interpretType();
+
+	newValues(test, "i32", {"value"});
+	newBlocks(test, {"body"});
+
+	auto block = test.blocks["body"];
+
+	add(block, test.values, "value", "1", "2");
+
+	auto ret = new vanaheimr::ir::Ret(block);
+
+	guard(ret);
+
+	block->push_back(ret);
+}
+
+/*! \brief Enough globals and functions that some buckets hold chains */
+static StringVector generateModule(Module& module,
+	unsigned int globals, unsigned int functions)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	StringVector names;
+
+	for(unsigned int i = 0; i < globals; ++i)
+	{
+		std::stringstream name;
+
+		name << "global_" << i;
+
+		module.newGlobal(name.str(), compiler->getType("i64"),
+			vanaheimr::ir::Variable::ExternalLinkage,
+			vanaheimr::ir::Global::Shared);
+
+		names.push_back(name.str());
+	}
+
+	for(unsigned int i = 0; i < functions; ++i)
+	{
+		std::stringstream name;
+
+		name << "function_" << i;
+
+		addFunction(module, name.str());
+
+		names.push_back(name.str());
+	}
+
+	return names;
+}
+
+static std::string writeModule(const Module& module)
+{
+	std::stringstream stream;
+
+	vanaheimr::as::BinaryWriter writer;
+
+	writer.write(stream, module);
+
+	return stream.str();
+}
+
+static bool testRoundTrip(bool verbose)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-symbol-hash");
+
+	auto names = generateModule(*module, 17, 11);
+
+	Binary binary(writeModule(*module));
+
+	compiler->deleteModule(module);
+
+	bool passed = true;
+
+	auto buckets = binary.header.symbolHashBuckets;
+	auto symbols = binary.header.symbols;
+
+	if(verbose)
+	{
+		std::cout << " " << symbols << " symbols in " << buckets
+			<< " buckets\n";
+	}
+
+	if(buckets < symbols || (buckets & (buckets - 1)) != 0 ||
+		binary.header.symbolHashOffset % BinaryHeader::PageSize != 0)
+	{
+		std::cout << " the hash section has " << buckets << " buckets at "
+			<< binary.header.symbolHashOffset << "\n";
+		return false;
+	}
+
+	if(binary.bytes.size() < binary.header.symbolHashOffset +
+		sizeof(uint32_t) * (buckets + symbols))
+	{
+		std::cout << " the hash section is past the end of the binary\n";
+		return false;
+	}
+
+	// every symbol, including the arguments, is reached from its own bucket
+	for(uint32_t symbol = 0; symbol != symbols; ++symbol)
+	{
+		if(findSymbol(binary, binary.name(symbol)) != symbol)
+		{
+			std::cout << " symbol " << binary.name(symbol)
+				<< " was not found in its bucket\n";
+			passed = false;
+		}
+	}
+
+	for(auto& name : names)
+	{
+		auto symbol = findSymbol(binary, name);
+
+		if(symbol == BinaryHeader::InvalidSymbol)
+		{
+			std::cout << " " << name << " was not found\n";
+			passed = false;
+		}
+		else if(name.find("function") == 0 &&
+			binary.symbols()[symbol].type != SymbolTableEntry::FunctionType)
+		{
+			std::cout << " " << name << " is not a function symbol\n";
+			passed = false;
+		}
+	}
+
+	for(auto name : {"global_17", "function", "", "input"})
+	{
+		if(findSymbol(binary, name) != BinaryHeader::InvalidSymbol)
+		{
+			std::cout << " '" << name << "' was found, but it is not a "
+				"symbol\n";
+			passed = false;
+		}
+	}
+
+	// each symbol is in exactly one chain
+	unsigned int chained = 0;
+
+	for(uint32_t bucket = 0; bucket != buckets; ++bucket)
+	{
+		for(uint32_t symbol = binary.hash()[bucket];
+			symbol != BinaryHeader::InvalidSymbol && chained <= symbols;
+			symbol = binary.hash()[buckets + symbol], ++chained)
+		{
+			if(symbol >= symbols || hashName(binary.name(symbol)) %
+				buckets != bucket)
+			{
+				std::cout << " bucket " << bucket << " holds a symbol that "
+					"does not hash to it\n";
+				return false;
+			}
+		}
+	}
+
+	if(chained != symbols)
+	{
+		std::cout << " the chains hold " << chained << " entries, not "
+			<< symbols << "\n";
+		passed = false;
+	}
+
+	return passed;
+}
+
+/*! \brief A module without symbols has no hash section */
+static bool testEmptyModule()
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-symbol-hash-empty");
+
+	Binary binary(writeModule(*module));
+
+	compiler->deleteModule(module);
+
+	if(binary.header.symbols != 0 || binary.header.symbolHashBuckets != 0)
+	{
+		std::cout << " an empty module has " << binary.header.symbols
+			<< " symbols and " << binary.header.symbolHashBuckets
+			<< " buckets\n";
+		return false;
+	}
+
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program writes a module to a binary and finds "
+		"each of its symbols through the symbol hash section.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testEmptyModule())
+	{
+		std::cout << "Symbol hash test Failed\n";
+		return -1;
+	}
+
+	if(!test::testRoundTrip(verbose))
+	{
+		std::cout << "Symbol hash test Failed\n";
+		return -1;
+	}
+
+	std::cout << "Symbol hash test Passed\n";
+
+	return 0;
+}
+
@@ -11,21 +11,19 @@
 
 #include <vanaheimr/machine/interface/MachineModel.h>
 
-#include <vanaheimr/machine/interface/PhysicalRegisterOperand.h>
-#include <vanaheimr/machine/interface/PhysicalIndirectOperand.h>
-
 #include <vanaheimr/compiler/interface/Compiler.h>
 
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/VirtualRegister.h>
 
-#include <vanaheimr/util/interface/SmallSet.h>
+#include <vanaheimr/util/interface/BitVector.h>
 
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
 #include <algorithm>
+#include <stdexcept>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -49,12 +47,174 @@ ChaitinBriggsRegisterAllocatorPass::ChaitinBriggsRegisterAllocatorPass()
 
 typedef analysis::InterferenceAnalysis InterferenceAnalysis;
 typedef util::LargeMap<unsigned int, unsigned int> RegisterMap;
+typedef std::vector<unsigned int> CostVector;
+
+/*! \brief A set of nodes or moves that can be updated in constant time */
+class Worklist
+{
+public:
+	explicit Worklist(size_t size = 0)
+	: _members(size), _size(0)
+	{
+	
+	}
+	
+public:
+	bool empty() const { return _size == 0; }
+	
+	bool contains(unsigned int i) const { return _members.contains(i); }
+	
+	void insert(unsigned int i)
+	{
+		if(_members.insert(i)) ++_size;
+	}
+	
+	void erase(unsigned int i)
+	{
+		if(_members.erase(i)) --_size;
+	}
+	
+	unsigned int pop()
+	{
+		assert(!empty());
+	
+		unsigned int i = *_members.begin();
+		
+		erase(i);
+		
+		return i;
+	}
+
+public:
+	util::BitVector::const_iterator begin() const { return _members.begin(); }
+	util::BitVector::const_iterator   end() const { return _members.end();   }
+
+private:
+	util::BitVector _members;
+	size_t          _size;
+};
+
+/*! \brief Iterated register coalescing as described in:
+
+	"Iterated Register Coalescing" by
+		Lal George and Andrew W. Appel
+
+	Nodes are virtual register ids.  Copies are coalesced conservatively
+	(the Briggs test), so coalescing never turns a colorable graph into
+	an uncolorable one.  The lowest free color is always selected.
+*/
+class InterferenceGraphColoring
+{
+public:
+	typedef std::vector<unsigned int> IdVector;
+	typedef std::vector<IdVector>     IdVectorVector;
+
+	class Move
+	{
+	public:
+		Move(unsigned int d, unsigned int s)
+		: destination(d), source(s)
+		{
+		
+		}
+	
+	public:
+		unsigned int destination;
+		unsigned int source;
+	};
+	
+	typedef std::vector<Move> MoveVector;
+	
+public:
+	static const unsigned int Uncolored = (unsigned int)-1;
+
+public:
+	InterferenceGraphColoring(const ir::Function& function,
+		const InterferenceAnalysis& interferences,
+		const CostVector& spillCosts, unsigned int colors);
+
+public:
+	void color();
+	
+public:
+	/*! \brief The color of each node, Uncolored for spills */
+	IdVector colors;
+
+	unsigned int coalescedMoveCount;
+
+private:
+	void _addEdge(unsigned int u, unsigned int v);
+	bool _hasEdge(unsigned int u, unsigned int v) const;
+
+	void _makeWorklists();
+	
+	void _simplify();
+	void _coalesce();
+	void _freeze();
+	void _selectSpill();
+	void _assignColors();
+	
+private:
+	IdVector _adjacent(unsigned int n) const;
+	IdVector _nodeMoves(unsigned int n) const;
+	bool     _isMoveRelated(unsigned int n) const;
+
+	void _decrementDegree(unsigned int m);
+	void _enableMoves(unsigned int n);
+	void _addWorklist(unsigned int u);
+	bool _isConservative(unsigned int u, unsigned int v) const;
+	void _combine(unsigned int u, unsigned int v);
+	void _freezeMoves(unsigned int u);
+	
+	unsigned int _getAlias(unsigned int n) const;
+
+private:
+	enum NodeState
+	{
+		Initial,
+		Simplify,
+		Freeze,
+		Spill,
+		Coalesced,
+		Selected
+	};
+
+	typedef std::vector<NodeState> NodeStateVector;
+	typedef std::vector<double>    DoubleVector;
+
+private:
+	unsigned int _nodes;
+	unsigned int _colors;
+
+	// the graph, as a triangular bit-matrix and adjacency lists
+	util::BitVector _adjacencyMatrix;
+	IdVectorVector  _adjacencyLists;
+	IdVector        _degrees;
+	
+	DoubleVector _spillCosts;
+
+	MoveVector     _moves;
+	IdVectorVector _moveLists;
+
+	NodeStateVector _states;
+	IdVector        _aliases;
+	IdVector        _selectStack;
+	
+	Worklist _simplifyWorklist;
+	Worklist _freezeWorklist;
+	Worklist _spillWorklist;
+
+	Worklist _worklistMoves;
+	Worklist _activeMoves;
+
+};
+
+const unsigned int InterferenceGraphColoring::Uncolored;
 
 static void color(RegisterAllocator::VirtualRegisterSet& spilled,
 	RegisterMap& allocated, const ir::Function& function,
-	const InterferenceAnalysis& interferences, unsigned int colors);
-static void assignRegisters(ir::Function& f,
-	const ChaitinBriggsRegisterAllocatorPass& allocator);
+	const InterferenceAnalysis& interferences, const CostVector& spillCosts,
+	unsigned int registers, unsigned int scratchRegisters);
 
 void ChaitinBriggsRegisterAllocatorPass::runOnFunction(Function& f)
 {
@@ -67,17 +227,35 @@ void ChaitinBriggsRegisterAllocatorPass::runOnFunction(Function& f)
 	
 	_machine = compiler::Compiler::getSingleton()->getMachineModel();
 	
-	// attempt to color the interferences
-	color(_spilled, _allocated, f, *interferenceAnalysis,
-		_machine->totalRegisterCount());
+	auto& allocation = _allocations[&f];
+	
+	allocation = Allocation();
 	
-	// TODO: spill if allocation fails
-	assertM(_spilled.empty(), "No support for spills yet.");
+	unsigned int registers        = _machine->totalRegisterCount();
+	unsigned int scratchRegisters = computeScratchRegisterCount(f);
 	
-	// TODO: Map colors to registers
+	// attempt to color the interferences, spilling if there are too few
+	//  registers
+	color(allocation.spilled, allocation.allocated, f, *interferenceAnalysis,
+		computeSpillCosts(f), registers, scratchRegisters);
 	
-	// Assign registers
-	assignRegisters(f, *this);
+	// the registers above the highest color are left for spill code
+	if(!allocation.spilled.empty())
+	{
+		for(unsigned int id = registers - scratchRegisters;
+			id < registers; ++id)
+		{
+			allocation.scratch.push_back(_machine->getPhysicalRegister(id));
+		}
+	}
+	
+	// Assign registers, spilled values are left without one
+	assignRegisters(f);
+	
+	// Copies between coalesced values are now no-ops
+	unsigned int removed = removeCoalescedCopies(f);
+	
+	report(" Removed " << removed << " coalesced moves.");
 }
 
 transforms::Pass* ChaitinBriggsRegisterAllocatorPass::clone() const
@@ -86,319 +264,540 @@ transforms::Pass* ChaitinBriggsRegisterAllocatorPass::clone() const
 }
 
 RegisterAllocator::VirtualRegisterSet
-	ChaitinBriggsRegisterAllocatorPass::getSpilledRegisters()
+	ChaitinBriggsRegisterAllocatorPass::getSpilledRegisters(const Function& f)
 {
-	return _spilled;
+	auto allocation = _allocations.find(&f);
+	
+	if(allocation == _allocations.end()) return VirtualRegisterSet();
+	
+	return allocation->second.spilled;
 }
 
 const machine::PhysicalRegister*
 	ChaitinBriggsRegisterAllocatorPass::getPhysicalRegister(
 	const ir::VirtualRegister& vr) const
 {
-	auto allocatedRegister = _allocated.find(vr.id);
+	auto allocation = _allocations.find(vr.function);
 	
-	if(allocatedRegister == _allocated.end()) return nullptr;
+	if(allocation == _allocations.end()) return nullptr;
+	
+	auto& allocated = allocation->second.allocated;
+	
+	auto allocatedRegister = allocated.find(vr.id);
+	
+	if(allocatedRegister == allocated.end()) return nullptr;
 	
 	return _machine->getPhysicalRegister(allocatedRegister->second);
 }
 
-class RegisterInfo
+RegisterAllocator::PhysicalRegisterVector
+	ChaitinBriggsRegisterAllocatorPass::getScratchRegisters(
+	const Function& f) const
 {
-public:
-	RegisterInfo(const ir::VirtualRegister* r, unsigned int d = 0,
-		unsigned int c = 0, unsigned int s = 0, bool f = false)
-	: virtualRegister(r), nodeDegree(d), color(c), schedulingOrder(s),
-		finished(f)
-	{
+	auto allocation = _allocations.find(&f);
 	
-	}
-
-public:
-	const ir::VirtualRegister* virtualRegister;
-	unsigned int               nodeDegree;
-	unsigned int               color;
-	unsigned int               schedulingOrder;
-	bool                       finished;
-
-};
-
-typedef std::vector<RegisterInfo> RegisterInfoVector;
+	if(allocation == _allocations.end()) return PhysicalRegisterVector();
 	
-typedef util::SmallSet<unsigned int> ColorSet;
-typedef std::vector<unsigned int> ColorVector;
+	return allocation->second.scratch;
+}
 
-static unsigned int randomColorThatDoesntCollide(ColorSet& usedColors,
-	unsigned int maxColor)
+static unsigned int getRegisterId(const ir::Operand* operand)
 {
-	ColorSet unusedColors;
+	return static_cast<const ir::RegisterOperand*>(
+		operand)->virtualRegister->id;
+}
+
+InterferenceGraphColoring::InterferenceGraphColoring(
+	const ir::Function& function, const InterferenceAnalysis& interferences,
+	const CostVector& spillCosts, unsigned int colors)
+: colors(function.register_id_bound(), Uncolored), coalescedMoveCount(0),
+  _nodes(function.register_id_bound()), _colors(colors),
+  _adjacencyMatrix((size_t)_nodes * _nodes / 2),
+  _adjacencyLists(_nodes), _degrees(_nodes, 0),
+  _spillCosts(spillCosts.begin(), spillCosts.end()), _moveLists(_nodes),
+  _states(_nodes, Initial), _aliases(_nodes),
+  _simplifyWorklist(_nodes), _freezeWorklist(_nodes), _spillWorklist(_nodes)
+{
+	for(unsigned int n = 0; n < _nodes; ++n) _aliases[n] = n;
 	
-	for(unsigned int i = 0; i < maxColor; ++i)
+	// Build the graph
+	for(auto reg = function.register_begin();
+		reg != function.register_end(); ++reg)
 	{
-		if(usedColors.count(i) != 0) continue;
-		
-		unusedColors.insert(i);
+		assert(reg->id < _nodes);
+	
+		for(auto interference : interferences.getInterferences(reg->id))
+		{
+			_addEdge(reg->id, interference);
+		}
 	}
 	
-	ColorVector availableColors(unusedColors.begin(), unusedColors.end());
+	// Find copies
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			if(RegisterAllocator::isCopy(*instruction))
+			{
+				auto bitcast = static_cast<const ir::Bitcast*>(instruction);
+			
+				_moves.push_back(Move(getRegisterId(bitcast->d()),
+					getRegisterId(bitcast->a())));
+			}
+			else if(instruction->isPhi())
+			{
+				auto phi = static_cast<const ir::Phi*>(instruction);
+				
+				for(auto source : phi->sources())
+				{
+					_moves.push_back(Move(getRegisterId(phi->d()),
+						getRegisterId(source)));
+				}
+			}
+		}
+	}
 	
-	return availableColors[std::rand() % availableColors.size()];
+	_worklistMoves = Worklist(_moves.size());
+	_activeMoves   = Worklist(_moves.size());
+	
+	for(unsigned int m = 0; m < _moves.size(); ++m)
+	{
+		_moveLists[_moves[m].destination].push_back(m);
+		_moveLists[_moves[m].source].push_back(m);
+		
+		_worklistMoves.insert(m);
+	}
 }
 
-static unsigned int computeColor(bool& finished, const RegisterInfo& reg,
-	const RegisterInfoVector& registerInfo,
-	const InterferenceAnalysis& interferences)
+void InterferenceGraphColoring::color()
 {
-	ColorSet usedColors;
-
-	// Fix the color after the scheduling order window has passed
-	if(reg.finished) return reg.color;
-	
-	auto regInterferences =
-		interferences.getInterferences(*reg.virtualRegister);
+	_makeWorklists();
 	
-	finished = true;
+	while(true)
+	{
+		if(!_simplifyWorklist.empty())   _simplify();
+		else if(!_worklistMoves.empty()) _coalesce();
+		else if(!_freezeWorklist.empty()) _freeze();
+		else if(!_spillWorklist.empty())  _selectSpill();
+		else break;
+	}
 	
-	unsigned int predecessorCount = 0;
+	_assignColors();
+}
+
+void InterferenceGraphColoring::_addEdge(unsigned int u, unsigned int v)
+{
+	if(u == v || _hasEdge(u, v)) return;
 	
-	for(auto interference : regInterferences)
-	{
-		assert(interference->id < registerInfo.size());
+	unsigned int high = std::max(u, v);
+	unsigned int low  = std::min(u, v);
 	
-		const RegisterInfo& info = registerInfo[interference->id];
+	_adjacencyMatrix.insert((size_t)high * (high - 1) / 2 + low);
 
-		if(info.schedulingOrder > reg.schedulingOrder) continue;
+	_adjacencyLists[u].push_back(v);
+	_adjacencyLists[v].push_back(u);
 	
-		++predecessorCount;
+	++_degrees[u];
+	++_degrees[v];
+}
+
+bool InterferenceGraphColoring::_hasEdge(unsigned int u, unsigned int v) const
+{
+	if(u == v) return false;
 	
-		finished &= info.finished;
+	unsigned int high = std::max(u, v);
+	unsigned int low  = std::min(u, v);
 	
-		usedColors.insert(info.color);
+	return _adjacencyMatrix.contains((size_t)high * (high - 1) / 2 + low);
+}
+
+void InterferenceGraphColoring::_makeWorklists()
+{
+	for(unsigned int n = 0; n < _nodes; ++n)
+	{
+		if(_degrees[n] >= _colors)
+		{
+			_states[n] = Spill;
+			_spillWorklist.insert(n);
+		}
+		else if(_isMoveRelated(n))
+		{
+			_states[n] = Freeze;
+			_freezeWorklist.insert(n);
+		}
+		else
+		{
+			_states[n] = Simplify;
+			_simplifyWorklist.insert(n);
+		}
 	}
+}
+
+void InterferenceGraphColoring::_simplify()
+{
+	unsigned int n = _simplifyWorklist.pop();
 	
-	unsigned int spread = usedColors.size() + 1;
+	_states[n] = Selected;
+	_selectStack.push_back(n);
 	
-	// Define the range of possible colors [0 to usedRegisterCount]
-	if(finished && (usedColors.count(reg.color) != 0 || reg.color >= spread))
+	for(auto m : _adjacent(n))
 	{
-		return randomColorThatDoesntCollide(usedColors, spread);
+		_decrementDegree(m);
 	}
+}
+
+void InterferenceGraphColoring::_coalesce()
+{
+	unsigned int m = _worklistMoves.pop();
 	
-	// keep the original color if it doesn't collide
-	if(usedColors.count(reg.color) == 0)
+	unsigned int u = _getAlias(_moves[m].destination);
+	unsigned int v = _getAlias(_moves[m].source);
+	
+	if(u == v)
 	{
-		return reg.color;
+		++coalescedMoveCount;
+		_addWorklist(u);
 	}
+	else if(_hasEdge(u, v))
+	{
+		// constrained, the values are live at the same time
+		_addWorklist(u);
+		_addWorklist(v);
+	}
+	else if(_isConservative(u, v))
+	{
+		++coalescedMoveCount;
+		_combine(u, v);
+		_addWorklist(u);
+	}
+	else
+	{
+		_activeMoves.insert(m);
+	}
+}
+
+void InterferenceGraphColoring::_freeze()
+{
+	unsigned int u = _freezeWorklist.pop();
 	
-	// Otherwise, assign a new register randomly in the possible window
-	unsigned int maxColor = predecessorCount + 1;
+	_states[u] = Simplify;
+	_simplifyWorklist.insert(u);
 	
-	return randomColorThatDoesntCollide(usedColors, maxColor);
+	_freezeMoves(u);
 }
 
-static bool propagateColorsInParallel(RegisterInfoVector& registers,
-	unsigned int iteration, const InterferenceAnalysis& interferences)
+void InterferenceGraphColoring::_selectSpill()
 {
-	report("  -------------------- Iteration "
-		<< iteration << " ------------------");
-
-	RegisterInfoVector newRegisters;
+	// Prefer cheap values that free up the most neighbors
+	unsigned int candidate = Uncolored;
+	double       candidateCost = 0.0;
 	
-	newRegisters.reserve(registers.size());
-	bool changed = false;
-	
-	for(auto reg = registers.begin(); reg != registers.end(); ++reg)
+	for(auto n : _spillWorklist)
 	{
-		bool predecessorsFinished = true;
-		unsigned int newColor = computeColor(predecessorsFinished, *reg,
-			registers, interferences);
-
-		newRegisters.push_back(RegisterInfo(reg->virtualRegister,
-			reg->nodeDegree, newColor, reg->schedulingOrder,
-			predecessorsFinished));
-
-		changed |= reg->color != newColor;
-
-		reportE(reg->color != newColor,
-			"   vr" << reg->virtualRegister->id
-			<< " (degree " << reg->nodeDegree
-			<< ") | (color " << reg->color << ") -> (color " << newColor
-			<< ")");
+		double cost = _spillCosts[n] / (_degrees[n] + 1);
+		
+		if(candidate == Uncolored || cost < candidateCost)
+		{
+			candidate     = n;
+			candidateCost = cost;
+		}
 	}
 	
-	registers = std::move(newRegisters);
+	report("  potential spill vr" << candidate << " (cost "
+		<< _spillCosts[candidate] << ", degree " << _degrees[candidate] << ")");
 	
-	return changed;
+	_spillWorklist.erase(candidate);
+	
+	_states[candidate] = Simplify;
+	_simplifyWorklist.insert(candidate);
+	
+	_freezeMoves(candidate);
 }
 
-static void initializeColors(RegisterInfoVector& registers,
-	const InterferenceAnalysis& interferences)
+void InterferenceGraphColoring::_assignColors()
 {
-	// initialize the register randomly in the possible range
-	for(auto& reg : registers)
+	util::BitVector usedColors(_colors);
+
+	while(!_selectStack.empty())
 	{
-		auto regInterferences =
-			interferences.getInterferences(*reg.virtualRegister);
+		unsigned int n = _selectStack.back();
+		_selectStack.pop_back();
 	
-		unsigned int predecessorCount = 0;
+		usedColors.clear();
 	
-		for(auto interference : regInterferences)
+		for(auto w : _adjacencyLists[n])
 		{
-			assert(interference->id < registers.size());
-	
-			const RegisterInfo& info = registers[interference->id];
-
-			if(info.schedulingOrder > reg.schedulingOrder) continue;
+			unsigned int color = colors[_getAlias(w)];
+			
+			if(color != Uncolored) usedColors.insert(color);
+		}
+		
+		for(unsigned int color = 0; color < _colors; ++color)
+		{
+			if(usedColors.contains(color)) continue;
 			
-			++predecessorCount;
+			colors[n] = color;
+			break;
 		}
 		
-		unsigned int maxColor = predecessorCount + 1;
+		reportE(colors[n] == Uncolored, "  spilling vr" << n);
+	}
 	
-		reg.color = std::rand() % maxColor;
+	for(unsigned int n = 0; n < _nodes; ++n)
+	{
+		if(_states[n] == Coalesced) colors[n] = colors[_getAlias(n)];
 	}
 }
 
-static void initializeSchedulingOrder(RegisterInfoVector& registerInfo)
+InterferenceGraphColoring::IdVector InterferenceGraphColoring::_adjacent(
+	unsigned int n) const
 {
-	typedef std::pair<unsigned int, RegisterInfo*> DegreeAndInfoPair;
-	typedef std::vector<DegreeAndInfoPair>         DegreeAndInfoVector;
-	
-	report(" Ranking registers by interference graph node degree");
+	IdVector adjacent;
 	
-	DegreeAndInfoVector degrees;
+	for(auto m : _adjacencyLists[n])
+	{
+		if(_states[m] == Selected || _states[m] == Coalesced) continue;
+		
+		adjacent.push_back(m);
+	}
 	
-	degrees.reserve(registerInfo.size());
+	return adjacent;
+}
+
+InterferenceGraphColoring::IdVector InterferenceGraphColoring::_nodeMoves(
+	unsigned int n) const
+{
+	IdVector moves;
 	
-	for(auto info = registerInfo.begin(); info != registerInfo.end(); ++info)
+	for(auto m : _moveLists[n])
 	{
-		degrees.push_back(std::make_pair(info->nodeDegree, &*info));
+		if(_activeMoves.contains(m) || _worklistMoves.contains(m))
+		{
+			moves.push_back(m);
+		}
 	}
 	
-	// Sort by node degree (parallel)
-	std::sort(degrees.begin(), degrees.end(),
-		std::greater<DegreeAndInfoPair>());
+	return moves;
+}
 
-	for(auto degree = degrees.begin(); degree != degrees.end(); ++degree)
+bool InterferenceGraphColoring::_isMoveRelated(unsigned int n) const
+{
+	for(auto m : _moveLists[n])
 	{
-		report("  vr" << degree->second->virtualRegister->id
-			<< " (" << degree->first << ")");
-		degree->second->schedulingOrder =
-			std::distance(degrees.begin(), degree);
+		if(_activeMoves.contains(m) || _worklistMoves.contains(m))
+		{
+			return true;
+		}
 	}
+	
+	return false;
 }
 
-static void color(RegisterAllocator::VirtualRegisterSet& spilled,
-	RegisterMap& allocated, const ir::Function& function,
-	const InterferenceAnalysis& interferences, unsigned int colors)
+void InterferenceGraphColoring::_decrementDegree(unsigned int m)
 {
-	//std::srand(std::time(0));
-	std::srand(0);
+	unsigned int degree = _degrees[m]--;
 	
-	// Create a map from node degree to virtual register
-	RegisterInfoVector registers;
+	if(degree != _colors) return;
 	
-	registers.reserve(function.register_size());
+	_enableMoves(m);
 	
-	for(auto reg = function.register_begin();
-		reg != function.register_end(); ++reg)
+	for(auto n : _adjacent(m))
 	{
-		registers.push_back(RegisterInfo(&*reg,
-			interferences.getInterferences(*reg).size()));
+		_enableMoves(n);
 	}
 	
-	// Initialize scheduling order for each node
-	initializeSchedulingOrder(registers);
+	_spillWorklist.erase(m);
 	
-	// Initialize the colors
-	initializeColors(registers, interferences);
-	
-	// Propagate colors until converged
-	report(" Propating colors until converged.");
-	
-	unsigned int iteration = 0;
-	bool changed = true;
-	
-	while(changed)
+	if(_isMoveRelated(m))
 	{
-		changed = propagateColorsInParallel(registers,
-			iteration++, interferences);
+		_states[m] = Freeze;
+		_freezeWorklist.insert(m);
+	}
+	else
+	{
+		_states[m] = Simplify;
+		_simplifyWorklist.insert(m);
+	}
+}
+
+void InterferenceGraphColoring::_enableMoves(unsigned int n)
+{
+	for(auto m : _nodeMoves(n))
+	{
+		if(!_activeMoves.contains(m)) continue;
 		
-		// Check iteration count
-		assertM(iteration <= colors, "Too many iterations: " << iteration);
+		_activeMoves.erase(m);
+		_worklistMoves.insert(m);
 	}
+}
+
+void InterferenceGraphColoring::_addWorklist(unsigned int u)
+{
+	if(_isMoveRelated(u) || _degrees[u] >= _colors) return;
 	
-	report("  -------------------- Iteration Count "
-		<< iteration << " ------------------");
+	if(_states[u] != Freeze) return;
 	
-	// finish
-	report("  Final report");
-	unsigned int score = 0;
+	_freezeWorklist.erase(u);
 	
-	for(auto& reg : registers)
+	_states[u] = Simplify;
+	_simplifyWorklist.insert(u);
+}
+
+bool InterferenceGraphColoring::_isConservative(unsigned int u,
+	unsigned int v) const
+{
+	// Briggs: the combined node has fewer than K neighbors of significant
+	//  degree
+	util::BitVector neighbors(_nodes);
+	
+	unsigned int significant = 0;
+	
+	for(auto node : {u, v})
 	{
-		allocated.insert(std::make_pair(reg.virtualRegister->id, reg.color));
-		
-		score += reg.color;
-		
-		report("   vr" << reg.virtualRegister->id
-			<< " (degree " << reg.nodeDegree
-			<< ") | (color " << reg.color << ")");
+		for(auto n : _adjacent(node))
+		{
+			if(!neighbors.insert(n)) continue;
+			
+			// a neighbor of both loses one edge when they are combined
+			unsigned int degree = _degrees[n];
+			
+			if(_hasEdge(n, u) && _hasEdge(n, v)) --degree;
+			
+			if(degree >= _colors) ++significant;
+		}
 	}
-
-	report("  allocation score " << score);
 	
+	return significant < _colors;
 }
 
-static void replaceVirtualRegisterWithPhysical(ir::Operand*& operand,
-	const ChaitinBriggsRegisterAllocatorPass& allocator)
+void InterferenceGraphColoring::_combine(unsigned int u, unsigned int v)
 {
-	if(!operand->isRegister()) return;
-
-	auto newOperand = operand;
-	
-	if(operand->isIndirect())
+	if(_states[v] == Freeze)
 	{
-		auto indirectOperand = static_cast<ir::IndirectOperand*>(operand);
-		
-		newOperand = new machine::PhysicalIndirectOperand(
-			allocator.getPhysicalRegister(*indirectOperand->virtualRegister),
-			indirectOperand->virtualRegister, indirectOperand->offset,
-			indirectOperand->instruction);
+		_freezeWorklist.erase(v);
 	}
 	else
 	{
-		auto registerOperand = static_cast<ir::RegisterOperand*>(operand);
+		_spillWorklist.erase(v);
+	}
+	
+	_states[v]  = Coalesced;
+	_aliases[v] = u;
+	
+	_moveLists[u].insert(_moveLists[u].end(), _moveLists[v].begin(),
+		_moveLists[v].end());
 	
-		newOperand = new machine::PhysicalRegisterOperand(
-			allocator.getPhysicalRegister(*registerOperand->virtualRegister),
-			registerOperand->virtualRegister, registerOperand->instruction);
+	_spillCosts[u] += _spillCosts[v];
+	
+	_enableMoves(v);
+	
+	for(auto t : _adjacent(v))
+	{
+		_addEdge(t, u);
+		_decrementDegree(t);
 	}
-
-	delete operand;
 	
-	operand = newOperand;
+	if(_degrees[u] >= _colors && _states[u] == Freeze)
+	{
+		_freezeWorklist.erase(u);
+		
+		_states[u] = Spill;
+		_spillWorklist.insert(u);
+	}
 }
 
-static void assignRegisters(ir::Function& f,
-	const ChaitinBriggsRegisterAllocatorPass& allocator)
+void InterferenceGraphColoring::_freezeMoves(unsigned int u)
 {
-	for(auto& block : f)
+	for(auto m : _nodeMoves(u))
 	{
-		for(auto& instruction : block)
+		unsigned int x = _moves[m].destination;
+		unsigned int y = _moves[m].source;
+		
+		unsigned int v = _getAlias(y) == _getAlias(u) ?
+			_getAlias(x) : _getAlias(y);
+		
+		_activeMoves.erase(m);
+		_worklistMoves.erase(m);
+		
+		if(_states[v] == Freeze && !_isMoveRelated(v) &&
+			_degrees[v] < _colors)
 		{
-			for(auto& read : instruction->reads)
-			{
-				replaceVirtualRegisterWithPhysical(read, allocator);
-			}
-
-			for(auto& write : instruction->writes)
-			{
-				replaceVirtualRegisterWithPhysical(write, allocator);
-			}
+			_freezeWorklist.erase(v);
+			
+			_states[v] = Simplify;
+			_simplifyWorklist.insert(v);
 		}
 	}
 }
 
+unsigned int InterferenceGraphColoring::_getAlias(unsigned int n) const
+{
+	while(_states[n] == Coalesced) n = _aliases[n];
+	
+	return n;
+}
+
+static void color(RegisterAllocator::VirtualRegisterSet& spilled,
+	RegisterMap& allocated, const ir::Function& function,
+	const InterferenceAnalysis& interferences, const CostVector& spillCosts,
+	unsigned int registerCount, unsigned int scratchRegisters)
+{
+	std::unique_ptr<InterferenceGraphColoring> coloring(
+		new InterferenceGraphColoring(function, interferences, spillCosts,
+		registerCount));
+	
+	coloring->color();
+	
+	bool needsSpills = std::count(coloring->colors.begin(),
+		coloring->colors.end(), InterferenceGraphColoring::Uncolored) != 0;
+	
+	// If there are too few registers, hold some back for spill code and
+	//  color again with the rest
+	if(needsSpills)
+	{
+		if(scratchRegisters >= registerCount)
+		{
+			throw std::runtime_error("Too few registers in the machine model "
+				"to hold the operands of a single instruction in "
+				+ function.name());
+		}
+		
+		unsigned int colors = registerCount - scratchRegisters;
+		
+		report(" Spilling, " << colors << " registers are available after "
+			"reserving " << scratchRegisters << " for spill code.");
+		
+		coloring.reset(new InterferenceGraphColoring(function, interferences,
+			spillCosts, colors));
+		
+		coloring->color();
+	}
+	
+	report("  Final report");
+	
+	unsigned int registers = 0;
+	
+	for(auto reg = function.register_begin();
+		reg != function.register_end(); ++reg)
+	{
+		unsigned int color = coloring->colors[reg->id];
+	
+		if(color == InterferenceGraphColoring::Uncolored)
+		{
+			spilled.insert(const_cast<ir::VirtualRegister*>(&*reg));
+			continue;
+		}
+		
+		allocated.insert(std::make_pair(reg->id, color));
+		
+		registers = std::max(registers, color + 1);
+		
+		report("   vr" << reg->id << " | (color " << color << ")");
+	}
+
+	report("  " << registers << " registers used, " << spilled.size()
+		<< " spilled, " << coloring->coalescedMoveCount << " moves coalesced");
+}
 
 }
 
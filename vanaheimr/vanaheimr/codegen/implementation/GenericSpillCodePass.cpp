@@ -9,9 +9,37 @@
 
 #include <vanaheimr/codegen/interface/RegisterAllocator.h>
 
+#include <vanaheimr/abi/interface/ApplicationBinaryInterface.h>
+
+#include <vanaheimr/machine/interface/MachineModel.h>
+#include <vanaheimr/machine/interface/PhysicalRegisterOperand.h>
+#include <vanaheimr/machine/interface/PhysicalPredicateOperand.h>
+#include <vanaheimr/machine/interface/PhysicalIndirectOperand.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+#include <vanaheimr/util/interface/LargeMap.h>
+#include <vanaheimr/util/interface/SmallSet.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
+// Standard Library Includes
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
 namespace vanaheimr
 {
 
@@ -19,28 +47,688 @@ namespace codegen
 {
 
 GenericSpillCodePass::GenericSpillCodePass()
-: FunctionPass({}, "GenericSpillCodePass")
+: FunctionPass({}, "GenericSpillCodePass"), abiName("archaeopteryx")
 {
 
 }
 
+typedef RegisterAllocator::VirtualRegisterSet       VirtualRegisterSet;
+typedef RegisterAllocator::PhysicalRegisterVector   PhysicalRegisterVector;
+typedef util::LargeMap<unsigned int, uint64_t>         SpillSlotMap;
+typedef util::LargeMap<unsigned int, ir::Instruction*> InstructionMap;
+
+class SpillStatistics
+{
+public:
+	SpillStatistics();
+
+public:
+	unsigned int spilledRegisters;
+	unsigned int rematerializedRegisters;
+	unsigned int loads;
+	unsigned int stores;
+	unsigned int rematerializations;
+	uint64_t     bytes;
+
+};
+
+/*! \brief Rewrites the accesses to spilled values in one block at a time */
+class SpillCodeGenerator
+{
+public:
+	SpillCodeGenerator(const VirtualRegisterSet& spilled,
+		const PhysicalRegisterVector& scratch, const SpillSlotMap& slots,
+		const InstructionMap& rematerializable,
+		const machine::PhysicalRegister* frameRegister,
+		ir::VirtualRegister* frame, SpillStatistics& statistics);
+
+public:
+	void spill(ir::BasicBlock& block);
+
+private:
+	typedef ir::BasicBlock::iterator     iterator;
+	typedef util::SmallSet<unsigned int> IdSet;
+	typedef std::vector<unsigned int>    IdVector;
+
+private:
+	void _spill(ir::BasicBlock& block, iterator instruction, iterator next);
+
+	unsigned int _findScratch(unsigned int id) const;
+	unsigned int _selectScratch(const IdSet& pinned) const;
+
+	void _reload(ir::BasicBlock& block, iterator position,
+		ir::VirtualRegister* value, unsigned int scratch);
+	void _store(ir::BasicBlock& block, iterator position,
+		ir::VirtualRegister* value, unsigned int scratch);
+
+	void _rewrite(ir::Operand*& operand, unsigned int scratch);
+
+	bool _isSpilled(const ir::Operand* operand) const;
+	ir::VirtualRegister* _value(const ir::Operand* operand) const;
+
+private:
+	static const unsigned int Empty = (unsigned int)-1;
+
+private:
+	const VirtualRegisterSet&     _spilled;
+	const PhysicalRegisterVector& _scratch;
+	const SpillSlotMap&           _slots;
+	const InstructionMap&         _rematerializable;
+	SpillStatistics&              _statistics;
+
+	// Holds the address of the spill slots of the running thread
+	const machine::PhysicalRegister* _frameRegister;
+	ir::VirtualRegister*             _frame;
+
+private:
+	// The value held in each scratch register, valid within a block
+	IdVector     _values;
+	IdVector     _lastUses;
+	unsigned int _time;
+
+};
+
+const unsigned int SpillCodeGenerator::Empty;
+
+static InstructionMap findRematerializableRegisters(ir::Function& function,
+	const VirtualRegisterSet& spilled);
+static uint64_t layoutSpillSlots(SpillSlotMap& slots,
+	const VirtualRegisterSet& spilled, const InstructionMap& rematerializable);
+static ir::VirtualRegister* computeFrameAddress(ir::Function& function,
+	const machine::PhysicalRegister* frameRegister,
+	const machine::PhysicalRegister* threadIdRegister,
+	const abi::FixedAddressRegion& localRegion);
+
 void GenericSpillCodePass::runOnFunction(Function& f)
 {
 	auto pass = static_cast<RegisterAllocator*>(getPass("register-allocator"));
 	assert(pass != nullptr);
-	
-	auto spilled = pass->getSpilledRegisters();
-	
-	assertM(spilled.empty(), "Spilling not implemented");	
+
+	auto spilled = pass->getSpilledRegisters(f);
+
+	if(spilled.empty())
+	{
+		hydrazine::log("GenericSpillCodePass") << "Function '" << f.name()
+			<< "': no registers were spilled\n";
+		return;
+	}
+
+	auto scratch = pass->getScratchRegisters(f);
+
+	assertM(scratch.size() > 1, "The register allocator spilled values "
+		"without reserving scratch registers.");
+
+	auto abi = abi::ApplicationBinaryInterface::getABI(abiName);
+
+	if(abi == nullptr)
+	{
+		throw std::runtime_error("Spill code generation failed, there is no "
+			"ABI named '" + abiName + "'.");
+	}
+
+	auto region = abi->findRegion("local");
+
+	if(region == nullptr)
+	{
+		throw std::runtime_error("Spill code generation failed, the '" +
+			abiName + "' ABI has no local memory region.");
+	}
+
+	assertM(region->isFixed(), "Only fixed local memory regions are "
+		"supported for spill slots.");
+
+	auto localRegion = static_cast<const abi::FixedAddressRegion*>(region);
+
+	auto threadId = abi->findVariable("global_tid");
+
+	if(threadId == nullptr || threadId->binding() !=
+		abi::ApplicationBinaryInterface::BoundVariable::Register)
+	{
+		throw std::runtime_error("Spill code generation failed, the '" +
+			abiName + "' ABI has no register holding the global thread id.");
+	}
+
+	auto threadIdRegisterName = static_cast<const
+		abi::ApplicationBinaryInterface::RegisterBoundVariable*>(
+		threadId)->registerName;
+
+	auto threadIdRegister = compiler::Compiler::getSingleton()->
+		getMachineModel()->findPhysicalRegister(threadIdRegisterName);
+
+	if(threadIdRegister == nullptr)
+	{
+		throw std::runtime_error("Spill code generation failed, the machine "
+			"model has no register named '" + threadIdRegisterName + "'.");
+	}
+
+	auto rematerializable = findRematerializableRegisters(f, spilled);
+
+	SpillStatistics statistics;
+	SpillSlotMap    slots;
+
+	statistics.spilledRegisters        = spilled.size();
+	statistics.rematerializedRegisters = rematerializable.size();
+	statistics.bytes = layoutSpillSlots(slots, spilled, rematerializable);
+
+	if(statistics.bytes > localRegion->bytes)
+	{
+		std::stringstream message;
+
+		message << "Spill code generation failed, " << f.name() << " needs "
+			<< statistics.bytes << " bytes of spill slots, but the local "
+			"memory region only holds " << localRegion->bytes << " bytes.";
+
+		throw std::runtime_error(message.str());
+	}
+
+	// The last scratch register holds the frame for the whole function
+	auto frameRegister = scratch.back();
+
+	scratch.pop_back();
+
+	auto frame = computeFrameAddress(f, frameRegister, threadIdRegister,
+		*localRegion);
+
+	SpillCodeGenerator generator(spilled, scratch, slots, rematerializable,
+		frameRegister, frame, statistics);
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		generator.spill(*block);
+	}
+
+	// Every use now recomputes the constant
+	for(auto definition : rematerializable)
+	{
+		definition.second->eraseFromBlock();
+	}
+
+	hydrazine::log("GenericSpillCodePass") << "Function '" << f.name()
+		<< "': spilled " << statistics.spilledRegisters << " registers ("
+		<< statistics.rematerializedRegisters << " rematerialized), "
+		<< statistics.bytes << " bytes of local memory, "
+		<< statistics.loads << " loads, " << statistics.stores
+		<< " stores, " << statistics.rematerializations
+		<< " rematerializations\n";
 }
 
 transforms::Pass* GenericSpillCodePass::clone() const
 {
-	return new GenericSpillCodePass;
+	auto pass = new GenericSpillCodePass;
+
+	pass->abiName = abiName;
+
+	return pass;
+}
+
+transforms::Pass::StringVector
+	GenericSpillCodePass::getPreservedAnalyses() const
+{
+	return getControlFlowAnalyses();
+}
+
+static bool isRematerializable(const ir::Instruction* instruction)
+{
+	if(instruction->opcode != ir::Instruction::Bitcast) return false;
+
+	auto bitcast = static_cast<const ir::Bitcast*>(instruction);
+
+	if(bitcast->guard() == nullptr || !bitcast->guard()->isAlwaysTrue())
+	{
+		return false;
+	}
+
+	return bitcast->a() != nullptr && bitcast->a()->isImmediate();
+}
+
+static InstructionMap findRematerializableRegisters(ir::Function& function,
+	const VirtualRegisterSet& spilled)
+{
+	typedef util::LargeMap<unsigned int, unsigned int> CountMap;
+
+	InstructionMap definitions;
+	CountMap       definitionCounts;
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(write == nullptr || !write->isRegister()) continue;
+				if(write->isIndirect()) continue;
+
+				auto value = static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister;
+
+				if(spilled.count(value) == 0) continue;
+
+				++definitionCounts[value->id];
+
+				definitions[value->id] = instruction;
+			}
+		}
+	}
+
+	InstructionMap rematerializable;
+
+	for(auto definition : definitions)
+	{
+		if(definitionCounts[definition.first] != 1)   continue;
+		if(!isRematerializable(definition.second)) continue;
+
+		rematerializable.insert(definition);
+	}
+
+	return rematerializable;
+}
+
+static uint64_t align(uint64_t address, uint64_t alignment)
+{
+	uint64_t remainder = address % alignment;
+	uint64_t offset = remainder == 0 ? 0 : alignment - remainder;
+
+	return address + offset;
+}
+
+static bool compareIds(const ir::VirtualRegister* left,
+	const ir::VirtualRegister* right)
+{
+	return left->id < right->id;
+}
+
+static uint64_t layoutSpillSlots(SpillSlotMap& slots,
+	const VirtualRegisterSet& spilled, const InstructionMap& rematerializable)
+{
+	typedef std::vector<ir::VirtualRegister*> VirtualRegisterVector;
+
+	// Lay out slots in a deterministic order
+	VirtualRegisterVector values(spilled.begin(), spilled.end());
+
+	std::sort(values.begin(), values.end(), compareIds);
+
+	uint64_t offset = 0;
+
+	for(auto value : values)
+	{
+		if(rematerializable.count(value->id) != 0) continue;
+
+		offset = align(offset, value->type->alignment());
+
+		hydrazine::log("GenericSpillCodePass") << " Spill slot for "
+			<< value->toString() << " at offset " << offset << "\n";
+
+		slots.insert(std::make_pair(value->id, offset));
+
+		offset += value->type->bytes();
+	}
+
+	return offset;
+}
+
+/*! \brief Point a register at the local memory window of the running thread
+
+	Each thread has its own window, so the first instructions of the
+	function compute 'frame = global_tid * window bytes + window address'.
+	The thread id register is read before any allocated code runs.
+*/
+static ir::VirtualRegister* computeFrameAddress(ir::Function& function,
+	const machine::PhysicalRegister* frameRegister,
+	const machine::PhysicalRegister* threadIdRegister,
+	const abi::FixedAddressRegion& localRegion)
+{
+	auto addressType = compiler::Compiler::getSingleton()->getType("i64");
+	assert(addressType != nullptr);
+
+	auto frame    = &*function.newVirtualRegister(addressType, "spill_frame");
+	auto threadId = &*function.newVirtualRegister(addressType, "global_tid");
+
+	auto& entry = *function.entry_block();
+
+	auto offset = new ir::Mul(&entry);
+
+	offset->setGuard(new ir::PredicateOperand(
+		ir::PredicateOperand::PredicateTrue, offset));
+	offset->setD(new machine::PhysicalRegisterOperand(frameRegister, frame,
+		offset));
+	offset->setA(new machine::PhysicalRegisterOperand(threadIdRegister,
+		threadId, offset));
+	offset->setB(new ir::ImmediateOperand((uint64_t)localRegion.bytes, offset,
+		addressType));
+
+	auto address = new ir::Add(&entry);
+
+	address->setGuard(new ir::PredicateOperand(
+		ir::PredicateOperand::PredicateTrue, address));
+	address->setD(new machine::PhysicalRegisterOperand(frameRegister, frame,
+		address));
+	address->setA(new machine::PhysicalRegisterOperand(frameRegister, frame,
+		address));
+	address->setB(new ir::ImmediateOperand((uint64_t)localRegion.address,
+		address, addressType));
+
+	entry.push_front(address);
+	entry.push_front(offset);
+
+	hydrazine::log("GenericSpillCodePass") << " Frame address "
+		<< offset->toString() << "; " << address->toString() << "\n";
+
+	return frame;
+}
+
+SpillCodeGenerator::SpillCodeGenerator(const VirtualRegisterSet& spilled,
+	const PhysicalRegisterVector& scratch, const SpillSlotMap& slots,
+	const InstructionMap& rematerializable,
+	const machine::PhysicalRegister* frameRegister,
+	ir::VirtualRegister* frame, SpillStatistics& statistics)
+: _spilled(spilled), _scratch(scratch), _slots(slots),
+  _rematerializable(rematerializable), _statistics(statistics),
+  _frameRegister(frameRegister), _frame(frame), _time(0)
+{
+
+}
+
+void SpillCodeGenerator::spill(ir::BasicBlock& block)
+{
+	// Values are not kept in scratch registers across blocks
+	_values.assign(_scratch.size(), Empty);
+	_lastUses.assign(_scratch.size(), 0);
+
+	for(auto instruction = block.begin(); instruction != block.end(); )
+	{
+		auto next = instruction; ++next;
+
+		_spill(block, instruction, next);
+
+		instruction = next;
+	}
+}
+
+void SpillCodeGenerator::_spill(ir::BasicBlock& block, iterator instruction,
+	iterator next)
+{
+	typedef std::vector<ir::Operand**> OperandPointerVector;
+
+	// The constant definitions of rematerialized values are deleted
+	if(!_rematerializable.empty())
+	{
+		for(auto write : (*instruction)->writes)
+		{
+			if(!_isSpilled(write) || write->isIndirect()) continue;
+
+			auto definition = _rematerializable.find(_value(write)->id);
+
+			if(definition != _rematerializable.end() &&
+				definition->second == *instruction)
+			{
+				return;
+			}
+		}
+	}
+
+	OperandPointerVector uses;
+	OperandPointerVector definitions;
+
+	for(auto& read : (*instruction)->reads)
+	{
+		if(_isSpilled(read)) uses.push_back(&read);
+	}
+
+	// predicated writes must preserve the previous value
+	bool isPredicated = (*instruction)->guard() != nullptr &&
+		!(*instruction)->guard()->isAlwaysTrue();
+
+	for(auto& write : (*instruction)->writes)
+	{
+		if(!_isSpilled(write)) continue;
+
+		if(write->isIndirect() || isPredicated) uses.push_back(&write);
+
+		if(!write->isIndirect()) definitions.push_back(&write);
+	}
+
+	if(uses.empty() && definitions.empty()) return;
+
+	assertM(definitions.empty() || (!(*instruction)->isBranch() &&
+		!(*instruction)->isReturn()), "Cannot spill a value defined by "
+		"the terminator " << (*instruction)->toString());
+
+	hydrazine::log("GenericSpillCodePass") << " Spilling operands of "
+		<< (*instruction)->toString() << "\n";
+
+	++_time;
+
+	// Bring every used value into a scratch register
+	IdSet pinned;
+
+	for(auto use : uses)
+	{
+		auto value = _value(*use);
+
+		auto scratch = _findScratch(value->id);
+
+		if(scratch == Empty)
+		{
+			scratch = _selectScratch(pinned);
+
+			_reload(block, instruction, value, scratch);
+
+			_values[scratch] = value->id;
+		}
+
+		pinned.insert(scratch);
+		_lastUses[scratch] = _time;
+	}
+
+	for(auto use : uses)
+	{
+		if(std::find(definitions.begin(), definitions.end(), use) !=
+			definitions.end()) continue;
+
+		_rewrite(*use, _findScratch(_value(*use)->id));
+	}
+
+	// Sources are read before the destination is written, so definitions
+	//  may reuse any scratch register that is not also defined here
+	IdSet defined;
+
+	for(auto definition : definitions)
+	{
+		auto value = _value(*definition);
+
+		auto scratch = _findScratch(value->id);
+
+		if(scratch == Empty)
+		{
+			scratch = _selectScratch(pinned);
+
+			if(pinned.count(scratch) != 0)
+			{
+				// all were pinned by sources, take one that is not defined
+				for(scratch = 0; scratch < _scratch.size(); ++scratch)
+				{
+					if(defined.count(scratch) == 0) break;
+				}
+
+				assert(scratch < _scratch.size());
+			}
+
+			_values[scratch] = value->id;
+		}
+
+		pinned.insert(scratch);
+		defined.insert(scratch);
+		_lastUses[scratch] = _time;
+
+		_rewrite(*definition, scratch);
+
+		// Keep the slot up to date so that the value can be dropped anywhere
+		_store(block, next, value, scratch);
+	}
+}
+
+unsigned int SpillCodeGenerator::_findScratch(unsigned int id) const
+{
+	for(unsigned int scratch = 0; scratch < _values.size(); ++scratch)
+	{
+		if(_values[scratch] == id) return scratch;
+	}
+
+	return Empty;
+}
+
+unsigned int SpillCodeGenerator::_selectScratch(const IdSet& pinned) const
+{
+	unsigned int selected = Empty;
+
+	// Prefer empty registers, then the least recently used one
+	for(unsigned int scratch = 0; scratch < _values.size(); ++scratch)
+	{
+		if(pinned.count(scratch) != 0) continue;
+
+		if(_values[scratch] == Empty) return scratch;
+
+		if(selected == Empty || _lastUses[scratch] < _lastUses[selected])
+		{
+			selected = scratch;
+		}
+	}
+
+	if(selected != Empty) return selected;
+
+	// Every register is in use by the current instruction
+	return *pinned.begin();
+}
+
+void SpillCodeGenerator::_reload(ir::BasicBlock& block, iterator position,
+	ir::VirtualRegister* value, unsigned int scratch)
+{
+	auto definition = _rematerializable.find(value->id);
+
+	if(definition != _rematerializable.end())
+	{
+		auto constant = static_cast<ir::Bitcast*>(definition->second);
+
+		auto copy = new ir::Bitcast(&block);
+
+		auto source = constant->a()->clone();
+
+		source->instruction = copy;
+
+		copy->setGuard(new ir::PredicateOperand(
+			ir::PredicateOperand::PredicateTrue, copy));
+		copy->setD(new machine::PhysicalRegisterOperand(_scratch[scratch],
+			value, copy));
+		copy->setA(source);
+
+		hydrazine::log("GenericSpillCodePass") << "  rematerialize "
+			<< copy->toString() << "\n";
+
+		block.insert(position, copy);
+
+		++_statistics.rematerializations;
+
+		return;
+	}
+
+	auto slot = _slots.find(value->id);
+	assert(slot != _slots.end());
+
+	auto load = new ir::Ld(&block);
+
+	load->setGuard(new ir::PredicateOperand(
+		ir::PredicateOperand::PredicateTrue, load));
+	load->setD(new machine::PhysicalRegisterOperand(_scratch[scratch],
+		value, load));
+	load->setA(new machine::PhysicalIndirectOperand(_frameRegister, _frame,
+		slot->second, load));
+
+	hydrazine::log("GenericSpillCodePass") << "  reload "
+		<< load->toString() << "\n";
+
+	block.insert(position, load);
+
+	++_statistics.loads;
 }
 
+void SpillCodeGenerator::_store(ir::BasicBlock& block, iterator position,
+	ir::VirtualRegister* value, unsigned int scratch)
+{
+	auto slot = _slots.find(value->id);
+	assert(slot != _slots.end());
+
+	auto store = new ir::St(&block);
+
+	store->setGuard(new ir::PredicateOperand(
+		ir::PredicateOperand::PredicateTrue, store));
+	store->setD(new machine::PhysicalIndirectOperand(_frameRegister, _frame,
+		slot->second, store));
+	store->setA(new machine::PhysicalRegisterOperand(_scratch[scratch],
+		value, store));
+
+	hydrazine::log("GenericSpillCodePass") << "  store "
+		<< store->toString() << "\n";
+
+	block.insert(position, store);
+
+	++_statistics.stores;
 }
 
+void SpillCodeGenerator::_rewrite(ir::Operand*& operand, unsigned int scratch)
+{
+	assert(scratch < _scratch.size());
+
+	auto value = _value(operand);
+
+	ir::Operand* newOperand = nullptr;
+
+	if(operand->isIndirect())
+	{
+		auto indirect = static_cast<machine::PhysicalIndirectOperand*>(
+			operand);
+
+		newOperand = new machine::PhysicalIndirectOperand(_scratch[scratch],
+			value, indirect->offset, operand->instruction);
+	}
+	else if(operand->mode() == ir::Operand::Predicate)
+	{
+		auto predicate = static_cast<ir::PredicateOperand*>(operand);
+		
+		newOperand = new machine::PhysicalPredicateOperand(_scratch[scratch],
+			value, predicate->modifier, operand->instruction);
+	}
+	else
+	{
+		newOperand = new machine::PhysicalRegisterOperand(_scratch[scratch],
+			value, operand->instruction);
+	}
+
+	delete operand;
+
+	operand = newOperand;
 }
 
+bool SpillCodeGenerator::_isSpilled(const ir::Operand* operand) const
+{
+	if(operand == nullptr || !operand->isRegister()) return false;
+
+	return _spilled.count(_value(operand)) != 0;
+}
+
+ir::VirtualRegister* SpillCodeGenerator::_value(
+	const ir::Operand* operand) const
+{
+	return static_cast<const ir::RegisterOperand*>(operand)->virtualRegister;
+}
+
+SpillStatistics::SpillStatistics()
+: spilledRegisters(0), rematerializedRegisters(0), loads(0), stores(0),
+  rematerializations(0), bytes(0)
+{
+
+}
+
+}
+
+}
 
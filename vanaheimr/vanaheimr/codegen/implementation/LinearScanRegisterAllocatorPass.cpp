@@ -0,0 +1,527 @@
+/*! \file   LinearScanRegisterAllocatorPass.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the LinearScanRegisterAllocatorPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/codegen/interface/LinearScanRegisterAllocatorPass.h>
+
+#include <vanaheimr/analysis/interface/LiveRangeAnalysis.h>
+
+#include <vanaheimr/machine/interface/MachineModel.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace codegen
+{
+
+LinearScanRegisterAllocatorPass::LinearScanRegisterAllocatorPass()
+: RegisterAllocator({"LiveRangeAnalysis"},
+	"LinearScanRegisterAllocatorPass")
+{
+
+}
+
+typedef analysis::LiveRangeAnalysis LiveRangeAnalysis;
+
+typedef std::vector<unsigned int> CostVector;
+
+/*! \brief The positions where a value is live, as sorted, disjoint and
+	closed segments, using the numbering of LiveRangeAnalysis.
+*/
+class LiveInterval
+{
+public:
+	typedef std::pair<unsigned int, unsigned int> Segment;
+	typedef std::vector<Segment>                  SegmentVector;
+
+public:
+	static const unsigned int NoIntersection = (unsigned int)-1;
+
+public:
+	LiveInterval()
+	: cost(0), hint(NoIntersection)
+	{
+
+	}
+
+public:
+	bool empty() const { return segments.empty(); }
+
+	unsigned int start() const { return segments.front().first; }
+	unsigned int   end() const { return segments.back().second; }
+
+public:
+	bool covers(unsigned int position) const
+	{
+		auto segment = std::upper_bound(segments.begin(), segments.end(),
+			Segment(position, NoIntersection));
+
+		if(segment == segments.begin()) return false;
+
+		--segment;
+
+		return position <= segment->second;
+	}
+
+	/*! \brief The first position where both intervals are live */
+	unsigned int firstIntersection(const LiveInterval& interval) const
+	{
+		auto one = segments.begin();
+		auto two = interval.segments.begin();
+
+		while(one != segments.end() && two != interval.segments.end())
+		{
+			unsigned int begin = std::max(one->first,  two->first);
+			unsigned int end   = std::min(one->second, two->second);
+
+			if(begin <= end) return begin;
+
+			if(one->second < two->second) ++one;
+			else ++two;
+		}
+
+		return NoIntersection;
+	}
+
+public:
+	SegmentVector segments;
+	unsigned int  cost;
+
+	/*! \brief A copy-related value that would like the same register */
+	unsigned int hint;
+};
+
+const unsigned int LiveInterval::NoIntersection;
+
+typedef std::vector<LiveInterval> LiveIntervalVector;
+
+static unsigned int getRegisterId(const ir::Operand* operand)
+{
+	return static_cast<const ir::RegisterOperand*>(
+		operand)->virtualRegister->id;
+}
+
+/*! \brief Build an interval for each value, indexed by id */
+static void buildIntervals(LiveIntervalVector& intervals, ir::Function& f,
+	const LiveRangeAnalysis& liveRanges, const CostVector& costs)
+{
+	intervals.assign(f.register_id_bound(), LiveInterval());
+
+	for(auto& liveRange : liveRanges)
+	{
+		if(liveRange.virtualRegister() == nullptr) continue;
+
+		unsigned int id = liveRange.virtualRegister()->id;
+
+		auto& interval = intervals[id];
+
+		for(auto& range : liveRange.intervals)
+		{
+			interval.segments.push_back(LiveInterval::Segment(range.start,
+				range.end - 1));
+		}
+
+		interval.cost = costs[id];
+	}
+
+	// Record copies as hints
+	for(auto& block : f)
+	{
+		for(auto instruction : block)
+		{
+			if(!RegisterAllocator::isCopy(*instruction)) continue;
+
+			auto d = getRegisterId(instruction->writes.front());
+			auto a = getRegisterId(instruction->reads.back());
+
+			intervals[d].hint = a;
+			intervals[a].hint = d;
+		}
+	}
+}
+
+/*! \brief Linear scan over intervals with lifetime holes */
+class LinearScan
+{
+public:
+	typedef std::vector<unsigned int> IdVector;
+
+public:
+	static const unsigned int Unassigned = (unsigned int)-1;
+
+public:
+	LinearScan(const LiveIntervalVector& intervals, unsigned int registers)
+	: registers(intervals.size(), Unassigned), spills(0),
+	  _intervals(intervals), _registerCount(registers)
+	{
+
+	}
+
+public:
+	void allocate();
+
+public:
+	/*! \brief The register assigned to each interval, Unassigned for
+		spills */
+	IdVector     registers;
+	unsigned int spills;
+
+private:
+	void _advance(unsigned int position);
+	void _assign(unsigned int id, unsigned int reg);
+	void _spill(unsigned int id);
+	void _evict(unsigned int id);
+
+	bool _tryFreeRegister(unsigned int id);
+	void _allocateBlockedRegister(unsigned int id);
+
+private:
+	const LiveIntervalVector& _intervals;
+	unsigned int              _registerCount;
+
+private:
+	// intervals live at the current position
+	IdVector _active;
+	// intervals in a lifetime hole at the current position
+	IdVector _inactive;
+
+};
+
+const unsigned int LinearScan::Unassigned;
+
+void LinearScan::allocate()
+{
+	IdVector unhandled;
+
+	for(unsigned int id = 0; id < _intervals.size(); ++id)
+	{
+		if(!_intervals[id].empty()) unhandled.push_back(id);
+	}
+
+	std::stable_sort(unhandled.begin(), unhandled.end(),
+		[&](unsigned int left, unsigned int right)
+		{
+			return _intervals[left].start() < _intervals[right].start();
+		});
+
+	for(auto id : unhandled)
+	{
+		_advance(_intervals[id].start());
+
+		if(_tryFreeRegister(id)) continue;
+
+		_allocateBlockedRegister(id);
+	}
+}
+
+void LinearScan::_advance(unsigned int position)
+{
+	IdVector active;
+	IdVector inactive;
+
+	for(auto id : _active)
+	{
+		auto& interval = _intervals[id];
+
+		if(interval.end() < position) continue;
+
+		if(interval.covers(position)) active.push_back(id);
+		else inactive.push_back(id);
+	}
+
+	for(auto id : _inactive)
+	{
+		auto& interval = _intervals[id];
+
+		if(interval.end() < position) continue;
+
+		if(interval.covers(position)) active.push_back(id);
+		else inactive.push_back(id);
+	}
+
+	_active.swap(active);
+	_inactive.swap(inactive);
+}
+
+void LinearScan::_assign(unsigned int id, unsigned int reg)
+{
+	report("  vr" << id << " -> register " << reg);
+
+	registers[id] = reg;
+
+	_active.push_back(id);
+}
+
+void LinearScan::_spill(unsigned int id)
+{
+	report("  spilling vr" << id);
+
+	registers[id] = Unassigned;
+
+	++spills;
+}
+
+void LinearScan::_evict(unsigned int id)
+{
+	auto active = std::find(_active.begin(), _active.end(), id);
+
+	if(active != _active.end())
+	{
+		_active.erase(active);
+	}
+	else
+	{
+		_inactive.erase(std::find(_inactive.begin(), _inactive.end(), id));
+	}
+
+	_spill(id);
+}
+
+bool LinearScan::_tryFreeRegister(unsigned int id)
+{
+	auto& interval = _intervals[id];
+
+	IdVector freeUntil(_registerCount, LiveInterval::NoIntersection);
+
+	for(auto active : _active)
+	{
+		freeUntil[registers[active]] = 0;
+	}
+
+	// pack the interval into the holes of inactive intervals
+	for(auto inactive : _inactive)
+	{
+		auto& reg = freeUntil[registers[inactive]];
+
+		reg = std::min(reg, _intervals[inactive].firstIntersection(interval));
+	}
+
+	// prefer the register of a copy-related value
+	if(interval.hint != LiveInterval::NoIntersection)
+	{
+		unsigned int hint = registers[interval.hint];
+
+		if(hint != Unassigned && freeUntil[hint] > interval.end())
+		{
+			_assign(id, hint);
+			return true;
+		}
+	}
+
+	auto best = std::max_element(freeUntil.begin(), freeUntil.end());
+
+	if(best == freeUntil.end() || *best <= interval.end()) return false;
+
+	// take the lowest register that is free for the whole interval
+	auto reg = std::find_if(freeUntil.begin(), freeUntil.end(),
+		[&](unsigned int position) { return position > interval.end(); });
+
+	_assign(id, reg - freeUntil.begin());
+
+	return true;
+}
+
+void LinearScan::_allocateBlockedRegister(unsigned int id)
+{
+	auto& interval = _intervals[id];
+
+	// the cost of spilling everything that blocks each register
+	IdVector blockingCost(_registerCount, 0);
+
+	for(auto active : _active)
+	{
+		blockingCost[registers[active]] += _intervals[active].cost;
+	}
+
+	for(auto inactive : _inactive)
+	{
+		if(_intervals[inactive].firstIntersection(interval) ==
+			LiveInterval::NoIntersection)
+		{
+			continue;
+		}
+
+		blockingCost[registers[inactive]] += _intervals[inactive].cost;
+	}
+
+	auto cheapest = std::min_element(blockingCost.begin(),
+		blockingCost.end());
+
+	if(cheapest == blockingCost.end() || *cheapest >= interval.cost)
+	{
+		_spill(id);
+		return;
+	}
+
+	unsigned int reg = cheapest - blockingCost.begin();
+
+	IdVector blocking;
+
+	for(auto active : _active)
+	{
+		if(registers[active] == reg) blocking.push_back(active);
+	}
+
+	for(auto inactive : _inactive)
+	{
+		if(registers[inactive] != reg) continue;
+
+		if(_intervals[inactive].firstIntersection(interval) ==
+			LiveInterval::NoIntersection)
+		{
+			continue;
+		}
+
+		blocking.push_back(inactive);
+	}
+
+	for(auto blocker : blocking)
+	{
+		_evict(blocker);
+	}
+
+	_assign(id, reg);
+}
+
+void LinearScanRegisterAllocatorPass::runOnFunction(Function& f)
+{
+	report("Running linear scan register allocator on " << f.name());
+
+	auto liveRanges = static_cast<LiveRangeAnalysis*>(
+		getAnalysis("LiveRangeAnalysis"));
+	assert(liveRanges != nullptr);
+
+	_machine = compiler::Compiler::getSingleton()->getMachineModel();
+
+	auto& allocation = _allocations[&f];
+
+	allocation = Allocation();
+
+	LiveIntervalVector intervals;
+
+	buildIntervals(intervals, f, *liveRanges, computeSpillCosts(f));
+
+	unsigned int registers        = _machine->totalRegisterCount();
+	unsigned int scratchRegisters = computeScratchRegisterCount(f);
+
+	std::unique_ptr<LinearScan> scan(new LinearScan(intervals, registers));
+
+	scan->allocate();
+
+	// If there are too few registers, hold some back for spill code and
+	//  allocate again with the rest
+	if(scan->spills > 0)
+	{
+		if(scratchRegisters >= registers)
+		{
+			throw std::runtime_error("Too few registers in the machine model "
+				"to hold the operands of a single instruction in "
+				+ f.name());
+		}
+
+		for(unsigned int id = registers - scratchRegisters;
+			id < registers; ++id)
+		{
+			allocation.scratch.push_back(_machine->getPhysicalRegister(id));
+		}
+
+		scan.reset(new LinearScan(intervals, registers - scratchRegisters));
+
+		scan->allocate();
+	}
+
+	for(auto reg = f.register_begin(); reg != f.register_end(); ++reg)
+	{
+		if(intervals[reg->id].empty()) continue;
+
+		unsigned int assigned = scan->registers[reg->id];
+
+		if(assigned == LinearScan::Unassigned)
+		{
+			allocation.spilled.insert(&*reg);
+			continue;
+		}
+
+		allocation.allocated.insert(std::make_pair(reg->id, assigned));
+	}
+
+	report(" " << allocation.allocated.size() << " values allocated, "
+		<< allocation.spilled.size() << " spilled.");
+
+	assignRegisters(f);
+
+	unsigned int removed = removeCoalescedCopies(f);
+
+	report(" Removed " << removed << " copies.");
+}
+
+transforms::Pass* LinearScanRegisterAllocatorPass::clone() const
+{
+	return new LinearScanRegisterAllocatorPass;
+}
+
+RegisterAllocator::VirtualRegisterSet
+	LinearScanRegisterAllocatorPass::getSpilledRegisters(const Function& f)
+{
+	auto allocation = _allocations.find(&f);
+
+	if(allocation == _allocations.end()) return VirtualRegisterSet();
+
+	return allocation->second.spilled;
+}
+
+const machine::PhysicalRegister*
+	LinearScanRegisterAllocatorPass::getPhysicalRegister(
+	const ir::VirtualRegister& vr) const
+{
+	auto allocation = _allocations.find(vr.function);
+
+	if(allocation == _allocations.end()) return nullptr;
+
+	auto& allocated = allocation->second.allocated;
+
+	auto allocatedRegister = allocated.find(vr.id);
+
+	if(allocatedRegister == allocated.end()) return nullptr;
+
+	return _machine->getPhysicalRegister(allocatedRegister->second);
+}
+
+RegisterAllocator::PhysicalRegisterVector
+	LinearScanRegisterAllocatorPass::getScratchRegisters(
+	const Function& f) const
+{
+	auto allocation = _allocations.find(&f);
+
+	if(allocation == _allocations.end()) return PhysicalRegisterVector();
+
+	return allocation->second.scratch;
+}
+
+}
+
+}
+
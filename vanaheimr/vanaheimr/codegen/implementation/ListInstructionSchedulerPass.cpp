@@ -8,17 +8,25 @@
 #include <vanaheimr/codegen/interface/ListInstructionSchedulerPass.h>
 
 #include <vanaheimr/analysis/interface/DependenceAnalysis.h>
+#include <vanaheimr/analysis/interface/DataflowAnalysis.h>
+
+#include <vanaheimr/machine/interface/MachineModel.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
 
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/BasicBlock.h>
 
-#include <vanaheimr/util/interface/LargeSet.h>
+#include <vanaheimr/util/interface/SmallSet.h>
 
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
 #include <cassert>
+#include <queue>
+#include <unordered_map>
+#include <vector>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -34,100 +42,317 @@ namespace codegen
 {
 
 ListInstructionSchedulerPass::ListInstructionSchedulerPass()
-: FunctionPass({"DependenceAnalysis"}, "ListInstructionSchedulerPass")
+: FunctionPass({"DependenceAnalysis", "DataflowAnalysis"},
+	"ListInstructionSchedulerPass")
 {
 
 }
 
-typedef util::LargeSet<ir::Instruction*> InstructionSet;
-	
-static bool anyDependencies(ir::Instruction* instruction,
-	analysis::DependenceAnalysis& dep, const InstructionSet& remaining)
+typedef std::vector<unsigned int> IndexVector;
+typedef std::vector<IndexVector>  IndexVectorVector;
+
+typedef std::vector<ir::Instruction*> InstructionVector;
+
+typedef util::SmallSet<ir::VirtualRegister*> VirtualRegisterSet;
+
+/*! \brief The dependence graph of a block, indexed by original position */
+class BlockDependenceGraph
 {
-	auto predecessors = dep.getLocalPredecessors(*instruction);
+public:
+	BlockDependenceGraph(ir::BasicBlock& block,
+		const analysis::DependenceAnalysis& dep,
+		const machine::MachineModel& machine);
+
+public:
+	InstructionVector instructions;
+
+	IndexVectorVector successors;
+	IndexVectorVector successorLatencies;
+	IndexVector       predecessorCounts;
+
+	/*! \brief The longest latency path from each instruction to the end
+		of the block */
+	IndexVector heights;
+};
 
-	for(auto writer : predecessors)
+static void getRegisters(VirtualRegisterSet& registers,
+	const ir::Instruction::OperandVector& operands)
+{
+	for(auto operand : operands)
 	{
-		if(writer->block != instruction->block) continue;
-		       if(remaining.count(writer) == 0) continue;
-		
-		assertM(writer->index() < instruction->index(), "Instruction '"
-			<< writer->toString() << "' has a higher sequence number than '"
-			<< instruction->toString() << "'");
-
-		return true;
+		if(operand == nullptr || !operand->isRegister()) continue;
+
+		registers.insert(
+			static_cast<ir::RegisterOperand*>(operand)->virtualRegister);
 	}
-	
+}
+
+/*! \brief Does the successor read a value written by the predecessor? */
+static bool readsResult(const ir::Instruction& predecessor,
+	const ir::Instruction& successor)
+{
+	VirtualRegisterSet writes;
+
+	getRegisters(writes, predecessor.writes);
+
+	for(auto read : successor.reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		auto reg = static_cast<ir::RegisterOperand*>(read)->virtualRegister;
+
+		if(writes.count(reg) != 0) return true;
+	}
+
 	return false;
 }
 
-static void schedule(ir::BasicBlock& block, analysis::DependenceAnalysis& dep)
+BlockDependenceGraph::BlockDependenceGraph(ir::BasicBlock& block,
+	const analysis::DependenceAnalysis& dep,
+	const machine::MachineModel& machine)
+: instructions(block.begin(), block.end()),
+  successors(block.size()), successorLatencies(block.size()),
+  predecessorCounts(block.size(), 0), heights(block.size(), 0)
 {
-	report(" Scheduling basic block '" << block.name() << "'");
+	typedef std::unordered_map<const ir::Instruction*, unsigned int>
+		IndexMap;
 
-	// TODO sort by priority, sort in parallel
-	ir::BasicBlock::InstructionList newInstructions;
-	
-	InstructionSet readyInstructions;
-	
-	InstructionSet remainingInstructions;
-	
-	remainingInstructions.insert(block.begin(), block.end());
-
-	report("  Getting instructions with no dependencies...");
-	
-	for(auto instruction : block)
+	IndexMap indices;
+
+	for(unsigned int i = 0; i < instructions.size(); ++i)
 	{
-		if(!anyDependencies(instruction, dep, remainingInstructions))
+		indices.insert(std::make_pair(instructions[i], i));
+	}
+
+	IndexVector latencies(instructions.size());
+
+	for(unsigned int i = 0; i < instructions.size(); ++i)
+	{
+		latencies[i] = machine.getLatency(*instructions[i]);
+	}
+
+	for(unsigned int i = 0; i < instructions.size(); ++i)
+	{
+		for(auto successor : dep.getLocalSuccessors(*instructions[i]))
+		{
+			auto index = indices.find(successor);
+
+			if(index == indices.end()) continue;
+
+			assertM(index->second > i, "Instruction '"
+				<< successor->toString() << "' depends on the later '"
+				<< instructions[i]->toString() << "'");
+
+			// only consumers of the result wait for the full latency
+			unsigned int latency = readsResult(*instructions[i],
+				*successor) ? latencies[i] : 1;
+
+			successors[i].push_back(index->second);
+			successorLatencies[i].push_back(latency);
+
+			++predecessorCounts[index->second];
+		}
+	}
+
+	// successors always follow, so heights are final in reverse order
+	for(unsigned int i = instructions.size(); i > 0; --i)
+	{
+		unsigned int index  = i - 1;
+		unsigned int height = latencies[index];
+
+		for(unsigned int s = 0; s < successors[index].size(); ++s)
+		{
+			height = std::max(height, successorLatencies[index][s] +
+				heights[successors[index][s]]);
+		}
+
+		heights[index] = height;
+	}
+}
+
+/*! \brief Tracks the values live at the current point of the schedule to
+	estimate how each candidate changes register pressure */
+class RegisterPressureTracker
+{
+public:
+	RegisterPressureTracker(const InstructionVector& instructions,
+		const analysis::DataflowAnalysis::VirtualRegisterBitSet& liveOuts)
+	: _liveOuts(liveOuts)
+	{
+		for(auto instruction : instructions)
+		{
+			VirtualRegisterSet reads;
+
+			getRegisters(reads, instruction->reads);
+
+			for(auto reg : reads) ++_remainingUses[reg];
+		}
+	}
+
+public:
+	/*! \brief Values started minus values ended by the instruction */
+	int delta(const ir::Instruction& instruction) const
+	{
+		VirtualRegisterSet reads;
+		VirtualRegisterSet writes;
+
+		getRegisters(reads,  instruction.reads);
+		getRegisters(writes, instruction.writes);
+
+		int delta = writes.size();
+
+		for(auto reg : reads)
 		{
-			report("   " << instruction->toString());
-		
-			readyInstructions.insert(instruction);
+			if(writes.count(reg) != 0) continue;
+			if(_liveOuts.contains(reg)) continue;
+
+			auto uses = _remainingUses.find(reg);
+
+			if(uses != _remainingUses.end() && uses->second == 1) --delta;
 		}
+
+		return delta;
 	}
-	
-	// Remove them from the set of remaining instructions
-	for(auto instruction : readyInstructions)
+
+	void schedule(const ir::Instruction& instruction)
 	{
-		auto remaining = remainingInstructions.find(instruction);
+		VirtualRegisterSet reads;
 
-		assert(remaining != remainingInstructions.end());
+		getRegisters(reads, instruction.reads);
 
-		remainingInstructions.erase(remaining);
+		for(auto reg : reads) --_remainingUses[reg];
 	}
 
-	report("  Scheduling remaining instructions...");
-	
-	while(!readyInstructions.empty())
+private:
+	typedef std::unordered_map<ir::VirtualRegister*, unsigned int> UseMap;
+
+private:
+	const analysis::DataflowAnalysis::VirtualRegisterBitSet& _liveOuts;
+
+	UseMap _remainingUses;
+};
+
+static void schedule(ir::BasicBlock& block, analysis::DependenceAnalysis& dep,
+	analysis::DataflowAnalysis& dataflow, const machine::MachineModel& machine)
+{
+	report(" Scheduling basic block '" << block.name() << "'");
+
+	BlockDependenceGraph graph(block, dep, machine);
+
+	RegisterPressureTracker pressure(graph.instructions,
+		dataflow.getLiveOuts(block));
+
+	typedef std::pair<unsigned int, unsigned int> CycleAndIndex;
+	typedef std::priority_queue<CycleAndIndex, std::vector<CycleAndIndex>,
+		std::greater<CycleAndIndex>> PendingQueue;
+
+	// the critical path first, then program order
+	auto lowerPriority = [&](unsigned int left, unsigned int right)
 	{
-		auto next = *readyInstructions.begin();
-		readyInstructions.erase(readyInstructions.begin());
+		if(graph.heights[left] != graph.heights[right])
+		{
+			return graph.heights[left] < graph.heights[right];
+		}
+
+		return left > right;
+	};
+
+	typedef std::priority_queue<unsigned int, IndexVector,
+		decltype(lowerPriority)> ReadyQueue;
+
+	// instructions with all predecessors scheduled, by earliest cycle
+	PendingQueue pending;
+	// instructions whose operands are available in the current cycle
+	ReadyQueue ready(lowerPriority);
+
+	IndexVector earliestCycles(graph.instructions.size(), 0);
+	IndexVector predecessorCounts = graph.predecessorCounts;
+
+	for(unsigned int i = 0; i < graph.instructions.size(); ++i)
+	{
+		if(predecessorCounts[i] == 0) pending.push(CycleAndIndex(0, i));
+	}
 
-		report("   " << next->toString());
+	ir::BasicBlock::InstructionList newInstructions;
 
-		newInstructions.push_back(next);
+	unsigned int cycle = 0;
 
-		// free dependent instructions
-		auto successors = dep.getLocalSuccessors(*next);
+	while(newInstructions.size() < graph.instructions.size())
+	{
+		while(!pending.empty() && pending.top().first <= cycle)
+		{
+			ready.push(pending.top().second);
+			pending.pop();
+		}
 
-		for(auto successor : successors)
+		// stall until an operand arrives
+		if(ready.empty())
 		{
-			auto remaining = remainingInstructions.find(successor);
+			assert(!pending.empty());
 
-			if(remaining == remainingInstructions.end()) continue;
+			cycle = pending.top().first;
+			continue;
+		}
 
-			if(!anyDependencies(successor, dep, remainingInstructions))
+		// among instructions on equally critical paths, prefer the one
+		//  that frees the most registers
+		IndexVector ties(1, ready.top());
+		ready.pop();
+
+		while(!ready.empty() &&
+			graph.heights[ready.top()] == graph.heights[ties.front()])
+		{
+			ties.push_back(ready.top());
+			ready.pop();
+		}
+
+		unsigned int next = ties.front();
+		int nextDelta = pressure.delta(*graph.instructions[next]);
+
+		for(auto tie : ties)
+		{
+			int delta = pressure.delta(*graph.instructions[tie]);
+
+			if(delta < nextDelta || (delta == nextDelta && tie < next))
 			{
-				remainingInstructions.erase(remaining);
-				
-				report("    released '" << successor->toString() << "'");
+				next      = tie;
+				nextDelta = delta;
+			}
+		}
+
+		for(auto tie : ties)
+		{
+			if(tie != next) ready.push(tie);
+		}
+
+		auto instruction = graph.instructions[next];
+
+		report("   " << cycle << ": " << instruction->toString()
+			<< " (height " << graph.heights[next] << ")");
 
-				readyInstructions.insert(successor);
+		newInstructions.push_back(instruction);
+
+		pressure.schedule(*instruction);
+
+		// release dependent instructions
+		for(unsigned int s = 0; s < graph.successors[next].size(); ++s)
+		{
+			unsigned int successor = graph.successors[next][s];
+
+			earliestCycles[successor] = std::max(earliestCycles[successor],
+				cycle + graph.successorLatencies[next][s]);
+
+			if(--predecessorCounts[successor] == 0)
+			{
+				pending.push(CycleAndIndex(earliestCycles[successor],
+					successor));
 			}
 		}
+
+		++cycle;
 	}
 
-	assert(newInstructions.size() == block.size());
+	report("  " << cycle << " cycles");
 
 	block.assign(newInstructions.begin(), newInstructions.end());
 }
@@ -136,13 +361,20 @@ void ListInstructionSchedulerPass::runOnFunction(Function& f)
 {
 	auto dep = static_cast<analysis::DependenceAnalysis*>(
 		getAnalysis("DependenceAnalysis"));
-	
+	assert(dep != nullptr);
+
+	auto dataflow = static_cast<analysis::DataflowAnalysis*>(
+		getAnalysis("DataflowAnalysis"));
+	assert(dataflow != nullptr);
+
+	auto machine = compiler::Compiler::getSingleton()->getMachineModel();
+
 	report("Running list scheduling on '" << f.name() << "'");
-	
+
 	// for all blocks
 	for(auto block = f.begin(); block != f.end(); ++block)
 	{
-		schedule(*block, *dep);
+		schedule(*block, *dep, *dataflow, *machine);
 	}
 }
 
@@ -151,6 +383,12 @@ transforms::Pass* ListInstructionSchedulerPass::clone() const
 	return new ListInstructionSchedulerPass;
 }
 
+transforms::Pass::StringVector
+	ListInstructionSchedulerPass::getPreservedAnalyses() const
+{
+	return getControlFlowAnalyses();
+}
+
 }
 
 }
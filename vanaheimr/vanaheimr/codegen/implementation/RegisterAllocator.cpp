@@ -7,6 +7,19 @@
 // Vanaheimr Includes
 #include <vanaheimr/codegen/interface/RegisterAllocator.h>
 
+#include <vanaheimr/machine/interface/PhysicalRegisterOperand.h>
+#include <vanaheimr/machine/interface/PhysicalPredicateOperand.h>
+#include <vanaheimr/machine/interface/PhysicalIndirectOperand.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Standard Library Includes
+#include <algorithm>
+
 namespace vanaheimr
 {
 
@@ -35,6 +48,199 @@ void RegisterAllocator::finalize()
 
 }
 
+RegisterAllocator::StringVector RegisterAllocator::getPreservedAnalyses() const
+{
+	return getControlFlowAnalyses();
+}
+
+RegisterAllocator::CostVector RegisterAllocator::computeSpillCosts(
+	const Function& f)
+{
+	CostVector costs(f.register_id_bound(), 0);
+	
+	for(auto& block : f)
+	{
+		for(auto instruction : block)
+		{
+			for(auto read : instruction->reads)
+			{
+				if(read == nullptr || !read->isRegister()) continue;
+				
+				auto reg = static_cast<ir::RegisterOperand*>(read);
+				
+				++costs[reg->virtualRegister->id];
+			}
+			
+			for(auto write : instruction->writes)
+			{
+				if(write == nullptr || !write->isRegister()) continue;
+				
+				auto reg = static_cast<ir::RegisterOperand*>(write);
+				
+				++costs[reg->virtualRegister->id];
+			}
+		}
+	}
+	
+	return costs;
+}
+
+unsigned int RegisterAllocator::computeScratchRegisterCount(const Function& f)
+{
+	typedef util::SmallSet<unsigned int> IdSet;
+	
+	size_t count = 0;
+	
+	for(auto& block : f)
+	{
+		for(auto instruction : block)
+		{
+			IdSet registers;
+			
+			for(auto read : instruction->reads)
+			{
+				if(read == nullptr || !read->isRegister()) continue;
+				
+				auto reg = static_cast<ir::RegisterOperand*>(read);
+				
+				registers.insert(reg->virtualRegister->id);
+			}
+			
+			for(auto write : instruction->writes)
+			{
+				if(write == nullptr || !write->isRegister()) continue;
+				
+				auto reg = static_cast<ir::RegisterOperand*>(write);
+				
+				registers.insert(reg->virtualRegister->id);
+			}
+			
+			count = std::max(count, registers.size());
+		}
+	}
+	
+	// the frame pointer for spill slots
+	return count + 1;
+}
+
+bool RegisterAllocator::isCopy(const ir::Instruction& instruction)
+{
+	if(instruction.opcode != ir::Instruction::Bitcast) return false;
+	
+	auto bitcast = static_cast<const ir::Bitcast*>(&instruction);
+	
+	if(bitcast->guard() == nullptr || !bitcast->guard()->isAlwaysTrue())
+	{
+		return false;
+	}
+	
+	auto d = bitcast->d();
+	auto a = bitcast->a();
+
+	if(d == nullptr || a == nullptr) return false;
+
+	if(d->mode() != ir::Operand::Register) return false;
+	if(a->mode() != ir::Operand::Register) return false;
+	
+	// only copies that do not change the size of the value
+	return d->type()->bytes() == a->type()->bytes();
+}
+
+static void replaceVirtualRegisterWithPhysical(ir::Operand*& operand,
+	const RegisterAllocator& allocator)
+{
+	if(!operand->isRegister()) return;
+
+	auto newOperand = operand;
+	
+	if(operand->isIndirect())
+	{
+		auto indirectOperand = static_cast<ir::IndirectOperand*>(operand);
+		
+		newOperand = new machine::PhysicalIndirectOperand(
+			allocator.getPhysicalRegister(*indirectOperand->virtualRegister),
+			indirectOperand->virtualRegister, indirectOperand->offset,
+			indirectOperand->instruction);
+	}
+	else if(operand->mode() == ir::Operand::Predicate)
+	{
+		auto predicateOperand = static_cast<ir::PredicateOperand*>(operand);
+		
+		newOperand = new machine::PhysicalPredicateOperand(
+			allocator.getPhysicalRegister(*predicateOperand->virtualRegister),
+			predicateOperand->virtualRegister, predicateOperand->modifier,
+			predicateOperand->instruction);
+	}
+	else
+	{
+		auto registerOperand = static_cast<ir::RegisterOperand*>(operand);
+	
+		newOperand = new machine::PhysicalRegisterOperand(
+			allocator.getPhysicalRegister(*registerOperand->virtualRegister),
+			registerOperand->virtualRegister, registerOperand->instruction);
+	}
+
+	delete operand;
+	
+	operand = newOperand;
+}
+
+void RegisterAllocator::assignRegisters(Function& f) const
+{
+	for(auto& block : f)
+	{
+		for(auto& instruction : block)
+		{
+			for(auto& read : instruction->reads)
+			{
+				replaceVirtualRegisterWithPhysical(read, *this);
+			}
+
+			for(auto& write : instruction->writes)
+			{
+				replaceVirtualRegisterWithPhysical(write, *this);
+			}
+		}
+	}
+}
+
+unsigned int RegisterAllocator::removeCoalescedCopies(Function& f)
+{
+	unsigned int removed = 0;
+	
+	for(auto& block : f)
+	{
+		for(auto instruction = block.begin(); instruction != block.end(); )
+		{
+			if(!isCopy(**instruction))
+			{
+				++instruction;
+				continue;
+			}
+			
+			auto bitcast = static_cast<ir::Bitcast*>(*instruction);
+			
+			auto d = static_cast<machine::PhysicalRegisterOperand*>(
+				bitcast->d());
+			auto a = static_cast<machine::PhysicalRegisterOperand*>(
+				bitcast->a());
+			
+			if(d->physicalRegister == nullptr ||
+				d->physicalRegister != a->physicalRegister)
+			{
+				++instruction;
+				continue;
+			}
+			
+			instruction = block.erase(instruction);
+			
+			++removed;
+		}
+	}
+	
+	return removed;
+}
+
 }
 
 }
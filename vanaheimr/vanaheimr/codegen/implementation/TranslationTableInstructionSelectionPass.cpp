@@ -16,6 +16,9 @@
 
 #include <vanaheimr/ir/interface/Function.h>
 
+#include <vanaheimr/util/interface/MemoryPool.h>
+#include <vanaheimr/util/interface/ParallelFor.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
@@ -37,10 +40,49 @@ TranslationTableInstructionSelectionPass::TranslationTableInstructionSelectionPa
 
 void TranslationTableInstructionSelectionPass::runOnFunction(Function& f)
 {
-	// Parallel for all
+	auto machineModel = compiler::Compiler::getSingleton()->getMachineModel();
+	
+	auto translationTable = machineModel->translationTable();
+
+	typedef std::vector<BasicBlock*> BasicBlockVector;
+	
+	BasicBlockVector blocks;
+	
+	blocks.reserve(f.size());
+	
 	for(auto block = f.begin(); block != f.end(); ++block)
 	{
-		_lowerBlock(*block);
+		blocks.push_back(&*block);
+	}
+	
+	// Blocks are lowered concurrently, each into its own buffer, within
+	//  the thread budget of the caller.  Temporaries are collected per
+	//  block rather than added to the function.
+	std::vector<InstructionVector>   loweredBlocks(blocks.size());
+	std::vector<VirtualRegisterList> temporaries(blocks.size());
+	
+	auto& pool = util::MemoryPool::current();
+	
+	util::parallelFor(blocks.size(), 0, [&](size_t i)
+	{
+		util::MemoryPool::Scope scope(pool);
+		
+		_lowerBlock(loweredBlocks[i], temporaries[i], *blocks[i],
+			translationTable);
+	});
+
+	// Swap out the block contents only after every block was lowered, and
+	//  number the temporaries in block order so that ids do not depend on
+	//  how the blocks were scheduled
+	for(size_t i = 0; i != blocks.size(); ++i)
+	{
+		auto block = blocks[i];
+		
+		f.spliceVirtualRegisters(temporaries[i]);
+		
+		block->clear();
+
+		block->assign(loweredBlocks[i].begin(), loweredBlocks[i].end());
 	}
 }
 
@@ -49,35 +91,33 @@ transforms::Pass* TranslationTableInstructionSelectionPass::clone() const
 	return new TranslationTableInstructionSelectionPass;
 }
 
-static void lowerInstruction(ir::BasicBlock::InstructionList& instructions,
-	ir::Instruction* instruction,
+typedef std::vector<ir::Instruction*> InstructionVector;
+
+typedef ir::Function::VirtualRegisterList VirtualRegisterList;
+
+static void lowerInstruction(InstructionVector& instructions,
+	VirtualRegisterList& temporaries, ir::Instruction* instruction,
 	const machine::TranslationTable* translationTable);
 
-void TranslationTableInstructionSelectionPass::_lowerBlock(BasicBlock& block)
+void TranslationTableInstructionSelectionPass::_lowerBlock(
+	InstructionVector& loweredInstructions, VirtualRegisterList& temporaries,
+	const BasicBlock& block, const machine::TranslationTable* translationTable)
 {
 	hydrazine::log("TranslationTableInstructionSelectionPass")
 		<< "Running on basic block " << block.name() << "\n";
 	
-	auto machineModel = compiler::Compiler::getSingleton()->getMachineModel();
-	
-	BasicBlock::InstructionList loweredInstructions;
-
-	auto translationTable = machineModel->translationTable();
+	// Most instructions translate one to one
+	loweredInstructions.reserve(block.size());
 	
-	// Parallel for all and final gather
 	for(auto instruction : block)
 	{
-		lowerInstruction(loweredInstructions, instruction, translationTable);
+		lowerInstruction(loweredInstructions, temporaries, instruction,
+			translationTable);
 	}
-
-	// Swap out the block contents, deallocate it
-	block.clear();
-
-	block.assign(loweredInstructions.begin(), loweredInstructions.end());
 }
 
-static void lowerInstruction(ir::BasicBlock::InstructionList& instructions,
-	ir::Instruction* instruction,
+static void lowerInstruction(InstructionVector& instructions,
+	VirtualRegisterList& temporaries, ir::Instruction* instruction,
 	const machine::TranslationTable* translationTable)
 {
 	hydrazine::log("TranslationTableInstructionSelectionPass")
@@ -103,7 +143,7 @@ static void lowerInstruction(ir::BasicBlock::InstructionList& instructions,
 	}
 
 	auto machineInstructions =
-		translationTable->translateInstruction(instruction);
+		translationTable->translateInstruction(instruction, temporaries);
 
 	if(machineInstructions.empty())
 	{
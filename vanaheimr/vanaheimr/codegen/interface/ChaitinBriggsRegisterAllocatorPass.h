@@ -11,6 +11,9 @@
 
 #include <vanaheimr/util/interface/LargeMap.h>
 
+// Standard Library Includes
+#include <unordered_map>
+
 // Forward Declarations
 namespace vanaheimr { namespace machine { class MachineModel; } }
 
@@ -20,6 +23,13 @@ namespace vanaheimr
 namespace codegen
 {
 
+/*! \brief A graph coloring register allocator using iterated register
+	coalescing.
+
+	Copies and PHI operands are coalesced conservatively.  Values to spill
+	are chosen by spill cost over degree, and colors are picked lowest
+	first, so the allocation is the same for every run.
+*/
 class ChaitinBriggsRegisterAllocatorPass : public RegisterAllocator
 {
 public:
@@ -34,18 +44,32 @@ public:
 
 public:
 	/*! \brief Get the set of values that were spilled during allocation */
-	VirtualRegisterSet getSpilledRegisters();
+	VirtualRegisterSet getSpilledRegisters(const Function& f);
 	
 	/*! \brief Get the mapping of a value to a named physical register */
 	const machine::PhysicalRegister* getPhysicalRegister(
 		const ir::VirtualRegister&) const;
 
+	/*! \brief Get the registers held back for spill code */
+	PhysicalRegisterVector getScratchRegisters(const Function& f) const;
+
 private:
 	typedef util::LargeMap<unsigned int, unsigned int> RegisterMap;
 
+	/*! \brief The result of allocating registers for one function */
+	class Allocation
+	{
+	public:
+		VirtualRegisterSet     spilled;
+		RegisterMap            allocated;
+		PhysicalRegisterVector scratch;
+	};
+
+	typedef std::unordered_map<const Function*, Allocation>
+		AllocationMap;
+
 private:
-	VirtualRegisterSet _spilled;
-	RegisterMap        _allocated;
+	AllocationMap _allocations;
 
 private:
 	const machine::MachineModel* _machine;
@@ -15,6 +15,19 @@ namespace vanaheimr
 namespace codegen
 {
 
+/*! \brief Insert loads and stores for the values that the register allocator
+	could not fit into registers.
+
+	Spilled values live in slots of the local memory region of the ABI
+	between blocks.  Each thread has its own window of the region, the
+	function entry points the last scratch register at it, and slots
+	are addressed relative to that register.  Within a block, a value
+	is loaded into one of the other scratch registers at its first use
+	and kept there until the scratch register is needed for another
+	value, so each block holds a short, split live range for it.  Every
+	write is stored back to the slot immediately.  Values that are only
+	ever set to a constant are rematerialized instead of being stored.
+*/
 class GenericSpillCodePass : public transforms::FunctionPass
 {
 public:
@@ -26,10 +39,17 @@ public:
 
 public:
 	virtual Pass* clone() const;
+
+public:
+	virtual StringVector getPreservedAnalyses() const;
+
+public:
+	/*! \brief The ABI providing the 'local' memory region for spill slots */
+	std::string abiName;
+
 };
 
 }
 
 }
 
-
@@ -0,0 +1,86 @@
+/*! \file   LinearScanRegisterAllocatorPass.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the LinearScanRegisterAllocatorPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/codegen/interface/RegisterAllocator.h>
+
+#include <vanaheimr/util/interface/LargeMap.h>
+
+// Standard Library Includes
+#include <unordered_map>
+
+// Forward Declarations
+namespace vanaheimr { namespace machine { class MachineModel; } }
+
+namespace vanaheimr
+{
+
+namespace codegen
+{
+
+/*! \brief A register allocator that makes a single pass over live intervals
+	in order of their start points, intended for fast compilation.
+
+	Intervals keep the holes between the blocks where a value is live, and
+	a value may be packed into the holes of the values already assigned to
+	a register (binpacking, as described in "Quality and Speed in
+	Linear-scan Register Allocation" by Omri Traub, Glenn Holloway, and
+	Michael D. Smith).  When no register is free, the cheapest of the
+	current value and the values blocking a register is spilled.  Spilled
+	values get a second chance in GenericSpillCodePass, which splits them
+	into short ranges in scratch registers around each use.
+*/
+class LinearScanRegisterAllocatorPass : public RegisterAllocator
+{
+public:
+	LinearScanRegisterAllocatorPass();
+
+public:
+	/*! \brief Run the pass on a specific function in the module */
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+
+public:
+	/*! \brief Get the set of values that were spilled during allocation */
+	VirtualRegisterSet getSpilledRegisters(const Function& f);
+
+	/*! \brief Get the mapping of a value to a named physical register */
+	const machine::PhysicalRegister* getPhysicalRegister(
+		const ir::VirtualRegister&) const;
+
+	/*! \brief Get the registers held back for spill code */
+	PhysicalRegisterVector getScratchRegisters(const Function& f) const;
+
+private:
+	typedef util::LargeMap<unsigned int, unsigned int> RegisterMap;
+
+	/*! \brief The result of allocating registers for one function */
+	class Allocation
+	{
+	public:
+		VirtualRegisterSet     spilled;
+		RegisterMap            allocated;
+		PhysicalRegisterVector scratch;
+	};
+
+	typedef std::unordered_map<const Function*, Allocation>
+		AllocationMap;
+
+private:
+	AllocationMap _allocations;
+
+private:
+	const machine::MachineModel* _machine;
+};
+
+}
+
+}
+
@@ -15,7 +15,13 @@ namespace vanaheimr
 namespace codegen
 {
 
-/*! \brief Perform instruction scheduling using the list algorithm */
+/*! \brief Perform instruction scheduling using the list algorithm
+
+	Each block is scheduled for a single issue machine, with latencies from
+	the machine model.  Ready instructions are taken in order of the longest
+	latency path to the end of the block, so loads are started well ahead of
+	their uses.  Ties go to the instruction that ends the most live values.
+*/
 class ListInstructionSchedulerPass : public transforms::FunctionPass
 {
 public:
@@ -27,6 +33,9 @@ public:
 public:
 	virtual Pass* clone() const;
 
+public:
+	virtual StringVector getPreservedAnalyses() const;
+
 
 };
 
@@ -11,8 +11,12 @@
 
 #include <vanaheimr/util/interface/LargeSet.h>
 
+// Standard Library Includes
+#include <vector>
+
 // Forward Declarations
 namespace vanaheimr { namespace ir      { class VirtualRegister;  } }
+namespace vanaheimr { namespace ir      { class Instruction;      } }
 namespace vanaheimr { namespace machine { class PhysicalRegister; } }
 
 namespace vanaheimr
@@ -27,6 +31,8 @@ class RegisterAllocator : public transforms::FunctionPass
 
 public:
 	typedef util::LargeSet<ir::VirtualRegister*> VirtualRegisterSet;
+	typedef std::vector<const machine::PhysicalRegister*>
+		PhysicalRegisterVector;
 
 public:
 	/*! \brief The default constructor sets the type */
@@ -43,13 +49,54 @@ public:
 	virtual void finalize();
 
 public:
-	/*! \brief Get the set of values that were spilled during allocation */
-	virtual VirtualRegisterSet getSpilledRegisters() = 0;
+	/*! \brief Allocation only rewrites operands */
+	virtual StringVector getPreservedAnalyses() const;
+
+public:
+	/*! \brief Get the set of values that were spilled during allocation
+		of a function
+
+		Results are kept for every function the pass ran on, passes that
+		run in a later wave see the allocation of their own function.
+	*/
+	virtual VirtualRegisterSet getSpilledRegisters(const Function& f) = 0;
 	
 	/*! \brief Get the mapping of a value to a named physical register */
 	virtual const machine::PhysicalRegister* getPhysicalRegister(
 		const ir::VirtualRegister&) const = 0;
 
+	/*! \brief Get the registers that were held back from allocation of a
+		function for loading and storing spilled values */
+	virtual PhysicalRegisterVector getScratchRegisters(
+		const Function& f) const = 0;
+
+public:
+	/*! \brief Is the instruction an unconditional copy between two registers
+		of the same size? */
+	static bool isCopy(const ir::Instruction& instruction);
+
+protected:
+	typedef std::vector<unsigned int> CostVector;
+
+protected:
+	/*! \brief Estimate the cost of spilling each register (indexed by id)
+		as the number of times it is read or written */
+	static CostVector computeSpillCosts(const Function& f);
+
+	/*! \brief The most registers referenced by a single instruction, spill
+		code needs this many scratch registers in the worst case, plus
+		one that holds the address of the thread's spill slots */
+	static unsigned int computeScratchRegisterCount(const Function& f);
+
+protected:
+	/*! \brief Replace virtual register operands with the physical
+		registers returned by getPhysicalRegister() */
+	void assignRegisters(Function& f) const;
+
+	/*! \brief Delete copies that were assigned the same register for
+		both operands, returns the number deleted */
+	static unsigned int removeCoalescedCopies(Function& f);
+
 };
 
 }
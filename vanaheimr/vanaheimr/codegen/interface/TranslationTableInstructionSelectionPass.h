@@ -10,6 +10,15 @@
 // Vanaheimr Includes
 #include <vanaheimr/transforms/interface/Pass.h>
 
+#include <vanaheimr/ir/interface/Function.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace machine { class TranslationTable; } }
+namespace vanaheimr { namespace ir      { class Instruction;      } }
+
 namespace vanaheimr
 {
 
@@ -29,7 +38,13 @@ public:
 	virtual Pass* clone() const;
 
 private:
-	void _lowerBlock(BasicBlock& b);
+	typedef std::vector<ir::Instruction*> InstructionVector;
+	typedef Function::VirtualRegisterList VirtualRegisterList;
+
+private:
+	void _lowerBlock(InstructionVector& loweredInstructions,
+		VirtualRegisterList& temporaries, const BasicBlock& b,
+		const machine::TranslationTable* table);
 
 };
 
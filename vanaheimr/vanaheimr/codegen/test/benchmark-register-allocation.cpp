@@ -0,0 +1,312 @@
+/*! \file   benchmark-register-allocation.cpp
+	\author Gregory Diamos <gregory.diamos@gatech.edu>
+	\date   Friday October 16, 2026
+	\brief  A benchmark comparing the compile time and register usage of the
+		register allocators.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/codegen/interface/RegisterAllocator.h>
+
+#include <vanaheimr/machine/interface/PhysicalRegisterOperand.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+#include <hydrazine/interface/string.h>
+
+// Standard Library Includes
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+typedef std::vector<BasicBlock*> BasicBlockVector;
+
+class Measurement
+{
+public:
+	Measurement()
+	: seconds(0.0), registers(0), spills(0)
+	{
+
+	}
+
+public:
+	double seconds;
+	size_t registers;
+	size_t spills;
+};
+
+/*! \brief Create a kernel of random arithmetic over a set of values, with
+	loops between the blocks */
+static void generateKernel(Module& module, unsigned int blocks,
+	unsigned int values, unsigned int seed)
+{
+	std::mt19937 generator(seed);
+
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto i32 = compiler->getType("i32");
+	auto i1  = compiler->getType("i1");
+
+	auto function = module.newFunction("kernel",
+		vanaheimr::ir::Variable::ExternalLinkage,
+		vanaheimr::ir::Variable::HiddenVisibility);
+
+	BasicBlockVector basicBlocks;
+
+	for(unsigned int b = 0; b < blocks; ++b)
+	{
+		basicBlocks.push_back(&*function->newBasicBlock(
+			function->exit_block(), "block" + std::to_string(b)));
+	}
+
+	VirtualRegisterVector registers;
+
+	for(unsigned int v = 0; v < values; ++v)
+	{
+		registers.push_back(&*function->newVirtualRegister(i32,
+			"value" + std::to_string(v)));
+	}
+
+	auto predicate = &*function->newVirtualRegister(i1, "predicate");
+
+	auto entry = basicBlocks.front();
+
+	for(unsigned int v = 0; v < values; ++v)
+	{
+		auto add = new vanaheimr::ir::Add(entry);
+
+		guard(add);
+		add->setD(use(registers[v], add));
+		add->setA(immediate(v, i32, add));
+		add->setB(immediate(1, i32, add));
+
+		entry->push_back(add);
+	}
+
+	auto setp = new vanaheimr::ir::Setp(
+		vanaheimr::ir::ComparisonInstruction::UnorderedLessThan, entry);
+
+	guard(setp);
+	setp->setD(use(predicate, setp));
+	setp->setA(use(registers.front(), setp));
+	setp->setB(use(registers.back(), setp));
+
+	entry->push_back(setp);
+
+	// each block works on a window of the values, so live ranges vary
+	unsigned int window = std::max(values / 4, 2U);
+
+	for(unsigned int b = 0; b < blocks; ++b)
+	{
+		auto block = basicBlocks[b];
+
+		unsigned int base = generator() % values;
+
+		auto pick = [&]()
+		{
+			return registers[(base + generator() % window) % values];
+		};
+
+		for(unsigned int i = 0; i < 2 * window; ++i)
+		{
+			if(generator() % 8 == 0)
+			{
+				auto copy = new vanaheimr::ir::Bitcast(block);
+
+				guard(copy);
+				copy->setD(use(pick(), copy));
+				copy->setA(use(pick(), copy));
+
+				block->push_back(copy);
+				continue;
+			}
+
+			auto add = new vanaheimr::ir::Add(block);
+
+			guard(add);
+			add->setD(use(pick(), add));
+			add->setA(use(pick(), add));
+			add->setB(use(pick(), add));
+
+			block->push_back(add);
+		}
+
+		// loop back to an earlier block
+		if(b > 0 && generator() % 2 == 0)
+		{
+			branch(block, basicBlocks[generator() % b], predicate);
+		}
+	}
+}
+
+static size_t countRegisters(const Function& function)
+{
+	std::set<const vanaheimr::machine::PhysicalRegister*> registers;
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(write == nullptr || !write->isRegister()) continue;
+
+				auto physical = static_cast<
+					vanaheimr::machine::PhysicalRegisterOperand*>(write);
+
+				if(physical->physicalRegister == nullptr) continue;
+
+				registers.insert(physical->physicalRegister);
+			}
+		}
+	}
+
+	return registers.size();
+}
+
+static Measurement benchmarkAllocator(const std::string& allocator,
+	unsigned int blocks, unsigned int values, unsigned int iterations,
+	unsigned int seed)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	Measurement result;
+
+	for(unsigned int i = 0; i < iterations; ++i)
+	{
+		auto module = compiler->newModule("benchmark-" + allocator);
+
+		generateKernel(*module, blocks, values, seed + i);
+
+		{
+			vanaheimr::transforms::PassManager manager(&*module);
+
+			auto pass = static_cast<vanaheimr::codegen::RegisterAllocator*>(
+				vanaheimr::transforms::PassFactory::createPass(allocator));
+
+			if(pass == nullptr)
+			{
+				throw std::runtime_error("Failed to create register "
+					"allocator '" + allocator + "'");
+			}
+
+			manager.addPass(pass);
+
+			auto start = std::chrono::steady_clock::now();
+
+			manager.runOnModule();
+
+			result.seconds += std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+
+			result.spills += pass->getSpilledRegisters(
+				*module->begin()).size();
+		}
+
+		result.registers += countRegisters(*module->begin());
+
+		compiler->deleteModule(module);
+	}
+
+	return result;
+}
+
+static void printRow(const std::string& name, const Measurement& measurement,
+	unsigned int iterations)
+{
+	std::cout << "  " << std::setw(16) << std::left << name
+		<< std::setw(12) << std::right << std::fixed << std::setprecision(1)
+		<< (measurement.seconds * 1.0e6) / iterations << " us/kernel"
+		<< std::setw(8) << std::setprecision(1)
+		<< ((double)measurement.registers) / iterations << " registers"
+		<< std::setw(8) << std::setprecision(1)
+		<< ((double)measurement.spills) / iterations << " spills\n";
+}
+
+static bool benchmarkRegisterAllocation(const std::string& allocators,
+	unsigned int blocks, unsigned int values, unsigned int iterations,
+	unsigned int seed)
+{
+	vanaheimr::compiler::Compiler::getSingleton()->switchToNewMachineModel(
+		"ArchaeopteryxSimulator");
+
+	std::cout << blocks << " blocks, " << values << " values:\n";
+
+	for(auto& allocator : hydrazine::split(allocators, ","))
+	{
+		try
+		{
+			printRow(allocator, benchmarkAllocator(allocator, blocks, values,
+				iterations, seed), iterations);
+		}
+		catch(const std::exception& e)
+		{
+			std::cout << " Benchmark failed for '" << allocator << "': "
+				<< e.what() << "\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	std::string  allocators;
+	unsigned int blocks     = 0;
+	unsigned int values     = 0;
+	unsigned int iterations = 0;
+	unsigned int seed       = 0;
+
+	bool verbose = false;
+
+	parser.description("This program compares the compile time and register "
+		"usage of the register allocators on generated kernels.");
+
+	parser.parse("-a", "--allocators", allocators,
+		"chaitin-briggs,linear-scan",
+		"Comma separated list of register allocation passes.");
+	parser.parse("-b", "--blocks", blocks, 16,
+		"The number of basic blocks in each kernel.");
+	parser.parse("-r", "--values", values, 96,
+		"The number of values in each kernel.");
+	parser.parse("-n", "--iterations", iterations, 10,
+		"The number of kernels to allocate with each allocator.");
+	parser.parse("-s", "--seed", seed, 0,
+		"The seed for generating kernels.");
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::benchmarkRegisterAllocation(allocators, blocks, values,
+		iterations, seed))
+	{
+		std::cout << "Register allocation benchmark Failed\n";
+		return -1;
+	}
+
+	std::cout << "Register allocation benchmark Passed\n";
+
+	return 0;
+}
+
@@ -0,0 +1,265 @@
+/*! \file   test-chaitin-briggs.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for iterated register coalescing in the Chaitin-Briggs
+		register allocator.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/codegen/interface/RegisterAllocator.h>
+
+#include <vanaheimr/machine/interface/PhysicalRegisterOperand.h>
+#include <vanaheimr/machine/interface/PhysicalRegister.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+typedef std::vector<unsigned int> IdVector;
+
+typedef vanaheimr::compiler::Compiler::module_iterator ModuleIterator;
+
+/*! \brief Create a function that copies a value through a chain of
+	registers, none of the copies interfere with their sources */
+static void generateCopies(Module& module, unsigned int copies)
+{
+	auto test = newTestFunction(module, "copies");
+
+	newValues(test, "i32", {"value"});
+	newBlocks(test, {"body"});
+
+	auto block = test.blocks["body"];
+	auto value = test.values["value"];
+
+	add(block, test.values, "value", "1", "2");
+
+	for(unsigned int c = 0; c < copies; ++c)
+	{
+		auto copy = &*test.function->newVirtualRegister(getType("i32"),
+			"copy" + std::to_string(c));
+
+		auto bitcast = new vanaheimr::ir::Bitcast(block);
+
+		guard(bitcast);
+		bitcast->setD(use(copy, bitcast));
+		bitcast->setA(use(value, bitcast));
+
+		block->push_back(bitcast);
+
+		value = copy;
+	}
+
+	// the result reads the last copy
+	test.values["copy"] = value;
+
+	newValues(test, "i32", {"result"});
+
+	add(block, test.values, "result", "copy", "1");
+}
+
+static unsigned int getPhysicalRegisterId(
+	const vanaheimr::ir::Operand* operand)
+{
+	auto physical = dynamic_cast<
+		const vanaheimr::machine::PhysicalRegisterOperand*>(operand);
+
+	if(physical == nullptr || physical->physicalRegister == nullptr)
+	{
+		return (unsigned int)-1;
+	}
+
+	return physical->physicalRegister->id();
+}
+
+/*! \brief The physical register of every register operand, in order */
+static IdVector getAssignment(const Function& function, bool& allocated)
+{
+	IdVector assignment;
+
+	allocated = true;
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			for(auto operands : {&instruction->writes, &instruction->reads})
+			{
+				for(auto operand : *operands)
+				{
+					if(!operand->isRegister()) continue;
+
+					assignment.push_back(getPhysicalRegisterId(operand));
+
+					if(assignment.back() == (unsigned int)-1)
+					{
+						allocated = false;
+					}
+				}
+			}
+		}
+	}
+
+	return assignment;
+}
+
+static unsigned int countOpcode(const Function& function,
+	Instruction::Opcode opcode)
+{
+	unsigned int count = 0;
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			if(instruction->opcode == opcode) ++count;
+		}
+	}
+
+	return count;
+}
+
+static ModuleIterator allocate(const std::string& name)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule(name);
+
+	generateCopies(*module, 4);
+	generateClique(*module, "clique", 8);
+
+	runPass(*module, "chaitin-briggs");
+
+	return module;
+}
+
+/*! \brief Copies that do not interfere are coalesced and then deleted,
+	values that are live together get different registers, and the
+	assignment does not change from run to run. */
+static bool testChaitinBriggs(bool verbose)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	compiler->switchToNewMachineModel("ArchaeopteryxSimulator");
+
+	auto first  = allocate("test-chaitin-briggs-0");
+	auto second = allocate("test-chaitin-briggs-1");
+
+	bool passed = true;
+
+	auto copies = first->getFunction("copies");
+	auto clique = first->getFunction("clique");
+
+	unsigned int bitcasts = countOpcode(*copies, Instruction::Bitcast);
+
+	if(verbose)
+	{
+		std::cout << "  " << bitcasts << " copies left after coalescing\n";
+	}
+
+	if(bitcasts != 0)
+	{
+		std::cout << " " << bitcasts << " copies were not coalesced\n";
+		passed = false;
+	}
+
+	std::set<unsigned int> cliqueRegisters;
+
+	for(auto& block : *clique)
+	{
+		for(auto instruction : block)
+		{
+			if(instruction->isLoad() || instruction->isStore())
+			{
+				std::cout << " the clique was spilled\n";
+				passed = false;
+			}
+
+			if(instruction->opcode != Instruction::Add) continue;
+
+			auto add = static_cast<vanaheimr::ir::Add*>(instruction);
+
+			// the values are the adds of two immediates
+			if(add->a()->isRegister()) continue;
+
+			cliqueRegisters.insert(getPhysicalRegisterId(add->d()));
+		}
+	}
+
+	if(cliqueRegisters.size() != 8 || cliqueRegisters.count(-1) != 0)
+	{
+		std::cout << " the 8 values of the clique were given "
+			<< cliqueRegisters.size() << " distinct registers\n";
+		passed = false;
+	}
+
+	for(auto& function : *first)
+	{
+		bool firstAllocated  = false;
+		bool secondAllocated = false;
+
+		auto firstAssignment = getAssignment(function, firstAllocated);
+		auto secondAssignment = getAssignment(
+			*second->getFunction(function.name()), secondAllocated);
+
+		if(!firstAllocated || !secondAllocated)
+		{
+			std::cout << " operands in " << function.name()
+				<< " were left without a register\n";
+			passed = false;
+		}
+
+		if(firstAssignment != secondAssignment)
+		{
+			std::cout << " the registers assigned in " << function.name()
+				<< " changed between runs\n";
+			passed = false;
+		}
+	}
+
+	compiler->deleteModule(first);
+	compiler->deleteModule(second);
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program colors registers with iterated "
+		"register coalescing and checks the result.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testChaitinBriggs(verbose))
+	{
+		std::cout << "Chaitin-Briggs test Failed\n";
+		return -1;
+	}
+
+	std::cout << "Chaitin-Briggs test Passed\n";
+
+	return 0;
+}
+
@@ -0,0 +1,224 @@
+/*! \file   test-list-scheduler.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for critical path list scheduling.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+typedef std::vector<const Instruction*> InstructionVector;
+
+/*! \brief The instruction that wrote each value read, in read order */
+typedef std::map<const Instruction*, InstructionVector> ReachingWriterMap;
+
+/*! \brief A chain of cheap adds and an independent load that feeds the
+	last instruction, the load should be started before the chain */
+static void generateLoadAndChain(Module& module, InstructionVector& marks)
+{
+	auto test = newTestFunction(module, "load-and-chain");
+
+	newValues(test, "i32", {"a", "b", "c"});
+	newValues(test, "i64", {"p"});
+	newValues(test, "i32", {"v", "s"});
+	newBlocks(test, {"body"});
+
+	auto& values = test.values;
+	auto  block  = test.blocks["body"];
+
+	add(block, values, "a", "1", "2");
+
+	marks.push_back(add(block, values, "b", "a", "1"));
+
+	add(block, values, "c", "b", "1");
+	add(block, values, "p", "256", "0");
+
+	marks.push_back(load(block, values, "v", "p"));
+
+	add(block, values, "s", "v", "c");
+}
+
+/*! \brief The same register is written twice, the load that overwrites
+	it may not move above the read of the first value */
+static void generateRegisterReuse(Module& module)
+{
+	auto test = newTestFunction(module, "register-reuse");
+
+	newValues(test, "i64", {"p"});
+	newValues(test, "i32", {"x", "y", "z"});
+	newBlocks(test, {"body"});
+
+	auto& values = test.values;
+	auto  block  = test.blocks["body"];
+
+	add(block, values, "p", "256", "0");
+	add(block, values, "x", "1", "1");
+	add(block, values, "y", "x", "1");
+	load(block, values, "x", "p");
+	add(block, values, "z", "x", "y");
+	add(block, values, "y", "z", "1");
+}
+
+static VirtualRegister* getRegister(const vanaheimr::ir::Operand* operand)
+{
+	return static_cast<const vanaheimr::ir::RegisterOperand*>(
+		operand)->virtualRegister;
+}
+
+/*! \brief Record the writer that each read observes, and the final writer
+	of each value, so any legal schedule gives the same map */
+static ReachingWriterMap getReachingWriters(const BasicBlock& block)
+{
+	std::map<const VirtualRegister*, const Instruction*> writers;
+
+	ReachingWriterMap reachingWriters;
+
+	for(auto instruction : block)
+	{
+		auto& observed = reachingWriters[instruction];
+
+		for(auto read : instruction->reads)
+		{
+			if(!read->isRegister()) continue;
+
+			observed.push_back(writers[getRegister(read)]);
+		}
+
+		for(auto write : instruction->writes)
+		{
+			writers[getRegister(write)] = instruction;
+		}
+	}
+
+	auto& finalWriters = reachingWriters[nullptr];
+
+	for(auto writer : writers) finalWriters.push_back(writer.second);
+
+	return reachingWriters;
+}
+
+static unsigned int position(const BasicBlock& block,
+	const Instruction* instruction)
+{
+	unsigned int index = 0;
+
+	for(auto i : block)
+	{
+		if(i == instruction) return index;
+
+		++index;
+	}
+
+	return index;
+}
+
+static void printBlock(const BasicBlock& block)
+{
+	for(auto instruction : block)
+	{
+		std::cout << "   " << instruction->toString() << "\n";
+	}
+}
+
+static bool testListScheduler(bool verbose)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	compiler->switchToNewMachineModel("ArchaeopteryxSimulator");
+
+	auto module = compiler->newModule("test-list-scheduler");
+
+	// the add that starts the chain, and the load
+	InstructionVector marks;
+
+	generateLoadAndChain(*module, marks);
+	generateRegisterReuse(*module);
+
+	std::map<std::string, ReachingWriterMap> original;
+
+	for(auto& function : *module)
+	{
+		original[function.name()] = getReachingWriters(
+			*++function.begin());
+	}
+
+	runPass(*module, "list");
+
+	bool passed = true;
+
+	for(auto& function : *module)
+	{
+		auto& block = *++function.begin();
+
+		if(verbose)
+		{
+			std::cout << "  " << function.name() << " scheduled as:\n";
+			printBlock(block);
+		}
+
+		if(getReachingWriters(block) != original[function.name()])
+		{
+			std::cout << " the schedule of " << function.name()
+				<< " changed the value read by an instruction:\n";
+			printBlock(block);
+			passed = false;
+		}
+	}
+
+	auto& block = *++module->getFunction("load-and-chain")->begin();
+
+	if(position(block, marks[1]) > position(block, marks[0]))
+	{
+		std::cout << " the load was not hoisted above the add chain:\n";
+		printBlock(block);
+		passed = false;
+	}
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program schedules blocks with long latency "
+		"loads and reused registers and checks the order.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testListScheduler(verbose))
+	{
+		std::cout << "List scheduler test Failed\n";
+		return -1;
+	}
+
+	std::cout << "List scheduler test Passed\n";
+
+	return 0;
+}
+
@@ -0,0 +1,365 @@
+/*! \file   test-register-allocation.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for register allocation and spilling of modules with
+		several functions.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/codegen/interface/RegisterAllocator.h>
+
+#include <vanaheimr/machine/interface/PhysicalRegisterOperand.h>
+#include <vanaheimr/machine/interface/PhysicalPredicateOperand.h>
+#include <vanaheimr/machine/interface/PhysicalIndirectOperand.h>
+#include <vanaheimr/machine/interface/PhysicalRegister.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+#include <hydrazine/interface/string.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace test
+{
+
+static bool isAllocated(const vanaheimr::ir::Operand* operand)
+{
+	if(operand == nullptr || !operand->isRegister()) return true;
+
+	auto predicate = dynamic_cast<
+		const vanaheimr::machine::PhysicalPredicateOperand*>(operand);
+
+	if(predicate != nullptr) return predicate->physicalRegister != nullptr;
+
+	auto physical = dynamic_cast<
+		const vanaheimr::machine::PhysicalRegisterOperand*>(operand);
+
+	if(physical == nullptr) return false;
+
+	return physical->physicalRegister != nullptr;
+}
+
+/*! \brief Add a function with a predicate that is live across a number of
+	values that are all live at the same time, the last add only runs if
+	the predicate is false
+
+	body: p = 0 < 1; value0 = 0 + 1; ...; sum = value0 + value1; ...;
+		!@p sum = sum + 1
+*/
+static void generateGuarded(Module& module, const std::string& name,
+	unsigned int values)
+{
+	auto test = newTestFunction(module, name);
+
+	newValues(test, "i1", {"p"});
+	newBlocks(test, {"body"});
+
+	auto block = test.blocks["body"];
+
+	setp(block, test.values, "p", "0", "1");
+
+	auto i32 = getType("i32");
+
+	for(unsigned int v = 0; v < values; ++v)
+	{
+		auto value = "value" + std::to_string(v);
+
+		test.values[value] = &*test.function->newVirtualRegister(i32, value);
+
+		add(block, test.values, value, std::to_string(v), "1");
+	}
+
+	test.values["sum"] = &*test.function->newVirtualRegister(i32, "sum");
+
+	for(unsigned int v = 0; v < values; ++v)
+	{
+		add(block, test.values, "sum", v == 0 ? "value0" : "sum",
+			"value" + std::to_string(v));
+	}
+
+	auto last = add(block, test.values, "sum", "sum", "1");
+
+	last->setGuard(new vanaheimr::ir::PredicateOperand(test.values["p"],
+		vanaheimr::ir::PredicateOperand::InversePredicate, last));
+}
+
+/*! \brief Count the guards that lost their modifier or register */
+static unsigned int countBadGuards(const Function& function)
+{
+	unsigned int bad = 0;
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			if(instruction->guard()->isAlwaysTrue()) continue;
+
+			auto guard = dynamic_cast<
+				const vanaheimr::machine::PhysicalPredicateOperand*>(
+				instruction->guard());
+
+			if(guard == nullptr || guard->physicalRegister == nullptr ||
+				guard->modifier !=
+				vanaheimr::ir::PredicateOperand::InversePredicate)
+			{
+				++bad;
+			}
+		}
+	}
+
+	return bad;
+}
+
+class Statistics
+{
+public:
+	Statistics()
+	: unallocated(0), loads(0), unframed(0)
+	{
+
+	}
+
+public:
+	unsigned int unallocated;
+	unsigned int loads;
+	unsigned int unframed;
+};
+
+/*! \brief Get the register that a spill load or store addresses through */
+static const vanaheimr::machine::PhysicalRegister* getFrameRegister(
+	const Instruction* instruction)
+{
+	auto address = instruction->opcode == Instruction::Ld ?
+		static_cast<const vanaheimr::ir::Ld*>(instruction)->a() :
+		static_cast<const vanaheimr::ir::St*>(instruction)->d();
+
+	auto indirect = dynamic_cast<
+		const vanaheimr::machine::PhysicalIndirectOperand*>(address);
+
+	if(indirect == nullptr) return nullptr;
+
+	return indirect->physicalRegister;
+}
+
+/*! \brief Is the first instruction of the function the start of the
+	frame address computation, from the global thread id in rf33? */
+static const vanaheimr::machine::PhysicalRegister* getFramePointer(
+	const Function& function)
+{
+	auto& entry = *function.entry_block();
+
+	if(entry.empty() || entry.front()->opcode != Instruction::Mul)
+	{
+		return nullptr;
+	}
+
+	auto offset = static_cast<const vanaheimr::ir::Mul*>(entry.front());
+
+	auto threadId = dynamic_cast<
+		const vanaheimr::machine::PhysicalRegisterOperand*>(offset->a());
+	auto frame = dynamic_cast<
+		const vanaheimr::machine::PhysicalRegisterOperand*>(offset->d());
+
+	if(threadId == nullptr || frame == nullptr) return nullptr;
+	if(threadId->physicalRegister->name() != "rf33") return nullptr;
+
+	return frame->physicalRegister;
+}
+
+static Statistics countSpillCode(const Function& function)
+{
+	Statistics statistics;
+
+	auto framePointer = getFramePointer(function);
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			if(instruction->isLoad()) ++statistics.loads;
+
+			// spill slots are addressed relative to the thread's frame
+			if(instruction->opcode == Instruction::Ld ||
+				instruction->opcode == Instruction::St)
+			{
+				auto frame = getFrameRegister(instruction);
+
+				if(frame == nullptr || frame != framePointer)
+				{
+					++statistics.unframed;
+				}
+			}
+
+			for(auto read : instruction->reads)
+			{
+				if(!isAllocated(read)) ++statistics.unallocated;
+			}
+
+			for(auto write : instruction->writes)
+			{
+				if(!isAllocated(write)) ++statistics.unallocated;
+			}
+		}
+	}
+
+	return statistics;
+}
+
+/*! \brief Allocate a module with functions that need spill code and
+	functions that do not, every operand should end up in a register, and
+	guards should keep their modifiers, including guards that are reloaded.
+
+	The spiller runs in a later wave than allocators that are named after
+	it, so it must see the allocation of each function, not only the last.
+*/
+static bool testTwoFunctions(const std::string& allocator,
+	unsigned int threads, bool verbose)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-" + allocator);
+
+	generateClique(*module, "spills", 100);
+	generateClique(*module, "fits",     4);
+
+	generateGuarded(*module, "guarded",        4);
+	generateGuarded(*module, "guarded-spills", 100);
+
+	{
+		vanaheimr::transforms::PassManager manager(&*module);
+
+		manager.setMaximumThreadCount(threads);
+
+		auto pass = vanaheimr::transforms::PassFactory::createPass(allocator);
+
+		if(pass == nullptr)
+		{
+			throw std::runtime_error("Failed to create register "
+				"allocator '" + allocator + "'");
+		}
+
+		auto spiller = vanaheimr::transforms::PassFactory::createPass(
+			"GenericSpillCodePass");
+
+		manager.addPass(pass);
+		manager.addPass(spiller);
+
+		manager.addDependence(spiller->name, pass->name);
+
+		manager.runOnModule();
+	}
+
+	bool passed = true;
+
+	for(auto& function : *module)
+	{
+		auto statistics = countSpillCode(function);
+
+		if(verbose)
+		{
+			std::cout << "  " << allocator << " (" << threads << " threads) "
+				<< function.name() << ": " << statistics.unallocated
+				<< " unallocated operands, " << statistics.loads
+				<< " spill loads\n";
+		}
+
+		if(statistics.unframed != 0)
+		{
+			std::cout << " " << allocator << " emitted "
+				<< statistics.unframed << " spill loads or stores in "
+				<< function.name() << " that are not relative to the "
+				"thread's frame\n";
+			passed = false;
+		}
+
+		if(statistics.unallocated != 0)
+		{
+			std::cout << " " << allocator << " left "
+				<< statistics.unallocated << " operands without a register "
+				"in " << function.name() << "\n";
+			passed = false;
+		}
+
+		auto badGuards = countBadGuards(function);
+
+		if(badGuards != 0)
+		{
+			std::cout << " " << allocator << " dropped the predicate of "
+				<< badGuards << " guards in " << function.name() << "\n";
+			passed = false;
+		}
+
+		bool shouldSpill = function.name() == "spills" ||
+			function.name() == "guarded-spills";
+
+		if(shouldSpill != (statistics.loads != 0))
+		{
+			std::cout << " " << allocator << " emitted " << statistics.loads
+				<< " spill loads in " << function.name() << "\n";
+			passed = false;
+		}
+	}
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+static bool testRegisterAllocation(const std::string& allocators,
+	bool verbose)
+{
+	vanaheimr::compiler::Compiler::getSingleton()->switchToNewMachineModel(
+		"ArchaeopteryxSimulator");
+
+	for(auto& allocator : hydrazine::split(allocators, ","))
+	{
+		for(unsigned int threads : {1, 2})
+		{
+			if(!testTwoFunctions(allocator, threads, verbose)) return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	std::string allocators;
+
+	bool verbose = false;
+
+	parser.description("This program allocates registers for a module with "
+		"two functions, one of which spills, and checks the result.");
+
+	parser.parse("-a", "--allocators", allocators,
+		"chaitin-briggs,linear-scan",
+		"Comma separated list of register allocation passes.");
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testRegisterAllocation(allocators, verbose))
+	{
+		std::cout << "Register allocation test Failed\n";
+		return -1;
+	}
+
+	std::cout << "Register allocation test Passed\n";
+
+	return 0;
+}
+
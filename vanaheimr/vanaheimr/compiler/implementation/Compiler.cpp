@@ -35,22 +35,20 @@ namespace vanaheimr
 namespace compiler
 {
 
-static Compiler singleton;
-
 Compiler::Compiler()
 {
 	// TODO Add in common types
-	_types.push_back(new ir::IntegerType(this, 1) );
-	_types.push_back(new ir::IntegerType(this, 8) );
-	_types.push_back(new ir::IntegerType(this, 16));
-	_types.push_back(new ir::IntegerType(this, 32));
-	_types.push_back(new ir::IntegerType(this, 64));
+	_types.insert(ir::IntegerType(this, 1) );
+	_types.insert(ir::IntegerType(this, 8) );
+	_types.insert(ir::IntegerType(this, 16));
+	_types.insert(ir::IntegerType(this, 32));
+	_types.insert(ir::IntegerType(this, 64));
 
-	_types.push_back(new ir::FloatType(this));
-	_types.push_back(new ir::DoubleType(this));
+	_types.insert(ir::FloatType(this));
+	_types.insert(ir::DoubleType(this));
 
-	_types.push_back(new ir::BasicBlockType(this));
-	_types.push_back(new ir::VoidType(this));
+	_types.insert(ir::BasicBlockType(this));
+	_types.insert(ir::VoidType(this));
 
 	// Create the machine model
 	_machineModel = machine::MachineModelFactory::createDefaultMachine();
@@ -60,8 +58,6 @@ Compiler::Compiler()
 
 Compiler::~Compiler()
 {
-	for(auto type : *this) delete type;
-
 	delete getMachineModel();
 }
 
@@ -117,30 +113,39 @@ Compiler::const_module_iterator Compiler::module_end() const
 
 Compiler::module_iterator Compiler::newModule(const std::string& name)
 {
+	Lock lock(_moduleMutex);
+
 	return _modules.insert(_modules.end(), ir::Module(name, this));
 }
 	
+void Compiler::deleteModule(module_iterator module)
+{
+	Lock lock(_moduleMutex);
+
+	_modules.erase(module);
+}
+
 Compiler::iterator Compiler::newType(const ir::Type& type)
 {
-	assert(getType(type.name) == nullptr);
+	auto newType = _types.insert(type);
 
-	report("Added type: '" << type.name << "'");
+	assert(newType.second);
 	
-	return _types.insert(_types.end(), type.clone());
+	return newType.first;
 }
 
 Compiler::iterator Compiler::getOrInsertType(const ir::Type& type)
 {
-	for(iterator t = begin(); t != end(); ++t)
-	{
-		if(type.name == (*t)->name) return t;
-	}
-
-	return newType(type);
+	return _types.insert(type).first;
 }
 
 Compiler::iterator Compiler::getOrInsertType(const std::string& signature)
 {
+	// Type names are canonical signatures, so avoid parsing known types
+	auto existingType = _types.find(signature);
+	
+	if(existingType != _types.end()) return existingType;
+
 	report("Parsing type with signature: '" << signature << "'");
 	
 	parser::TypeParser parser(this);
@@ -149,11 +154,13 @@ Compiler::iterator Compiler::getOrInsertType(const std::string& signature)
 	
 	parser.parse(&stream);
 	
-	return getOrInsertType(*parser.parsedType()->clone());
+	return getOrInsertType(*parser.parsedType());
 }
 
 Compiler::module_iterator Compiler::getModule(const std::string& name)
 {
+	Lock lock(_moduleMutex);
+
 	for(module_iterator module = module_begin();
 		module != module_end(); ++module)
 	{
@@ -166,7 +173,9 @@ Compiler::module_iterator Compiler::getModule(const std::string& name)
 Compiler::const_module_iterator Compiler::getModule(
 	const std::string& name) const
 {
-	const_module_iterator module = module_end();
+	Lock lock(_moduleMutex);
+
+	const_module_iterator module = module_begin();
 	
 	for( ; module != module_end(); ++module)
 	{
@@ -178,26 +187,16 @@ Compiler::const_module_iterator Compiler::getModule(
 
 ir::Type* Compiler::getType(const std::string& name)
 {
-	iterator type = _types.begin();
+	auto type = _types.find(name);
 	
-	for( ; type != _types.end(); ++type)
-	{
-		if((*type)->name == name) return *type;
-	}
+	if(type == _types.end()) return 0;
 	
-	return 0;
+	return *type;
 }
 
 const ir::Type* Compiler::getType(const std::string& typeName) const
 {
-	const_iterator type = _types.begin();
-	
-	for( ; type != _types.end(); ++type)
-	{
-		if((*type)->name == typeName) return *type;
-	}
-	
-	return 0;
+	return const_cast<Compiler*>(this)->getType(typeName);
 }
 
 const ir::Type* Compiler::getBasicBlockType() const
@@ -226,6 +225,9 @@ void Compiler::switchToNewMachineModel(const std::string& name)
 
 Compiler* Compiler::getSingleton()
 {
+	// Constructed on first use, other static initializers depend on it
+	static Compiler singleton;
+
 	return &singleton;
 }
 
@@ -233,4 +235,3 @@ Compiler* Compiler::getSingleton()
 
 }
 
-
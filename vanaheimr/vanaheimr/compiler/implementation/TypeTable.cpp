@@ -0,0 +1,144 @@
+/*! \file   TypeTable.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the TypeTable class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/compiler/interface/TypeTable.h>
+
+#include <vanaheimr/ir/interface/Type.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace compiler
+{
+
+TypeTable::TypeTable()
+{
+
+}
+
+TypeTable::~TypeTable()
+{
+	for(auto type : _types) delete type;
+}
+
+TypeTable::iterator TypeTable::find(const std::string& name)
+{
+	Key key(name);
+
+	auto& shard = _getShard(key);
+
+	Lock lock(shard.mutex);
+
+	auto type = shard.types.find(key);
+
+	if(type == shard.types.end()) return end();
+
+	return type->second;
+}
+
+std::pair<TypeTable::iterator, bool> TypeTable::insert(const ir::Type& type)
+{
+	Key key(type.name);
+
+	auto& shard = _getShard(key);
+
+	Lock lock(shard.mutex);
+
+	auto existingType = shard.types.find(key);
+
+	if(existingType != shard.types.end())
+	{
+		return std::make_pair(existingType->second, false);
+	}
+
+	report("Added type: '" << type.name << "'");
+
+	auto newType = type.clone();
+
+	iterator position;
+
+	{
+		Lock typesLock(_typesMutex);
+
+		position = _types.insert(_types.end(), newType);
+	}
+
+	// the key must refer to the copy owned by the table
+	shard.types.insert(std::make_pair(Key(newType->name), position));
+
+	return std::make_pair(position, true);
+}
+
+TypeTable::iterator TypeTable::begin()
+{
+	return _types.begin();
+}
+
+TypeTable::const_iterator TypeTable::begin() const
+{
+	return _types.begin();
+}
+
+TypeTable::iterator TypeTable::end()
+{
+	return _types.end();
+}
+
+TypeTable::const_iterator TypeTable::end() const
+{
+	return _types.end();
+}
+
+bool TypeTable::empty() const
+{
+	return size() == 0;
+}
+
+size_t TypeTable::size() const
+{
+	Lock lock(_typesMutex);
+
+	return _types.size();
+}
+
+TypeTable::Key::Key(const std::string& n)
+: hash(std::hash<std::string>()(n)), name(&n)
+{
+
+}
+
+bool TypeTable::Key::operator==(const Key& k) const
+{
+	return hash == k.hash && *name == *k.name;
+}
+
+size_t TypeTable::KeyHash::operator()(const Key& k) const
+{
+	return k.hash;
+}
+
+TypeTable::Shard& TypeTable::_getShard(const Key& key)
+{
+	// use the high bits, the low bits select buckets within the shard
+	return _shards[(key.hash >> (sizeof(size_t) * 8 - 4)) % ShardCount];
+}
+
+}
+
+}
+
+
@@ -5,9 +5,18 @@
 	
 */
 
-// Standard Library Includes
+#pragma once
+
+// Vanaheimr Includes
 #include <vanaheimr/ir/interface/Module.h>
 
+#include <vanaheimr/compiler/interface/TypeTable.h>
+
+// Standard Library Includes
+#include <list>
+#include <mutex>
+#include <string>
+
 // Forward Declarations
 namespace vanaheimr { namespace ir      { class Type;         } }
 namespace vanaheimr { namespace machine { class MachineModel; } }
@@ -19,15 +28,22 @@ namespace vanaheimr
 namespace compiler
 {
 
-/*! \brief The global compiler state for vanaheimr. */
+/*! \brief The global compiler state for vanaheimr.
+
+	Types are interned in a TypeTable, so lookups by name are constant
+	time and types can be compared by pointer.
+
+	Adding and looking up types and modules is safe from multiple threads.
+	Iterators are never invalidated by insertions, but walking the type or
+	module lists while another thread inserts is not.
+*/
 class Compiler
 {
 public:
-	typedef std::vector<ir::Type*> TypeVector;
-	typedef std::list<ir::Module>  ModuleList;
+	typedef std::list<ir::Module> ModuleList;
 	
-	typedef TypeVector::iterator       iterator;
-	typedef TypeVector::const_iterator const_iterator;
+	typedef TypeTable::iterator       iterator;
+	typedef TypeTable::const_iterator const_iterator;
 
 	typedef ModuleList::iterator       module_iterator;
 	typedef ModuleList::const_iterator const_module_iterator;
@@ -62,6 +78,10 @@ public:
 	module_iterator newModule(const std::string& name);
 	iterator newType(const ir::Type& type);
 
+public:
+	/*! \brief Delete a module and everything in it */
+	void deleteModule(module_iterator module);
+
 public:
 	      module_iterator getModule(const std::string& name);
 	const_module_iterator getModule(const std::string& name) const;
@@ -91,10 +111,17 @@ public:
 	static Compiler* getSingleton();
 
 private:
-	TypeVector             _types;
+	typedef std::mutex             Mutex;
+	typedef std::lock_guard<Mutex> Lock;
+
+private:
+	TypeTable              _types;
 	ModuleList             _modules;
 	machine::MachineModel* _machineModel;
 
+private:
+	mutable Mutex _moduleMutex;
+
 };	
 
 }
@@ -0,0 +1,123 @@
+/*! \file   TypeTable.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the TypeTable class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Type; } }
+
+namespace vanaheimr
+{
+
+namespace compiler
+{
+
+/*! \brief A hash-consed table of types, keyed by their signature (name).
+
+	Each signature is stored exactly once, so types may be compared by
+	pointer.  The index is split into independently locked shards chosen
+	by the signature hash, so that threads inserting or looking up
+	unrelated types do not contend.
+
+	Iterators are never invalidated by insertions, but walking the table
+	while another thread inserts is not safe.  The names of interned
+	types must not be changed.
+*/
+class TypeTable
+{
+public:
+	typedef std::list<ir::Type*> TypeList;
+
+	typedef TypeList::iterator       iterator;
+	typedef TypeList::const_iterator const_iterator;
+
+public:
+	TypeTable();
+	~TypeTable();
+
+public:
+	TypeTable(const TypeTable&) = delete;
+	TypeTable& operator=(const TypeTable&) = delete;
+
+public:
+	/*! \brief Find a type by signature, returns end() if there is none */
+	iterator find(const std::string& name);
+
+	/*! \brief Insert a copy of the type unless its signature is present
+
+		\return The interned type, and whether it was newly inserted
+	*/
+	std::pair<iterator, bool> insert(const ir::Type& type);
+
+public:
+	iterator       begin();
+	const_iterator begin() const;
+
+	iterator       end();
+	const_iterator end() const;
+
+public:
+	bool   empty() const;
+	size_t size()  const;
+
+private:
+	/*! \brief A signature with its precomputed hash */
+	class Key
+	{
+	public:
+		explicit Key(const std::string& name);
+
+	public:
+		bool operator==(const Key& k) const;
+
+	public:
+		size_t             hash;
+		const std::string* name;
+	};
+
+	class KeyHash
+	{
+	public:
+		size_t operator()(const Key& k) const;
+	};
+
+	typedef std::unordered_map<Key, iterator, KeyHash> TypeMap;
+
+	class Shard
+	{
+	public:
+		std::mutex mutex;
+		TypeMap    types;
+	};
+
+	typedef std::lock_guard<std::mutex> Lock;
+
+private:
+	static const unsigned int ShardCount = 16;
+
+private:
+	Shard& _getShard(const Key& key);
+
+private:
+	Shard _shards[ShardCount];
+
+	TypeList           _types;
+	mutable std::mutex _typesMutex;
+
+};
+
+}
+
+}
+
+
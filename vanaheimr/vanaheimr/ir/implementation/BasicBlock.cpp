@@ -257,6 +257,11 @@ void BasicBlock::setFunction(Function* f)
 	_function = f;
 }
 
+void BasicBlock::setId(Id i)
+{
+	_id = i;
+}
+
 void BasicBlock::setName(const std::string& n)
 {
 	_setName(n);
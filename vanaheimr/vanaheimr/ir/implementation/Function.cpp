@@ -15,6 +15,7 @@
 
 // Standard Library Includes
 #include <unordered_map>
+#include <algorithm>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -277,6 +278,17 @@ Function::register_iterator Function::newVirtualRegister(const Type* type,
 		VirtualRegister(name, _nextRegisterId++, this, type));	
 }
 
+void Function::spliceVirtualRegisters(VirtualRegisterList& registers)
+{
+	for(auto& virtualRegister : registers)
+	{
+		virtualRegister.id       = _nextRegisterId++;
+		virtualRegister.function = this;
+	}
+	
+	_registers.splice(register_end(), registers);
+}
+
 Function::argument_iterator Function::newArgument(const Type* type,
 	const std::string& name)
 {
@@ -401,6 +413,18 @@ bool Function::register_empty() const
 	return _registers.empty();
 }
 
+VirtualRegister::Id Function::register_id_bound() const
+{
+	VirtualRegister::Id bound = 0;
+
+	for(auto value = register_begin(); value != register_end(); ++value)
+	{
+		bound = std::max(bound, value->id + 1);
+	}
+	
+	return bound;
+}
+
 Function::register_iterator Function::erase(const register_iterator& r)
 {
 	return _registers.erase(r);
@@ -456,6 +480,29 @@ void Function::moveBasicBlock(iterator position, iterator block)
 	_blocks.splice(position, _blocks, block);
 }
 
+Function::iterator Function::erase(iterator block)
+{
+	assert(block != entry_block());
+	assert(block != exit_block());
+	
+	BasicBlock::Id id = block->id();
+	
+	auto next = _blocks.erase(block);
+	
+	--_nextBlockId;
+	
+	for(auto& remaining : *this)
+	{
+		if(remaining.id() == _nextBlockId)
+		{
+			remaining.setId(id);
+			break;
+		}
+	}
+	
+	return next;
+}
+
 Function::local_iterator Function::local_begin()
 {
 	return _locals.begin();
@@ -11,6 +11,8 @@
 #include <vanaheimr/ir/interface/MetaData.h>
 #include <vanaheimr/ir/interface/Type.h>
 
+#include <vanaheimr/util/interface/MemoryPool.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
@@ -37,6 +39,16 @@ Instruction::~Instruction()
 	clear();
 }
 
+void* Instruction::operator new(size_t bytes)
+{
+	return util::MemoryPool::allocate(bytes);
+}
+
+void Instruction::operator delete(void* pointer, size_t bytes)
+{
+	util::MemoryPool::deallocate(pointer, bytes);
+}
+
 Instruction::Instruction(const Instruction& i)
 : opcode(i.opcode), block(i.block), _id(i.id())
 {
@@ -858,7 +870,7 @@ const Instruction::OperandPointer& Call::target() const
 
 Call::OperandVector Call::returned()
 {
-	return writes;
+	return OperandVector(writes.begin(), writes.end());
 }
 
 Call::ConstOperandVector Call::returned() const
@@ -1380,7 +1392,7 @@ void Phi::removeSource(BasicBlock* predecessor)
 		delete *readPosition;
 		reads.erase(readPosition);
 		
-		break;
+		return;
 	}
 	
 	assertM(false, "Phi instruction " << toString()
@@ -27,13 +27,13 @@ ModuleBase::~ModuleBase()
 }
 
 Module::Module(const std::string& n, compiler::Compiler* c)
-: name(n), _compiler(c)
+: name(n), _memoryPool(new util::MemoryPool), _compiler(c)
 {
 
 }
 
 Module::Module(const Module& m)
-: name(m.name), _compiler(m._compiler)
+: name(m.name), _memoryPool(new util::MemoryPool), _compiler(m._compiler)
 {
 	operator=(m);
 }
@@ -47,19 +47,22 @@ Module& Module::operator=(const Module& m)
 	name      = m.name;
 	_compiler = m._compiler;
 	
-	for(auto function : _functions)
+	// the copies are allocated from this module's pool
+	util::MemoryPool::Scope scope(memoryPool());
+	
+	for(auto& function : m._functions)
 	{
 		_functions.push_back(function);
 		_functions.back().setModule(this);
 	}
 	
-	for(auto global : _globals)
+	for(auto& global : m._globals)
 	{
 		_globals.push_back(global);
 		_globals.back().setModule(this);
 	}
 	
-	for(auto constant : _constants)
+	for(auto constant : m._constants)
 	{
 		_constants.push_back(constant->clone());
 	}
@@ -267,6 +270,11 @@ void Module::clear()
 	_constants.clear();
 }
 
+util::MemoryPool& Module::memoryPool()
+{
+	return *_memoryPool;
+}
+
 }
 
 }
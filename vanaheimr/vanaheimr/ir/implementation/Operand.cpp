@@ -12,6 +12,8 @@
 #include <vanaheimr/ir/interface/Argument.h>
 #include <vanaheimr/ir/interface/Constant.h>
 
+#include <vanaheimr/util/interface/MemoryPool.h>
+
 // Standard Library Includes
 #include <sstream>
 
@@ -32,6 +34,16 @@ Operand::~Operand()
 	
 }
 
+void* Operand::operator new(size_t bytes)
+{
+	return util::MemoryPool::allocate(bytes);
+}
+
+void Operand::operator delete(void* pointer, size_t bytes)
+{
+	util::MemoryPool::deallocate(pointer, bytes);
+}
+
 bool Operand::isRegister() const
 {
 	if(mode() == Register || mode() == Indirect) 
@@ -10,6 +10,8 @@
 #include <vanaheimr/ir/interface/Instruction.h>
 #include <vanaheimr/ir/interface/Variable.h>
 
+#include <vanaheimr/util/interface/MemoryPool.h>
+
 // Standard Library Includes
 #include <list>
 
@@ -26,7 +28,8 @@ namespace ir
 class BasicBlock : public Variable
 {
 public:
-	typedef std::list<Instruction*> InstructionList;
+	typedef util::PoolAllocator<Instruction*>             InstructionAllocator;
+	typedef std::list<Instruction*, InstructionAllocator> InstructionList;
 
 	typedef InstructionList::iterator       iterator;
 	typedef InstructionList::const_iterator const_iterator;
@@ -122,6 +125,8 @@ public:
 	void clear();
 	/*! \brief Set the owning function */
 	void setFunction(Function*);
+	/*! \brief Set the id of the block within the owning function */
+	void setId(Id id);
 
 public:
 	/*! \brief Set the name of the basic block */
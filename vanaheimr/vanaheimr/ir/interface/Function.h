@@ -26,11 +26,15 @@ namespace ir
 class Function : public Variable
 {
 public:
-	typedef std::list<BasicBlock>      BasicBlockList;
-	typedef std::list<Argument>        ArgumentList;
-	typedef std::list<VirtualRegister> VirtualRegisterList;
-	typedef std::list<std::string>     StringList;
-	typedef std::list<Local>           LocalList;
+	typedef std::list<BasicBlock, util::PoolAllocator<BasicBlock>>
+		BasicBlockList;
+	typedef std::list<Argument, util::PoolAllocator<Argument>>
+		ArgumentList;
+	typedef std::list<VirtualRegister, util::PoolAllocator<VirtualRegister>>
+		VirtualRegisterList;
+	typedef std::list<Local, util::PoolAllocator<Local>>
+		LocalList;
+	typedef std::list<std::string> StringList;
 	
 	typedef BasicBlockList::iterator       iterator;
 	typedef BasicBlockList::const_iterator const_iterator;
@@ -89,6 +93,9 @@ public:
 	iterator newBasicBlock(iterator position, const std::string& name);
 	register_iterator newVirtualRegister(const Type* type,
 		const std::string& name = "");
+	/*! \brief Move registers that were created outside of the function to
+		the end of its list, in order, giving them the next ids */
+	void spliceVirtualRegisters(VirtualRegisterList& registers);
 	argument_iterator newArgument(const Type* type,
 		const std::string& name);
 	argument_iterator newReturnValue(const Type* type,
@@ -133,6 +140,10 @@ public:
 	size_t register_size()  const;
 	bool   register_empty() const;
 
+	/*! \brief One more than the largest register id, the size of a table
+		indexed by id (ids are sparse once registers are erased) */
+	VirtualRegister::Id register_id_bound() const;
+
 public:
 	register_iterator erase(const register_iterator&);
 	register_iterator erase(const VirtualRegister*);
@@ -144,6 +155,9 @@ public:
 public:
 	/*! \brief Move a basic block to a new position */
 	void moveBasicBlock(iterator position, iterator block);
+	/*! \brief Delete a basic block, the block with the highest id takes
+		its id so that ids stay in [0, size()) */
+	iterator erase(iterator block);
 
 public:
 	local_iterator       local_begin();
@@ -9,6 +9,8 @@
 // Vanaheimr Includes
 #include <vanaheimr/ir/interface/Operand.h>
 
+#include <vanaheimr/util/interface/SmallVector.h>
+
 // Standard Library Includes 
 #include <vector>
 #include <string>
@@ -81,7 +83,7 @@ public:
 	};
 
 	typedef Operand* OperandPointer;
-	typedef std::vector<OperandPointer> OperandVector;
+	typedef util::SmallVector<OperandPointer, 4> OperandVector;
 	typedef PredicateOperand* PredicateOperandPointer;
 	
 	typedef unsigned int Id;
@@ -93,6 +95,11 @@ public:
 	Instruction(const Instruction&);
 	Instruction& operator=(const Instruction&);
 
+public:
+	/*! \brief Instructions are allocated from the pool of the calling thread */
+	static void* operator new(size_t bytes);
+	static void  operator delete(void* pointer, size_t bytes);
+
 public:
 	/*! \brief Sets the predicate guard, the instruction now owns it */
 	void setGuard(PredicateOperand* g);
@@ -11,6 +11,11 @@
 #include <vanaheimr/ir/interface/Global.h>
 #include <vanaheimr/ir/interface/Constant.h>
 
+#include <vanaheimr/util/interface/MemoryPool.h>
+
+// Standard Library Includes
+#include <memory>
+
 // Forward Declarations
 namespace vanaheimr { namespace compiler { class Compiler; } }
 
@@ -145,10 +150,22 @@ public:
 	
 public:
 	void clear();
+
+public:
+	/*! \brief The pool that the IR in the module is allocated from, open
+		a MemoryPool::Scope on it while building or changing the module */
+	util::MemoryPool& memoryPool();
 	
 public:
 	std::string name;
 	
+private:
+	typedef std::unique_ptr<util::MemoryPool> MemoryPoolPointer;
+
+private:
+	// Declared first, it must outlive the IR that is allocated from it
+	MemoryPoolPointer _memoryPool;
+
 private:
 	FunctionList _functions;
 	GlobalList   _globals;
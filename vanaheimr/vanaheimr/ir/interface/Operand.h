@@ -7,6 +7,7 @@
 #pragma once
 
 // Standard Library Includes
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -46,6 +47,11 @@ public:
 	Operand(OperandMode mode, Instruction* instruction);
 	virtual ~Operand();
 
+public:
+	/*! \brief Operands are allocated from the pool of the calling thread */
+	static void* operator new(size_t bytes);
+	static void  operator delete(void* pointer, size_t bytes);
+
 public:
 	/*! \brief Is the operand a register */
 	bool isRegister() const;
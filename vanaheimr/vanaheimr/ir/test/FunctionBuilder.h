@@ -0,0 +1,344 @@
+/*! \file   FunctionBuilder.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the helpers that the compiler tests use to
+		build functions and check the analyses of them.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/PassManager.h>
+#include <vanaheimr/transforms/interface/PassFactory.h>
+#include <vanaheimr/transforms/interface/Pass.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Standard Library Includes
+#include <initializer_list>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+typedef vanaheimr::ir::Module          Module;
+typedef vanaheimr::ir::Function        Function;
+typedef vanaheimr::ir::BasicBlock      BasicBlock;
+typedef vanaheimr::ir::Instruction     Instruction;
+typedef vanaheimr::ir::VirtualRegister VirtualRegister;
+typedef vanaheimr::ir::Operand         Operand;
+typedef vanaheimr::ir::Type            Type;
+
+typedef std::map<std::string, VirtualRegister*> VirtualRegisterMap;
+typedef std::map<std::string, BasicBlock*>      BasicBlockMap;
+typedef std::vector<VirtualRegister*>           VirtualRegisterVector;
+
+typedef std::initializer_list<const char*> NameList;
+
+/*! \brief The values and blocks of a function, by name */
+class TestFunction
+{
+public:
+	TestFunction()
+	: function(nullptr)
+	{
+
+	}
+
+public:
+	Function*          function;
+	VirtualRegisterMap values;
+	BasicBlockMap      blocks;
+};
+
+inline const Type* getType(const std::string& name)
+{
+	return vanaheimr::compiler::Compiler::getSingleton()->getType(name);
+}
+
+/*! \brief Add an empty function to the module */
+inline TestFunction newTestFunction(Module& module, const std::string& name)
+{
+	TestFunction test;
+
+	test.function = &*module.newFunction(name,
+		vanaheimr::ir::Variable::ExternalLinkage,
+		vanaheimr::ir::Variable::HiddenVisibility);
+
+	return test;
+}
+
+/*! \brief Add a value of the same type for each name */
+inline void newValues(TestFunction& test, const std::string& type,
+	NameList names)
+{
+	for(auto name : names)
+	{
+		test.values[name] = &*test.function->newVirtualRegister(
+			getType(type), name);
+	}
+}
+
+/*! \brief Add blocks in layout order, each falls through to the next */
+inline void newBlocks(TestFunction& test, NameList names)
+{
+	for(auto name : names)
+	{
+		test.blocks[name] = &*test.function->newBasicBlock(
+			test.function->exit_block(), name);
+	}
+}
+
+/*! \brief Guard the instruction with a predicate, or always run it */
+inline void guard(Instruction* instruction,
+	VirtualRegister* predicate = nullptr)
+{
+	if(predicate == nullptr)
+	{
+		instruction->setGuard(new vanaheimr::ir::PredicateOperand(
+			vanaheimr::ir::PredicateOperand::PredicateTrue, instruction));
+	}
+	else
+	{
+		instruction->setGuard(new vanaheimr::ir::PredicateOperand(predicate,
+			vanaheimr::ir::PredicateOperand::StraightPredicate, instruction));
+	}
+}
+
+inline vanaheimr::ir::RegisterOperand* use(VirtualRegister* value,
+	Instruction* instruction)
+{
+	return new vanaheimr::ir::RegisterOperand(value, instruction);
+}
+
+inline Operand* immediate(uint64_t value, const Type* type,
+	Instruction* instruction)
+{
+	return new vanaheimr::ir::ImmediateOperand(value, instruction, type);
+}
+
+/*! \brief Immediates take the type of the first named value among the
+	operands, i32 if there is none */
+inline const Type* getImmediateType(const VirtualRegisterMap& values,
+	std::initializer_list<std::string> names)
+{
+	for(auto& name : names)
+	{
+		auto value = values.find(name);
+
+		if(value != values.end()) return value->second->type;
+	}
+
+	return getType("i32");
+}
+
+/*! \brief A named value, or an immediate if the name is a number */
+inline Operand* operand(const std::string& name,
+	const VirtualRegisterMap& values, const Type* type,
+	Instruction* instruction)
+{
+	auto value = values.find(name);
+
+	if(value == values.end())
+	{
+		return immediate((uint64_t)std::stoul(name), type, instruction);
+	}
+
+	return use(value->second, instruction);
+}
+
+/*! \brief Append 'd = a op b', where operands are value names or numbers */
+template<typename T>
+inline Instruction* binary(BasicBlock* block, const VirtualRegisterMap& values,
+	const std::string& d, const std::string& a, const std::string& b,
+	VirtualRegister* predicate = nullptr)
+{
+	auto instruction = new T(block);
+
+	auto type = getImmediateType(values, {a, b, d});
+
+	guard(instruction, predicate);
+	instruction->setD(operand(d, values, type, instruction));
+	instruction->setA(operand(a, values, type, instruction));
+	instruction->setB(operand(b, values, type, instruction));
+
+	block->push_back(instruction);
+
+	return instruction;
+}
+
+/*! \brief Append 'd = a + b' */
+inline Instruction* add(BasicBlock* block, const VirtualRegisterMap& values,
+	const std::string& d, const std::string& a, const std::string& b,
+	VirtualRegister* predicate = nullptr)
+{
+	return binary<vanaheimr::ir::Add>(block, values, d, a, b, predicate);
+}
+
+/*! \brief Append 'd = a < b' */
+inline Instruction* setp(BasicBlock* block, const VirtualRegisterMap& values,
+	const std::string& d, const std::string& a, const std::string& b)
+{
+	auto setp = new vanaheimr::ir::Setp(
+		vanaheimr::ir::ComparisonInstruction::UnorderedLessThan, block);
+
+	auto type = getImmediateType(values, {a, b});
+
+	guard(setp);
+	setp->setD(operand(d, values, type, setp));
+	setp->setA(operand(a, values, type, setp));
+	setp->setB(operand(b, values, type, setp));
+
+	block->push_back(setp);
+
+	return setp;
+}
+
+/*! \brief Append 'd = ld [address + offset]' */
+inline Instruction* load(BasicBlock* block, const VirtualRegisterMap& values,
+	const std::string& d, const std::string& address, int64_t offset = 0)
+{
+	auto ld = new vanaheimr::ir::Ld(block);
+
+	guard(ld);
+	ld->setD(use(values.at(d), ld));
+	ld->setA(new vanaheimr::ir::IndirectOperand(values.at(address), offset,
+		ld));
+
+	block->push_back(ld);
+
+	return ld;
+}
+
+/*! \brief Append 'st [address], value' */
+inline Instruction* store(BasicBlock* block, const VirtualRegisterMap& values,
+	const std::string& address, const std::string& value)
+{
+	auto st = new vanaheimr::ir::St(block);
+
+	guard(st);
+	st->setD(new vanaheimr::ir::IndirectOperand(values.at(address), 0, st));
+	st->setA(operand(value, values, getImmediateType(values, {value}), st));
+
+	block->push_back(st);
+
+	return st;
+}
+
+/*! \brief Append a branch, conditional if there is a predicate */
+inline Instruction* branch(BasicBlock* block, BasicBlock* target,
+	VirtualRegister* predicate = nullptr)
+{
+	auto bra = new vanaheimr::ir::Bra(vanaheimr::ir::Bra::UniformBranch,
+		block);
+
+	guard(bra, predicate);
+	bra->setTarget(new vanaheimr::ir::AddressOperand(target, bra));
+
+	block->push_back(bra);
+
+	return bra;
+}
+
+/*! \brief Add a function that defines a number of values, and then adds
+	them all up, so every value is live at the same time */
+inline void generateClique(Module& module, const std::string& name,
+	unsigned int values)
+{
+	auto test = newTestFunction(module, name);
+
+	auto i32 = getType("i32");
+
+	auto block = &*test.function->newBasicBlock(test.function->exit_block(),
+		"body");
+
+	VirtualRegisterVector registers;
+
+	for(unsigned int v = 0; v < values; ++v)
+	{
+		registers.push_back(&*test.function->newVirtualRegister(i32,
+			"value" + std::to_string(v)));
+
+		auto add = new vanaheimr::ir::Add(block);
+
+		guard(add);
+		add->setD(use(registers.back(), add));
+		add->setA(immediate(v, i32, add));
+		add->setB(immediate(1, i32, add));
+
+		block->push_back(add);
+	}
+
+	auto sum = &*test.function->newVirtualRegister(i32, "sum");
+
+	for(unsigned int v = 0; v < values; ++v)
+	{
+		auto add = new vanaheimr::ir::Add(block);
+
+		guard(add);
+		add->setD(use(sum, add));
+		add->setA(use(v == 0 ? registers[0] : sum, add));
+		add->setB(use(registers[v], add));
+
+		block->push_back(add);
+	}
+}
+
+/*! \brief A pass that checks the analyses of each function it runs on */
+class CheckPass : public vanaheimr::transforms::ImmutableFunctionPass
+{
+public:
+	CheckPass(const StringVector& analyses, const std::string& name)
+	: ImmutableFunctionPass(analyses, name), passed(true)
+	{
+
+	}
+
+public:
+	bool passed;
+
+protected:
+	void _check(bool condition, const std::string& message)
+	{
+		if(condition) return;
+
+		std::cout << " Check failed: " << message << "\n";
+
+		passed = false;
+	}
+};
+
+/*! \brief Run a check pass over the module, the manager takes ownership of
+	the pass, returns whether every check passed */
+inline bool runCheckPass(Module& module, CheckPass* pass)
+{
+	vanaheimr::transforms::PassManager manager(&module);
+
+	manager.addPass(pass);
+
+	manager.runOnModule();
+
+	return pass->passed;
+}
+
+/*! \brief Run a pass from the factory over the module */
+inline void runPass(Module& module, const std::string& name)
+{
+	vanaheimr::transforms::PassManager manager(&module);
+
+	manager.addPass(vanaheimr::transforms::PassFactory::createPass(name));
+
+	manager.runOnModule();
+}
+
+}
+
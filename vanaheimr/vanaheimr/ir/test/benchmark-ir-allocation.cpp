@@ -0,0 +1,237 @@
+/*! \file   benchmark-ir-allocation.cpp
+	\author Gregory Diamos <gregory.diamos@gatech.edu>
+	\date   Friday October 16, 2026
+	\brief  A benchmark for the cost of building, copying, and destroying IR.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/parser/interface/LLVMParser.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+
+#include <vanaheimr/util/interface/MemoryPool.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+#include <hydrazine/interface/string.h>
+
+// Standard Library Includes
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+// Count every heap allocation made by the program
+static size_t allocationCount = 0;
+
+void* operator new(size_t bytes)
+{
+	++allocationCount;
+
+	void* memory = std::malloc(bytes == 0 ? 1 : bytes);
+
+	if(memory == nullptr) throw std::bad_alloc();
+
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+namespace test
+{
+
+typedef std::chrono::steady_clock Clock;
+
+class Measurement
+{
+public:
+	Measurement()
+	: seconds(0.0), allocations(0)
+	{
+
+	}
+
+public:
+	double seconds;
+	size_t allocations;
+};
+
+class Timer
+{
+public:
+	Timer(Measurement& m)
+	: _measurement(m), _allocations(allocationCount), _start(Clock::now())
+	{
+
+	}
+
+	~Timer()
+	{
+		_measurement.seconds += std::chrono::duration<double>(
+			Clock::now() - _start).count();
+		_measurement.allocations += allocationCount - _allocations;
+	}
+
+private:
+	Measurement&      _measurement;
+	size_t            _allocations;
+	Clock::time_point _start;
+};
+
+static void printRow(const std::string& name, const Measurement& measurement,
+	unsigned int iterations)
+{
+	std::cout << "  " << std::setw(10) << std::left << name
+		<< std::setw(12) << std::right << std::fixed << std::setprecision(1)
+		<< (measurement.seconds * 1.0e6) / iterations << " us/iteration"
+		<< std::setw(12) << std::setprecision(1)
+		<< ((double)measurement.allocations) / iterations
+		<< " mallocs/iteration\n";
+}
+
+/*! \brief Parse a file, copy the module, and delete both, each module
+	frees its own pool */
+static void benchmarkFile(const std::string& filename, unsigned int iterations)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	Measurement parse;
+	Measurement copy;
+	Measurement destroy;
+
+	size_t chunks = 0;
+
+	for(unsigned int i = 0; i < iterations; ++i)
+	{
+		std::string moduleName;
+
+		{
+			Timer timer(parse);
+
+			vanaheimr::parser::LLVMParser parser(compiler);
+
+			parser.parse(filename);
+
+			moduleName = parser.getParsedModuleName();
+		}
+
+		auto module = compiler->getModule(moduleName);
+
+		if(module == compiler->module_end())
+		{
+			throw std::runtime_error("Parsing '" + filename +
+				"' did not produce a module.");
+		}
+
+		std::unique_ptr<vanaheimr::ir::Module> duplicate;
+
+		{
+			Timer timer(copy);
+
+			duplicate.reset(new vanaheimr::ir::Module(*module));
+		}
+
+		if(duplicate->size() != module->size())
+		{
+			throw std::runtime_error("The copy of '" + filename +
+				"' has " + std::to_string(duplicate->size()) +
+				" functions, the original has " +
+				std::to_string(module->size()) + ".");
+		}
+
+		chunks += module->memoryPool().chunkCount() +
+			duplicate->memoryPool().chunkCount();
+
+		{
+			Timer timer(destroy);
+
+			duplicate.reset();
+
+			compiler->deleteModule(module);
+		}
+	}
+
+	std::cout << filename << ":\n";
+
+	printRow("parse",   parse,   iterations);
+	printRow("copy",    copy,    iterations);
+	printRow("destroy", destroy, iterations);
+
+	std::cout << "  " << ((double)chunks) / iterations
+		<< " memory pool chunks/iteration\n";
+}
+
+static bool benchmarkIRAllocation(const std::string& files,
+	unsigned int iterations)
+{
+	for(auto& file : hydrazine::split(files, ","))
+	{
+		try
+		{
+			benchmarkFile(file, iterations);
+		}
+		catch(const std::exception& e)
+		{
+			std::cout << " Benchmark failed on '" << file << "': "
+				<< e.what() << "\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	std::string  files;
+	unsigned int iterations = 0;
+
+	bool verbose = false;
+
+	parser.description("This program measures the time and heap allocations "
+		"needed to parse, copy, and destroy vanaheimr modules.");
+
+	parser.parse("-i", "--input", files,
+		"examples/c++/hello.llvm,examples/c++/hello-simple.llvm,"
+		"examples/c++/hello-medium.llvm",
+		"Comma separated list of LLVM assembly files to parse.");
+	parser.parse("-n", "--iterations", iterations, 100,
+		"The number of times to parse each file.");
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::benchmarkIRAllocation(files, iterations))
+	{
+		std::cout << "IR allocation benchmark Failed\n";
+		return -1;
+	}
+
+	std::cout << "IR allocation benchmark Passed\n";
+
+	return 0;
+}
+
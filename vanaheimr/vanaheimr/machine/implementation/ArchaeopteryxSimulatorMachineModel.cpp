@@ -17,6 +17,12 @@ ArchaeopteryxSimulatorMachineModel::ArchaeopteryxSimulatorMachineModel()
 : MachineModel("ArchaeopteryxSimulator")
 {
 	addRegisterFile("rf", 64);
+	
+	// Memory operations go to the simulated DRAM, everything else
+	//  completes in a cycle
+	addOperation(Operation("ld",   "load",       400));
+	addOperation(Operation("st",   "store",        1));
+	addOperation(Operation("atom", "load store", 400));
 }
 
 MachineModel* ArchaeopteryxSimulatorMachineModel::clone() const
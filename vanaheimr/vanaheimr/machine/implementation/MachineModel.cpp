@@ -7,6 +7,7 @@
 // Vanaheimr Includes
 #include <vanaheimr/machine/interface/MachineModel.h>
 #include <vanaheimr/machine/interface/TranslationTable.h>
+#include <vanaheimr/machine/interface/Instruction.h>
 
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
@@ -37,6 +38,17 @@ const PhysicalRegister* MachineModel::getPhysicalRegister(RegisterId id) const
 	return reg->second;
 }
 
+const PhysicalRegister* MachineModel::findPhysicalRegister(
+	const std::string& name) const
+{
+	for(auto reg : _idToRegisters)
+	{
+		if(reg.second->name() == name) return reg.second;
+	}
+	
+	return nullptr;
+}
+
 const Operation* MachineModel::getOperation(const std::string& name) const
 {
 	auto operation = _machineOperations.find(name);
@@ -46,6 +58,25 @@ const Operation* MachineModel::getOperation(const std::string& name) const
 	return &operation->second;
 }
 
+unsigned int MachineModel::getLatency(const ir::Instruction& instruction) const
+{
+	const Operation* operation = nullptr;
+	
+	if(instruction.isMachineInstruction())
+	{
+		operation = static_cast<const Instruction&>(instruction).operation;
+	}
+	else
+	{
+		operation = getOperation(instruction.opcodeString());
+	}
+	
+	// operations without a latency complete in one cycle
+	if(operation == nullptr || operation->latency == 0) return 1;
+	
+	return operation->latency;
+}
+
 unsigned int MachineModel::totalRegisterCount() const
 {
 	return _idToRegisters.size();
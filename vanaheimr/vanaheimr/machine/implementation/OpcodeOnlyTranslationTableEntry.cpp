@@ -9,8 +9,6 @@
 #include <vanaheimr/machine/interface/MachineModel.h>
 #include <vanaheimr/machine/interface/Instruction.h>
 
-#include <vanaheimr/compiler/interface/Compiler.h>
-
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
@@ -20,38 +18,36 @@ namespace vanaheimr
 namespace machine
 {
 
-OpcodeOnlyTranslationTableEntry::OpcodeOnlyTranslationTableEntry(
-	const std::string& s, const std::string& d, const std::string& sp)
-: TranslationTableEntry(s), machineInstructionOpcode(d),
-	machineInstructionSpecialProperty(sp)
-{
-
-}
-
-static const Operation* getOrAddOperation(const std::string& opcode,
-	const std::string& special)
+static const Operation* getOrAddOperation(MachineModel& machineModel,
+	const std::string& opcode, const std::string& special)
 {
-	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
-
-	auto operation = compiler->getMachineModel()->getOperation(opcode);
+	auto operation = machineModel.getOperation(opcode);
 
 	if(operation == nullptr)
 	{
-		compiler->getMachineModel()->addOperation(Operation(opcode, special));
+		machineModel.addOperation(Operation(opcode, special));
 		
-		operation = compiler->getMachineModel()->getOperation(opcode);
+		operation = machineModel.getOperation(opcode);
 	}
 
 	return operation;
 }
 
+OpcodeOnlyTranslationTableEntry::OpcodeOnlyTranslationTableEntry(
+	MachineModel& machineModel, const std::string& s, const std::string& d,
+	const std::string& sp)
+: TranslationTableEntry(s), machineInstructionOpcode(d),
+	machineInstructionSpecialProperty(sp),
+	_operation(getOrAddOperation(machineModel, d, sp))
+{
+
+}
+
 OpcodeOnlyTranslationTableEntry::MachineInstructionVector
 	OpcodeOnlyTranslationTableEntry::translateInstruction(
-	const ir::Instruction* instruction) const
+	const ir::Instruction* instruction, VirtualRegisterList&) const
 {
-	auto machineInstruction = new Instruction(
-		getOrAddOperation(machineInstructionOpcode,
-			machineInstructionSpecialProperty),
+	auto machineInstruction = new Instruction(_operation,
 		instruction->block);
 	
 	machineInstruction->clear();
@@ -0,0 +1,46 @@
+/*	\file   PhysicalPredicateOperand.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the PhysicalPredicateOperand class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/machine/interface/PhysicalPredicateOperand.h>
+
+#include <vanaheimr/machine/interface/PhysicalRegister.h>
+
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+namespace vanaheimr
+{
+
+namespace machine
+{
+
+PhysicalPredicateOperand::PhysicalPredicateOperand(const PhysicalRegister* p,
+	VirtualRegister* reg, PredicateModifier mod, Instruction* i)
+: PredicateOperand(reg, mod, i), physicalRegister(p)
+{
+
+}
+
+PhysicalPredicateOperand::Operand* PhysicalPredicateOperand::clone() const
+{
+	return new PhysicalPredicateOperand(*this);
+}
+
+std::string PhysicalPredicateOperand::toString() const
+{
+	if(physicalRegister == nullptr) return PredicateOperand::toString();
+
+	std::string name = "@" + physicalRegister->name();
+	
+	if(modifier == InversePredicate) return "!" + name;
+
+	return name;
+}
+
+}
+
+}
+
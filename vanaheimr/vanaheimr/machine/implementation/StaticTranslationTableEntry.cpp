@@ -144,11 +144,13 @@ static void mapOperands(ir::Instruction* newInstruction,
 
 StaticTranslationTableEntry::MachineInstructionVector
 	StaticTranslationTableEntry::translateInstruction(
-	const ir::Instruction* instruction) const
+	const ir::Instruction* instruction,
+	VirtualRegisterList& temporaryRegisters) const
 {
 	MachineInstructionVector translatedInstructions;
 
-	// Create temporary registers
+	// Create temporary registers, they get ids once the caller moves
+	//  them into the function
 	RegisterVector temporaries;
 
 	auto temps = getTemporaries();
@@ -159,7 +161,10 @@ StaticTranslationTableEntry::MachineInstructionVector
 	{
 		assert(temp.index == temporaries.size());
 	
-		temporaries.push_back(&*function->newVirtualRegister(temp.type));
+		temporaryRegisters.push_back(
+			ir::VirtualRegister("", 0, function, temp.type));
+		
+		temporaries.push_back(&temporaryRegisters.back());
 	}
 	
 	// Translate instructions
@@ -24,15 +24,28 @@ class TranslationTableMap
 {
 public:
 	typedef std::map<std::string, TranslationTableEntry*> Map;
+	typedef std::vector<const TranslationTableEntry*>     EntryVector;
 
 public:
+	TranslationTableMap();
 	~TranslationTableMap();	
 
 public:
 	Map opcodeToTranslation;
 
+public:
+	// Entries for IR opcodes, indexed by opcode, so that the common case
+	//  does not need to build and compare opcode strings
+	EntryVector irOpcodeToTranslation;
+
 };
 
+TranslationTableMap::TranslationTableMap()
+: irOpcodeToTranslation(ir::Instruction::InvalidOpcode, nullptr)
+{
+
+}
+
 TranslationTableMap::~TranslationTableMap()
 {
 	for(auto translation : opcodeToTranslation)
@@ -54,9 +67,21 @@ TranslationTable::~TranslationTable()
 
 TranslationTable::MachineInstructionVector
 	TranslationTable::translateInstruction(
-	const ir::Instruction* instruction) const
+	const ir::Instruction* instruction,
+	VirtualRegisterList& temporaries) const
 {
-	auto translation = getTranslation(instruction->opcodeString());
+	const TranslationTableEntry* translation = nullptr;
+	
+	if(instruction->opcode < ir::Instruction::Machine)
+	{
+		translation =
+			_translations->irOpcodeToTranslation[instruction->opcode];
+	}
+	else
+	{
+		// machine instructions are named by their operation
+		translation = getTranslation(instruction->opcodeString());
+	}
 	
 	if(translation == nullptr)
 	{
@@ -64,7 +89,7 @@ TranslationTable::MachineInstructionVector
 		return MachineInstructionVector();
 	}
 
-	return translation->translateInstruction(instruction);
+	return translation->translateInstruction(instruction, temporaries);
 }
 
 const TranslationTableEntry* TranslationTable::getTranslation(
@@ -84,8 +109,17 @@ void TranslationTable::addTranslation(const TranslationTableEntry* entry)
 {
 	assert(_translations->opcodeToTranslation.count(entry->name) == 0);
 
+	auto translation = entry->clone();
+
 	_translations->opcodeToTranslation.insert(
-		std::make_pair(entry->name, entry->clone()));
+		std::make_pair(entry->name, translation));
+	
+	auto opcode = ir::Instruction::parseOpcode(entry->name);
+	
+	if(opcode < ir::Instruction::Machine)
+	{
+		_translations->irOpcodeToTranslation[opcode] = translation;
+	}
 }
 
 }
@@ -19,6 +19,7 @@
 // Forward Declarations
 namespace vanaheimr { namespace machine { class PhysicalRegister; } }
 namespace vanaheimr { namespace machine { class TranslationTable; } }
+namespace vanaheimr { namespace ir      { class Instruction;      } }
 
 namespace vanaheimr
 {
@@ -47,9 +48,17 @@ public:
 public:
 	/*! \brief Get the named physical register */
 	const PhysicalRegister* getPhysicalRegister(RegisterId id) const;
+	/*! \brief Get a physical register by name, return 0 if not found */
+	const PhysicalRegister* findPhysicalRegister(
+		const std::string& name) const;
 	/*! \brief Get the named physical operation */
 	const Operation* getOperation(const std::string& name) const;
 
+public:
+	/*! \brief Get the cycles before the results of an instruction can be
+		used, from the operation with the same name as its opcode */
+	unsigned int getLatency(const ir::Instruction& instruction) const;
+
 public:
 	/*! \brief Get the total register count */
 	unsigned int totalRegisterCount() const;
@@ -10,7 +10,8 @@
 #include <vanaheimr/machine/interface/TranslationTableEntry.h>
 
 // Forward Declarations
-namespace vanaheimr { namespace machine { class Operation; } }
+namespace vanaheimr { namespace machine { class Operation;    } }
+namespace vanaheimr { namespace machine { class MachineModel; } }
 
 namespace vanaheimr { namespace ir { class Type;     } }
 namespace vanaheimr { namespace ir { class Constant; } }
@@ -25,14 +26,17 @@ namespace machine
 class OpcodeOnlyTranslationTableEntry : public TranslationTableEntry
 {
 public:
-	/*! \brief Create the rule and specify the opcode mapping */
-	OpcodeOnlyTranslationTableEntry(const std::string& sourceOpcode,
+	/*! \brief Create the rule and specify the opcode mapping, the machine
+		operation is added to the model that owns the table here, so
+		translation only reads the model */
+	OpcodeOnlyTranslationTableEntry(MachineModel& machineModel,
+		const std::string& sourceOpcode,
 		const std::string& destinationOpcode, const std::string& special);
 
 public:
 	/*! \brief Translate IR instruction into equivalent machine instructions */
 	virtual MachineInstructionVector translateInstruction(
-		const ir::Instruction*) const;
+		const ir::Instruction*, VirtualRegisterList& temporaries) const;
 
 public:
 	virtual TranslationTableEntry* clone() const;
@@ -40,6 +44,9 @@ public:
 public:
 	std::string machineInstructionOpcode;
 	std::string machineInstructionSpecialProperty;
+
+private:
+	const Operation* _operation;
 };
 
 }
@@ -0,0 +1,47 @@
+/*	\file   PhysicalPredicateOperand.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the PhysicalPredicateOperand class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/Operand.h>
+
+// Forward Declarations
+namespace vanaheimr { namespace machine { class PhysicalRegister; } }
+
+namespace vanaheimr
+{
+
+namespace machine
+{
+
+/*! \brief This class represents a guard after assignment to a physical
+	register, it keeps the modifier of the predicate */
+class PhysicalPredicateOperand : public vanaheimr::ir::PredicateOperand
+{
+public:
+	typedef vanaheimr::ir::VirtualRegister VirtualRegister;
+	typedef vanaheimr::ir::Instruction     Instruction;
+	typedef vanaheimr::ir::Operand         Operand;
+
+public:
+	PhysicalPredicateOperand(const PhysicalRegister* preg,
+		VirtualRegister* reg, PredicateModifier mod, Instruction* i);
+
+public:
+	virtual Operand* clone() const;
+	virtual std::string toString() const;
+
+public:
+	/*! \brief The physical register being accessed */
+	const PhysicalRegister* physicalRegister;
+
+};
+
+}
+
+}
+
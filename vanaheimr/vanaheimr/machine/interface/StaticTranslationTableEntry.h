@@ -31,7 +31,7 @@ public:
 public:
 	/*! \brief Translate IR instruction into equivalent machine instructions */
 	virtual MachineInstructionVector translateInstruction(
-		const ir::Instruction*) const;
+		const ir::Instruction*, VirtualRegisterList& temporaries) const;
 
 public:
 	virtual TranslationTableEntry* clone() const;
@@ -6,6 +6,9 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/Function.h>
+
 // Standard Library Includes
 #include <string>
 #include <vector>
@@ -27,6 +30,7 @@ class TranslationTable
 {
 public:
 	typedef std::vector<machine::Instruction*> MachineInstructionVector;
+	typedef ir::Function::VirtualRegisterList  VirtualRegisterList;
 
 public:
 	TranslationTable();
@@ -37,8 +41,10 @@ public:
 	TranslationTable& operator=(const TranslationTable&) = delete;
 
 public:
-	/*! \brief Translate IR instruction into equivalent machine instructions */
-	MachineInstructionVector translateInstruction(const ir::Instruction*) const;
+	/*! \brief Translate IR instruction into equivalent machine instructions,
+		new temporary registers are appended to 'temporaries' */
+	MachineInstructionVector translateInstruction(const ir::Instruction*,
+		VirtualRegisterList& temporaries) const;
 
 public:
 	const TranslationTableEntry* getTranslation(const std::string& name) const;
@@ -6,6 +6,9 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/Function.h>
+
 // Standard Library Includes
 #include <string>
 #include <vector>
@@ -25,15 +28,18 @@ class TranslationTableEntry
 {
 public:
 	typedef std::vector<machine::Instruction*> MachineInstructionVector;
+	typedef ir::Function::VirtualRegisterList  VirtualRegisterList;
 
 public:
 	TranslationTableEntry(const std::string& _name = "");
 	virtual ~TranslationTableEntry();
 
 public:
-	/*! \brief Translate IR instruction into equivalent machine instructions */
+	/*! \brief Translate IR instruction into equivalent machine instructions,
+		new temporary registers are appended to 'temporaries', the caller
+		moves them into the function */
 	virtual MachineInstructionVector translateInstruction(
-		const ir::Instruction*) const = 0;
+		const ir::Instruction*, VirtualRegisterList& temporaries) const = 0;
 
 public:
 	/*! \brief Clone the entry */
@@ -17,11 +17,14 @@
 #include <vanaheimr/ir/interface/Module.h>
 #include <vanaheimr/ir/interface/Type.h>
 
+#include <vanaheimr/util/interface/StringView.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
-#include <fstream>
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -48,13 +51,15 @@ typedef ir::Global       Global;
 typedef ir::FunctionType FunctionType;
 typedef ir::Constant     Constant;
 
+typedef util::StringView StringView;
+
 class LLVMParserEngine
 {
 public:
 	LLVMParserEngine(compiler::Compiler* compiler, const std::string& filename);
 
 public:
-	void parse(std::istream& stream);
+	void parse(const std::string& filename);
 
 public:
 	std::string moduleName;
@@ -62,12 +67,12 @@ public:
 private:
 	void _parseTypedefs();
 
-	void _parseTopLevelDeclaration(const std::string& declaration);
+	void _parseTopLevelDeclaration(const StringView& declaration);
 	
-	void _parseGlobalVariable(const std::string& token);
-	void _parseTypedef(const std::string& token);
+	void _parseGlobalVariable(const StringView& token);
+	void _parseTypedef(const StringView& token);
 	void _parseFunction();
-	void _parsePrototype(const std::string& linkage);
+	void _parsePrototype(const StringView& linkage);
 	void _parseTarget();
 	void _parseMetadata();
 
@@ -117,17 +122,16 @@ private:
 
 void LLVMParser::parse(const std::string& filename)
 {
-	std::ifstream file(filename.c_str());
-	
-	if(!file.is_open())
-	{
-		throw std::runtime_error("LLVM Parser: Could not open file '" +
-			filename + "' for reading.");
-	}
-
 	LLVMParserEngine engine(_compiler, filename);
 
-	engine.parse(file);
+	try
+	{
+		engine.parse(filename);
+	}
+	catch(const std::exception& e)
+	{
+		throw std::runtime_error("LLVM Parser: " + std::string(e.what()));
+	}
 
 	_moduleName = engine.moduleName;
 }
@@ -175,7 +179,7 @@ LLVMParserEngine::LLVMParserEngine(Compiler* compiler,
 	_lexer.addWhitespaceRules(" \t\n\r");
 }
 
-static bool isTopLevelDeclaration(const std::string& token)
+static bool isTopLevelDeclaration(const StringView& token)
 {
 	if(token == "define" || token == "declare" ||
 		token == "!" || token == "target")
@@ -196,27 +200,30 @@ static bool isTopLevelDeclaration(const std::string& token)
 	return false;
 }
 
-void LLVMParserEngine::parse(std::istream& stream)
+void LLVMParserEngine::parse(const std::string& filename)
 {
 	_module = &*_compiler->newModule(moduleName);
 
-	_lexer.setStream(&stream);
+	util::MemoryPool::Scope scope(_module->memoryPool());
+
+	// tokens refer directly to the mapped file, they are not copied
+	_lexer.setInputFile(filename);
 
 	_parseTypedefs();
 
-	auto token = _lexer.nextToken();
+	auto token = _lexer.nextTokenView();
 
 	while(isTopLevelDeclaration(token))
 	{
 		_parseTopLevelDeclaration(token);
 	
-		token = _lexer.nextToken();
+		token = _lexer.nextTokenView();
 	}
 
 	if(!_lexer.hitEndOfStream())
 	{
 		throw std::runtime_error("At " + _lexer.location() +
-			": hit invalid top level declaration '" + token + "'" );
+			": hit invalid top level declaration '" + token.str() + "'" );
 	}
 }
 
@@ -226,11 +233,11 @@ void LLVMParserEngine::_parseTypedefs()
 	
 	while(!_lexer.hitEndOfStream())
 	{
-		auto token = _lexer.nextToken();
+		auto token = _lexer.nextTokenView();
 
 		if(token != "%") continue;
 		
-		auto name = _lexer.nextToken();
+		auto name = _lexer.nextTokenView();
 
 		if(!_lexer.scan("=")) continue;
 
@@ -246,7 +253,7 @@ void LLVMParserEngine::_parseTypedefs()
 	_lexer.reset();
 }
 
-void LLVMParserEngine::_parseTopLevelDeclaration(const std::string& token)
+void LLVMParserEngine::_parseTopLevelDeclaration(const StringView& token)
 {
 	if(token.find("@") == 0)
 	{
@@ -274,7 +281,7 @@ void LLVMParserEngine::_parseTopLevelDeclaration(const std::string& token)
 	}
 }
 
-static bool isLinkage(const std::string& token)
+static bool isLinkage(const StringView& token)
 {
 	return token == "private" ||
 		token == "linker_private" ||
@@ -294,13 +301,13 @@ static bool isLinkage(const std::string& token)
 		token == "dllexport";
 }
 
-static Variable::Linkage translateLinkage(const std::string& token)
+static Variable::Linkage translateLinkage(const StringView& token)
 {
 	if(token == "internal") return Variable::InternalLinkage;
 	if(token == "external") return Variable::ExternalLinkage;
 	if(token == "private")  return Variable::PrivateLinkage;
 
-	assertM(false, "Linkage " + token + " implemented.");
+	assertM(false, "Linkage " + token.str() + " implemented.");
 
 	return Variable::ExternalLinkage;
 }
@@ -386,9 +393,9 @@ void LLVMParserEngine::_resolveTypeAliasesInSubtypes(
 	}
 }
 
-void LLVMParserEngine::_parseGlobalVariable(const std::string& token)
+void LLVMParserEngine::_parseGlobalVariable(const StringView& token)
 {
-	auto name = token.substr(1);
+	auto name = token.substr(1).str();
 
 	if(!_lexer.scan("="))
 	{
@@ -396,11 +403,11 @@ void LLVMParserEngine::_parseGlobalVariable(const std::string& token)
 			": expecting a '='.");
 	}
 	
-	auto linkage = _lexer.peek();
+	auto linkage = _lexer.peekView();
 
 	if(isLinkage(linkage))
 	{
-		_lexer.nextToken();
+		_lexer.nextTokenView();
 	}
 	else
 	{
@@ -427,9 +434,9 @@ void LLVMParserEngine::_parseGlobalVariable(const std::string& token)
 	_parseAlignment(&*global);
 }
 
-void LLVMParserEngine::_parseTypedef(const std::string& token)
+void LLVMParserEngine::_parseTypedef(const StringView& token)
 {
-	auto name = token.substr(1);
+	auto name = token.substr(1).str();
 	
 	if(!_lexer.scan("="))
 	{
@@ -450,11 +457,11 @@ void LLVMParserEngine::_parseTypedef(const std::string& token)
 
 void LLVMParserEngine::_parseFunction()
 {
-	auto linkage = _lexer.peek();
+	auto linkage = _lexer.peekView();
 
 	if(isLinkage(linkage))
 	{
-		_lexer.nextToken();
+		_lexer.nextTokenView();
 	}
 	else
 	{
@@ -471,11 +478,11 @@ void LLVMParserEngine::_parseFunction()
 	_lexer.scanThrow("}");
 }
 
-void LLVMParserEngine::_parsePrototype(const std::string& linkage)
+void LLVMParserEngine::_parsePrototype(const StringView& linkage)
 {
 	auto returnType = _parseType();
 	
-	auto name = _lexer.nextToken();
+	auto name = _lexer.nextTokenView();
 
 	if(name.find('@') != 0)
 	{
@@ -487,7 +494,7 @@ void LLVMParserEngine::_parsePrototype(const std::string& linkage)
 
 	_lexer.scanThrow("(");
 
-	auto end = _lexer.peek();
+	auto end = _lexer.peekView();
 
 	Type::TypeVector argumentTypes;
 
@@ -497,7 +504,7 @@ void LLVMParserEngine::_parsePrototype(const std::string& linkage)
 		{
 			argumentTypes.push_back(_parseType());
 			
-			auto next = _lexer.peek();
+			auto next = _lexer.peekView();
 
 			if(next != ",") break;
 			
@@ -510,7 +517,7 @@ void LLVMParserEngine::_parsePrototype(const std::string& linkage)
 	auto type = _compiler->getOrInsertType(FunctionType(_compiler,
 		returnType, argumentTypes));
 
-	_function = &*_module->newFunction(name, translateLinkage(linkage),
+	_function = &*_module->newFunction(name.str(), translateLinkage(linkage),
 		Variable::HiddenVisibility, *type);
 }
 
@@ -518,11 +525,11 @@ void LLVMParserEngine::_parseTarget()
 {
 	hydrazine::log("LLVM::Parser") << "Parsing target\n";
 
-	auto name = _lexer.nextToken();
+	auto name = _lexer.nextTokenView();
 
 	_lexer.scanThrow("=");
 
-	auto targetString = _lexer.nextToken();
+	auto targetString = _lexer.nextTokenView();
 
 	hydrazine::log("LLVM::Parser") << " target:'" << name << " = "
 		<< targetString << "'\n";
@@ -537,7 +544,7 @@ void LLVMParserEngine::_parseMetadata()
 	assertM(false, "Not Implemented.");
 }
 
-static bool isGlobalAttribute(const std::string& token)
+static bool isGlobalAttribute(const StringView& token)
 {
 	if(token == "internal")     return true;
 	if(token == "external")     return true;
@@ -555,7 +562,7 @@ LLVMParserEngine::StringList LLVMParserEngine::_parseGlobalAttributes()
 
 	hydrazine::log("LLVM::Parser") << "Parsing global attributes...\n";
 	
-	auto next = _lexer.peek();
+	auto next = _lexer.peekView();
 
 	while(isGlobalAttribute(next))
 	{
@@ -564,13 +571,13 @@ LLVMParserEngine::StringList LLVMParserEngine::_parseGlobalAttributes()
 		hydrazine::log("LLVM::Parser") << " parsed '"
 			<< attributes.back() << "'\n";
 
-		next = _lexer.peek();
+		next = _lexer.peekView();
 	}
 
 	return attributes;
 }
 
-static bool isConstant(const std::string& token)
+static bool isConstant(const StringView& token)
 {
 	if(token == "zeroinitializer") return true;
 	if(token.find("c\"") == 0)     return true;
@@ -581,7 +588,7 @@ static bool isConstant(const std::string& token)
 
 Constant* LLVMParserEngine::_parseInitializer(const Type* type)
 {
-	auto next = _lexer.peek();
+	auto next = _lexer.peekView();
 
 	if(!isConstant(next)) return nullptr;
 
@@ -594,18 +601,18 @@ Constant* LLVMParserEngine::_parseInitializer(const Type* type)
 
 void LLVMParserEngine::_parseAlignment(ir::Global* global)
 {
-	auto next = _lexer.peek();
+	auto next = _lexer.peekView();
 
 	while(next == ",")
 	{
 		_lexer.scan(",");
 
-		_lexer.nextToken();
-		_lexer.nextToken();
+		_lexer.nextTokenView();
+		_lexer.nextTokenView();
 		
 		// TODO: store the alignment
 
-		next = _lexer.peek();
+		next = _lexer.peekView();
 	}
 }
 
@@ -631,13 +638,13 @@ void LLVMParserEngine::_addTypeAlias(const std::string& alias, const Type* type)
 
 void LLVMParserEngine::_parseFunctionAttributes()
 {
-	while(_lexer.peek() != "{")
+	while(_lexer.peekView() != "{")
 	{
 		_parseFunctionAttribute();
 	}
 }
 
-static bool isFunctionAttribute(const std::string& token)
+static bool isFunctionAttribute(const StringView& token)
 {
 	return (token == "section"
 		|| token == "#");
@@ -645,7 +652,7 @@ static bool isFunctionAttribute(const std::string& token)
 
 void LLVMParserEngine::_parseFunctionAttribute()
 {
-	auto attribute = _lexer.nextToken();
+	auto attribute = _lexer.nextTokenView();
 	
 	if(!isFunctionAttribute(attribute))
 	{
@@ -656,12 +663,12 @@ void LLVMParserEngine::_parseFunctionAttribute()
 	if(attribute == "section")
 	{
 		// TODO: save the section
-		_lexer.nextToken();
+		_lexer.nextTokenView();
 	}
 	else if(attribute == "#")
 	{
 		// TODO: save the metadata node
-		_lexer.nextToken();
+		_lexer.nextTokenView();
 	}
 	else
 	{
@@ -671,27 +678,28 @@ void LLVMParserEngine::_parseFunctionAttribute()
 
 void LLVMParserEngine::_parseFunctionBody()
 {
-	while(_lexer.peek() != "}")
+	while(_lexer.peekView() != "}")
 	{
 		_parseFunctionBodyDeclaration();
 	}
 }
 
-static bool isLabel(const std::string& token)
+static bool isLabel(const StringView& token)
 {
 	if(token.empty()) return false;
 	
 	return token.back() == ':';
 }
 
-static std::set<std::string> opcodes = {"call", "ret"};
+static const char* opcodes[] = {"call", "ret"};
 
-static bool isOpcode(const std::string& token)
+static bool isOpcode(const StringView& token)
 {
-	return opcodes.count(token) != 0;
+	return std::find(std::begin(opcodes), std::end(opcodes), token) !=
+		std::end(opcodes);
 }
 
-static bool isInstruction(const std::string& token)
+static bool isInstruction(const StringView& token)
 {
 	if(isOpcode(token)) return true;
 	
@@ -705,11 +713,11 @@ static bool isInstruction(const std::string& token)
 
 void LLVMParserEngine::_parseFunctionBodyDeclaration()
 {
-	if(isLabel(_lexer.peek()))
+	if(isLabel(_lexer.peekView()))
 	{
 		_parseLabel();
 	}
-	else if(isInstruction(_lexer.peek()))
+	else if(isInstruction(_lexer.peekView()))
 	{
 		_parseInstruction();
 	}
@@ -722,10 +730,10 @@ void LLVMParserEngine::_parseFunctionBodyDeclaration()
 
 void LLVMParserEngine::_parseLabel()
 {
-	auto label = _lexer.nextToken();
+	auto label = _lexer.nextTokenView();
 
 	_block = &*_function->newBasicBlock(_function->end(),
-		label.substr(0, label.size() - 1));
+		label.substr(0, label.size() - 1).str());
 }
 
 void LLVMParserEngine::_parseInstruction()
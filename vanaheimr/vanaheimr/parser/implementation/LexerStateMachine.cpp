@@ -0,0 +1,349 @@
+/*! \file   LexerStateMachine.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the LexerStateMachine class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/parser/interface/LexerStateMachine.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <cassert>
+#include <map>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace parser
+{
+
+const LexerStateMachine::RuleId  LexerStateMachine::InvalidRule;
+const LexerStateMachine::StateId LexerStateMachine::DeadState;
+
+LexerStateMachine::LexerStateMachine()
+: _characterClassCount(1), _startState(DeadState), _isCompiled(false)
+{
+	std::fill(_characterClasses, _characterClasses + 256, 0);
+
+	_transitions.push_back(DeadState);
+	_acceptedRules.push_back(InvalidRule);
+}
+
+LexerStateMachine::RuleId LexerStateMachine::addRule(const LexerRule& rule)
+{
+	_rules.push_back(rule);
+
+	_isCompiled = false;
+
+	return _rules.size() - 1;
+}
+
+void LexerStateMachine::compile()
+{
+	_buildCharacterClasses();
+	_buildStates();
+	_minimize();
+
+	_isCompiled = true;
+
+	report("Compiled " << _rules.size() << " lexer rules into "
+		<< stateCount() << " states over " << _characterClassCount
+		<< " character classes.");
+}
+
+bool LexerStateMachine::isCompiled() const
+{
+	return _isCompiled;
+}
+
+LexerStateMachine::RuleId LexerStateMachine::match(const char* begin,
+	const char* end, size_t& length) const
+{
+	RuleId matchedRule = InvalidRule;
+
+	length = 0;
+
+	StateId state = _startState;
+
+	for(auto position = begin; position != end; ++position)
+	{
+		state = _transitions[state * _characterClassCount +
+			_characterClasses[(unsigned char)*position]];
+
+		if(state == DeadState) break;
+
+		RuleId rule = _acceptedRules[state];
+
+		if(rule != InvalidRule)
+		{
+			matchedRule = rule;
+			length      = position - begin + 1;
+		}
+	}
+
+	return matchedRule;
+}
+
+const LexerRule& LexerStateMachine::getRule(RuleId rule) const
+{
+	assert(rule < _rules.size());
+
+	return _rules[rule];
+}
+
+size_t LexerStateMachine::ruleCount() const
+{
+	return _rules.size();
+}
+
+size_t LexerStateMachine::stateCount() const
+{
+	return _acceptedRules.size();
+}
+
+size_t LexerStateMachine::characterClassCount() const
+{
+	return _characterClassCount;
+}
+
+void LexerStateMachine::_buildCharacterClasses()
+{
+	std::fill(_characterClasses, _characterClasses + 256, 0);
+
+	_characterClassCount = 1;
+
+	// split every class by membership in each element's character set
+	for(auto& rule : _rules)
+	{
+		for(auto& element : rule)
+		{
+			std::vector<int> splitClasses(2 * _characterClassCount, -1);
+
+			size_t newClassCount = 0;
+
+			for(unsigned int c = 0; c < 256; ++c)
+			{
+				auto& splitClass = splitClasses[2 * _characterClasses[c] +
+					element.characters.test(c)];
+
+				if(splitClass < 0) splitClass = newClassCount++;
+
+				_characterClasses[c] = splitClass;
+			}
+
+			_characterClassCount = newClassCount;
+		}
+	}
+}
+
+typedef std::vector<unsigned int> NFAStateSet;
+
+void LexerStateMachine::_buildStates()
+{
+	// Each (rule, number of elements matched) pair is an NFA state
+	NFAStateSet nfaRules;
+	NFAStateSet nfaPositions;
+
+	for(RuleId rule = 0; rule < _rules.size(); ++rule)
+	{
+		for(size_t position = 0; position <= _rules[rule].size(); ++position)
+		{
+			nfaRules.push_back(rule);
+			nfaPositions.push_back(position);
+		}
+	}
+
+	auto element = [&](unsigned int nfaState) -> const LexerRule::Element*
+	{
+		auto& rule = _rules[nfaRules[nfaState]];
+
+		if(nfaPositions[nfaState] == rule.size()) return nullptr;
+
+		return &*(rule.begin() + nfaPositions[nfaState]);
+	};
+
+	// repeated elements may be skipped
+	auto closure = [&](NFAStateSet& states)
+	{
+		for(size_t i = 0; i < states.size(); ++i)
+		{
+			auto repeated = element(states[i]);
+
+			if(repeated != nullptr && repeated->isRepeated)
+			{
+				states.push_back(states[i] + 1);
+			}
+		}
+
+		std::sort(states.begin(), states.end());
+
+		states.erase(std::unique(states.begin(), states.end()), states.end());
+	};
+
+	std::vector<unsigned char> representatives(_characterClassCount);
+
+	for(int c = 255; c >= 0; --c)
+	{
+		representatives[_characterClasses[c]] = c;
+	}
+
+	typedef std::map<NFAStateSet, StateId> StateMap;
+	typedef std::vector<NFAStateSet>       StateSetVector;
+
+	StateMap       stateIds;
+	StateSetVector states;
+
+	auto getOrAddState = [&](const NFAStateSet& set)
+	{
+		auto state = stateIds.insert(std::make_pair(set, states.size()));
+
+		if(state.second) states.push_back(set);
+
+		return state.first->second;
+	};
+
+	_transitions.clear();
+	_acceptedRules.clear();
+
+	getOrAddState(NFAStateSet());
+
+	NFAStateSet start;
+
+	for(unsigned int nfaState = 0; nfaState < nfaRules.size(); ++nfaState)
+	{
+		if(nfaPositions[nfaState] == 0) start.push_back(nfaState);
+	}
+
+	closure(start);
+
+	_startState = getOrAddState(start);
+
+	// states are numbered in discovery order, so rows are appended in order
+	for(StateId state = 0; state < states.size(); ++state)
+	{
+		RuleId accepted = InvalidRule;
+
+		for(auto nfaState : states[state])
+		{
+			if(element(nfaState) == nullptr)
+			{
+				accepted = std::min(accepted, nfaRules[nfaState]);
+			}
+		}
+
+		_acceptedRules.push_back(accepted);
+
+		for(size_t c = 0; c < _characterClassCount; ++c)
+		{
+			NFAStateSet next;
+
+			for(auto nfaState : states[state])
+			{
+				auto current = element(nfaState);
+
+				if(current == nullptr) continue;
+
+				if(!current->characters.test(representatives[c])) continue;
+
+				next.push_back(current->isRepeated ? nfaState : nfaState + 1);
+			}
+
+			closure(next);
+
+			_transitions.push_back(getOrAddState(next));
+		}
+	}
+}
+
+void LexerStateMachine::_minimize()
+{
+	// Moore's algorithm: split blocks of states until every state in a block
+	//  accepts the same rule and moves to the same blocks on every class
+	size_t stateCount = _acceptedRules.size();
+
+	StateVector blocks(stateCount);
+
+	size_t blockCount = 0;
+
+	{
+		std::map<RuleId, StateId> acceptedBlocks;
+
+		for(StateId state = 0; state < stateCount; ++state)
+		{
+			blocks[state] = acceptedBlocks.insert(std::make_pair(
+				_acceptedRules[state], acceptedBlocks.size())).first->second;
+		}
+
+		blockCount = acceptedBlocks.size();
+	}
+
+	while(true)
+	{
+		std::map<StateVector, StateId> signatures;
+
+		StateVector newBlocks(stateCount);
+
+		for(StateId state = 0; state < stateCount; ++state)
+		{
+			StateVector signature(1 + _characterClassCount);
+
+			signature[0] = blocks[state];
+
+			for(size_t c = 0; c < _characterClassCount; ++c)
+			{
+				signature[c + 1] = blocks[
+					_transitions[state * _characterClassCount + c]];
+			}
+
+			newBlocks[state] = signatures.insert(std::make_pair(signature,
+				signatures.size())).first->second;
+		}
+
+		blocks = std::move(newBlocks);
+
+		if(signatures.size() == blockCount) break;
+
+		blockCount = signatures.size();
+	}
+
+	// the dead state is visited first, so it stays state 0
+	assert(blocks[DeadState] == DeadState);
+
+	StateVector  transitions(blockCount * _characterClassCount);
+	RuleIdVector acceptedRules(blockCount);
+
+	for(StateId state = 0; state < stateCount; ++state)
+	{
+		auto block = blocks[state];
+
+		acceptedRules[block] = _acceptedRules[state];
+
+		for(size_t c = 0; c < _characterClassCount; ++c)
+		{
+			transitions[block * _characterClassCount + c] =
+				blocks[_transitions[state * _characterClassCount + c]];
+		}
+	}
+
+	report(" minimized " << stateCount << " states to " << blockCount);
+
+	_transitions   = std::move(transitions);
+	_acceptedRules = std::move(acceptedRules);
+	_startState    = blocks[_startState];
+}
+
+}
+
+}
+
@@ -6,6 +6,9 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/StringView.h>
+
 // Forward Declarations
 namespace vanaheimr { namespace parser { class LexerEngine; } }
 
@@ -24,6 +27,7 @@ class Lexer
 {
 public:
 	typedef std::list<std::string> StringList;
+	typedef util::StringView       StringView;
 
 public:
 	Lexer();
@@ -34,9 +38,13 @@ public:
 	Lexer& operator=(const Lexer&) = delete;
 
 public:
-	/*! brief Set the stream being lexed */
+	/*! \brief Set the stream being lexed, it is read once from its
+		current position and never rewound */
 	void setStream(std::istream* stream);	
 
+	/*! \brief Lex a file, it is mapped into memory rather than copied */
+	void setInputFile(const std::string& filename);
+
 public:
 	/*! \brief Add a rule for lexing whitespace */
 	void addWhitespaceRules(const std::string& whitespaceCharacters);	
@@ -57,11 +65,18 @@ public:
 	void scanThrow(const std::string& token);
 	bool scanPeek(const std::string& token);
 
+public:
+	/*! \brief Variants of peek/nextToken that refer to the input rather than
+		copying it, they remain valid until the input is changed */
+	StringView peekView();
+	StringView nextTokenView();
+
 public:
 	size_t   line() const;
 	size_t column() const;
 
 public:
+	/*! \brief Start lexing again from the beginning of the input */
 	void reset();
 	void checkpoint();
 	void restoreCheckpoint();
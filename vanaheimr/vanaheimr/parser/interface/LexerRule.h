@@ -7,6 +7,7 @@
 #pragma once
 
 // Standard Library Includes
+#include <bitset>
 #include <string>
 #include <vector>
 
@@ -18,127 +19,62 @@ namespace parser
 
 /* \brief A class for representing a regular expression used to match a
 		Lexer token
+
+	A rule is a sequence of elements.  Each element matches one character
+	from a set (a literal, an escaped literal, '.', [:alnum:], [:digit:],
+	or a bracketed class like [a-z] or [^"]), and may be followed by '*'
+	to match zero or more of them.
 */
 class LexerRule
 {
 public:
-	explicit LexerRule(const std::string& regex);
-	
-public:
-	~LexerRule();
-	LexerRule(const LexerRule&);
-	
-	LexerRule& operator=(const LexerRule& rule);
-	
+	typedef std::bitset<256> CharacterSet;
+
+	class Element
+	{
+	public:
+		Element(const CharacterSet& characters, bool isRepeated);
+
+	public:
+		bool matches(char c) const;
+
+	public:
+		CharacterSet characters;
+		bool         isRepeated;
+	};
+
+	typedef std::vector<Element> ElementVector;
+
+	typedef ElementVector::const_iterator const_iterator;
+
 public:
-	bool canMatchWithBegin(const std::string&) const;
-	bool canMatchWithEnd(const std::string&) const;
-	bool canOnlyMatchWithBegin(const std::string&) const;
-	bool canOnlyMatchWithEnd(const std::string&) const;
-	bool canMatch(const std::string&) const;
-	bool isExactMatch(const std::string&) const;
+	explicit LexerRule(const std::string& regex);
 
 public:
-	bool isEndRepeated() const;
+	bool isExactMatch(const std::string&) const;
 
 public:
 	const std::string& toString() const;
-	
-public:
-	typedef std::string::iterator       iterator;
-	typedef std::string::const_iterator const_iterator;
-	
-	typedef std::string::reverse_iterator       reverse_iterator;
-	typedef std::string::const_reverse_iterator const_reverse_iterator;
 
 public:
-	      iterator begin();
 	const_iterator begin() const;
-
-	      iterator end();
 	const_iterator end() const;
-	
-	      reverse_iterator rbegin();
-	const_reverse_iterator rbegin() const;
 
-	      reverse_iterator rend();
-	const_reverse_iterator rend() const;	
-	
 public:
 	bool   empty() const;
 	size_t  size() const;
 
-public:	
-	class Character
-	{
-	public:
-		virtual ~Character();
-	
-	public:
-		virtual bool matches(const_iterator& position,
-			const_iterator end) const = 0;
-		virtual bool matches(const_reverse_iterator& position,
-			const_reverse_iterator end) const;
-
-	public:
-		virtual bool isRepeated() const;
-	
-	public:
-		virtual Character* clone() const = 0;
-	
-	protected:
-		typedef std::string::iterator       iterator;
-		typedef std::string::const_iterator const_iterator;
-	
-		typedef std::string::reverse_iterator       reverse_iterator;
-		typedef std::string::const_reverse_iterator const_reverse_iterator;	
-	};
-	
-	typedef std::vector<Character*> CharacterVector;
-
 private:
-	typedef CharacterVector::iterator       regex_iterator;
-	typedef CharacterVector::const_iterator const_regex_iterator;
-	
-	typedef CharacterVector::reverse_iterator reverse_regex_iterator;
-
-	typedef CharacterVector::const_reverse_iterator
-		const_reverse_regex_iterator;
+	typedef std::string::const_iterator string_iterator;
 
 private:
 	void _interpretRegex(const std::string& regex);
-	void _formRegex(const_iterator& begin, const_iterator end);
+	void _formRegex(string_iterator& begin, string_iterator end);
 
 private:
-	bool _match(const_iterator& matchEnd, const_regex_iterator& matchRuleEnd,
-		const_iterator begin, const_iterator end,
-		const_regex_iterator ruleBegin, const_regex_iterator ruleEnd) const;
-	bool _match(const_iterator& matchEnd, const_iterator begin,
-		const_iterator end) const;
-	bool _isExactMatch(const std::string& text) const;
-	bool _matchWithEnd(const_iterator begin, const_iterator end) const;
-	bool _matchWithBegin(const_iterator begin, const_iterator end) const;
-	bool _canMatchWithBegin(const std::string& text) const;
-	bool _canMatchWithEnd(const std::string& text) const;
-	bool _canMatch(const std::string&) const;
-	
-private:
-	      regex_iterator regex_begin();
-	const_regex_iterator regex_begin() const;
-
-	      regex_iterator regex_end();
-	const_regex_iterator regex_end() const;
-	
-	      reverse_regex_iterator regex_rbegin();
-	const_reverse_regex_iterator regex_rbegin() const;
-
-	      reverse_regex_iterator regex_rend();
-	const_reverse_regex_iterator regex_rend() const;
-	
-private:
-	CharacterVector _regex;
-	std::string     _rawString;
-	
+	ElementVector _regex;
+	std::string   _rawString;
+
 };
 
 }
@@ -0,0 +1,97 @@
+/*! \file   LexerStateMachine.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the LexerStateMachine class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/parser/interface/LexerRule.h>
+
+// Standard Library Includes
+#include <vector>
+
+namespace vanaheimr
+{
+
+namespace parser
+{
+
+/*! \brief A minimized DFA that finds the longest prefix of a buffer matched
+	by any of a set of LexerRules.
+
+	Bytes that no rule can tell apart share a character class, so the
+	transition table has one column per class rather than one per byte.
+	When several rules match the longest prefix, the rule that was added
+	first wins.
+*/
+class LexerStateMachine
+{
+public:
+	typedef unsigned int RuleId;
+
+	static const RuleId InvalidRule = (RuleId)-1;
+
+public:
+	LexerStateMachine();
+
+public:
+	/*! \brief Add a rule, ids are assigned in order starting from 0 */
+	RuleId addRule(const LexerRule& rule);
+
+	/*! \brief Build the state machine for the current set of rules */
+	void compile();
+
+	/*! \brief Have any rules been added since the last compile? */
+	bool isCompiled() const;
+
+public:
+	/*! \brief Match the longest non-empty prefix of [begin, end)
+
+		\return The matched rule, or InvalidRule if nothing matches
+	*/
+	RuleId match(const char* begin, const char* end, size_t& length) const;
+
+public:
+	const LexerRule& getRule(RuleId rule) const;
+
+	size_t ruleCount() const;
+
+public:
+	size_t stateCount() const;
+	size_t characterClassCount() const;
+
+private:
+	typedef unsigned int StateId;
+
+	typedef std::vector<LexerRule> RuleVector;
+	typedef std::vector<StateId>   StateVector;
+	typedef std::vector<RuleId>    RuleIdVector;
+
+private:
+	static const StateId DeadState = 0;
+
+private:
+	void _buildCharacterClasses();
+	void _buildStates();
+	void _minimize();
+
+private:
+	RuleVector _rules;
+
+	unsigned char _characterClasses[256];
+	size_t        _characterClassCount;
+
+	StateVector  _transitions;
+	RuleIdVector _acceptedRules;
+	StateId      _startState;
+
+	bool _isCompiled;
+
+};
+
+}
+
+}
+
@@ -13,39 +13,46 @@
 #include <hydrazine/interface/ArgumentParser.h>
 
 // Standard Library Includes
-#include <fstream>
+#include <iostream>
 
 namespace vanaheimr
 {
 
-static void dump(const std::string& name)
-{	
-	std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary;
-	
-	std::ifstream virFile(name.c_str(), mode);
-	
-	if(!virFile.is_open())
-	{
-		std::cerr << "ObjDump Failed: could not open VIR file '"
-			<< name << "' for reading.\n"; 
-		return;
-	}
-	
+static void dump(const std::string& name, const std::string& functionName)
+{
 	ir::Module* module = 0;
 
 	try
 	{
 		as::BinaryReader reader;
 
-		module = reader.read(virFile, name);
+		module = reader.map(name);
 	
+		if(functionName.empty())
+		{
+			reader.materializeAll(*module);
+		}
+		else
+		{
+			auto function = module->getFunction(functionName);
+
+			if(function == module->end())
+			{
+				std::cerr << "ObjDump Failed: no function named '"
+					<< functionName << "' in VIR file '" << name << "'.\n";
+				delete module;
+				return;
+			}
+
+			reader.materialize(*function);
+		}
+
 		module->writeAssembly(std::cout);
 	}
 	catch(const std::exception& e)
 	{
 		std::cerr << "ObjDump Failed: binary reading failed.\n"; 
 		std::cerr << "  Message: " << e.what() << "\n"; 
-		return;
 	}
 	
 	delete module;
@@ -58,14 +65,17 @@ int main(int argc, char** argv)
 	hydrazine::ArgumentParser parser(argc, argv);
 
 	std::string virFileName;
+	std::string functionName;
 
 	parser.description("This program prints out an assembly "
 		"representation of a VIR binary.");
 
 	parser.parse("-i", "--input",  virFileName, "", "The input VIR file path.");
+	parser.parse("-f", "--function", functionName, "",
+		"Only decode the named function, others are listed as declarations.");
 	parser.parse();
 	
-	vanaheimr::dump(virFileName);
+	vanaheimr::dump(virFileName, functionName);
 
 	return 0;
 }
@@ -26,12 +26,15 @@
 namespace vanaheimr
 {
 
-static void optimizeModule(ir::Module* module, const std::string& optimizations)
+static void optimizeModule(ir::Module* module, const std::string& optimizations,
+	unsigned int threads)
 {
 	auto optimizationList = hydrazine::split(optimizations, ",");
 	
 	transforms::PassManager manager(module);
 	
+	manager.setMaximumThreadCount(threads);
+	
 	for(auto optimization : optimizationList)
 	{
 		auto pass = transforms::PassFactory::createPass(optimization);
@@ -121,7 +124,7 @@ static ir::Module* loadModule(const std::string& inputFileName)
 
 static void optimize(const std::string& inputFileName,
 	const std::string& outputFileName,
-	const std::string& optimizations)
+	const std::string& optimizations, unsigned int threads)
 {	
 	
 	ir::Module* module = loadModule(inputFileName);
@@ -130,7 +133,7 @@ static void optimize(const std::string& inputFileName,
 	
 	try
 	{
-		optimizeModule(module, optimizations);
+		optimizeModule(module, optimizations, threads);
 	}
 	catch(const std::exception& e)
 	{
@@ -175,6 +178,8 @@ int main(int argc, char** argv)
 	std::string outputFileName;
 	std::string optimizations;
 
+	unsigned int threads = 1;
+
 	bool verbose = false;
 
 	parser.description("This program reads in a VIR binary, optimizes it, "
@@ -187,7 +192,11 @@ int main(int argc, char** argv)
 	parser.parse("-v", "--verbose", verbose, false,
 		"Print out log messages during execution");
 	parser.parse("", "--optimizations",  optimizations,
-		"", "Comma separated list of optimizations (ConvertToSSA).");
+		"", "Comma separated list of optimizations (loop-unroll, ConvertToSSA, "
+		"gvn, sccp, chaitin-briggs or linear-scan register allocation, "
+		"...).");
+	parser.parse("-j", "--threads", threads, 1,
+		"Optimize up to this many functions in parallel (0 for all cores).");
 	parser.parse();
 
 	if(verbose)
@@ -195,7 +204,7 @@ int main(int argc, char** argv)
 		hydrazine::enableAllLogs();
 	}
 	
-	vanaheimr::optimize(virFileName, outputFileName, optimizations);
+	vanaheimr::optimize(virFileName, outputFileName, optimizations, threads);
 
 	return 0;
 }
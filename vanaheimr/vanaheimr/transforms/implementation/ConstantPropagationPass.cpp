@@ -0,0 +1,1088 @@
+/*! \file   ConstantPropagationPass.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the ConstantPropagationPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/ConstantPropagationPass.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+#include <vanaheimr/util/interface/BitVector.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <cassert>
+#include <set>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+ConstantPropagationPass::ConstantPropagationPass()
+: FunctionPass(StringVector({"ControlFlowGraph"}), "ConstantPropagationPass")
+{
+
+}
+
+typedef ir::BasicBlock      BasicBlock;
+typedef ir::Instruction     Instruction;
+typedef ir::VirtualRegister VirtualRegister;
+
+/*! \brief A point in the lattice undefined > constant > overdefined */
+class LatticeValue
+{
+public:
+	enum State
+	{
+		Undefined,
+		Constant,
+		Overdefined
+	};
+
+public:
+	LatticeValue(State s = Undefined, uint64_t v = 0)
+	: state(s), value(v)
+	{
+
+	}
+
+public:
+	bool isUndefined()   const { return state == Undefined;   }
+	bool isConstant()    const { return state == Constant;    }
+	bool isOverdefined() const { return state == Overdefined; }
+
+public:
+	bool operator==(const LatticeValue& v) const
+	{
+		return state == v.state && (state != Constant || value == v.value);
+	}
+
+public:
+	LatticeValue meet(const LatticeValue& v) const
+	{
+		if(isUndefined())   return v;
+		if(v.isUndefined()) return *this;
+
+		if(isConstant() && v.isConstant() && value == v.value) return *this;
+
+		return LatticeValue(Overdefined);
+	}
+
+public:
+	State    state;
+	uint64_t value;
+};
+
+/*! \brief The width of an integer type, 0 for all other types */
+static unsigned int getBits(const ir::Type* type)
+{
+	if(type == nullptr || !type->isInteger()) return 0;
+
+	return static_cast<const ir::IntegerType*>(type)->bits();
+}
+
+static uint64_t truncate(uint64_t value, unsigned int bits)
+{
+	if(bits >= 64) return value;
+
+	return value & ((((uint64_t)1) << bits) - 1);
+}
+
+static int64_t signExtend(uint64_t value, unsigned int bits)
+{
+	if(bits >= 64) return value;
+
+	uint64_t sign = ((uint64_t)1) << (bits - 1);
+
+	return (int64_t)((truncate(value, bits) ^ sign) - sign);
+}
+
+static bool isFoldableOpcode(Instruction::Opcode opcode)
+{
+	switch(opcode)
+	{
+	case Instruction::Add:
+	case Instruction::And:
+	case Instruction::Ashr:
+	case Instruction::Bitcast:
+	case Instruction::Lshr:
+	case Instruction::Mul:
+	case Instruction::Or:
+	case Instruction::Sdiv:
+	case Instruction::Setp:
+	case Instruction::Sext:
+	case Instruction::Shl:
+	case Instruction::Srem:
+	case Instruction::Sub:
+	case Instruction::Trunc:
+	case Instruction::Udiv:
+	case Instruction::Urem:
+	case Instruction::Xor:
+	case Instruction::Zext:
+	{
+		return true;
+	}
+	default: break;
+	}
+
+	return false;
+}
+
+static VirtualRegister* getDefinedValue(const Instruction& instruction)
+{
+	if(instruction.writes.size() != 1) return nullptr;
+
+	auto write = instruction.writes.front();
+
+	if(write->mode() != ir::Operand::Register &&
+		write->mode() != ir::Operand::Predicate)
+	{
+		return nullptr;
+	}
+
+	return static_cast<const ir::RegisterOperand*>(write)->virtualRegister;
+}
+
+static bool foldUnary(uint64_t& result, Instruction::Opcode opcode,
+	uint64_t a, unsigned int sourceBits, unsigned int bits)
+{
+	switch(opcode)
+	{
+	case Instruction::Bitcast:
+	case Instruction::Trunc:
+	case Instruction::Zext:
+	{
+		result = a;
+		break;
+	}
+	case Instruction::Sext:
+	{
+		result = signExtend(a, sourceBits);
+		break;
+	}
+	default: return false;
+	}
+
+	result = truncate(result, bits);
+
+	return true;
+}
+
+static bool foldBinary(uint64_t& result, Instruction::Opcode opcode,
+	uint64_t a, uint64_t b, unsigned int bits)
+{
+	int64_t signedA = signExtend(a, bits);
+	int64_t signedB = signExtend(b, bits);
+
+	switch(opcode)
+	{
+	case Instruction::Add: result = a + b; break;
+	case Instruction::Sub: result = a - b; break;
+	case Instruction::Mul: result = a * b; break;
+	case Instruction::And: result = a & b; break;
+	case Instruction::Or:  result = a | b; break;
+	case Instruction::Xor: result = a ^ b; break;
+	case Instruction::Shl:
+	{
+		if(b >= bits) return false;
+
+		result = a << b;
+		break;
+	}
+	case Instruction::Lshr:
+	{
+		if(b >= bits) return false;
+
+		result = a >> b;
+		break;
+	}
+	case Instruction::Ashr:
+	{
+		if(b >= bits) return false;
+
+		result = signedA >> b;
+		break;
+	}
+	case Instruction::Udiv:
+	case Instruction::Urem:
+	{
+		if(b == 0) return false;
+
+		result = opcode == Instruction::Udiv ? a / b : a % b;
+		break;
+	}
+	case Instruction::Sdiv:
+	case Instruction::Srem:
+	{
+		if(signedB == 0) return false;
+
+		// the quotient of the most negative value and -1 overflows
+		if(signedB == -1 && signedA == signExtend(((uint64_t)1) << (bits - 1),
+			bits))
+		{
+			return false;
+		}
+
+		result = opcode == Instruction::Sdiv ?
+			signedA / signedB : signedA % signedB;
+		break;
+	}
+	default: return false;
+	}
+
+	result = truncate(result, bits);
+
+	return true;
+}
+
+/*! \brief Compare two integers, the sign of a comparison is not recorded,
+	so relational comparisons are only folded if the signed and unsigned
+	results agree */
+static bool foldComparison(uint64_t& result,
+	ir::ComparisonInstruction::Comparison comparison,
+	uint64_t a, uint64_t b, unsigned int bits)
+{
+	typedef ir::ComparisonInstruction ComparisonInstruction;
+
+	int64_t signedA = signExtend(a, bits);
+	int64_t signedB = signExtend(b, bits);
+
+	bool unsignedResult = false;
+	bool signedResult   = false;
+
+	switch(comparison)
+	{
+	case ComparisonInstruction::OrderedEqual:
+	case ComparisonInstruction::UnorderedEqual:
+	{
+		result = a == b;
+		return true;
+	}
+	case ComparisonInstruction::OrderedNotEqual:
+	case ComparisonInstruction::UnorderedNotEqual:
+	{
+		result = a != b;
+		return true;
+	}
+	case ComparisonInstruction::OrderedLessThan:
+	case ComparisonInstruction::UnorderedLessThan:
+	{
+		unsignedResult = a < b;
+		signedResult   = signedA < signedB;
+		break;
+	}
+	case ComparisonInstruction::OrderedLessOrEqual:
+	case ComparisonInstruction::UnorderedLessOrEqual:
+	{
+		unsignedResult = a <= b;
+		signedResult   = signedA <= signedB;
+		break;
+	}
+	case ComparisonInstruction::OrderedGreaterThan:
+	case ComparisonInstruction::UnorderedGreaterThan:
+	{
+		unsignedResult = a > b;
+		signedResult   = signedA > signedB;
+		break;
+	}
+	case ComparisonInstruction::OrderedGreaterOrEqual:
+	case ComparisonInstruction::UnorderedGreaterOrEqual:
+	{
+		unsignedResult = a >= b;
+		signedResult   = signedA >= signedB;
+		break;
+	}
+	default: return false;
+	}
+
+	if(unsignedResult != signedResult) return false;
+
+	result = unsignedResult;
+
+	return true;
+}
+
+/*! \brief Compare a value against itself */
+static bool foldSelfComparison(uint64_t& result,
+	ir::ComparisonInstruction::Comparison comparison)
+{
+	typedef ir::ComparisonInstruction ComparisonInstruction;
+
+	switch(comparison)
+	{
+	case ComparisonInstruction::OrderedEqual:
+	case ComparisonInstruction::UnorderedEqual:
+	case ComparisonInstruction::OrderedLessOrEqual:
+	case ComparisonInstruction::UnorderedLessOrEqual:
+	case ComparisonInstruction::OrderedGreaterOrEqual:
+	case ComparisonInstruction::UnorderedGreaterOrEqual:
+	{
+		result = 1;
+		return true;
+	}
+	case ComparisonInstruction::OrderedNotEqual:
+	case ComparisonInstruction::UnorderedNotEqual:
+	case ComparisonInstruction::OrderedLessThan:
+	case ComparisonInstruction::UnorderedLessThan:
+	case ComparisonInstruction::OrderedGreaterThan:
+	case ComparisonInstruction::UnorderedGreaterThan:
+	{
+		result = 0;
+		return true;
+	}
+	default: break;
+	}
+
+	return false;
+}
+
+/*! \brief Propagates lattice values along executable edges and SSA
+	def-use chains until neither changes */
+class ConstantPropagationPass::Solver
+{
+public:
+	Solver(ir::Function& function, analysis::ControlFlowGraph& cfg);
+
+public:
+	void solve();
+
+public:
+	bool isExecutable(const BasicBlock& block) const;
+	bool isExecutable(const BasicBlock& head, const BasicBlock& tail) const;
+
+public:
+	bool isConstant(const VirtualRegister& value) const;
+	uint64_t getConstant(const VirtualRegister& value) const;
+
+private:
+	typedef std::vector<LatticeValue>     LatticeValueVector;
+	typedef std::vector<Instruction*>     InstructionVector;
+	typedef std::vector<InstructionVector> InstructionVectorVector;
+	typedef std::vector<BasicBlock*>      BasicBlockVector;
+
+	typedef std::pair<const BasicBlock*, const BasicBlock*> Edge;
+	typedef std::set<Edge>    EdgeSet;
+	typedef std::vector<Edge> EdgeVector;
+
+private:
+	void _markEdge(const BasicBlock* head, BasicBlock* tail);
+	void _update(const VirtualRegister& value, const LatticeValue& result);
+
+private:
+	void _visitBlock(BasicBlock& block);
+	void _visit(Instruction& instruction);
+	void _visitPhi(ir::Phi& phi);
+	void _visitTerminator(BasicBlock& block);
+
+private:
+	LatticeValue _evaluate(const Instruction& instruction) const;
+	LatticeValue _evaluateComparison(
+		const ir::ComparisonInstruction& comparison) const;
+	LatticeValue _getValue(const ir::Operand& operand) const;
+
+private:
+	ir::Function&               _function;
+	analysis::ControlFlowGraph& _cfg;
+
+private:
+	LatticeValueVector      _values;
+	InstructionVectorVector _uses;
+
+	/*! \brief The block following each block in the layout, by id */
+	BasicBlockVector _fallthroughs;
+
+	util::BitVector _executableBlocks;
+	EdgeSet         _executableEdges;
+
+private:
+	EdgeVector        _edgeWorklist;
+	InstructionVector _instructionWorklist;
+};
+
+ConstantPropagationPass::Solver::Solver(ir::Function& function,
+	analysis::ControlFlowGraph& cfg)
+: _function(function), _cfg(cfg),
+  _values(function.register_id_bound(), LatticeValue::Undefined),
+  _uses(function.register_id_bound()),
+  _fallthroughs(function.size(), nullptr),
+  _executableBlocks(function.size())
+{
+	typedef std::vector<unsigned int> CountVector;
+
+	CountVector definitions(function.register_id_bound(), 0);
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		auto next = block; ++next;
+
+		if(next != function.end()) _fallthroughs[block->id()] = &*next;
+
+		for(auto instruction : *block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(!write->isRegister()) continue;
+
+				++definitions[static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister->id];
+			}
+
+			for(auto read : instruction->reads)
+			{
+				if(!read->isRegister()) continue;
+
+				auto reg = static_cast<ir::RegisterOperand*>(read);
+
+				if(reg->virtualRegister == nullptr) continue;
+
+				_uses[reg->virtualRegister->id].push_back(instruction);
+			}
+		}
+	}
+
+	// values defined more than once (or never) are never constant
+	for(unsigned int id = 0; id < definitions.size(); ++id)
+	{
+		if(definitions[id] != 1) _values[id] = LatticeValue::Overdefined;
+	}
+}
+
+void ConstantPropagationPass::Solver::solve()
+{
+	_markEdge(nullptr, &*_function.entry_block());
+
+	while(!_edgeWorklist.empty() || !_instructionWorklist.empty())
+	{
+		while(!_edgeWorklist.empty())
+		{
+			auto edge = _edgeWorklist.back();
+			_edgeWorklist.pop_back();
+
+			auto tail = const_cast<BasicBlock*>(edge.second);
+
+			if(_executableBlocks.insert(tail->id()))
+			{
+				_visitBlock(*tail);
+				continue;
+			}
+
+			// only the phis depend on the new edge
+			for(auto instruction : *tail)
+			{
+				if(!instruction->isPhi()) break;
+
+				_visitPhi(static_cast<ir::Phi&>(*instruction));
+			}
+		}
+
+		while(!_instructionWorklist.empty())
+		{
+			auto instruction = _instructionWorklist.back();
+			_instructionWorklist.pop_back();
+
+			if(!isExecutable(*instruction->block)) continue;
+
+			_visit(*instruction);
+		}
+	}
+}
+
+bool ConstantPropagationPass::Solver::isExecutable(
+	const BasicBlock& block) const
+{
+	return _executableBlocks.contains(block.id());
+}
+
+bool ConstantPropagationPass::Solver::isExecutable(const BasicBlock& head,
+	const BasicBlock& tail) const
+{
+	return _executableEdges.count(Edge(&head, &tail)) != 0;
+}
+
+bool ConstantPropagationPass::Solver::isConstant(
+	const VirtualRegister& value) const
+{
+	assert(value.id < _values.size());
+
+	return _values[value.id].isConstant();
+}
+
+uint64_t ConstantPropagationPass::Solver::getConstant(
+	const VirtualRegister& value) const
+{
+	assert(isConstant(value));
+
+	return _values[value.id].value;
+}
+
+void ConstantPropagationPass::Solver::_markEdge(const BasicBlock* head,
+	BasicBlock* tail)
+{
+	if(!_executableEdges.insert(Edge(head, tail)).second) return;
+
+	_edgeWorklist.push_back(Edge(head, tail));
+}
+
+void ConstantPropagationPass::Solver::_update(const VirtualRegister& value,
+	const LatticeValue& result)
+{
+	auto& current = _values[value.id];
+
+	// values only move down the lattice
+	auto lowered = current.meet(result);
+
+	if(lowered == current) return;
+
+	report("  " << value.toString() << " is "
+		<< (lowered.isConstant() ? "constant" : "overdefined"));
+
+	current = lowered;
+
+	_instructionWorklist.insert(_instructionWorklist.end(),
+		_uses[value.id].begin(), _uses[value.id].end());
+}
+
+void ConstantPropagationPass::Solver::_visitBlock(BasicBlock& block)
+{
+	for(auto instruction : block)
+	{
+		_visit(*instruction);
+	}
+
+	if(block.terminator() == nullptr) _visitTerminator(block);
+}
+
+void ConstantPropagationPass::Solver::_visit(Instruction& instruction)
+{
+	if(instruction.isPhi())
+	{
+		_visitPhi(static_cast<ir::Phi&>(instruction));
+		return;
+	}
+
+	auto value = getDefinedValue(instruction);
+
+	if(value != nullptr)
+	{
+		_update(*value, _evaluate(instruction));
+	}
+	else
+	{
+		for(auto write : instruction.writes)
+		{
+			if(!write->isRegister()) continue;
+
+			_update(*static_cast<ir::RegisterOperand*>(write)->virtualRegister,
+				LatticeValue::Overdefined);
+		}
+	}
+
+	if(&instruction == instruction.block->terminator())
+	{
+		_visitTerminator(*instruction.block);
+	}
+}
+
+void ConstantPropagationPass::Solver::_visitPhi(ir::Phi& phi)
+{
+	auto value = phi.d()->virtualRegister;
+
+	if(getBits(value->type) == 0)
+	{
+		_update(*value, LatticeValue::Overdefined);
+		return;
+	}
+
+	LatticeValue result;
+
+	auto sources = phi.sources();
+	auto blocks  = phi.blocks();
+
+	for(unsigned int i = 0; i < sources.size(); ++i)
+	{
+		if(!isExecutable(*blocks[i], *phi.block)) continue;
+
+		result = result.meet(_getValue(*sources[i]));
+	}
+
+	_update(*value, result);
+}
+
+void ConstantPropagationPass::Solver::_visitTerminator(BasicBlock& block)
+{
+	auto terminator = block.terminator();
+	auto successors = _cfg.getSuccessors(block);
+
+	if(terminator != nullptr && terminator->opcode == Instruction::Bra)
+	{
+		auto branch = static_cast<ir::Bra*>(terminator);
+
+		auto guard = _getValue(*branch->guard());
+
+		// branches with an undefined predicate are resolved conservatively,
+		//  so no executable block can branch into a deleted one
+		if(guard.isConstant() && branch->target()->isBasicBlock())
+		{
+			if(guard.value != 0)
+			{
+				_markEdge(&block, branch->targetBasicBlock());
+			}
+			else if(_fallthroughs[block.id()] != nullptr)
+			{
+				_markEdge(&block, _fallthroughs[block.id()]);
+			}
+
+			return;
+		}
+	}
+
+	for(auto successor : successors)
+	{
+		_markEdge(&block, successor);
+	}
+}
+
+LatticeValue ConstantPropagationPass::Solver::_evaluate(
+	const Instruction& instruction) const
+{
+	auto guard = _getValue(*instruction.guard());
+
+	// instructions that never execute leave their value undefined
+	if(guard.isUndefined() || (guard.isConstant() && guard.value == 0))
+	{
+		return LatticeValue::Undefined;
+	}
+
+	if(guard.isOverdefined()) return LatticeValue::Overdefined;
+
+	if(!isFoldableOpcode(instruction.opcode)) return LatticeValue::Overdefined;
+
+	unsigned int bits = getBits(getDefinedValue(instruction)->type);
+
+	if(bits == 0) return LatticeValue::Overdefined;
+
+	if(instruction.isComparison())
+	{
+		return _evaluateComparison(
+			static_cast<const ir::ComparisonInstruction&>(instruction));
+	}
+
+	uint64_t result = 0;
+
+	if(instruction.isUnary())
+	{
+		auto& unary = static_cast<const ir::UnaryInstruction&>(instruction);
+
+		unsigned int sourceBits = getBits(unary.a()->type());
+
+		if(sourceBits == 0) return LatticeValue::Overdefined;
+
+		auto a = _getValue(*unary.a());
+
+		if(!a.isConstant()) return a;
+
+		if(!foldUnary(result, instruction.opcode, a.value, sourceBits, bits))
+		{
+			return LatticeValue::Overdefined;
+		}
+
+		return LatticeValue(LatticeValue::Constant, result);
+	}
+
+	auto& binary = static_cast<const ir::BinaryInstruction&>(instruction);
+
+	auto a = _getValue(*binary.a());
+	auto b = _getValue(*binary.b());
+
+	// x * 0 and x & 0 are 0 for any x
+	if(instruction.opcode == Instruction::Mul ||
+		instruction.opcode == Instruction::And)
+	{
+		if((a.isConstant() && a.value == 0) ||
+			(b.isConstant() && b.value == 0))
+		{
+			return LatticeValue(LatticeValue::Constant, 0);
+		}
+	}
+
+	if(a.isOverdefined() || b.isOverdefined())
+	{
+		return LatticeValue::Overdefined;
+	}
+
+	if(a.isUndefined() || b.isUndefined()) return LatticeValue::Undefined;
+
+	if(!foldBinary(result, instruction.opcode, a.value, b.value, bits))
+	{
+		return LatticeValue::Overdefined;
+	}
+
+	return LatticeValue(LatticeValue::Constant, result);
+}
+
+LatticeValue ConstantPropagationPass::Solver::_evaluateComparison(
+	const ir::ComparisonInstruction& comparison) const
+{
+	unsigned int bits = getBits(comparison.a()->type());
+
+	// floating point comparisons are not folded
+	if(bits == 0 || getBits(comparison.b()->type()) == 0)
+	{
+		return LatticeValue::Overdefined;
+	}
+
+	uint64_t result = 0;
+
+	if(comparison.a()->mode() == ir::Operand::Register &&
+		comparison.b()->mode() == ir::Operand::Register)
+	{
+		auto a = static_cast<const ir::RegisterOperand*>(comparison.a());
+		auto b = static_cast<const ir::RegisterOperand*>(comparison.b());
+
+		if(a->virtualRegister == b->virtualRegister &&
+			foldSelfComparison(result, comparison.comparison))
+		{
+			return LatticeValue(LatticeValue::Constant, result);
+		}
+	}
+
+	auto a = _getValue(*comparison.a());
+	auto b = _getValue(*comparison.b());
+
+	if(a.isOverdefined() || b.isOverdefined())
+	{
+		return LatticeValue::Overdefined;
+	}
+
+	if(a.isUndefined() || b.isUndefined()) return LatticeValue::Undefined;
+
+	if(!foldComparison(result, comparison.comparison, a.value, b.value, bits))
+	{
+		return LatticeValue::Overdefined;
+	}
+
+	return LatticeValue(LatticeValue::Constant, result);
+}
+
+LatticeValue ConstantPropagationPass::Solver::_getValue(
+	const ir::Operand& operand) const
+{
+	switch(operand.mode())
+	{
+	case ir::Operand::Register:
+	{
+		auto value = static_cast<const ir::RegisterOperand&>(
+			operand).virtualRegister;
+
+		if(value == nullptr) return LatticeValue::Overdefined;
+
+		return _values[value->id];
+	}
+	case ir::Operand::Predicate:
+	{
+		auto& predicate = static_cast<const ir::PredicateOperand&>(operand);
+
+		switch(predicate.modifier)
+		{
+		case ir::PredicateOperand::PredicateTrue:
+		{
+			return LatticeValue(LatticeValue::Constant, 1);
+		}
+		case ir::PredicateOperand::PredicateFalse:
+		{
+			return LatticeValue(LatticeValue::Constant, 0);
+		}
+		default: break;
+		}
+
+		auto value = _values[predicate.virtualRegister->id];
+
+		if(!value.isConstant()) return value;
+
+		bool condition = value.value != 0;
+
+		if(predicate.modifier == ir::PredicateOperand::InversePredicate)
+		{
+			condition = !condition;
+		}
+
+		return LatticeValue(LatticeValue::Constant, condition);
+	}
+	case ir::Operand::Immediate:
+	{
+		auto& immediate = static_cast<const ir::ImmediateOperand&>(operand);
+
+		unsigned int bits = getBits(immediate.dataType);
+
+		if(bits == 0) return LatticeValue::Overdefined;
+
+		return LatticeValue(LatticeValue::Constant,
+			truncate(immediate.uint, bits));
+	}
+	default: break;
+	}
+
+	return LatticeValue::Overdefined;
+}
+
+void ConstantPropagationPass::runOnFunction(Function& function)
+{
+	report("Running constant propagation on function '"
+		<< function.name() << "'");
+
+	auto cfg = static_cast<analysis::ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	Solver solver(function, *cfg);
+
+	solver.solve();
+
+	// block ids are stable until unreachable blocks are deleted
+	unsigned int replaced = _replaceConstantUses(function, solver);
+	unsigned int blocks   = _removeUnreachableBlocks(function, solver);
+
+	unsigned int removed = _foldBranches(function);
+
+	removed += _removeConstantDefinitions(function, solver);
+
+	hydrazine::log("ConstantPropagationPass") << "Function '"
+		<< function.name() << "': replaced " << replaced
+		<< " constant operands, removed " << removed << " instructions and "
+		<< blocks << " unreachable blocks\n";
+}
+
+Pass* ConstantPropagationPass::clone() const
+{
+	return new ConstantPropagationPass;
+}
+
+unsigned int ConstantPropagationPass::_replaceConstantUses(Function& function,
+	const Solver& solver)
+{
+	unsigned int replaced = 0;
+
+	for(auto& block : function)
+	{
+		if(!solver.isExecutable(block)) continue;
+
+		for(auto instruction : block)
+		{
+			auto guard = instruction->guard();
+
+			if(guard->virtualRegister != nullptr &&
+				solver.isConstant(*guard->virtualRegister))
+			{
+				bool condition =
+					solver.getConstant(*guard->virtualRegister) != 0;
+
+				if(guard->modifier == ir::PredicateOperand::InversePredicate)
+				{
+					condition = !condition;
+				}
+
+				instruction->setGuard(new ir::PredicateOperand(condition ?
+					ir::PredicateOperand::PredicateTrue :
+					ir::PredicateOperand::PredicateFalse, instruction));
+
+				++replaced;
+			}
+
+			// these keep register sources
+			if(instruction->isPhi() || instruction->isPsi() ||
+				instruction->isCall() || instruction->accessesMemory() ||
+				instruction->isMachineInstruction())
+			{
+				continue;
+			}
+
+			for(unsigned int i = 1; i < instruction->reads.size(); ++i)
+			{
+				auto read = instruction->reads[i];
+
+				if(read->mode() != ir::Operand::Register) continue;
+
+				auto value = static_cast<ir::RegisterOperand*>(
+					read)->virtualRegister;
+
+				if(value == nullptr || !solver.isConstant(*value)) continue;
+
+				instruction->replaceOperand(read, new ir::ImmediateOperand(
+					solver.getConstant(*value), instruction, value->type));
+
+				++replaced;
+			}
+		}
+	}
+
+	return replaced;
+}
+
+typedef std::vector<unsigned int> CountVector;
+
+static void countUses(CountVector& uses, const Instruction& instruction,
+	int delta)
+{
+	for(auto read : instruction.reads)
+	{
+		if(!read->isRegister()) continue;
+
+		auto value = static_cast<ir::RegisterOperand*>(read)->virtualRegister;
+
+		if(value != nullptr) uses[value->id] += delta;
+	}
+}
+
+unsigned int ConstantPropagationPass::_removeConstantDefinitions(
+	Function& function, const Solver& solver)
+{
+	CountVector uses(function.register_id_bound(), 0);
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			countUses(uses, *instruction, 1);
+		}
+	}
+
+	unsigned int removed = 0;
+	bool         changed = true;
+
+	// Walk backwards so that uses are removed before their definitions,
+	//  phis around loops may take another iteration
+	while(changed)
+	{
+		changed = false;
+
+		for(auto block = function.end(); block != function.begin(); )
+		{
+			--block;
+
+			for(auto instruction = block->end();
+				instruction != block->begin(); )
+			{
+				--instruction;
+
+				auto value = getDefinedValue(**instruction);
+
+				if(value == nullptr || uses[value->id] != 0 ||
+					!solver.isConstant(*value) ||
+					!(*instruction)->guard()->isAlwaysTrue() ||
+					!(isFoldableOpcode((*instruction)->opcode) ||
+					(*instruction)->isPhi()))
+				{
+					continue;
+				}
+
+				report("  removing " << (*instruction)->toString());
+
+				countUses(uses, **instruction, -1);
+
+				instruction = block->erase(instruction);
+
+				++removed;
+				changed = true;
+			}
+		}
+	}
+
+	return removed;
+}
+
+unsigned int ConstantPropagationPass::_foldBranches(Function& function)
+{
+	unsigned int removed = 0;
+
+	// Branches with a true predicate are now unconditional, remove
+	//  the ones with a false predicate along with everything else that
+	//  can never execute.
+	for(auto& block : function)
+	{
+		for(auto instruction = block.begin(); instruction != block.end(); )
+		{
+			if((*instruction)->guard()->modifier !=
+				ir::PredicateOperand::PredicateFalse)
+			{
+				++instruction;
+				continue;
+			}
+
+			report("  removing " << (*instruction)->toString());
+
+			instruction = block.erase(instruction);
+			++removed;
+		}
+	}
+
+	return removed;
+}
+
+unsigned int ConstantPropagationPass::_removeUnreachableBlocks(
+	Function& function, const Solver& solver)
+{
+	typedef std::vector<Function::iterator> BlockIteratorVector;
+
+	BlockIteratorVector unreachable;
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		if(!solver.isExecutable(*block))
+		{
+			if(block != function.entry_block() &&
+				block != function.exit_block())
+			{
+				unreachable.push_back(block);
+			}
+
+			continue;
+		}
+
+		for(auto instruction : *block)
+		{
+			if(!instruction->isPhi()) continue;
+
+			auto phi = static_cast<ir::Phi*>(instruction);
+
+			for(auto predecessor : phi->blocks())
+			{
+				if(solver.isExecutable(*predecessor, *block)) continue;
+
+				phi->removeSource(predecessor);
+			}
+		}
+	}
+
+	for(auto block : unreachable)
+	{
+		report("  removing unreachable block " << block->name());
+
+		function.erase(block);
+	}
+
+	return unreachable.size();
+}
+
+}
+
+}
+
@@ -41,6 +41,11 @@ Pass* ConvertFromSSAPass::clone() const
 	return new ConvertFromSSAPass;
 }
 
+Pass::StringVector ConvertFromSSAPass::getPreservedAnalyses() const
+{
+	return getControlFlowAnalyses();
+}
+
 void ConvertFromSSAPass::_removePhis(Function& f)
 {
 	// TODO split critical edges
@@ -57,6 +57,11 @@ Pass* ConvertToSSAPass::clone() const
 	return new ConvertToSSAPass;
 }
 
+Pass::StringVector ConvertToSSAPass::getPreservedAnalyses() const
+{
+	return getControlFlowAnalyses();
+}
+
 void ConvertToSSAPass::_insertPhis(Function& function)
 {
 	report(" Inserting PHIs");
@@ -95,7 +100,7 @@ void ConvertToSSAPass::_insertPhis(Function& function)
 			for(auto frontierBlock : dominanceFrontier)
 			{
 				// the value needs a PHI if it is live-in here
-				auto liveIns = dfg->getLiveIns(*frontierBlock);
+				auto& liveIns = dfg->getLiveIns(*frontierBlock);
 				
 				if(liveIns.count(&*value) != 0)
 				{
@@ -483,11 +488,8 @@ void ConvertToSSAPass::_renameValuesInBlock(
 	
 	for(auto value : renamedLiveIns)
 	{
-		auto liveOut = blockLiveOuts.find(value.first);
-		
-		if(liveOut != blockLiveOuts.end())
+		if(blockLiveOuts.erase(value.first) != 0)
 		{
-			blockLiveOuts.erase(liveOut);
 			newRenamedValues.insert(value);
 		}
 	}
@@ -508,7 +510,7 @@ void ConvertToSSAPass::_renameValuesInBlock(
 	
 	for(auto dominatedBlock : dominatedBlocks)
 	{
-		auto dominatedBlockLiveIns = dfg->getLiveIns(*dominatedBlock);
+		auto& dominatedBlockLiveIns = dfg->getLiveIns(*dominatedBlock);
 	
 		VirtualRegisterMap& dominatedBlockLiveInMap =
 			_renamedLiveIns[dominatedBlock->id()];
@@ -546,7 +548,7 @@ void ConvertToSSAPass::_renamePhiInputs(BasicBlock* block,
 
 	for(auto successor : successors)
 	{		
-		auto successorBlockLiveIns = dfg->getLiveIns(*successor);
+		auto& successorBlockLiveIns = dfg->getLiveIns(*successor);
 		
 		for(auto value : renamedValues)
 		{
@@ -0,0 +1,642 @@
+/*! \file   GlobalValueNumberingPass.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the GlobalValueNumberingPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/GlobalValueNumberingPass.h>
+
+#include <vanaheimr/analysis/interface/DominatorAnalysis.h>
+#include <vanaheimr/analysis/interface/ReversePostOrderTraversal.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+GlobalValueNumberingPass::GlobalValueNumberingPass()
+: FunctionPass(StringVector({"DominatorAnalysis",
+	"ReversePostOrderTraversal"}),
+	"GlobalValueNumberingPass")
+{
+
+}
+
+typedef ir::VirtualRegister VirtualRegister;
+typedef std::vector<VirtualRegister*> VirtualRegisterVector;
+
+/*! \brief Follow replacements until reaching a value that is kept */
+static VirtualRegister* getLeader(const VirtualRegisterVector& leaders,
+	VirtualRegister* value)
+{
+	while(leaders[value->id] != nullptr)
+	{
+		value = leaders[value->id];
+	}
+
+	return value;
+}
+
+/*! \brief The opcode, modifier, and type of an instruction, followed by a
+	(mode, value, modifier) triple for each source operand */
+typedef std::vector<uint64_t> ValueKey;
+typedef std::vector<ValueKey> ValueKeyVector;
+
+class ValueKeyHash
+{
+public:
+	size_t operator()(const ValueKey& key) const
+	{
+		size_t hash = key.size();
+
+		for(auto word : key)
+		{
+			hash ^= std::hash<uint64_t>()(word) + 0x9e3779b9 +
+				(hash << 6) + (hash >> 2);
+		}
+
+		return hash;
+	}
+};
+
+/*! \brief The available values in the dominator tree scopes that enclose
+	the current block */
+class GlobalValueNumberingPass::ValueTable
+{
+public:
+	ValueTable(ir::Function& function, const VirtualRegisterVector& leaders);
+
+public:
+	/*! \brief Build the key of the value computed by an instruction,
+		returns false if the instruction is not a candidate */
+	bool getKey(ValueKey& key, const ir::Instruction& instruction) const;
+
+	/*! \brief Is a phi redundant because all sources are the same value?
+		Returns that value, or nullptr */
+	VirtualRegister* getUniqueSource(const ir::Phi& phi) const;
+
+	/*! \brief Get the single value written by a candidate instruction */
+	VirtualRegister* getDefinedValue(const ir::Instruction& instruction) const;
+
+public:
+	VirtualRegister* lookup(const ValueKey& key) const;
+	void insert(const ValueKey& key, VirtualRegister* value);
+
+public:
+	/*! \brief The marker for the start of a new scope */
+	size_t getScope() const;
+	/*! \brief Remove the values inserted since the scope started */
+	void popScope(size_t scope);
+
+private:
+	bool _hasSingleDefinition(const VirtualRegister* value) const;
+	bool _appendOperand(ValueKey& key, const ir::Operand& operand) const;
+
+private:
+	typedef std::unordered_map<ValueKey, VirtualRegister*, ValueKeyHash>
+		ValueMap;
+	typedef std::vector<unsigned int> CountVector;
+
+private:
+	ValueMap                     _values;
+	ValueKeyVector               _scope;
+	CountVector                  _definitions;
+	const VirtualRegisterVector& _leaders;
+};
+
+GlobalValueNumberingPass::ValueTable::ValueTable(ir::Function& function,
+	const VirtualRegisterVector& leaders)
+: _definitions(function.register_id_bound(), 0), _leaders(leaders)
+{
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(!write->isRegister()) continue;
+
+				++_definitions[static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister->id];
+			}
+		}
+	}
+}
+
+static bool isCandidateOpcode(ir::Instruction::Opcode opcode)
+{
+	switch(opcode)
+	{
+	case ir::Instruction::Add:
+	case ir::Instruction::And:
+	case ir::Instruction::Ashr:
+	case ir::Instruction::Bitcast:
+	case ir::Instruction::Fdiv:
+	case ir::Instruction::Fmul:
+	case ir::Instruction::Fpext:
+	case ir::Instruction::Fptosi:
+	case ir::Instruction::Fptoui:
+	case ir::Instruction::Fptrunc:
+	case ir::Instruction::Frem:
+	case ir::Instruction::Lshr:
+	case ir::Instruction::Mul:
+	case ir::Instruction::Or:
+	case ir::Instruction::Setp:
+	case ir::Instruction::Sext:
+	case ir::Instruction::Sdiv:
+	case ir::Instruction::Shl:
+	case ir::Instruction::Sitofp:
+	case ir::Instruction::Srem:
+	case ir::Instruction::Sub:
+	case ir::Instruction::Trunc:
+	case ir::Instruction::Udiv:
+	case ir::Instruction::Uitofp:
+	case ir::Instruction::Urem:
+	case ir::Instruction::Xor:
+	case ir::Instruction::Zext:
+	case ir::Instruction::Phi:
+	{
+		return true;
+	}
+	default: break;
+	}
+
+	return false;
+}
+
+static bool isCommutative(ir::Instruction::Opcode opcode)
+{
+	switch(opcode)
+	{
+	case ir::Instruction::Add:
+	case ir::Instruction::And:
+	case ir::Instruction::Fmul:
+	case ir::Instruction::Mul:
+	case ir::Instruction::Or:
+	case ir::Instruction::Xor:
+	{
+		return true;
+	}
+	default: break;
+	}
+
+	return false;
+}
+
+static const size_t KeyHeaderSize  = 3;
+static const size_t KeyOperandSize = 3;
+
+bool GlobalValueNumberingPass::ValueTable::getKey(ValueKey& key,
+	const ir::Instruction& instruction) const
+{
+	if(!isCandidateOpcode(instruction.opcode)) return false;
+
+	if(!instruction.guard()->isAlwaysTrue()) return false;
+
+	auto value = getDefinedValue(instruction);
+
+	if(value == nullptr) return false;
+
+	uint64_t modifier = 0;
+
+	if(instruction.isComparison())
+	{
+		modifier = static_cast<const ir::ComparisonInstruction&>(
+			instruction).comparison;
+	}
+
+	key.push_back(instruction.opcode);
+	key.push_back(modifier);
+	key.push_back((uint64_t)value->type);
+
+	if(instruction.isPhi())
+	{
+		auto& phi = static_cast<const ir::Phi&>(instruction);
+
+		// phis are only equivalent within the same block
+		key[1] = phi.block->id();
+
+		typedef std::pair<unsigned int, const ir::Operand*> BlockOperand;
+		typedef std::vector<BlockOperand> BlockOperandVector;
+
+		BlockOperandVector sources;
+
+		auto blocks = phi.blocks();
+		auto values = phi.sources();
+
+		for(unsigned int i = 0; i < values.size(); ++i)
+		{
+			sources.push_back(BlockOperand(blocks[i]->id(), values[i]));
+		}
+
+		std::sort(sources.begin(), sources.end());
+
+		for(auto& source : sources)
+		{
+			key.push_back(source.first);
+
+			if(!_appendOperand(key, *source.second)) return false;
+		}
+
+		return true;
+	}
+
+	for(auto read : instruction.reads)
+	{
+		if(read == instruction.guard()) continue;
+
+		if(!_appendOperand(key, *read)) return false;
+	}
+
+	// order the sources of commutative operations
+	if(isCommutative(instruction.opcode) &&
+		key.size() == KeyHeaderSize + 2 * KeyOperandSize)
+	{
+		auto first  = key.begin() + KeyHeaderSize;
+		auto second = first + KeyOperandSize;
+
+		if(std::lexicographical_compare(second, key.end(), first, second))
+		{
+			std::swap_ranges(first, second, second);
+		}
+	}
+
+	return true;
+}
+
+VirtualRegister* GlobalValueNumberingPass::ValueTable::getUniqueSource(
+	const ir::Phi& phi) const
+{
+	auto value = getDefinedValue(phi);
+
+	if(value == nullptr) return nullptr;
+
+	VirtualRegister* unique = nullptr;
+
+	for(auto source : phi.sources())
+	{
+		if(!_hasSingleDefinition(source->virtualRegister)) return nullptr;
+
+		auto leader = getLeader(_leaders, source->virtualRegister);
+
+		// a loop may carry the phi's own value around
+		if(leader == value) continue;
+
+		if(unique != nullptr && unique != leader) return nullptr;
+
+		unique = leader;
+	}
+
+	return unique;
+}
+
+VirtualRegister* GlobalValueNumberingPass::ValueTable::getDefinedValue(
+	const ir::Instruction& instruction) const
+{
+	if(instruction.writes.size() != 1) return nullptr;
+
+	auto write = instruction.writes.front();
+
+	if(write->mode() != ir::Operand::Register &&
+		write->mode() != ir::Operand::Predicate)
+	{
+		return nullptr;
+	}
+
+	auto value = static_cast<const ir::RegisterOperand*>(
+		write)->virtualRegister;
+
+	if(!_hasSingleDefinition(value)) return nullptr;
+
+	return value;
+}
+
+VirtualRegister* GlobalValueNumberingPass::ValueTable::lookup(
+	const ValueKey& key) const
+{
+	auto value = _values.find(key);
+
+	if(value == _values.end()) return nullptr;
+
+	return value->second;
+}
+
+void GlobalValueNumberingPass::ValueTable::insert(const ValueKey& key,
+	VirtualRegister* value)
+{
+	_values.insert(std::make_pair(key, value));
+	_scope.push_back(key);
+}
+
+size_t GlobalValueNumberingPass::ValueTable::getScope() const
+{
+	return _scope.size();
+}
+
+void GlobalValueNumberingPass::ValueTable::popScope(size_t scope)
+{
+	assert(scope <= _scope.size());
+
+	for(auto key = _scope.begin() + scope; key != _scope.end(); ++key)
+	{
+		_values.erase(*key);
+	}
+
+	_scope.resize(scope);
+}
+
+bool GlobalValueNumberingPass::ValueTable::_hasSingleDefinition(
+	const VirtualRegister* value) const
+{
+	assert(value->id < _definitions.size());
+
+	return _definitions[value->id] == 1;
+}
+
+bool GlobalValueNumberingPass::ValueTable::_appendOperand(ValueKey& key,
+	const ir::Operand& operand) const
+{
+	key.push_back(operand.mode());
+
+	switch(operand.mode())
+	{
+	case ir::Operand::Register:
+	case ir::Operand::Predicate:
+	{
+		auto& reg = static_cast<const ir::RegisterOperand&>(operand);
+
+		if(reg.virtualRegister == nullptr) return false;
+
+		// values defined more than once may change between the uses
+		if(!_hasSingleDefinition(reg.virtualRegister)) return false;
+
+		key.push_back(getLeader(_leaders, reg.virtualRegister)->id);
+
+		if(operand.mode() == ir::Operand::Predicate)
+		{
+			key.push_back(static_cast<const ir::PredicateOperand&>(
+				operand).modifier);
+		}
+		else
+		{
+			key.push_back(0);
+		}
+
+		break;
+	}
+	case ir::Operand::Immediate:
+	{
+		auto& immediate = static_cast<const ir::ImmediateOperand&>(operand);
+
+		key.push_back(immediate.uint);
+		key.push_back((uint64_t)immediate.dataType);
+
+		break;
+	}
+	case ir::Operand::Address:
+	{
+		key.push_back((uint64_t)static_cast<const ir::AddressOperand&>(
+			operand).globalValue);
+		key.push_back(0);
+
+		break;
+	}
+	case ir::Operand::Argument:
+	{
+		key.push_back((uint64_t)static_cast<const ir::ArgumentOperand&>(
+			operand).argument);
+		key.push_back(0);
+
+		break;
+	}
+	default:
+	{
+		// indirect operands read memory
+		return false;
+	}
+	}
+
+	return true;
+}
+
+void GlobalValueNumberingPass::runOnFunction(Function& function)
+{
+	report("Running global value numbering on function '"
+		<< function.name() << "'");
+
+	auto dominators = static_cast<analysis::DominatorAnalysis*>(
+		getAnalysis("DominatorAnalysis"));
+	assert(dominators != nullptr);
+
+	auto traversal = static_cast<analysis::ReversePostOrderTraversal*>(
+		getAnalysis("ReversePostOrderTraversal"));
+	assert(traversal != nullptr);
+
+	_order.clear();
+
+	for(unsigned int position = 0; position < traversal->order.size();
+		++position)
+	{
+		auto block = traversal->order[position];
+
+		if(block->id() >= _order.size()) _order.resize(block->id() + 1, 0);
+
+		_order[block->id()] = position;
+	}
+
+	size_t instructions = 0;
+
+	for(auto& block : function)
+	{
+		instructions += block.size();
+	}
+
+	_leaders.assign(function.register_id_bound(), nullptr);
+
+	ValueTable table(function, _leaders);
+
+	unsigned int eliminated = _numberValues(*function.entry_block(), table,
+		*dominators);
+
+	_replaceUses(function);
+
+	hydrazine::log("GlobalValueNumberingPass") << "Function '"
+		<< function.name() << "': eliminated " << eliminated << " of "
+		<< instructions << " instructions\n";
+}
+
+Pass* GlobalValueNumberingPass::clone() const
+{
+	return new GlobalValueNumberingPass;
+}
+
+Pass::StringVector GlobalValueNumberingPass::getPreservedAnalyses() const
+{
+	return getControlFlowAnalyses();
+}
+
+unsigned int GlobalValueNumberingPass::_numberValues(BasicBlock& entry,
+	ValueTable& table, const analysis::DominatorAnalysis& dominators)
+{
+	typedef std::vector<BasicBlock*> BasicBlockVector;
+
+	// A null block marks the end of the scope of a block
+	typedef std::pair<BasicBlock*, size_t> StackEntry;
+	typedef std::vector<StackEntry>        Stack;
+
+	unsigned int eliminated = 0;
+
+	Stack stack;
+
+	stack.push_back(StackEntry(&entry, 0));
+
+	while(!stack.empty())
+	{
+		auto top = stack.back();
+
+		stack.pop_back();
+
+		// values from a block are not available outside of its subtree
+		if(top.first == nullptr)
+		{
+			table.popScope(top.second);
+			continue;
+		}
+
+		auto& block = *top.first;
+
+		stack.push_back(StackEntry(nullptr, table.getScope()));
+
+		eliminated += _numberBlock(block, table);
+
+		auto& dominated = dominators.getDominatedBlocks(block);
+
+		BasicBlockVector children(dominated.begin(), dominated.end());
+
+		// visit children in reverse post order, the first is on top
+		std::sort(children.begin(), children.end(),
+			[this](const BasicBlock* left, const BasicBlock* right)
+			{
+				return _getOrder(*left) > _getOrder(*right);
+			});
+
+		for(auto child : children)
+		{
+			stack.push_back(StackEntry(child, 0));
+		}
+	}
+
+	return eliminated;
+}
+
+unsigned int GlobalValueNumberingPass::_numberBlock(BasicBlock& block,
+	ValueTable& table)
+{
+	unsigned int eliminated = 0;
+
+	for(auto instruction = block.begin(); instruction != block.end(); )
+	{
+		if((*instruction)->isPhi())
+		{
+			auto phi = static_cast<ir::Phi*>(*instruction);
+
+			auto unique = table.getUniqueSource(*phi);
+
+			if(unique != nullptr)
+			{
+				report("  " << phi->toString() << " is " << unique->toString());
+
+				_leaders[phi->d()->virtualRegister->id] = unique;
+
+				instruction = block.erase(instruction);
+				++eliminated;
+
+				continue;
+			}
+		}
+
+		ValueKey key;
+
+		if(!table.getKey(key, **instruction))
+		{
+			++instruction;
+			continue;
+		}
+
+		auto value     = table.getDefinedValue(**instruction);
+		auto available = table.lookup(key);
+
+		if(available != nullptr)
+		{
+			report("  " << (*instruction)->toString() << " is "
+				<< available->toString());
+
+			_leaders[value->id] = available;
+
+			instruction = block.erase(instruction);
+			++eliminated;
+
+			continue;
+		}
+
+		table.insert(key, value);
+
+		++instruction;
+	}
+
+	return eliminated;
+}
+
+unsigned int GlobalValueNumberingPass::_getOrder(
+	const BasicBlock& block) const
+{
+	if(block.id() >= _order.size()) return _order.size();
+
+	return _order[block.id()];
+}
+
+void GlobalValueNumberingPass::_replaceUses(Function& function)
+{
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			for(auto read : instruction->reads)
+			{
+				if(!read->isRegister()) continue;
+
+				auto reg = static_cast<ir::RegisterOperand*>(read);
+
+				reg->virtualRegister = getLeader(_leaders,
+					reg->virtualRegister);
+			}
+		}
+	}
+}
+
+}
+
+}
+
@@ -0,0 +1,195 @@
+/*! \file   LoopUnrollingPass.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the LoopUnrollingPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/LoopUnrollingPass.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <cassert>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief The largest number of instructions an unrolled body may have */
+static const unsigned int MaxUnrolledSize = 256;
+
+/*! \brief The most copies made of a loop that is partially unrolled */
+static const unsigned int MaxUnrollFactor = 8;
+
+LoopUnrollingPass::LoopUnrollingPass()
+: FunctionPass(StringVector({"LoopAnalysis"}), "LoopUnrollingPass")
+{
+
+}
+
+void LoopUnrollingPass::runOnFunction(Function& function)
+{
+	report("Running loop unrolling on function '" << function.name() << "'");
+
+	auto loops = static_cast<analysis::LoopAnalysis*>(
+		getAnalysis("LoopAnalysis"));
+	assert(loops != nullptr);
+
+	CountVector uses(function.register_id_bound(), 0);
+
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			for(auto read : instruction->reads)
+			{
+				if(!read->isRegister()) continue;
+
+				auto value = static_cast<ir::RegisterOperand*>(
+					read)->virtualRegister;
+
+				if(value != nullptr) ++uses[value->id];
+			}
+		}
+	}
+
+	unsigned int full    = 0;
+	unsigned int partial = 0;
+
+	for(auto& loop : *loops)
+	{
+		unsigned int factor = _getUnrollFactor(loop);
+
+		if(factor == 0) continue;
+
+		report(" unrolling loop at " << loop.header->name() << " by "
+			<< factor << ", trip count " << loop.tripCount);
+
+		_unroll(loop, factor, uses);
+
+		if(factor == loop.tripCount) ++full;
+		else ++partial;
+	}
+
+	hydrazine::log("LoopUnrollingPass") << "Function '" << function.name()
+		<< "': fully unrolled " << full << " and partially unrolled "
+		<< partial << " of " << loops->size() << " loops\n";
+}
+
+Pass* LoopUnrollingPass::clone() const
+{
+	return new LoopUnrollingPass;
+}
+
+unsigned int LoopUnrollingPass::_getUnrollFactor(const Loop& loop) const
+{
+	if(!loop.isInnermost() || loop.tripCount == 0) return 0;
+
+	// a single block: header: ...; @p bra header
+	if(loop.blocks.size() != 1) return 0;
+
+	auto block = loop.header;
+
+	for(auto instruction : *block)
+	{
+		if(instruction->isPhi()) return 0;
+	}
+
+	unsigned int bodySize = block->size() - 1;
+
+	if(loop.tripCount * bodySize <= MaxUnrolledSize) return loop.tripCount;
+
+	for(unsigned int factor = MaxUnrollFactor; factor > 1; --factor)
+	{
+		if(loop.tripCount % factor != 0)          continue;
+		if(factor * bodySize > MaxUnrolledSize) continue;
+
+		return factor;
+	}
+
+	return 0;
+}
+
+void LoopUnrollingPass::_unroll(Loop& loop, unsigned int factor,
+	const CountVector& uses)
+{
+	typedef std::vector<ir::Instruction*> InstructionVector;
+
+	auto block  = loop.header;
+	auto branch = block->terminator();
+
+	assert(branch != nullptr && branch->opcode == ir::Instruction::Bra);
+
+	bool isFull = factor == loop.tripCount;
+
+	// the exit test is only kept for the last copy, unless other
+	//  instructions read the predicate
+	ir::Instruction* test = nullptr;
+
+	auto predicate = branch->guard()->virtualRegister;
+
+	if(uses[predicate->id] == 1)
+	{
+		for(auto instruction : *block)
+		{
+			if(instruction->writes.size() != 1) continue;
+
+			auto write = instruction->writes.front();
+
+			if(!write->isRegister()) continue;
+
+			if(static_cast<ir::RegisterOperand*>(write)->virtualRegister ==
+				predicate)
+			{
+				test = instruction;
+			}
+		}
+	}
+
+	auto position = block->end(); --position;
+
+	InstructionVector body(block->begin(), position);
+
+	for(unsigned int copy = 1; copy < factor; ++copy)
+	{
+		bool isLast = copy + 1 == factor;
+
+		for(auto instruction : body)
+		{
+			if(instruction == test && (isFull || !isLast)) continue;
+
+			block->insert(position, instruction->clone());
+		}
+	}
+
+	if(test != nullptr && (isFull || factor > 1))
+	{
+		block->erase(test);
+	}
+
+	if(isFull)
+	{
+		block->erase(branch);
+	}
+}
+
+}
+
+}
+
@@ -74,6 +74,17 @@ Pass::StringVector Pass::getDependentPasses() const
 	return StringVector();
 }
 
+Pass::StringVector Pass::getPreservedAnalyses() const
+{
+	return StringVector();
+}
+
+Pass::StringVector Pass::getControlFlowAnalyses()
+{
+	return {"ControlFlowGraph", "DominatorAnalysis",
+		"ReversePostOrderTraversal"};
+}
+
 void Pass::configure(const StringVector& options)
 {
 
@@ -10,10 +10,14 @@
 
 #include <vanaheimr/transforms/interface/ConvertToSSAPass.h>
 #include <vanaheimr/transforms/interface/ConvertFromSSAPass.h>
+#include <vanaheimr/transforms/interface/GlobalValueNumberingPass.h>
+#include <vanaheimr/transforms/interface/ConstantPropagationPass.h>
+#include <vanaheimr/transforms/interface/LoopUnrollingPass.h>
 
 #include <vanaheimr/codegen/interface/EnforceArchaeopteryxABIPass.h>
 #include <vanaheimr/codegen/interface/ListInstructionSchedulerPass.h>
 #include <vanaheimr/codegen/interface/ChaitinBriggsRegisterAllocatorPass.h>
+#include <vanaheimr/codegen/interface/LinearScanRegisterAllocatorPass.h>
 #include <vanaheimr/codegen/interface/GenericSpillCodePass.h>
 #include <vanaheimr/codegen/interface/TranslationTableInstructionSelectionPass.h>
 
@@ -63,6 +67,21 @@ Pass* PassFactory::createPass(const std::string& name,
 		pass = new ConvertFromSSAPass();
 	}
 	
+	if(name == "gvn" || name == "GlobalValueNumberingPass")
+	{
+		pass = new GlobalValueNumberingPass();
+	}
+	
+	if(name == "sccp" || name == "ConstantPropagationPass")
+	{
+		pass = new ConstantPropagationPass();
+	}
+	
+	if(name == "loop-unroll" || name == "LoopUnrollingPass")
+	{
+		pass = new LoopUnrollingPass();
+	}
+	
 	if(name == "EnforceArchaeopteryxABIPass")
 	{
 		pass = new codegen::EnforceArchaeopteryxABIPass();
@@ -78,6 +97,11 @@ Pass* PassFactory::createPass(const std::string& name,
 		pass = new codegen::ChaitinBriggsRegisterAllocatorPass();
 	}
 	
+	if(name == "linear-scan" || name == "LinearScanRegisterAllocatorPass")
+	{
+		pass = new codegen::LinearScanRegisterAllocatorPass();
+	}
+	
 	if(name == "generic-spiller" || name == "GenericSpillCodePass")
 	{
 		pass = new codegen::GenericSpillCodePass();
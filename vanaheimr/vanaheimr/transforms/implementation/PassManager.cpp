@@ -15,10 +15,14 @@
 #include <vanaheimr/ir/interface/Module.h>
 #include <vanaheimr/ir/interface/Function.h>
 
+#include <vanaheimr/util/interface/ParallelFor.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
+#include <algorithm>
+#include <memory>
 #include <stdexcept>
 
 // Preprocessor Macros
@@ -39,204 +43,336 @@ typedef PassManager::Function     Function;
 typedef PassManager::Module       Module;
 typedef PassManager::PassWaveList PassWaveList;
 
-typedef std::unordered_map<std::string, unsigned int> PassUseCountMap;
+typedef PassManager::PassVector   PassVector;
+
+typedef std::unordered_map<std::string, unsigned int>       AnalysisUseCountMap;
+typedef std::unordered_map<std::string, Pass::StringVector> AnalysisDependenceMap;
+typedef std::unordered_map<std::string, Pass*>              PassMap;
+
+typedef std::vector<std::unique_ptr<Pass>> PassPointerVector;
+
+typedef Pass::StringVector StringVector;
+
+/*! \brief Record the analyses that each analysis used by the passes
+	depends on */
+static void addAnalysisDependences(AnalysisDependenceMap& dependences,
+	const std::string& type)
+{
+	if(dependences.count(type) != 0) return;
+	
+	auto analysis = analysis::AnalysisFactory::createAnalysis(type);
+	
+	assertM(analysis != nullptr, "Unknown analysis " << type);
+	
+	auto required = dependences.insert(std::make_pair(type,
+		analysis->required)).first->second;
+	
+	delete analysis;
+	
+	for(auto requiredType : required)
+	{
+		addAnalysisDependences(dependences, requiredType);
+	}
+}
 
-static PassUseCountMap getPassUseCounts(const PassWaveList& waves)
+static AnalysisDependenceMap getAnalysisDependences(const PassWaveList& waves)
 {
-	PassUseCountMap uses;
+	AnalysisDependenceMap dependences;
 	
-	for(auto wave : waves)
+	for(auto& wave : waves)
 	{
 		for(auto pass : wave)
 		{
-			for(auto analysisType : pass->analyses)
+			for(auto& type : pass->analyses)
 			{
-				auto use = uses.find(analysisType);
-			
-				report(" Recording future use of analysis " << analysisType);
-				
-				if(use == uses.end())
-				{
-					uses.insert(std::make_pair(analysisType, 1));
-				}
-				else
-				{
-					use->second += 1;
-				}
+				addAnalysisDependences(dependences, type);
 			}
 		}
 	}
+	
+	return dependences;
+}
 
-	return uses;
+/*! \brief Get the analyses used by a pass, including their dependences */
+static StringVector getAllAnalyses(const AnalysisDependenceMap& dependences,
+	const Pass* pass)
+{
+	StringVector types(pass->analyses.begin(), pass->analyses.end());
+	
+	for(unsigned int i = 0; i < types.size(); ++i)
+	{
+		auto required = dependences.find(types[i]);
+		assert(required != dependences.end());
+		
+		for(auto& type : required->second)
+		{
+			if(std::find(types.begin(), types.end(), type) == types.end())
+			{
+				types.push_back(type);
+			}
+		}
+	}
+	
+	return types;
 }
 
-static PassUseCountMap getPassUseCounts(const PassWaveList& waves,
-	const ir::Module& module)
+/*! \brief Count the passes that will use each analysis on one function */
+static AnalysisUseCountMap getAnalysisUseCounts(const PassWaveList& waves,
+	const AnalysisDependenceMap& dependences)
 {
-	PassUseCountMap uses;
+	AnalysisUseCountMap uses;
 	
-	for(auto wave : waves)
+	for(auto& wave : waves)
 	{
 		for(auto pass : wave)
 		{
-			for(auto analysisType : pass->analyses)
+			for(auto& type : getAllAnalyses(dependences, pass))
 			{
-				auto use = uses.find(analysisType);
-			
-				report(" Recording future use of analysis " << analysisType);
-				
-				unsigned int useCount = 0;
-				
-				switch(pass->type)
-				{
-				case Pass::ImmutablePass: // fall through
-				case Pass::ModulePass:
-				{
-					useCount = 1;
-				}
-				break;
-				case Pass::ImmutableFunctionPass: // fall through
-				case Pass::FunctionPass:
-				{
-					useCount = module.size();
-				}
-				break;
-				{
-					useCount = module.size();
-				}
-				break;
-				case Pass::BasicBlockPass:
-				{
-					for(auto function = module.begin();
-						function != module.end(); ++function)
-					{
-						useCount += function->size();
-					}
-				}
-				break;
-				default : break;
-				}
+				report(" Recording future use of analysis " << type);
 				
-				if(use == uses.end())
-				{
-					uses.insert(std::make_pair(analysisType, useCount));
-				}
-				else
-				{
-					use->second += useCount;
-				}
+				uses[type] += 1;
 			}
 		}
 	}
 
 	return uses;
 }
+
+static bool preservesAllAnalyses(const Pass* pass)
+{
+	return pass->type == Pass::ImmutablePass ||
+		pass->type == Pass::ImmutableFunctionPass;
+}
+
+/*! \brief The up to date analyses of a single function.
+
+	Analyses are kept across passes until a pass that does not preserve
+	them runs, or until no remaining pass needs them.  Invalidating an
+	analysis also invalidates every cached analysis built on top of it.
 	
-static void freeUnusedDataStructures(PassUseCountMap& uses,
-	AnalysisMap& analyses, const Pass::StringVector& types)
+	The cache also records the passes that ran on the function, so that
+	getPass in a later wave finds the instance that actually ran on it.
+*/
+class AnalysisCache
 {
-	for(auto analysisType : types)
+public:
+	AnalysisCache(Function* f, const AnalysisDependenceMap& d,
+		const AnalysisUseCountMap& u)
+	: function(f), hits(0), misses(0), _dependences(&d), _uses(u)
+	{
+	
+	}
+	
+	~AnalysisCache()
 	{
-		auto use = uses.find(analysisType);
+		clear();
+	}
+
+public:
+	/*! \brief Make sure that the analyses used by a pass are up to date */
+	void allocate(const Pass* pass, PassManager* manager)
+	{
+		for(auto& type : pass->analyses)
+		{
+			_getOrCreate(type, manager);
+		}
+	}
+	
+	/*! \brief Drop analyses invalidated by a pass or no longer needed */
+	void release(const Pass* pass)
+	{
+		for(auto& type : getAllAnalyses(*_dependences, pass))
+		{
+			auto use = _uses.find(type);
+			assert(use != _uses.end() && use->second > 0);
+			
+			--use->second;
+		}
+		
+		StringVector unusable;
 		
-		assert(use != uses.end());
+		if(!preservesAllAnalyses(pass))
+		{
+			auto preserved = pass->getPreservedAnalyses();
+			
+			for(auto& analysis : analyses)
+			{
+				if(std::find(preserved.begin(), preserved.end(),
+					analysis.first) != preserved.end()) continue;
+				
+				unusable.push_back(analysis.first);
+			}
+		}
 		
-		if(use->second == 0)
+		for(auto& analysis : analyses)
 		{
-			report("  Freeing analysis " << analysisType);
-			uses.erase(use);
+			auto use = _uses.find(analysis.first);
 			
-			auto analysis = analyses.find(analysisType);
-			if(analysis != analyses.end())
+			if(use == _uses.end() || use->second == 0)
 			{
-				delete analysis->second;
+				unusable.push_back(analysis.first);
+			}
+		}
+		
+		for(auto& type : unusable)
+		{
+			invalidate(type);
+		}
+	}
 
-				analyses.erase(analysis);
+	/*! \brief Delete an analysis and the analyses that depend on it */
+	void invalidate(const std::string& type)
+	{
+		auto analysis = analyses.find(type);
+		if(analysis == analyses.end()) return;
+		
+		StringVector dependents;
+		
+		for(auto& cached : analyses)
+		{
+			auto& required = cached.second->required;
+			
+			if(std::find(required.begin(), required.end(), type) !=
+				required.end())
+			{
+				dependents.push_back(cached.first);
 			}
 		}
+		
+		for(auto& dependent : dependents)
+		{
+			invalidate(dependent);
+		}
+		
+		report("  Freeing analysis " << type);
+		
+		analysis = analyses.find(type);
+		assert(analysis != analyses.end());
+		
+		delete analysis->second;
+		analyses.erase(analysis);
 	}
-}
 
-static void allocateDependencies(PassUseCountMap& uses,
-	analysis::Analysis* newAnalysis,
-	AnalysisMap& analyses, Function* function, PassManager* manager);
+	void clear()
+	{
+		for(auto& analysis : analyses)
+		{
+			delete analysis.second;
+		}
+		
+		analyses.clear();
+	}
 
-static void allocateDataStructure(PassUseCountMap& uses,
-	const std::string& analysisType,
-	AnalysisMap& analyses, Function* function, PassManager* manager)
-{
-	if(analyses.count(analysisType) != 0) return;
+public:
+	AnalysisCache(const AnalysisCache&) = delete;
+	AnalysisCache& operator=(const AnalysisCache&) = delete;
 
-	report("  Creating analysis " << analysisType);
+public:
+	Function*   function;
+	AnalysisMap analyses;
 	
-	auto newAnalysis = analysis::AnalysisFactory::createAnalysis(analysisType);
-	assert(newAnalysis != nullptr);
-
-	newAnalysis->setPassManager(manager);
+	/*! \brief The passes that ran on this function, by name */
+	PassMap passes;
+	/*! \brief Per-function clones of passes, kept until the module is
+		finished so that later waves can still query them */
+	PassPointerVector clones;
+	
+	size_t hits;
+	size_t misses;
 
-	// allocate dependencies
-	allocateDependencies(uses, newAnalysis, analyses, function, manager);
+private:
+	void _getOrCreate(const std::string& type, PassManager* manager)
+	{
+		if(analyses.count(type) != 0)
+		{
+			++hits;
+			return;
+		}
+		
+		++misses;
+		
+		report("  Creating analysis " << type);
+		
+		auto newAnalysis = analysis::AnalysisFactory::createAnalysis(type);
+		assert(newAnalysis != nullptr);
+	
+		newAnalysis->setPassManager(manager);
+	
+		for(auto& requiredType : newAnalysis->required)
+		{
+			_getOrCreate(requiredType, manager);
+		}
+		
+		assert(newAnalysis->type == analysis::Analysis::FunctionAnalysis);
+	
+		auto functionAnalysis = static_cast<analysis::FunctionAnalysis*>(
+			newAnalysis);
 	
-	assert(newAnalysis->type == analysis::Analysis::FunctionAnalysis);
+		functionAnalysis->analyze(*function);
+		
+		analyses.insert(std::make_pair(type, newAnalysis));
+	}
 
-	auto functionAnalysis = static_cast<analysis::FunctionAnalysis*>(
-		newAnalysis);
+private:
+	const AnalysisDependenceMap* _dependences;
+	AnalysisUseCountMap          _uses;
 
-	functionAnalysis->analyze(*function);
+};
 
-	// free dependencies
-	freeUnusedDataStructures(uses, analyses, newAnalysis->required);
+typedef std::unique_ptr<AnalysisCache>  AnalysisCachePointer;
+typedef std::vector<AnalysisCachePointer> AnalysisCacheVector;
 
-	analyses.insert(std::make_pair(analysisType, newAnalysis));
-}
+/*! \brief The analyses and passes visible to one thread while it runs
+	passes on a single function.  Module passes run with a context that
+	has no cache.
 
-static void allocateDependencies(PassUseCountMap& uses,
-	analysis::Analysis* newAnalysis,
-	AnalysisMap& analyses, Function* function, PassManager* manager)
+	Contexts are kept in a per-thread stack so that a pass may run a
+	nested PassManager of its own.
+*/
+class ExecutionContext
 {
-	// increment use count
-	for(auto type : newAnalysis->required)
+public:
+	ExecutionContext(const PassManager* m, AnalysisCache* c)
+	: manager(m), cache(c), _previous(_current)
 	{
-		auto use = uses.find(type);
-			
-		report(" Recording future use of analysis " << type);
-		
-		if(use == uses.end())
-		{
-			uses.insert(std::make_pair(type, 1));
-		}
-		else
-		{
-			++use->second;
-		}
+		_current = this;
 	}
 	
-	// allocate dependencies
-	for(auto type : newAnalysis->required)
+	~ExecutionContext()
 	{
-		allocateDataStructure(uses, type, analyses, function, manager);
+		_current = _previous;
 	}
-}
 
-static void allocateNewDataStructures(PassUseCountMap& uses,
-	AnalysisMap& analyses, Function* function, const Pass::StringVector& types,
-	PassManager* manager)
-{
-	for(auto analysisType : types)
+public:
+	ExecutionContext(const ExecutionContext&) = delete;
+	ExecutionContext& operator=(const ExecutionContext&) = delete;
+
+public:
+	/*! \brief Get the innermost context on this thread for a manager */
+	static ExecutionContext* find(const PassManager* manager)
 	{
-		report(" Recording use of analysis " << analysisType);
-		
-		auto use = uses.find(analysisType);
-		
-		assert(use != uses.end());
-		
-		assert(use->second > 0);
-		
-		--use->second;
+		for(auto context = _current; context != nullptr;
+			context = context->_previous)
+		{
+			if(context->manager == manager) return context;
+		}
 		
-		allocateDataStructure(uses, analysisType, analyses, function, manager);
+		return nullptr;
 	}
-}
+
+public:
+	const PassManager* manager;
+	AnalysisCache*     cache;
+
+private:
+	ExecutionContext* _previous;
+
+private:
+	static thread_local ExecutionContext* _current;
+
+};
+
+thread_local ExecutionContext* ExecutionContext::_current = nullptr;
 
 static void runFunctionPass(Function* function, Pass* pass)
 {
@@ -417,7 +553,8 @@ static void runModulePass(Module* module, Pass* pass)
 }
 
 PassManager::PassManager(Module* module) :
-	_module(module), _analyses(0)
+	_module(module), _maximumThreadCount(1), _analysisCacheHits(0),
+	_analysisCacheMisses(0)
 {
 	assert(_module != 0);
 }
@@ -484,9 +621,14 @@ void PassManager::runOnFunction(Function& function)
 {
 	report("Running pass manager on function " << function.name());
 
+	util::MemoryPool::Scope scope(_module->memoryPool());
+
 	PassWaveList passes = _schedulePasses();
 	
-	PassUseCountMap passesUseCounts = getPassUseCounts(passes);
+	auto dependences = getAnalysisDependences(passes);
+	
+	AnalysisCache cache(&function, dependences,
+		getAnalysisUseCounts(passes, dependences));
 	
 	for(auto wave = passes.begin(); wave != passes.end(); ++wave)
 	{
@@ -495,125 +637,200 @@ void PassManager::runOnFunction(Function& function)
 			initializeFunctionPass(_module, *pass);
 		}
 	
-		AnalysisMap analyses;
-	
-		_analyses = &analyses;
-		_function = &function;
+		ExecutionContext context(this, &cache);
 	
 		for(auto pass = wave->begin(); pass != wave->end(); ++pass)
 		{
-			allocateNewDataStructures(passesUseCounts, analyses,
-				&function, (*pass)->analyses, this);
+			cache.allocate(*pass, this);
 		
 			runFunctionPass(&function, *pass);
-			_previouslyRunPasses[(*pass)->name] = *pass;
+			cache.passes[(*pass)->name] = *pass;
 			
-			freeUnusedDataStructures(passesUseCounts, analyses,
-			 	(*pass)->analyses);
+			cache.release(*pass);
 		}
 
 		for(auto pass = wave->begin(); pass != wave->end(); ++pass)
 		{
 			finalizeFunctionPass(_module, *pass);
 		}
-
-		_analyses = 0;
-		_function = 0;
 	}
 	
+	_recordAnalysisCacheStatistics(cache.hits, cache.misses);
+	
 	_previouslyRunPasses.clear();
 }
 
-void PassManager::runOnModule()
+static bool isFunctionLevelPass(const Pass* pass)
 {
-	report("Running pass manager on module " << _module->name);
+	return pass->type == Pass::FunctionPass ||
+		pass->type == Pass::ImmutableFunctionPass ||
+		pass->type == Pass::BasicBlockPass;
+}
 
-	typedef std::map<std::string, AnalysisMap> AnalysisMapMap;
+static void runFunctionPasses(Module* module, AnalysisCache& cache,
+	const PassVector& passes, bool clonePasses, PassManager* manager)
+{
+	// Concurrent functions must not share pass state
+	PassVector instances = passes;
 	
-	AnalysisMapMap functionAnalyses;
+	if(clonePasses)
+	{
+		for(auto& pass : instances)
+		{
+			pass = pass->clone();
+			pass->setPassManager(manager);
+			
+			cache.clones.push_back(std::unique_ptr<Pass>(pass));
+		}
+	}
+	
+	for(auto pass : instances)
+	{
+		initializeFunctionPass(module, pass);
+	}
+
+	ExecutionContext context(manager, &cache);
+	
+	for(auto pass : instances)
+	{
+		cache.allocate(pass, manager);
+	
+		runFunctionPass(module, cache.function, pass);
+		cache.passes[pass->name] = pass;
 	
+		cache.release(pass);
+	}
+
+	for(auto pass : instances)
+	{
+		finalizeFunctionPass(module, pass);
+	}
+}
+
+void PassManager::runOnModule()
+{
+	report("Running pass manager on module " << _module->name);
+
+	util::MemoryPool::Scope scope(_module->memoryPool());
+
 	PassWaveList passes = _schedulePasses();
 
-	PassUseCountMap passesUseCounts = getPassUseCounts(passes, *_module);
+	auto dependences = getAnalysisDependences(passes);
+	auto uses        = getAnalysisUseCounts(passes, dependences);
+	
+	AnalysisCacheVector caches;
+	
+	caches.reserve(_module->size());
+	
+	for(auto function = _module->begin();
+		function != _module->end(); ++function)
+	{
+		caches.push_back(AnalysisCachePointer(
+			new AnalysisCache(&*function, dependences, uses)));
+	}
+	
+	unsigned int threads = _maximumThreadCount == 0 ?
+		util::defaultThreadCount() : _maximumThreadCount;
+	
+	bool clonePasses = threads > 1 && caches.size() > 1;
+	
+	report(" Using " << threads << " worker threads");
 	
 	// Run waves in order
 	for(auto wave = passes.begin(); wave != passes.end(); ++wave)
 	{
+		PassVector functionPasses;
+	
 		// Run all module passes first
 		for(auto pass = wave->begin(); pass != wave->end(); ++pass)
 		{
-			if((*pass)->type == Pass::FunctionPass)   continue;
-			if((*pass)->type == Pass::BasicBlockPass) continue;
+			if(isFunctionLevelPass(*pass))
+			{
+				functionPasses.push_back(*pass);
+				continue;
+			}
 		
-			for(auto function = _module->begin();
-				function != _module->end(); ++function)
+			for(auto& cache : caches)
 			{
-				auto analyses = functionAnalyses.insert(std::make_pair(
-					function->name(), AnalysisMap())).first;
-				
-				allocateNewDataStructures(passesUseCounts, analyses->second,
-					&*function, (*pass)->analyses, this);
+				ExecutionContext context(this, cache.get());
+			
+				cache->allocate(*pass, this);
 			}
 			
 			_previouslyRunPasses[(*pass)->name] = *pass;
 			
-			runModulePass(_module, *pass);
-		}
-	
-		// Run all function and bb passes
-		for(auto function = _module->begin();
-			function != _module->end(); ++function)
-		{
-			for(auto pass = wave->begin(); pass != wave->end(); ++pass)
-			{
-				initializeFunctionPass(_module, *pass);
-			}
-		
-			auto analyses = functionAnalyses.insert(std::make_pair(
-					function->name(), AnalysisMap())).first;
-				
-			_analyses = &analyses->second;
-			_function = &*function;
-		
-			for(auto pass = wave->begin(); pass != wave->end(); ++pass)
 			{
-				if((*pass)->type == Pass::ImmutablePass) continue;
-				if((*pass)->type == Pass::ModulePass)    continue;
-			
-				allocateNewDataStructures(passesUseCounts, analyses->second,
-					&*function, (*pass)->analyses, this);
-			
-				runFunctionPass(_module, &*function, *pass);
-				_previouslyRunPasses[(*pass)->name] = *pass;
+				ExecutionContext context(this, nullptr);
 			
-				freeUnusedDataStructures(passesUseCounts, analyses->second,
-					(*pass)->analyses);
+				runModulePass(_module, *pass);
 			}
-
-			for(auto pass = wave->begin(); pass != wave->end(); ++pass)
+			
+			for(auto& cache : caches)
 			{
-				finalizeFunctionPass(_module, *pass);
+				cache->release(*pass);
 			}
+		}
+		
+		if(functionPasses.empty()) continue;
+	
+		// Run all function and bb passes, each function is independent
+		util::parallelFor(caches.size(), threads, [&](size_t i)
+		{
+			util::MemoryPool::Scope scope(_module->memoryPool());
+
+			runFunctionPasses(_module, *caches[i], functionPasses,
+				clonePasses, this);
+		});
+		
+		// Clones ran instead of the original passes, they are only
+		//  visible to later passes on the same function
+		if(clonePasses) continue;
 		
-			_analyses = 0;
-			_function = 0;
+		for(auto pass : functionPasses)
+		{
+			_previouslyRunPasses[pass->name] = pass;
 		}
 	}
 	
+	for(auto& cache : caches)
+	{
+		_recordAnalysisCacheStatistics(cache->hits, cache->misses);
+	}
+	
 	_previouslyRunPasses.clear();
 }
 
+void PassManager::setMaximumThreadCount(unsigned int threads)
+{
+	_maximumThreadCount = threads;
+}
+
+unsigned int PassManager::getMaximumThreadCount() const
+{
+	return _maximumThreadCount;
+}
+
+size_t PassManager::getAnalysisCacheHits() const
+{
+	return _analysisCacheHits;
+}
+
+size_t PassManager::getAnalysisCacheMisses() const
+{
+	return _analysisCacheMisses;
+}
+
 PassManager::Analysis* PassManager::getAnalysis(const std::string& type)
 {
-	assert(_analyses != 0);
+	auto context = ExecutionContext::find(this);
 
-	AnalysisMap::iterator analysis = _analyses->find(type);
-	if(analysis == _analyses->end())
-	{
-		analysis = _analyses->find(type);
-	}
-	
-	if(analysis == _analyses->end()) return 0;
+	// Module passes do not run on a function, so they have no analyses
+	if(context == nullptr || context->cache == nullptr) return nullptr;
+
+	auto& analyses = context->cache->analyses;
+
+	AnalysisMap::iterator analysis = analyses.find(type);
+	if(analysis == analyses.end()) return 0;
 		
 	return analysis->second;
 }
@@ -621,25 +838,28 @@ PassManager::Analysis* PassManager::getAnalysis(const std::string& type)
 const PassManager::Analysis* PassManager::getAnalysis(
 	const std::string& type) const
 {
-	assert(_analyses != 0);
+	auto context = ExecutionContext::find(this);
+
+	// Module passes do not run on a function, so they have no analyses
+	if(context == nullptr || context->cache == nullptr) return nullptr;
 
-	AnalysisMap::const_iterator analysis = _analyses->find(type);
-	if(analysis == _analyses->end()) return 0;
+	auto& analyses = context->cache->analyses;
+
+	AnalysisMap::const_iterator analysis = analyses.find(type);
+	if(analysis == analyses.end()) return 0;
 	
 	return analysis->second;
 }
 
 void PassManager::invalidateAnalysis(const std::string& type)
 {
-	assert(_analyses != 0);
+	auto context = ExecutionContext::find(this);
 
-	AnalysisMap::iterator analysis = _analyses->find(type);
-	if(analysis != _analyses->end())
-	{
-		report("Invalidating analysis " << type);
-		delete analysis->second;
-		_analyses->erase(analysis);
-	}
+	if(context == nullptr || context->cache == nullptr) return;
+
+	report("Invalidating analysis " << type);
+	
+	context->cache->invalidate(type);
 }
 
 static bool passContainsClass(const Pass& pass, const std::string& className)
@@ -652,12 +872,12 @@ static bool passContainsClass(const Pass& pass, const std::string& className)
 	return false;
 }
 
-Pass* PassManager::getPass(const std::string& name)
+static Pass* findPass(const PassMap& passes, const std::string& name)
 {
-	auto pass = _previouslyRunPasses.find(name);
-	if(pass != _previouslyRunPasses.end()) return pass->second;
+	auto pass = passes.find(name);
+	if(pass != passes.end()) return pass->second;
 	
-	for(auto pass : _previouslyRunPasses)
+	for(auto pass : passes)
 	{
 		if(passContainsClass(*pass.second, name))
 		{
@@ -668,20 +888,25 @@ Pass* PassManager::getPass(const std::string& name)
 	return nullptr;
 }
 
+Pass* PassManager::getPass(const std::string& name)
+{
+	return const_cast<Pass*>(
+		static_cast<const PassManager*>(this)->getPass(name));
+}
+
 const Pass* PassManager::getPass(const std::string& name) const
 {
-	auto pass = _previouslyRunPasses.find(name);
-	if(pass != _previouslyRunPasses.end()) return pass->second;
+	// Passes run on the current function take precedence
+	auto context = ExecutionContext::find(this);
 	
-	for(auto pass : _previouslyRunPasses)
+	if(context != nullptr && context->cache != nullptr)
 	{
-		if(passContainsClass(*pass.second, name))
-		{
-			return pass.second;
-		}
+		auto pass = findPass(context->cache->passes, name);
+		
+		if(pass != nullptr) return pass;
 	}
 	
-	return nullptr;
+	return findPass(_previouslyRunPasses, name);
 }
 
 PassManager::PassWaveList PassManager::_schedulePasses()
@@ -849,6 +1074,14 @@ PassManager::PassWaveList PassManager::_schedulePasses()
 	return scheduled;
 }
 
+void PassManager::_recordAnalysisCacheStatistics(size_t hits, size_t misses)
+{
+	report(" Analysis cache hits: " << hits << ", misses: " << misses);
+	
+	_analysisCacheHits   += hits;
+	_analysisCacheMisses += misses;
+}
+
 Pass::StringVector PassManager::_getAllDependentPasses(Pass* pass)
 {
 	Pass::StringVector dependentPasses = pass->getDependentPasses();
@@ -1 +1,56 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   ConstantPropagationPass.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ConstantPropagationPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Sparse conditional constant propagation.
+
+	Values start out undefined and are only lowered to a constant or
+	overdefined when an executable instruction defines them, so constants
+	flow through branches that are folded along the way.  Integer
+	arithmetic, casts, and comparisons are folded, constant uses are
+	replaced with immediates, branches with a constant predicate are
+	folded, and blocks that can never execute are deleted.
+
+	The pass expects SSA form (see ConvertToSSAPass), values with more than
+	one definition are never considered constant.
+*/
+class ConstantPropagationPass : public FunctionPass
+{
+public:
+	ConstantPropagationPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+
+private:
+	class Solver;
+
+private:
+	unsigned int _replaceConstantUses(Function& f, const Solver& solver);
+	unsigned int _removeConstantDefinitions(Function& f,
+		const Solver& solver);
+	unsigned int _foldBranches(Function& f);
+	unsigned int _removeUnreachableBlocks(Function& f, const Solver& solver);
+
+};
+
+}
+
+}
+
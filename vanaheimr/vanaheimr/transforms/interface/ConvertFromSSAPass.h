@@ -29,6 +29,9 @@ public:
 public:
 	virtual Pass* clone() const;
 
+public:
+	virtual StringVector getPreservedAnalyses() const;
+
 private:
 	void _removePhis(Function& f);
 	void _removePsis(Function& f);
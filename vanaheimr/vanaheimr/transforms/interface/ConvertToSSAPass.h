@@ -43,6 +43,9 @@ public:
 public:
 	virtual Pass* clone() const;
 
+public:
+	virtual StringVector getPreservedAnalyses() const;
+
 private:
 	typedef ir::VirtualRegister VirtualRegister;
 	typedef ir::BasicBlock      BasicBlock;
@@ -1 +1,82 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   GlobalValueNumberingPass.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the GlobalValueNumberingPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class VirtualRegister; } }
+namespace vanaheimr { namespace ir { class BasicBlock;      } }
+
+namespace vanaheimr { namespace analysis { class DominatorAnalysis; } }
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Remove instructions that recompute a value that is already
+	available, using hash-based value numbering scoped by the dominator tree.
+
+	The blocks are visited in a preorder walk of the dominator tree, so
+	a value found in the table always dominates the redundant instruction.
+	Siblings are visited in reverse post order, so the sources of a phi are
+	numbered before the phi unless they flow around a loop.
+	The pass expects SSA form (see ConvertToSSAPass), values with more than
+	one definition are left alone.
+*/
+class GlobalValueNumberingPass : public FunctionPass
+{
+public:
+	GlobalValueNumberingPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+
+public:
+	virtual StringVector getPreservedAnalyses() const;
+
+private:
+	class ValueTable;
+
+private:
+	typedef ir::VirtualRegister VirtualRegister;
+	typedef ir::BasicBlock      BasicBlock;
+
+	typedef std::vector<VirtualRegister*> VirtualRegisterVector;
+	typedef std::vector<unsigned int>     OrderVector;
+
+private:
+	unsigned int _numberValues(BasicBlock& entry, ValueTable& table,
+		const analysis::DominatorAnalysis& dominators);
+	unsigned int _numberBlock(BasicBlock& block, ValueTable& table);
+
+	void _replaceUses(Function& f);
+
+private:
+	unsigned int _getOrder(const BasicBlock& block) const;
+
+private:
+	/*! \brief The value that replaces each value, indexed by id */
+	VirtualRegisterVector _leaders;
+
+	/*! \brief The reverse post order position of each block, by id */
+	OrderVector _order;
+};
+
+}
+
+}
+
@@ -1 +1,60 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   LoopUnrollingPass.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the LoopUnrollingPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+
+// Standard Library Includes
+#include <vector>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Unroll innermost single block loops with a known trip count.
+
+	Loops that fit within the size limit are fully unrolled, the branch
+	and the exit test are removed.  Larger loops are unrolled by a factor
+	that evenly divides the trip count, keeping one exit test for each
+	group of iterations.
+
+	Registers are reused by the copies, so the pass runs before
+	ConvertToSSAPass, loops with phis are left alone.
+*/
+class LoopUnrollingPass : public FunctionPass
+{
+public:
+	LoopUnrollingPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+
+private:
+	typedef analysis::LoopAnalysis::Loop Loop;
+
+	typedef std::vector<unsigned int> CountVector;
+
+private:
+	/*! \brief The number of copies of the body, 0 to leave the loop */
+	unsigned int _getUnrollFactor(const Loop& loop) const;
+
+	void _unroll(Loop& loop, unsigned int factor, const CountVector& uses);
+
+};
+
+}
+
+}
+
@@ -92,6 +92,17 @@ public:
 	/*! \brief Get a list of passes that this pass depends on */
 	virtual StringVector getDependentPasses() const;
 
+	/*! \brief Get a list of analyses that are still up to date after the
+		pass runs, all others are invalidated.  Immutable passes
+		preserve every analysis. */
+	virtual StringVector getPreservedAnalyses() const;
+
+protected:
+	/*! \brief The analyses that only depend on the control flow graph, a
+		pass that does not add, remove, or reconnect blocks can return
+		these from getPreservedAnalyses */
+	static StringVector getControlFlowAnalyses();
+
 public:
 	/*! \brief Configure the pass given a list of options */
 	virtual void configure(const StringVector& options);
@@ -25,7 +25,12 @@ namespace vanaheimr
 namespace transforms
 {
 
-/*! \brief A class to orchestrate the execution of many passes */
+/*! \brief A class to orchestrate the execution of many passes
+
+	Function analyses are cached per function.  An analysis stays valid
+	until a pass that does not list it in Pass::getPreservedAnalyses runs,
+	or until no remaining pass needs it.
+*/
 class PassManager
 {
 public:
@@ -93,22 +98,59 @@ public:
 	*/
 	void runOnFunction(Function& function);
 	
-	/*! \brief Runs passes on the entire module. */
+	/*! \brief Runs passes on the entire module.
+	
+		Within each wave, function and basic block passes are run on
+		different functions concurrently, see setMaximumThreadCount.
+	*/
 	void runOnModule();
 
 public:
-	/*! \brief Get an up to date analysis by type */
+	/*! \brief Limit the number of worker threads used by runOnModule.
+	
+		1 (the default) runs everything serially on the calling thread,
+		0 uses one worker per hardware thread.
+		
+		When more than one worker is used, every function gets its own
+		clone of each function-level pass and its own set of analyses.
+		
+		Passes that use util::parallelFor themselves share this limit,
+		the threads are split among the functions that run at once.
+	*/
+	void setMaximumThreadCount(unsigned int threads);
+	
+	/*! \brief Get the worker thread limit */
+	unsigned int getMaximumThreadCount() const;
+
+public:
+	/*! \brief The number of analysis requests served from the cache */
+	size_t getAnalysisCacheHits() const;
+	
+	/*! \brief The number of analyses that had to be computed */
+	size_t getAnalysisCacheMisses() const;
+
+public:
+	/*! \brief Get an up to date analysis by type, module passes do not
+		run on a function and always get nullptr */
 	Analysis* getAnalysis(const std::string& type);
 
 	/*! \brief Get an up to date analysis by type (const) */
 	const Analysis* getAnalysis(const std::string& type) const;
 	
-	/*! \brief Invalidate the analysis, the pass manager will
-		need to generate it again the next time 'get' is called */
+	/*! \brief Invalidate the analysis (and any analyses built on it), the
+		pass manager will need to generate it again the next time it is
+		required */
 	void invalidateAnalysis(const std::string& type);
 
 public:
-	/*! \brief Get a previously run pass by name */
+	/*! \brief Get a previously run pass by name
+	
+		From a function-level pass, this is the instance that ran on the
+		current function, in this or an earlier wave.  With one worker
+		that instance is shared by every function and has run on all of
+		them, so a pass that is queried from a later wave must keep its
+		results per function.
+	*/
 	Pass* getPass(const std::string& name);
 
 	/*! \brief Get a previously run pass by name (const) */
@@ -130,14 +172,20 @@ private:
 	StringVector _getAllDependentPasses(Pass* p);
 	Pass*        _findPass(const std::string& name);
 
+private:
+	void _recordAnalysisCacheStatistics(size_t hits, size_t misses);
+
 private:
 	PassVector    _passes;
 	Module*       _module;
-	Function*     _function;
-	AnalysisMap*  _analyses;
 	PassVector    _ownedTemporaryPasses;
 	DependenceMap _extraDependences;
 	PassMap       _previouslyRunPasses;
+	unsigned int  _maximumThreadCount;
+
+private:
+	size_t _analysisCacheHits;
+	size_t _analysisCacheMisses;
 };
 
 }
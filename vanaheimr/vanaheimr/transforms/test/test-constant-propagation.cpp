@@ -0,0 +1,390 @@
+/*! \file   test-constant-propagation.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for sparse conditional constant propagation and the
+		removal of unreachable blocks.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <set>
+#include <string>
+
+namespace test
+{
+
+/*! \brief Constant branches in both directions, and a phi that merges a
+	constant with a value from a block that never executes
+
+	A: a = 3 + 4; b = a * 2; p = b < 10; bra p, C
+	B: x = b + 1; bra D
+	C: y = b - 1
+	D: m = phi [x, B], [y, C]; q = a < 10; bra q, F
+	E: st [ptr], 0
+	F: st [ptr], m
+
+	ptr is never defined, so it is not a constant.
+*/
+static TestFunction generateFunction(Module& module)
+{
+	typedef vanaheimr::ir::Add Add;
+	typedef vanaheimr::ir::Mul Mul;
+	typedef vanaheimr::ir::Sub Sub;
+
+	auto test = newTestFunction(module, "constant-branches");
+
+	newValues(test, "i32", {"a", "b", "x", "y", "m"});
+	newValues(test, "i64", {"ptr"});
+	newValues(test, "i1",  {"p", "q"});
+	newBlocks(test, {"A", "B", "C", "D", "E", "F"});
+
+	auto& values = test.values;
+	auto& blocks = test.blocks;
+
+	binary<Add>(blocks["A"], values, "a", "3", "4");
+	binary<Mul>(blocks["A"], values, "b", "a", "2");
+	setp(blocks["A"], values, "p", "b", "10");
+	branch(blocks["A"], blocks["C"], values["p"]);
+
+	binary<Add>(blocks["B"], values, "x", "b", "1");
+	branch(blocks["B"], blocks["D"]);
+
+	binary<Sub>(blocks["C"], values, "y", "b", "1");
+
+	auto phi = new vanaheimr::ir::Phi(blocks["D"]);
+
+	guard(phi);
+	phi->setD(use(values["m"], phi));
+	phi->addSource(use(values["x"], phi),
+		new vanaheimr::ir::AddressOperand(blocks["B"], phi));
+	phi->addSource(use(values["y"], phi),
+		new vanaheimr::ir::AddressOperand(blocks["C"], phi));
+
+	blocks["D"]->push_back(phi);
+
+	setp(blocks["D"], values, "q", "a", "10");
+	branch(blocks["D"], blocks["F"], values["q"]);
+
+	store(blocks["E"], values, "ptr", "0");
+
+	store(blocks["F"], values, "ptr", "m");
+
+	return test;
+}
+
+/*! \brief The same constant defined on both sides of a diamond, which is
+	merged by a phi once the function is converted to SSA form
+
+	A: ptr = 4096 + 0; base = ld [ptr]; a = 3 + 4; p = base < 16; bra p, C
+	B: x = a + 1; bra D
+	C: x = a + 1
+	D: y = x * 2; st [ptr], y
+*/
+static TestFunction generateDiamond(Module& module)
+{
+	typedef vanaheimr::ir::Add Add;
+	typedef vanaheimr::ir::Mul Mul;
+
+	auto test = newTestFunction(module, "diamond");
+
+	newValues(test, "i64", {"ptr", "base", "a", "x", "y"});
+	newValues(test, "i1",  {"p"});
+	newBlocks(test, {"A", "B", "C", "D"});
+
+	auto& values = test.values;
+	auto& blocks = test.blocks;
+
+	binary<Add>(blocks["A"], values, "ptr", "4096", "0");
+	load(blocks["A"], values, "base", "ptr");
+	binary<Add>(blocks["A"], values, "a", "3", "4");
+	setp(blocks["A"], values, "p", "base", "16");
+	branch(blocks["A"], blocks["C"], values["p"]);
+
+	binary<Add>(blocks["B"], values, "x", "a", "1");
+	branch(blocks["B"], blocks["D"]);
+
+	binary<Add>(blocks["C"], values, "x", "a", "1");
+
+	binary<Mul>(blocks["D"], values, "y", "x", "2");
+	store(blocks["D"], values, "ptr", "y");
+
+	return test;
+}
+
+static void printFunction(const Function& function)
+{
+	for(auto& block : function)
+	{
+		std::cout << "  " << block.name() << " (" << block.id() << "):\n";
+
+		for(auto instruction : block)
+		{
+			std::cout << "   " << instruction->toString() << "\n";
+		}
+	}
+}
+
+static bool hasUniqueIds(const Function& function)
+{
+	std::set<unsigned int> ids;
+
+	for(auto& block : function)
+	{
+		if(block.id() >= function.size()) return false;
+
+		ids.insert(block.id());
+	}
+
+	return ids.size() == function.size();
+}
+
+static bool contains(const Function& function, const BasicBlock* block)
+{
+	for(auto& remaining : function)
+	{
+		if(&remaining == block) return true;
+	}
+
+	return false;
+}
+
+static bool testPropagation(bool verbose)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-constant-propagation");
+
+	auto test = generateFunction(*module);
+
+	auto& function = *module->getFunction("constant-branches");
+
+	runPass(*module, "sccp");
+
+	if(verbose) printFunction(function);
+
+	bool passed = true;
+
+	// C is only reached by a branch that is never taken, E is skipped by
+	//  one that is always taken
+	for(auto name : {"C", "E"})
+	{
+		if(contains(function, test.blocks[name]))
+		{
+			std::cout << " unreachable block " << name << " was kept\n";
+			passed = false;
+		}
+	}
+
+	if(function.size() != 6)
+	{
+		std::cout << " the function has " << function.size()
+			<< " blocks, not 6\n";
+		passed = false;
+	}
+
+	if(!hasUniqueIds(function))
+	{
+		std::cout << " block ids are not unique and less than the block "
+			"count after blocks were erased\n";
+		passed = false;
+	}
+
+	// phis and memory instructions keep register sources, all other
+	//  constant sources are replaced
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			if(instruction->isBranch() &&
+				!instruction->guard()->isAlwaysTrue())
+			{
+				std::cout << " '" << instruction->toString()
+					<< "' is still conditional\n";
+				passed = false;
+			}
+
+			if(instruction->isPhi() || instruction->accessesMemory())
+			{
+				continue;
+			}
+
+			for(auto read : instruction->reads)
+			{
+				if(!read->isRegister()) continue;
+
+				std::cout << " '" << instruction->toString()
+					<< "' still reads a register\n";
+				passed = false;
+			}
+		}
+	}
+
+	// the phi only merges the value from B, x = 2 * 7 + 1
+	auto& d = *test.blocks["D"];
+
+	auto phi = d.empty() ? nullptr :
+		static_cast<vanaheimr::ir::Phi*>(d.front());
+
+	if(phi == nullptr || !phi->isPhi() || phi->blocks().size() != 1 ||
+		phi->blocks().front() != test.blocks["B"])
+	{
+		std::cout << " the phi in D still has a source from C\n";
+		passed = false;
+	}
+
+	auto& b = *test.blocks["B"];
+
+	auto add = b.empty() ? nullptr :
+		static_cast<vanaheimr::ir::Add*>(b.front());
+
+	if(add == nullptr || add->opcode != Instruction::Add ||
+		!add->a()->isConstant() ||
+		static_cast<vanaheimr::ir::ImmediateOperand*>(
+			add->a())->uint != 14)
+	{
+		std::cout << " b was not replaced by 14 in B\n";
+		passed = false;
+	}
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+static bool testAfterConvertToSSA(bool verbose)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-constant-propagation-ssa");
+
+	auto test = generateDiamond(*module);
+
+	auto& function = *module->getFunction("diamond");
+
+	runPass(*module, "ConvertToSSA");
+	runPass(*module, "sccp");
+
+	if(verbose) printFunction(function);
+
+	bool passed = true;
+
+	// the branch depends on a load, so both sides execute
+	for(auto name : {"B", "C"})
+	{
+		if(!contains(function, test.blocks[name]))
+		{
+			std::cout << " reachable block " << name << " was removed\n";
+			passed = false;
+		}
+	}
+
+	// both sources of the phi for x are 8, so y = 8 * 2 is a constant
+	for(auto instruction : *test.blocks["D"])
+	{
+		if(instruction->isPhi() || instruction->accessesMemory()) continue;
+
+		for(auto read : instruction->reads)
+		{
+			if(!read->isRegister()) continue;
+
+			std::cout << " '" << instruction->toString()
+				<< "' still reads a register after conversion to SSA\n";
+			passed = false;
+		}
+	}
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+/*! \brief Erasing a block gives its id to the block with the highest id */
+static bool testErase()
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-function-erase");
+
+	auto function = module->newFunction("blocks",
+		vanaheimr::ir::Variable::ExternalLinkage,
+		vanaheimr::ir::Variable::HiddenVisibility);
+
+	auto first  = function->newBasicBlock(function->exit_block(), "first");
+	auto second = function->newBasicBlock(function->exit_block(), "second");
+	auto last   = function->newBasicBlock(function->exit_block(), "last");
+
+	auto erasedId = second->id();
+
+	function->erase(second);
+
+	bool passed = true;
+
+	if(last->id() != erasedId || first->id() == erasedId)
+	{
+		std::cout << " the last block did not take the erased id\n";
+		passed = false;
+	}
+
+	auto added = function->newBasicBlock(function->exit_block(), "added");
+
+	if(!hasUniqueIds(*function) || added->id() != function->size() - 1)
+	{
+		std::cout << " a block added after erasing reused an id\n";
+		passed = false;
+	}
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program propagates constants through branches "
+		"and a phi and checks which blocks and values are left.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testErase())
+	{
+		std::cout << "Constant propagation test Failed\n";
+		return -1;
+	}
+
+	if(!test::testPropagation(verbose))
+	{
+		std::cout << "Constant propagation test Failed\n";
+		return -1;
+	}
+
+	if(!test::testAfterConvertToSSA(verbose))
+	{
+		std::cout << "Constant propagation after SSA conversion test "
+			"Failed\n";
+		return -1;
+	}
+
+	std::cout << "Constant propagation test Passed\n";
+
+	return 0;
+}
+
@@ -0,0 +1,339 @@
+/*! \file   test-global-value-numbering.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for dominator-scoped global value numbering of redundant
+		address arithmetic.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace test
+{
+
+/*! \brief Addresses of the form base + tid * 4 recomputed in a diamond
+
+	A: ptr = 4096 + 0; base = ld [ptr]; tid = ld [ptr + 8];
+	   off1 = tid * 4; addr1 = base + off1; x = ld [addr1];
+	   off2 = 4 * tid; addr2 = off2 + base; y = ld [addr2 + 4];
+	   p = x < y; bra p, C
+	B: off3 = tid * 4; addr3 = base + off3; st [addr3], x; bra D
+	C: off4 = tid * 8; q = base + off4; st [q], y
+	D: off5 = tid * 4; z = base + off5; s = tid * 8; w = base + s;
+	   @p g = base + off1; st [w], z; st [g], x
+*/
+static TestFunction generateFunction(Module& module)
+{
+	typedef vanaheimr::ir::Add Add;
+	typedef vanaheimr::ir::Mul Mul;
+
+	auto test = newTestFunction(module, "address-arithmetic");
+
+	newValues(test, "i64", {"ptr", "base", "tid", "off1", "addr1", "x",
+		"off2", "addr2", "y", "off3", "addr3", "off4", "q", "off5", "z", "s",
+		"w", "g"});
+	newValues(test, "i1", {"p"});
+	newBlocks(test, {"A", "B", "C", "D"});
+
+	auto& values = test.values;
+	auto& blocks = test.blocks;
+
+	auto a = blocks["A"];
+
+	binary<Add>(a, values, "ptr", "4096", "0");
+	load(a, values, "base", "ptr");
+	load(a, values, "tid", "ptr", 8);
+	binary<Mul>(a, values, "off1", "tid", "4");
+	binary<Add>(a, values, "addr1", "base", "off1");
+	load(a, values, "x", "addr1");
+	binary<Mul>(a, values, "off2", "4", "tid");
+	binary<Add>(a, values, "addr2", "off2", "base");
+	load(a, values, "y", "addr2", 4);
+	setp(a, values, "p", "x", "y");
+	branch(a, blocks["C"], values["p"]);
+
+	auto b = blocks["B"];
+
+	binary<Mul>(b, values, "off3", "tid", "4");
+	binary<Add>(b, values, "addr3", "base", "off3");
+	store(b, values, "addr3", "x");
+	branch(b, blocks["D"]);
+
+	auto c = blocks["C"];
+
+	binary<Mul>(c, values, "off4", "tid", "8");
+	binary<Add>(c, values, "q", "base", "off4");
+	store(c, values, "q", "y");
+
+	auto d = blocks["D"];
+
+	binary<Mul>(d, values, "off5", "tid", "4");
+	binary<Add>(d, values, "z", "base", "off5");
+	binary<Mul>(d, values, "s", "tid", "8");
+	binary<Add>(d, values, "w", "base", "s");
+	binary<Add>(d, values, "g", "base", "off1", values["p"]);
+	store(d, values, "w", "z");
+	store(d, values, "g", "x");
+
+	return test;
+}
+
+/*! \brief A value defined on both sides of a diamond, which needs a phi and
+	leaves gaps in the register ids once it is converted to SSA form
+
+	A: ptr = 4096 + 0; base = ld [ptr]; p = base < 16; bra p, C
+	B: x = base + 1; bra D
+	C: x = base + 2
+	D: y = x + base; z = base + x; st [ptr], y; st [ptr], z
+*/
+static TestFunction generateDiamond(Module& module)
+{
+	auto test = newTestFunction(module, "diamond");
+
+	newValues(test, "i64", {"ptr", "base", "x", "y", "z"});
+	newValues(test, "i1", {"p"});
+	newBlocks(test, {"A", "B", "C", "D"});
+
+	auto& values = test.values;
+	auto& blocks = test.blocks;
+
+	auto a = blocks["A"];
+
+	add(a, values, "ptr", "4096", "0");
+	load(a, values, "base", "ptr");
+	setp(a, values, "p", "base", "16");
+	branch(a, blocks["C"], values["p"]);
+
+	auto b = blocks["B"];
+
+	add(b, values, "x", "base", "1");
+	branch(b, blocks["D"]);
+
+	add(blocks["C"], values, "x", "base", "2");
+
+	auto d = blocks["D"];
+
+	add(d, values, "y", "x", "base");
+	add(d, values, "z", "base", "x");
+	store(d, values, "ptr", "y");
+	store(d, values, "ptr", "z");
+
+	return test;
+}
+
+static void printFunction(const Function& function)
+{
+	for(auto& block : function)
+	{
+		std::cout << "  " << block.name() << ":\n";
+
+		for(auto instruction : block)
+		{
+			std::cout << "   " << instruction->toString() << "\n";
+		}
+	}
+}
+
+static bool writes(const Instruction* instruction, const VirtualRegister* value)
+{
+	for(auto write : instruction->writes)
+	{
+		if(!write->isRegister()) continue;
+
+		if(static_cast<vanaheimr::ir::RegisterOperand*>(
+			write)->virtualRegister == value)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool reads(const Instruction* instruction, const VirtualRegister* value)
+{
+	for(auto read : instruction->reads)
+	{
+		if(!read->isRegister()) continue;
+
+		if(static_cast<vanaheimr::ir::RegisterOperand*>(
+			read)->virtualRegister == value)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool isDefined(const Function& function, const VirtualRegister* value)
+{
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			if(writes(instruction, value)) return true;
+		}
+	}
+
+	return false;
+}
+
+static bool isRead(const Function& function, const VirtualRegister* value)
+{
+	for(auto& block : function)
+	{
+		for(auto instruction : block)
+		{
+			if(reads(instruction, value)) return true;
+		}
+	}
+
+	return false;
+}
+
+static bool testGlobalValueNumbering(bool verbose)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-global-value-numbering");
+
+	auto test = generateFunction(*module);
+
+	runPass(*module, "gvn");
+
+	auto& function = *module->getFunction("address-arithmetic");
+
+	if(verbose) printFunction(function);
+
+	bool passed = true;
+
+	// recomputations of off1 and addr1 in dominated blocks are removed,
+	//  including the commuted forms
+	for(auto name : {"off2", "addr2", "off3", "addr3", "off5", "z"})
+	{
+		auto value = test.values[name];
+
+		if(isDefined(function, value) || isRead(function, value))
+		{
+			std::cout << " " << name << " was not replaced\n";
+			passed = false;
+		}
+	}
+
+	// C does not dominate D, and g is predicated
+	for(auto name : {"off1", "addr1", "off4", "q", "s", "w", "g"})
+	{
+		if(!isDefined(function, test.values[name]))
+		{
+			std::cout << " " << name << " was removed\n";
+			passed = false;
+		}
+	}
+
+	std::map<std::string, size_t> sizes = {{"A", 9}, {"B", 2}, {"C", 3},
+		{"D", 5}};
+
+	for(auto& size : sizes)
+	{
+		auto block = test.blocks[size.first];
+
+		if(block->size() != size.second)
+		{
+			std::cout << " block " << size.first << " has " << block->size()
+				<< " instructions, not " << size.second << "\n";
+			passed = false;
+		}
+	}
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+static bool testAfterConvertToSSA(bool verbose)
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-global-value-numbering-ssa");
+
+	auto test = generateDiamond(*module);
+
+	runPass(*module, "ConvertToSSA");
+	runPass(*module, "gvn");
+
+	auto& function = *module->getFunction("diamond");
+
+	if(verbose) printFunction(function);
+
+	bool passed = true;
+
+	// z repeats y with the phi of x, which is renamed past the old ids
+	if(isDefined(function, test.values["z"]) ||
+		isRead(function, test.values["z"]))
+	{
+		std::cout << " z was not replaced after conversion to SSA\n";
+		passed = false;
+	}
+
+	// the phi, y, and both stores
+	auto d = test.blocks["D"];
+
+	if(d->size() != 4)
+	{
+		std::cout << " block D has " << d->size()
+			<< " instructions, not 4\n";
+		passed = false;
+	}
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program numbers the values of a function with "
+		"redundant address arithmetic and checks what was removed.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testGlobalValueNumbering(verbose))
+	{
+		std::cout << "Global value numbering test Failed\n";
+		return -1;
+	}
+
+	if(!test::testAfterConvertToSSA(verbose))
+	{
+		std::cout << "Global value numbering after SSA conversion test "
+			"Failed\n";
+		return -1;
+	}
+
+	std::cout << "Global value numbering test Passed\n";
+
+	return 0;
+}
+
@@ -0,0 +1,369 @@
+/*! \file   test-loop-unrolling.cpp
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  A test for loop analysis and the unrolling of loops with a known
+		trip count.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+
+#include <vanaheimr/ir/test/FunctionBuilder.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace test
+{
+
+typedef vanaheimr::analysis::LoopAnalysis LoopAnalysis;
+
+/*! \brief The values and blocks of every function, by name */
+typedef std::map<std::string, TestFunction> TestModule;
+
+static TestFunction& newFunction(Module& module, TestModule& test,
+	const std::string& name, NameList values, NameList blocks)
+{
+	auto& function = test[name] = newTestFunction(module, name);
+
+	newValues(function, "i32", values);
+	newValues(function, "i64", {"ptr"});
+	newValues(function, "i1",  {"p", "q"});
+	newBlocks(function, blocks);
+
+	return function;
+}
+
+/*! \brief A sum over a bottom-tested loop in the translator's form
+
+	A: i = 0 + 0; s = 0 + 0
+	L: s = s + i; i = i + 1; p = i < trips; bra p, L
+	X: st [ptr], s
+*/
+static void generateSum(Module& module, TestModule& test,
+	const std::string& name, unsigned int trips)
+{
+	auto& function = newFunction(module, test, name, {"i", "s"},
+		{"A", "L", "X"});
+
+	auto& values = function.values;
+	auto& blocks = function.blocks;
+
+	add(blocks["A"], values, "i", "0", "0");
+	add(blocks["A"], values, "s", "0", "0");
+
+	add(blocks["L"], values, "s", "s", "i");
+	add(blocks["L"], values, "i", "i", "1");
+	setp(blocks["L"], values, "p", "i", std::to_string(trips));
+	branch(blocks["L"], blocks["L"], values["p"]);
+
+	store(blocks["X"], values, "ptr", "s");
+}
+
+/*! \brief Two nested loops, the inner one runs 4 times per outer trip
+
+	A: j = 0 + 0
+	O: i = 0 + 0
+	I: i = i + 1; p = i < 4; bra p, I
+	T: j = j + 1; q = j < 3; bra q, O
+	X: st [ptr], j
+*/
+static void generateNest(Module& module, TestModule& test)
+{
+	auto& function = newFunction(module, test, "nest", {"i", "j"},
+		{"A", "O", "I", "T", "X"});
+
+	auto& values = function.values;
+	auto& blocks = function.blocks;
+
+	add(blocks["A"], values, "j", "0", "0");
+
+	add(blocks["O"], values, "i", "0", "0");
+
+	add(blocks["I"], values, "i", "i", "1");
+	setp(blocks["I"], values, "p", "i", "4");
+	branch(blocks["I"], blocks["I"], values["p"]);
+
+	add(blocks["T"], values, "j", "j", "1");
+	setp(blocks["T"], values, "q", "j", "3");
+	branch(blocks["T"], blocks["O"], values["q"]);
+
+	store(blocks["X"], values, "ptr", "j");
+}
+
+/*! \brief A loop inside an irreducible cycle, which enters it again from T
+	without running the initial definition of i in A
+
+	A: i = 0 + 0; bra p, T
+	E: st [ptr], i
+	L: i = i + 1; q = i < 4; bra q, L
+	T: bra p, E
+	X: st [ptr], i
+*/
+static void generateIrreducible(Module& module, TestModule& test)
+{
+	auto& function = newFunction(module, test, "irreducible", {"i"},
+		{"A", "E", "L", "T", "X"});
+
+	auto& values = function.values;
+	auto& blocks = function.blocks;
+
+	add(blocks["A"], values, "i", "0", "0");
+	branch(blocks["A"], blocks["T"], values["p"]);
+
+	store(blocks["E"], values, "ptr", "i");
+
+	add(blocks["L"], values, "i", "i", "1");
+	setp(blocks["L"], values, "q", "i", "4");
+	branch(blocks["L"], blocks["L"], values["q"]);
+
+	branch(blocks["T"], blocks["E"], values["p"]);
+
+	store(blocks["X"], values, "ptr", "i");
+}
+
+/*! \brief Checks the loops found in each function before unrolling */
+class LoopTestPass : public CheckPass
+{
+public:
+	LoopTestPass(const TestModule& t)
+	: CheckPass({"LoopAnalysis"}, "LoopTestPass"), test(t)
+	{
+
+	}
+
+public:
+	void runOnFunction(const Function& function)
+	{
+		auto loops = static_cast<LoopAnalysis*>(getAnalysis("LoopAnalysis"));
+
+		auto& values = test[function.name()].values;
+		auto& blocks = test[function.name()].blocks;
+
+		if(function.name() == "nest")
+		{
+			_check(loops->size() == 2, "nest has two loops");
+
+			auto inner = loops->getLoop(*blocks["I"]);
+			auto outer = loops->getLoop(*blocks["T"]);
+
+			if(inner == nullptr || outer == nullptr)
+			{
+				_check(false, "the loops of nest were found");
+				return;
+			}
+
+			_check(loops->getLoop(*blocks["O"]) == outer,
+				"O is in the outer loop");
+			_check(loops->getLoop(*blocks["X"]) == nullptr,
+				"X is not in a loop");
+			_check(inner->parent == outer && inner->depth == 2 &&
+				outer->depth == 1, "I is nested in the outer loop");
+			_check(outer->header == blocks["O"] && outer->blocks.size() == 3,
+				"the outer loop is O, I and T");
+			_check(inner->isInnermost() && !outer->isInnermost(),
+				"only I is innermost");
+			_check(inner->tripCount == 4, "the inner loop runs 4 times");
+			_check(outer->tripCount == 3, "the outer loop runs 3 times");
+
+			return;
+		}
+
+		if(function.name() == "irreducible")
+		{
+			auto loop = loops->getLoop(*blocks["L"]);
+
+			if(loop == nullptr)
+			{
+				_check(false, "the loop of irreducible was found");
+				return;
+			}
+
+			auto i = loop->getInductionVariable(*values["i"]);
+
+			_check(i != nullptr && !i->hasConstantStart,
+				"i does not start at zero when L is entered again from T");
+			_check(loop->tripCount == 0,
+				"the loop of irreducible has an unknown trip count");
+
+			return;
+		}
+
+		auto loop = loops->getLoop(*blocks["L"]);
+
+		if(loop == nullptr)
+		{
+			_check(false, "the loop of " + function.name() + " was found");
+			return;
+		}
+
+		unsigned int trips = function.name() == "full" ? 10 : 100;
+
+		_check(loop->header == blocks["L"] && loop->latches.size() == 1 &&
+			loop->latches.front() == blocks["L"],
+			"L is the header and latch of " + function.name());
+		_check(loop->tripCount == trips, "the loop of " + function.name() +
+			" runs " + std::to_string(trips) + " times");
+
+		auto i = loop->getInductionVariable(*values["i"]);
+
+		_check(i != nullptr && i->step == 1 && i->hasConstantStart &&
+			i->start == 0, "i counts up by one from zero");
+	}
+
+	vanaheimr::transforms::Pass* clone() const
+	{
+		return new LoopTestPass(test);
+	}
+
+public:
+	TestModule test;
+};
+
+static unsigned int countOpcode(const BasicBlock& block,
+	Instruction::Opcode opcode)
+{
+	unsigned int count = 0;
+
+	for(auto instruction : block)
+	{
+		if(instruction->opcode == opcode) ++count;
+	}
+
+	return count;
+}
+
+static bool checkBlock(const BasicBlock& block, const std::string& name,
+	unsigned int adds, unsigned int setps, unsigned int branches)
+{
+	if(countOpcode(block, Instruction::Add)  == adds  &&
+		countOpcode(block, Instruction::Setp) == setps &&
+		countOpcode(block, Instruction::Bra)  == branches &&
+		block.size() == adds + setps + branches)
+	{
+		return true;
+	}
+
+	std::cout << " " << name << " has " << block.size()
+		<< " instructions, expecting " << adds << " adds, " << setps
+		<< " exit tests and " << branches << " branches:\n";
+
+	for(auto instruction : block)
+	{
+		std::cout << "   " << instruction->toString() << "\n";
+	}
+
+	return false;
+}
+
+static bool testLoopUnrolling()
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-loop-unrolling");
+
+	TestModule test;
+
+	generateSum(*module, test, "full",     10);
+	generateSum(*module, test, "partial", 100);
+	generateNest(*module, test);
+	generateIrreducible(*module, test);
+
+	bool passed = runCheckPass(*module, new LoopTestPass(test));
+
+	runPass(*module, "loop-unroll");
+
+	// 10 copies of the two adds, without the exit test or branch
+	passed &= checkBlock(*test["full"].blocks["L"], "full", 20, 0, 0);
+
+	// 100 trips of 3 instructions is too large, so 5 copies of the adds
+	//  share one exit test
+	passed &= checkBlock(*test["partial"].blocks["L"], "partial", 10, 1, 1);
+
+	// only the inner loop is unrolled
+	passed &= checkBlock(*test["nest"].blocks["I"], "nest inner", 4, 0, 0);
+	passed &= checkBlock(*test["nest"].blocks["T"], "nest outer", 1, 1, 1);
+
+	// the trip count of a loop that can be entered again is not known
+	passed &= checkBlock(*test["irreducible"].blocks["L"], "irreducible",
+		1, 1, 1);
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+/*! \brief Unroll loops in SSA form, which leaves gaps in the register ids */
+static bool testLoopUnrollingAfterConvertToSSA()
+{
+	auto compiler = vanaheimr::compiler::Compiler::getSingleton();
+
+	auto module = compiler->newModule("test-loop-unrolling-ssa");
+
+	TestModule test;
+
+	generateSum(*module, test, "full", 10);
+	generateNest(*module, test);
+
+	runPass(*module, "ConvertToSSA");
+	runPass(*module, "loop-unroll");
+
+	bool passed = true;
+
+	for(auto name : {"full", "nest"})
+	{
+		if(countOpcode(*test[name].blocks["X"], Instruction::St) != 1)
+		{
+			std::cout << " the store after the loop of " << name
+				<< " was lost unrolling in SSA form\n";
+			passed = false;
+		}
+	}
+
+	compiler->deleteModule(module);
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	bool verbose = false;
+
+	parser.description("This program finds loops with known trip counts, "
+		"unrolls them, and checks the result.");
+
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::testLoopUnrolling())
+	{
+		std::cout << "Loop unrolling test Failed\n";
+		return -1;
+	}
+
+	if(!test::testLoopUnrollingAfterConvertToSSA())
+	{
+		std::cout << "Loop unrolling after SSA conversion test Failed\n";
+		return -1;
+	}
+
+	std::cout << "Loop unrolling test Passed\n";
+
+	return 0;
+}
+
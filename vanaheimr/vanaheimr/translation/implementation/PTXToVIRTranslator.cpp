@@ -54,6 +54,8 @@ void PTXToVIRTranslator::translate(const PTXModule& m)
 	_ptx    = &m;
 	_module = &*_compiler->newModule(m.path());
 	
+	util::MemoryPool::Scope scope(_module->memoryPool());
+
 	// Translate globals
 	for(PTXModule::GlobalMap::const_iterator global = m.globals().begin();
 		global != m.globals().end(); ++global)
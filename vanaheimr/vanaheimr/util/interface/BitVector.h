@@ -0,0 +1,293 @@
+/*! \file   BitVector.h
+	\date   Tuesday October 13, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the BitVector class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A dense, fixed-universe set of integers packed into 64-bit words.
+
+	Bulk operations are simple loops over contiguous words so that the
+	compiler can vectorize them.
+*/
+class BitVector
+{
+public:
+	typedef uint64_t              Word;
+	typedef std::vector<Word>     WordVector;
+	typedef size_t                size_type;
+
+public:
+	static const size_type BitsPerWord = 64;
+
+public:
+	/*! \brief Visits the index of each set bit in increasing order */
+	class const_iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef size_type                 value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef const size_type*          pointer;
+		typedef size_type                 reference;
+
+	public:
+		const_iterator(const Word* words, size_type wordCount, size_type word)
+		: _words(words), _wordCount(wordCount), _word(word), _bits(0)
+		{
+			if(_word < _wordCount) _bits = _words[_word];
+
+			_advance();
+		}
+
+	public:
+		size_type operator*() const
+		{
+			return _word * BitsPerWord + __builtin_ctzll(_bits);
+		}
+
+		const_iterator& operator++()
+		{
+			_bits &= _bits - 1;
+
+			_advance();
+
+			return *this;
+		}
+
+		bool operator==(const const_iterator& i) const
+		{
+			return _word == i._word && _bits == i._bits;
+		}
+
+		bool operator!=(const const_iterator& i) const
+		{
+			return !(*this == i);
+		}
+
+	private:
+		void _advance()
+		{
+			while(_bits == 0 && _word < _wordCount)
+			{
+				if(++_word < _wordCount) _bits = _words[_word];
+			}
+		}
+
+	private:
+		const Word* _words;
+		size_type   _wordCount;
+		size_type   _word;
+		Word        _bits;
+	};
+
+public:
+	explicit BitVector(size_type bits = 0)
+	: _bits(bits), _words(_wordsFor(bits), 0)
+	{
+
+	}
+
+public:
+	/*! \brief The number of bits in the universe */
+	size_type universe() const { return _bits; }
+
+	void resize(size_type bits)
+	{
+		_bits = bits;
+		_words.resize(_wordsFor(bits), 0);
+
+		_clearTail();
+	}
+
+public:
+	bool contains(size_type bit) const
+	{
+		return (_words[bit / BitsPerWord] >> (bit % BitsPerWord)) & 1;
+	}
+
+	/*! \brief Set a bit, returns true if it was previously clear */
+	bool insert(size_type bit)
+	{
+		Word& word = _words[bit / BitsPerWord];
+		Word  mask = Word(1) << (bit % BitsPerWord);
+
+		bool inserted = (word & mask) == 0;
+
+		word |= mask;
+
+		return inserted;
+	}
+
+	/*! \brief Clear a bit, returns true if it was previously set */
+	bool erase(size_type bit)
+	{
+		Word& word = _words[bit / BitsPerWord];
+		Word  mask = Word(1) << (bit % BitsPerWord);
+
+		bool erased = (word & mask) != 0;
+
+		word &= ~mask;
+
+		return erased;
+	}
+
+	void clear()
+	{
+		for(auto& word : _words) word = 0;
+	}
+
+public:
+	/*! \brief The number of set bits */
+	size_type count() const
+	{
+		size_type total = 0;
+
+		for(auto word : _words) total += __builtin_popcountll(word);
+
+		return total;
+	}
+
+	bool empty() const
+	{
+		for(auto word : _words) if(word != 0) return false;
+
+		return true;
+	}
+
+public:
+	/*! \brief this = this | v, returns true if any bit changed */
+	bool merge(const BitVector& v)
+	{
+		Word changed = 0;
+
+		Word*       left  = _words.data();
+		const Word* right = v._words.data();
+
+		for(size_type i = 0, e = _words.size(); i != e; ++i)
+		{
+			Word result = left[i] | right[i];
+
+			changed |= result ^ left[i];
+			left[i]  = result;
+		}
+
+		return changed != 0;
+	}
+
+	/*! \brief this = this & ~v */
+	void subtract(const BitVector& v)
+	{
+		Word*       left  = _words.data();
+		const Word* right = v._words.data();
+
+		for(size_type i = 0, e = _words.size(); i != e; ++i)
+		{
+			left[i] &= ~right[i];
+		}
+	}
+
+	/*! \brief this = gen | (in & ~kill), returns true if any bit changed */
+	bool assignTransfer(const BitVector& gen, const BitVector& in,
+		const BitVector& kill)
+	{
+		Word changed = 0;
+
+		Word*       result    = _words.data();
+		const Word* genWords  = gen._words.data();
+		const Word* inWords   = in._words.data();
+		const Word* killWords = kill._words.data();
+
+		for(size_type i = 0, e = _words.size(); i != e; ++i)
+		{
+			Word value = genWords[i] | (inWords[i] & ~killWords[i]);
+
+			changed  |= value ^ result[i];
+			result[i] = value;
+		}
+
+		return changed != 0;
+	}
+
+	BitVector& operator|=(const BitVector& v)
+	{
+		merge(v);
+
+		return *this;
+	}
+
+	BitVector& operator&=(const BitVector& v)
+	{
+		Word*       left  = _words.data();
+		const Word* right = v._words.data();
+
+		for(size_type i = 0, e = _words.size(); i != e; ++i)
+		{
+			left[i] &= right[i];
+		}
+
+		return *this;
+	}
+
+public:
+	bool operator==(const BitVector& v) const
+	{
+		return _bits == v._bits && _words == v._words;
+	}
+
+	bool operator!=(const BitVector& v) const
+	{
+		return !(*this == v);
+	}
+
+public:
+	const_iterator begin() const
+	{
+		return const_iterator(_words.data(), _words.size(), 0);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(_words.data(), _words.size(), _words.size());
+	}
+
+public:
+	const WordVector& words() const { return _words; }
+
+private:
+	static size_type _wordsFor(size_type bits)
+	{
+		return (bits + BitsPerWord - 1) / BitsPerWord;
+	}
+
+	void _clearTail()
+	{
+		size_type tail = _bits % BitsPerWord;
+
+		if(tail != 0) _words.back() &= (Word(1) << tail) - 1;
+	}
+
+private:
+	size_type  _bits;
+	WordVector _words;
+
+};
+
+}
+
+}
+
+
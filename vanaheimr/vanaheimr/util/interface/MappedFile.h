@@ -0,0 +1,153 @@
+/*! \file   MappedFile.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the MappedFile class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+// System Includes
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VANAHEIMR_HAS_MMAP 1
+#endif
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A read-only view of the contents of a file
+
+	Regular files are mapped into memory, so pages are only read from disk
+	when they are touched and are never copied onto the heap.  Other
+	files (or systems without mmap) fall back to reading into a buffer.
+*/
+class MappedFile
+{
+public:
+	/*! \brief How the pages of a mapped file will be touched */
+	enum AccessPattern
+	{
+		Sequential, // read ahead aggressively
+		Random,     // no read ahead, only touched pages are read
+		Normal      // the default read ahead of the system
+	};
+
+public:
+	explicit MappedFile(const std::string& path,
+		AccessPattern pattern = Sequential)
+	: _data(nullptr), _size(0), _isMapped(false)
+	{
+		#ifdef VANAHEIMR_HAS_MMAP
+		if(_map(path, pattern)) return;
+		#endif
+
+		_read(path);
+	}
+
+	~MappedFile()
+	{
+		#ifdef VANAHEIMR_HAS_MMAP
+		if(_isMapped) munmap(const_cast<char*>(_data), _size);
+		#endif
+	}
+
+public:
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+	const char* data() const { return _data; }
+	size_t      size() const { return _size; }
+
+	const char* begin() const { return _data;         }
+	const char*   end() const { return _data + _size; }
+
+	bool isMapped() const { return _isMapped; }
+
+private:
+	#ifdef VANAHEIMR_HAS_MMAP
+	bool _map(const std::string& path, AccessPattern pattern)
+	{
+		int file = open(path.c_str(), O_RDONLY);
+
+		if(file < 0) return false;
+
+		struct stat status;
+
+		if(fstat(file, &status) != 0 || !S_ISREG(status.st_mode) ||
+			status.st_size == 0)
+		{
+			close(file);
+			return false;
+		}
+
+		void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE,
+			file, 0);
+
+		close(file);
+
+		if(data == MAP_FAILED) return false;
+
+		madvise(data, status.st_size, _getAdvice(pattern));
+
+		_data     = static_cast<const char*>(data);
+		_size     = status.st_size;
+		_isMapped = true;
+
+		return true;
+	}
+
+	static int _getAdvice(AccessPattern pattern)
+	{
+		switch(pattern)
+		{
+		case Sequential: return MADV_SEQUENTIAL;
+		case Random:     return MADV_RANDOM;
+		case Normal:     break;
+		}
+
+		return MADV_NORMAL;
+	}
+	#endif
+
+	void _read(const std::string& path)
+	{
+		std::ifstream file(path.c_str(), std::ios::binary);
+
+		if(!file.is_open())
+		{
+			throw std::runtime_error("Could not open file '" + path +
+				"' for reading.");
+		}
+
+		_buffer.assign(std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>());
+
+		_data = _buffer.data();
+		_size = _buffer.size();
+	}
+
+private:
+	const char* _data;
+	size_t      _size;
+	bool        _isMapped;
+	std::string _buffer;
+
+};
+
+}
+
+}
+
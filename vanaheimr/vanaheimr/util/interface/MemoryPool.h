@@ -0,0 +1,494 @@
+/*! \file   MemoryPool.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the MemoryPool and PoolAllocator classes.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief Size-segregated pools for small, frequently allocated objects
+	(IR instructions, operands, and list nodes).
+
+	Each module owns a pool, so building a big module costs a handful of
+	calls to the system allocator, and deleting the module returns all of
+	its memory at once.  Memory is carved out of large chunks that start
+	with a pointer to the pool that owns them, so a block can be freed
+	from any thread without knowing where it came from.
+
+	Objects are allocated from the pool of the innermost Scope on the
+	calling thread.  A Scope keeps its own free lists and only exchanges
+	batches of blocks with the pool, so allocation does not contend when
+	passes run in parallel.  IR that is built outside of any Scope comes
+	from a pool that is never freed.
+
+	Every object from a pool must be destroyed before the pool, and no
+	Scope may be open on it when it is destroyed.
+*/
+class MemoryPool
+{
+public:
+	/*! \brief Requests are rounded up to a multiple of this */
+	static const size_t Granularity = 16;
+	/*! \brief Larger requests go directly to the system allocator */
+	static const size_t MaximumBytes = 512;
+	/*! \brief The size and alignment of each allocation from the system */
+	static const size_t ChunkBytes = 64 * 1024;
+	/*! \brief Blocks moved between a scope and the pool at once */
+	static const size_t BatchSize = 64;
+
+public:
+	class Scope;
+
+public:
+	MemoryPool()
+	: _scopes(0)
+	{
+		for(auto& block : _blocks) block = nullptr;
+	}
+
+	~MemoryPool()
+	{
+		assert(_scopes == 0);
+
+		for(auto chunk : _chunks) std::free(chunk);
+	}
+
+	MemoryPool(const MemoryPool&) = delete;
+	MemoryPool& operator=(const MemoryPool&) = delete;
+
+public:
+	/*! \brief Allocate from the pool of the calling thread */
+	static void* allocate(size_t bytes);
+	/*! \brief Return memory to the pool that it came from */
+	static void deallocate(void* pointer, size_t bytes);
+
+public:
+	/*! \brief The pool that the calling thread allocates from */
+	static MemoryPool& current();
+
+public:
+	/*! \brief The number of chunks requested from the system so far */
+	size_t chunkCount() const
+	{
+		Lock lock(_chunkMutex);
+
+		return _chunks.size();
+	}
+
+private:
+	static const size_t SizeClasses = MaximumBytes / Granularity;
+
+	/*! \brief The owner is stored at the start of each chunk */
+	static const size_t HeaderBytes = Granularity;
+
+private:
+	class Block
+	{
+	public:
+		Block* next;
+	};
+
+	class FreeList
+	{
+	public:
+		FreeList()
+		: blocks(nullptr), count(0)
+		{
+
+		}
+
+	public:
+		Block* blocks;
+		size_t count;
+	};
+
+	typedef std::lock_guard<std::mutex> Lock;
+	typedef std::vector<void*>          ChunkVector;
+
+private:
+	static size_t _sizeClass(size_t bytes)
+	{
+		return bytes == 0 ? 0 : (bytes - 1) / Granularity;
+	}
+
+	static size_t _blockBytes(size_t sizeClass)
+	{
+		return (sizeClass + 1) * Granularity;
+	}
+
+	static MemoryPool& _getOwner(void* pointer)
+	{
+		auto chunk = reinterpret_cast<uintptr_t>(pointer) & ~(ChunkBytes - 1);
+
+		return **reinterpret_cast<MemoryPool**>(chunk);
+	}
+
+	static Scope*& _currentScope()
+	{
+		static thread_local Scope* scope = nullptr;
+
+		return scope;
+	}
+
+	static MemoryPool& _global()
+	{
+		// Never destroyed, objects may be freed during static destruction
+		static MemoryPool* pool = new MemoryPool;
+
+		return *pool;
+	}
+
+private:
+	/*! \brief Allocate a chunk and add all of its blocks to the list */
+	void _carveChunk(FreeList& list, size_t sizeClass)
+	{
+		void* memory = nullptr;
+
+		if(posix_memalign(&memory, ChunkBytes, ChunkBytes) != 0)
+		{
+			throw std::bad_alloc();
+		}
+
+		{
+			Lock lock(_chunkMutex);
+
+			_chunks.push_back(memory);
+		}
+
+		char* chunk = static_cast<char*>(memory);
+
+		*reinterpret_cast<MemoryPool**>(chunk) = this;
+
+		size_t bytes = _blockBytes(sizeClass);
+
+		for(size_t offset = HeaderBytes; offset + bytes <= ChunkBytes;
+			offset += bytes)
+		{
+			Block* block = reinterpret_cast<Block*>(chunk + offset);
+
+			block->next = list.blocks;
+
+			list.blocks = block;
+			++list.count;
+		}
+	}
+
+	/*! \brief Move a batch of blocks from the pool into the list,
+		allocating a new chunk if the pool is empty */
+	void _refill(FreeList& list, size_t sizeClass)
+	{
+		{
+			Lock lock(_mutexes[sizeClass]);
+
+			Block* first = _blocks[sizeClass];
+
+			if(first != nullptr)
+			{
+				Block* last  = first;
+				size_t count = 1;
+
+				while(count < BatchSize && last->next != nullptr)
+				{
+					last = last->next;
+					++count;
+				}
+
+				_blocks[sizeClass] = last->next;
+
+				last->next = list.blocks;
+
+				list.blocks  = first;
+				list.count  += count;
+
+				return;
+			}
+		}
+
+		_carveChunk(list, sizeClass);
+	}
+
+	/*! \brief Return a batch of blocks from the list to the pool */
+	void _releaseBatch(FreeList& list, size_t sizeClass)
+	{
+		Block* first = list.blocks;
+		Block* last  = first;
+		size_t count = 1;
+
+		while(count < BatchSize && last->next != nullptr)
+		{
+			last = last->next;
+			++count;
+		}
+
+		list.blocks  = last->next;
+		list.count  -= count;
+
+		_releaseShared(sizeClass, first, last);
+	}
+
+	void _releaseShared(size_t sizeClass, Block* first, Block* last)
+	{
+		Lock lock(_mutexes[sizeClass]);
+
+		last->next = _blocks[sizeClass];
+
+		_blocks[sizeClass] = first;
+	}
+
+	void* _allocateShared(size_t sizeClass)
+	{
+		FreeList list;
+
+		{
+			Lock lock(_mutexes[sizeClass]);
+
+			Block* block = _blocks[sizeClass];
+
+			if(block != nullptr)
+			{
+				_blocks[sizeClass] = block->next;
+
+				return block;
+			}
+		}
+
+		_carveChunk(list, sizeClass);
+
+		Block* block = list.blocks;
+
+		list.blocks = block->next;
+		--list.count;
+
+		if(list.blocks != nullptr)
+		{
+			Block* last = list.blocks;
+
+			while(last->next != nullptr) last = last->next;
+
+			_releaseShared(sizeClass, list.blocks, last);
+		}
+
+		return block;
+	}
+
+private:
+	std::mutex          _mutexes[SizeClasses];
+	Block*              _blocks[SizeClasses];
+	mutable std::mutex  _chunkMutex;
+	ChunkVector         _chunks;
+	std::atomic<size_t> _scopes;
+
+};
+
+/*! \brief Allocate from a pool on the calling thread until the end of the
+	scope, scopes nest */
+class MemoryPool::Scope
+{
+public:
+	explicit Scope(MemoryPool& pool)
+	: _pool(pool), _previous(_currentScope())
+	{
+		++_pool._scopes;
+
+		_currentScope() = this;
+	}
+
+	~Scope()
+	{
+		for(size_t sizeClass = 0; sizeClass < SizeClasses; ++sizeClass)
+		{
+			while(_lists[sizeClass].blocks != nullptr)
+			{
+				_pool._releaseBatch(_lists[sizeClass], sizeClass);
+			}
+		}
+
+		_currentScope() = _previous;
+
+		--_pool._scopes;
+	}
+
+	Scope(const Scope&) = delete;
+	Scope& operator=(const Scope&) = delete;
+
+private:
+	void* _allocate(size_t sizeClass)
+	{
+		auto& list = _lists[sizeClass];
+
+		if(list.blocks == nullptr) _pool._refill(list, sizeClass);
+
+		Block* block = list.blocks;
+
+		list.blocks = block->next;
+		--list.count;
+
+		return block;
+	}
+
+	void _deallocate(size_t sizeClass, Block* block)
+	{
+		auto& list = _lists[sizeClass];
+
+		block->next = list.blocks;
+
+		list.blocks = block;
+
+		if(++list.count > 2 * BatchSize)
+		{
+			_pool._releaseBatch(list, sizeClass);
+		}
+	}
+
+private:
+	MemoryPool& _pool;
+	Scope*      _previous;
+	FreeList    _lists[SizeClasses];
+
+	friend class MemoryPool;
+};
+
+inline void* MemoryPool::allocate(size_t bytes)
+{
+	if(bytes > MaximumBytes) return ::operator new(bytes);
+
+	size_t sizeClass = _sizeClass(bytes);
+
+	auto scope = _currentScope();
+
+	if(scope == nullptr) return _global()._allocateShared(sizeClass);
+
+	return scope->_allocate(sizeClass);
+}
+
+inline void MemoryPool::deallocate(void* pointer, size_t bytes)
+{
+	if(pointer == nullptr) return;
+
+	if(bytes > MaximumBytes)
+	{
+		::operator delete(pointer);
+		return;
+	}
+
+	size_t sizeClass = _sizeClass(bytes);
+
+	Block* block = static_cast<Block*>(pointer);
+	auto&  owner = _getOwner(pointer);
+	auto   scope = _currentScope();
+
+	if(scope != nullptr && &scope->_pool == &owner)
+	{
+		scope->_deallocate(sizeClass, block);
+		return;
+	}
+
+	owner._releaseShared(sizeClass, block, block);
+}
+
+inline MemoryPool& MemoryPool::current()
+{
+	auto scope = _currentScope();
+
+	return scope == nullptr ? _global() : scope->_pool;
+}
+
+/*! \brief A stateless standard allocator that draws from the MemoryPool of
+	the calling thread */
+template<typename T>
+class PoolAllocator
+{
+public:
+	typedef T              value_type;
+	typedef T*             pointer;
+	typedef const T*       const_pointer;
+	typedef T&             reference;
+	typedef const T&       const_reference;
+	typedef size_t         size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template<typename U>
+	class rebind
+	{
+	public:
+		typedef PoolAllocator<U> other;
+	};
+
+public:
+	PoolAllocator()
+	{
+
+	}
+
+	template<typename U>
+	PoolAllocator(const PoolAllocator<U>&)
+	{
+
+	}
+
+public:
+	pointer allocate(size_type n, const void* = nullptr)
+	{
+		return static_cast<pointer>(MemoryPool::allocate(n * sizeof(T)));
+	}
+
+	void deallocate(pointer p, size_type n)
+	{
+		MemoryPool::deallocate(p, n * sizeof(T));
+	}
+
+public:
+	template<typename U, typename... Args>
+	void construct(U* p, Args&&... args)
+	{
+		::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+	}
+
+	template<typename U>
+	void destroy(U* p)
+	{
+		p->~U();
+	}
+
+public:
+	pointer       address(reference r)       const { return &r; }
+	const_pointer address(const_reference r) const { return &r; }
+
+	size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+};
+
+template<typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+	return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+	return false;
+}
+
+}
+
+}
+
+
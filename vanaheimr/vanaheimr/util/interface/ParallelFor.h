@@ -0,0 +1,160 @@
+/*! \file   ParallelFor.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the parallelFor function.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief The number of workers to use when the caller asks for 0 */
+inline unsigned int defaultThreadCount()
+{
+	unsigned int threads = std::thread::hardware_concurrency();
+
+	return threads == 0 ? 1 : threads;
+}
+
+/*! \brief The number of threads the calling thread may use, 0 if it is
+	not running inside a parallelFor */
+inline unsigned int& threadBudget()
+{
+	static thread_local unsigned int budget = 0;
+
+	return budget;
+}
+
+/*! \brief Set the thread budget of the calling thread for a scope */
+class ThreadBudgetScope
+{
+public:
+	explicit ThreadBudgetScope(unsigned int budget)
+	: _previous(threadBudget())
+	{
+		threadBudget() = budget;
+	}
+
+	~ThreadBudgetScope()
+	{
+		threadBudget() = _previous;
+	}
+
+private:
+	unsigned int _previous;
+};
+
+/*! \brief Call body(i) for every i in [0, count) using at most 'threads'
+	workers (0 selects the budget of the calling thread).
+
+	Outside of any parallelFor the budget is one worker per hardware
+	thread, inside one it also caps explicit requests.  The threads of a
+	loop are split evenly among its workers, so a nested loop never adds
+	threads beyond what the outer loop was given, and a loop nested in
+	one limited to a single thread is serial.
+
+	Indices are handed out dynamically, so uneven bodies balance.  The
+	calling thread participates as a worker.  If any body throws, the
+	remaining indices are skipped and the first exception is rethrown
+	once all workers have joined.
+*/
+inline void parallelFor(size_t count, unsigned int threads,
+	const std::function<void(size_t)>& body)
+{
+	unsigned int budget = threadBudget();
+
+	if(threads == 0)
+	{
+		threads = budget == 0 ? defaultThreadCount() : budget;
+	}
+	else if(budget != 0 && threads > budget)
+	{
+		threads = budget;
+	}
+
+	unsigned int total = threads;
+
+	if(threads > count) threads = count;
+
+	// the threads that this loop can not use go to its workers
+	unsigned int nestedBudget = threads <= 1 ? total : total / threads;
+
+	if(threads <= 1)
+	{
+		ThreadBudgetScope scope(nestedBudget);
+
+		for(size_t i = 0; i < count; ++i)
+		{
+			body(i);
+		}
+
+		return;
+	}
+
+	std::atomic<size_t> next(0);
+	std::atomic<bool>   failed(false);
+
+	std::exception_ptr exception;
+	std::mutex         exceptionMutex;
+
+	auto worker = [&]()
+	{
+		ThreadBudgetScope scope(nestedBudget);
+
+		while(!failed)
+		{
+			size_t i = next++;
+
+			if(i >= count) break;
+
+			try
+			{
+				body(i);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> lock(exceptionMutex);
+
+				if(!failed) exception = std::current_exception();
+
+				failed = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+
+	workers.reserve(threads - 1);
+
+	for(unsigned int t = 1; t < threads; ++t)
+	{
+		workers.push_back(std::thread(worker));
+	}
+
+	worker();
+
+	for(auto& thread : workers)
+	{
+		thread.join();
+	}
+
+	if(exception) std::rethrow_exception(exception);
+}
+
+}
+
+}
+
+
@@ -6,8 +6,13 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/SmallVector.h>
+
 // Standard Library Includes
-#include <map>
+#include <algorithm>
+#include <functional>
+#include <utility>
 
 namespace vanaheimr
 {
@@ -17,11 +22,215 @@ namespace util
 
 
 /*! \brief A class optimized to store a small unique map of objects with
-	zero mallocs, it falls back on a std::map if the set grows large */
-template<typename Key, typename Value>
-class SmallMap : public std::map<Key, Value>
+	zero mallocs.
+
+	Pairs are kept sorted by key in a flat array.  The first N live in an
+	inline buffer, larger maps spill to a single heap allocation.  The
+	interface mirrors std::map, but insert/erase invalidate iterators.
+*/
+template<typename Key, typename Value, unsigned int N = 8,
+	typename Compare = std::less<Key> >
+class SmallMap
 {
-// TODO specialize
+public:
+	typedef Key                     key_type;
+	typedef Value                   mapped_type;
+	typedef std::pair<Key, Value>   value_type;
+	typedef Compare                 key_compare;
+
+private:
+	typedef SmallVector<value_type, N> Storage;
+
+public:
+	typedef typename Storage::size_type       size_type;
+	typedef typename Storage::difference_type difference_type;
+	typedef typename Storage::reference       reference;
+	typedef typename Storage::const_reference const_reference;
+
+	typedef typename Storage::iterator       iterator;
+	typedef typename Storage::const_iterator const_iterator;
+
+	typedef typename Storage::reverse_iterator       reverse_iterator;
+	typedef typename Storage::const_reverse_iterator const_reverse_iterator;
+
+	typedef std::pair<iterator, bool> InsertionResult;
+
+public:
+	SmallMap(const Compare& c = Compare())
+	: _compare(c)
+	{
+
+	}
+
+	template<typename Iterator>
+	SmallMap(Iterator begin, Iterator end, const Compare& c = Compare())
+	: _compare(c)
+	{
+		insert(begin, end);
+	}
+
+public:
+	      iterator begin()       { return _storage.begin(); }
+	const_iterator begin() const { return _storage.begin(); }
+
+	      iterator end()       { return _storage.end(); }
+	const_iterator end() const { return _storage.end(); }
+
+	      reverse_iterator rbegin()       { return _storage.rbegin(); }
+	const_reverse_iterator rbegin() const { return _storage.rbegin(); }
+
+	      reverse_iterator rend()       { return _storage.rend(); }
+	const_reverse_iterator rend() const { return _storage.rend(); }
+
+public:
+	size_type size()  const { return _storage.size();  }
+	bool      empty() const { return _storage.empty(); }
+
+	key_compare key_comp() const { return _compare; }
+
+public:
+	InsertionResult insert(const value_type& value)
+	{
+		auto position = lower_bound(value.first);
+
+		if(position != end() && !_compare(value.first, position->first))
+		{
+			return InsertionResult(position, false);
+		}
+
+		return InsertionResult(_storage.insert(position, value), true);
+	}
+
+	iterator insert(const_iterator, const value_type& value)
+	{
+		return insert(value).first;
+	}
+
+	template<typename Iterator>
+	void insert(Iterator first, Iterator last)
+	{
+		for(; first != last; ++first)
+		{
+			insert(*first);
+		}
+	}
+
+	Value& operator[](const Key& key)
+	{
+		auto position = lower_bound(key);
+
+		if(position == end() || _compare(key, position->first))
+		{
+			position = _storage.insert(position, value_type(key, Value()));
+		}
+
+		return position->second;
+	}
+
+public:
+	size_type erase(const Key& key)
+	{
+		auto position = find(key);
+
+		if(position == end()) return 0;
+
+		_storage.erase(position);
+
+		return 1;
+	}
+
+	iterator erase(const_iterator position)
+	{
+		return _storage.erase(position);
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		return _storage.erase(first, last);
+	}
+
+	void clear()
+	{
+		_storage.clear();
+	}
+
+	void swap(SmallMap& m)
+	{
+		_storage.swap(m._storage);
+		std::swap(_compare, m._compare);
+	}
+
+public:
+	iterator find(const Key& key)
+	{
+		auto position = lower_bound(key);
+
+		if(position == end() || _compare(key, position->first)) return end();
+
+		return position;
+	}
+
+	const_iterator find(const Key& key) const
+	{
+		auto position = lower_bound(key);
+
+		if(position == end() || _compare(key, position->first)) return end();
+
+		return position;
+	}
+
+	size_type count(const Key& key) const
+	{
+		return find(key) == end() ? 0 : 1;
+	}
+
+	iterator lower_bound(const Key& key)
+	{
+		return std::lower_bound(begin(), end(), key, KeyCompare(_compare));
+	}
+
+	const_iterator lower_bound(const Key& key) const
+	{
+		return std::lower_bound(begin(), end(), key, KeyCompare(_compare));
+	}
+
+public:
+	bool operator==(const SmallMap& m) const
+	{
+		return _storage == m._storage;
+	}
+
+	bool operator!=(const SmallMap& m) const
+	{
+		return _storage != m._storage;
+	}
+
+private:
+	/*! \brief Orders stored pairs against a bare key */
+	class KeyCompare
+	{
+	public:
+		KeyCompare(const Compare& c)
+		: compare(c)
+		{
+
+		}
+
+	public:
+		bool operator()(const value_type& value, const Key& key) const
+		{
+			return compare(value.first, key);
+		}
+
+	public:
+		const Compare& compare;
+
+	};
+
+private:
+	Storage _storage;
+	Compare _compare;
+
 };
 
 }
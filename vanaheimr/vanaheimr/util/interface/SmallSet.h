@@ -6,8 +6,13 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/SmallVector.h>
+
 // Standard Library Includes
-#include <set>
+#include <algorithm>
+#include <functional>
+#include <utility>
 
 namespace vanaheimr
 {
@@ -17,11 +22,219 @@ namespace util
 
 
 /*! \brief A class optimized to store a small unique set of objects with
-	zero mallocs, it falls back on a std::set if the set grows large */
-template<typename T>
-class SmallSet : public std::set<T>
+	zero mallocs.
+
+	Elements are kept sorted in a flat array.  The first N live in an inline
+	buffer, larger sets spill to a single heap allocation.  The interface
+	mirrors std::set, but insert/erase invalidate iterators.
+*/
+template<typename T, unsigned int N = 8, typename Compare = std::less<T> >
+class SmallSet
 {
-// TODO specialize
+private:
+	typedef SmallVector<T, N> Storage;
+
+public:
+	typedef T       key_type;
+	typedef T       value_type;
+	typedef Compare key_compare;
+	typedef Compare value_compare;
+
+	typedef typename Storage::size_type       size_type;
+	typedef typename Storage::difference_type difference_type;
+	typedef typename Storage::const_reference reference;
+	typedef typename Storage::const_reference const_reference;
+
+	typedef typename Storage::const_iterator iterator;
+	typedef typename Storage::const_iterator const_iterator;
+
+	typedef typename Storage::const_reverse_iterator reverse_iterator;
+	typedef typename Storage::const_reverse_iterator const_reverse_iterator;
+
+	typedef std::pair<iterator, bool> InsertionResult;
+
+public:
+	SmallSet(const Compare& c = Compare())
+	: _compare(c)
+	{
+
+	}
+
+	template<typename Iterator>
+	SmallSet(Iterator begin, Iterator end, const Compare& c = Compare())
+	: _compare(c)
+	{
+		insert(begin, end);
+	}
+
+public:
+	const_iterator begin() const { return _storage.begin(); }
+	const_iterator end()   const { return _storage.end();   }
+
+	const_reverse_iterator rbegin() const { return _storage.rbegin(); }
+	const_reverse_iterator rend()   const { return _storage.rend();   }
+
+public:
+	size_type size()  const { return _storage.size();  }
+	bool      empty() const { return _storage.empty(); }
+
+	key_compare key_comp() const { return _compare; }
+
+public:
+	InsertionResult insert(const T& value)
+	{
+		auto position = lower_bound(value);
+
+		if(position != end() && !_compare(value, *position))
+		{
+			return InsertionResult(position, false);
+		}
+
+		return InsertionResult(_storage.insert(position, value), true);
+	}
+
+	iterator insert(const_iterator, const T& value)
+	{
+		return insert(value).first;
+	}
+
+	/*! \brief Insert a range of values, merging in linear time */
+	template<typename Iterator>
+	void insert(Iterator first, Iterator last)
+	{
+		if(first == last) return;
+
+		Storage values(first, last);
+
+		std::sort(values.begin(), values.end(), _compare);
+
+		Storage merged;
+
+		merged.reserve(size() + values.size());
+
+		_union(merged, values);
+
+		_storage = std::move(merged);
+	}
+
+public:
+	size_type erase(const T& value)
+	{
+		auto position = find(value);
+
+		if(position == end()) return 0;
+
+		_storage.erase(position);
+
+		return 1;
+	}
+
+	iterator erase(const_iterator position)
+	{
+		return _storage.erase(position);
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		return _storage.erase(first, last);
+	}
+
+	void clear()
+	{
+		_storage.clear();
+	}
+
+	void swap(SmallSet& s)
+	{
+		_storage.swap(s._storage);
+		std::swap(_compare, s._compare);
+	}
+
+public:
+	const_iterator find(const T& value) const
+	{
+		auto position = lower_bound(value);
+
+		if(position == end() || _compare(value, *position)) return end();
+
+		return position;
+	}
+
+	size_type count(const T& value) const
+	{
+		return find(value) == end() ? 0 : 1;
+	}
+
+	const_iterator lower_bound(const T& value) const
+	{
+		return std::lower_bound(begin(), end(), value, _compare);
+	}
+
+	const_iterator upper_bound(const T& value) const
+	{
+		return std::upper_bound(begin(), end(), value, _compare);
+	}
+
+	std::pair<const_iterator, const_iterator> equal_range(
+		const T& value) const
+	{
+		return std::equal_range(begin(), end(), value, _compare);
+	}
+
+public:
+	bool operator==(const SmallSet& s) const
+	{
+		return _storage == s._storage;
+	}
+
+	bool operator!=(const SmallSet& s) const
+	{
+		return _storage != s._storage;
+	}
+
+	bool operator<(const SmallSet& s) const
+	{
+		return std::lexicographical_compare(begin(), end(),
+			s.begin(), s.end(), _compare);
+	}
+
+private:
+	/*! \brief Merge the sorted values into result, dropping duplicates */
+	void _union(Storage& result, const Storage& values) const
+	{
+		auto left  = _storage.begin();
+		auto right = values.begin();
+
+		while(left != _storage.end() || right != values.end())
+		{
+			const T* next = nullptr;
+
+			if(right == values.end() ||
+				(left != _storage.end() && _compare(*left, *right)))
+			{
+				next = left++;
+			}
+			else
+			{
+				if(left != _storage.end() && !_compare(*right, *left))
+				{
+					++left;
+				}
+
+				next = right++;
+			}
+
+			if(result.empty() || _compare(result.back(), *next))
+			{
+				result.push_back(*next);
+			}
+		}
+	}
+
+private:
+	Storage _storage;
+	Compare _compare;
+
 };
 
 }
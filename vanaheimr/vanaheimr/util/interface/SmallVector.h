@@ -0,0 +1,410 @@
+/*! \file   SmallVector.h
+	\date   Monday October 12, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the SmallVector class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A contiguous array that stores up to N elements inline (with zero
+	mallocs), it spills to a single heap allocation if it grows larger */
+template<typename T, unsigned int N = 8>
+class SmallVector
+{
+public:
+	static_assert(N > 0, "SmallVector requires at least one inline element");
+
+public:
+	typedef T              value_type;
+	typedef T&             reference;
+	typedef const T&       const_reference;
+	typedef T*             pointer;
+	typedef const T*       const_pointer;
+	typedef size_t         size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef T*       iterator;
+	typedef const T* const_iterator;
+
+	typedef std::reverse_iterator<iterator>       reverse_iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+public:
+	/*! \brief The number of elements that fit in the inline buffer */
+	static const unsigned int InlineCapacity = N;
+
+public:
+	SmallVector()
+	: _begin(_inline()), _end(_inline()), _capacity(_inline() + N)
+	{
+
+	}
+
+	template<typename Iterator>
+	SmallVector(Iterator begin, Iterator end)
+	: _begin(_inline()), _end(_inline()), _capacity(_inline() + N)
+	{
+		insert(this->end(), begin, end);
+	}
+
+	SmallVector(const SmallVector& v)
+	: _begin(_inline()), _end(_inline()), _capacity(_inline() + N)
+	{
+		reserve(v.size());
+
+		_end = std::uninitialized_copy(v.begin(), v.end(), _begin);
+	}
+
+	SmallVector(SmallVector&& v)
+	: _begin(_inline()), _end(_inline()), _capacity(_inline() + N)
+	{
+		_steal(v);
+	}
+
+	~SmallVector()
+	{
+		_destroy(_begin, _end);
+		_release();
+	}
+
+public:
+	SmallVector& operator=(const SmallVector& v)
+	{
+		if(this == &v) return *this;
+
+		clear();
+		reserve(v.size());
+
+		_end = std::uninitialized_copy(v.begin(), v.end(), _begin);
+
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& v)
+	{
+		if(this == &v) return *this;
+
+		clear();
+		_release();
+
+		_begin    = _inline();
+		_end      = _inline();
+		_capacity = _inline() + N;
+
+		_steal(v);
+
+		return *this;
+	}
+
+public:
+	      iterator begin()       { return _begin; }
+	const_iterator begin() const { return _begin; }
+
+	      iterator end()       { return _end; }
+	const_iterator end() const { return _end; }
+
+public:
+	      reverse_iterator rbegin()       { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const
+	{
+		return const_reverse_iterator(end());
+	}
+
+	      reverse_iterator rend()       { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const
+	{
+		return const_reverse_iterator(begin());
+	}
+
+public:
+	      reference operator[](size_type i)       { return _begin[i]; }
+	const_reference operator[](size_type i) const { return _begin[i]; }
+
+	      reference front()       { return *_begin; }
+	const_reference front() const { return *_begin; }
+
+	      reference back()       { return *(_end - 1); }
+	const_reference back() const { return *(_end - 1); }
+
+	      pointer data()       { return _begin; }
+	const_pointer data() const { return _begin; }
+
+public:
+	size_type size()     const { return _end - _begin; }
+	size_type capacity() const { return _capacity - _begin; }
+	bool      empty()    const { return _begin == _end; }
+
+	/*! \brief Is the data still stored in the inline buffer? */
+	bool isSmall() const { return _begin == _inline(); }
+
+public:
+	void reserve(size_type elements)
+	{
+		if(elements > capacity()) _grow(elements);
+	}
+
+	void push_back(const T& value)
+	{
+		if(_end == _capacity)
+		{
+			T copy(value);
+
+			_grow(size() + 1);
+
+			::new(static_cast<void*>(_end)) T(std::move(copy));
+		}
+		else
+		{
+			::new(static_cast<void*>(_end)) T(value);
+		}
+
+		++_end;
+	}
+
+	void push_back(T&& value)
+	{
+		if(_end == _capacity)
+		{
+			T copy(std::move(value));
+
+			_grow(size() + 1);
+
+			::new(static_cast<void*>(_end)) T(std::move(copy));
+		}
+		else
+		{
+			::new(static_cast<void*>(_end)) T(std::move(value));
+		}
+
+		++_end;
+	}
+
+	void pop_back()
+	{
+		--_end;
+		_end->~T();
+	}
+
+	void resize(size_type elements)
+	{
+		if(elements < size())
+		{
+			erase(begin() + elements, end());
+			return;
+		}
+
+		reserve(elements);
+
+		for(T* element = _end; element != _begin + elements; ++element)
+		{
+			::new(static_cast<void*>(element)) T();
+		}
+
+		_end = _begin + elements;
+	}
+
+public:
+	/*! \brief Insert a single element before position */
+	iterator insert(const_iterator position, const T& value)
+	{
+		T copy(value);
+
+		return insert(position, std::move(copy));
+	}
+
+	/*! \brief Insert a single element before position */
+	iterator insert(const_iterator position, T&& value)
+	{
+		size_type index = position - _begin;
+
+		if(_end == _capacity) _grow(size() + 1);
+
+		T* slot = _begin + index;
+
+		if(slot == _end)
+		{
+			::new(static_cast<void*>(_end)) T(std::move(value));
+		}
+		else
+		{
+			::new(static_cast<void*>(_end)) T(std::move(*(_end - 1)));
+
+			std::move_backward(slot, _end - 1, _end);
+
+			*slot = std::move(value);
+		}
+
+		++_end;
+
+		return slot;
+	}
+
+	/*! \brief Insert a range of elements before position */
+	template<typename Iterator>
+	iterator insert(const_iterator position, Iterator first, Iterator last)
+	{
+		size_type index = position - _begin;
+		size_type oldSize = size();
+
+		for(; first != last; ++first)
+		{
+			push_back(*first);
+		}
+
+		std::rotate(_begin + index, _begin + oldSize, _end);
+
+		return _begin + index;
+	}
+
+	iterator erase(const_iterator position)
+	{
+		T* slot = _begin + (position - _begin);
+
+		std::move(slot + 1, _end, slot);
+
+		pop_back();
+
+		return slot;
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		T* begin = _begin + (first - _begin);
+		T* end   = _begin + (last  - _begin);
+
+		T* newEnd = std::move(end, _end, begin);
+
+		_destroy(newEnd, _end);
+
+		_end = newEnd;
+
+		return begin;
+	}
+
+	void clear()
+	{
+		_destroy(_begin, _end);
+
+		_end = _begin;
+	}
+
+	void swap(SmallVector& v)
+	{
+		SmallVector temp(std::move(v));
+
+		v     = std::move(*this);
+		*this = std::move(temp);
+	}
+
+public:
+	bool operator==(const SmallVector& v) const
+	{
+		return size() == v.size() && std::equal(begin(), end(), v.begin());
+	}
+
+	bool operator!=(const SmallVector& v) const
+	{
+		return !(*this == v);
+	}
+
+	bool operator<(const SmallVector& v) const
+	{
+		return std::lexicographical_compare(begin(), end(),
+			v.begin(), v.end());
+	}
+
+private:
+	T* _inline()
+	{
+		return reinterpret_cast<T*>(_storage);
+	}
+
+	const T* _inline() const
+	{
+		return reinterpret_cast<const T*>(_storage);
+	}
+
+	void _grow(size_type minimumCapacity)
+	{
+		size_type newCapacity = std::max(2 * capacity(), minimumCapacity);
+
+		T* newBegin = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+		T* newEnd   = newBegin;
+
+		for(T* element = _begin; element != _end; ++element, ++newEnd)
+		{
+			::new(static_cast<void*>(newEnd)) T(std::move(*element));
+		}
+
+		_destroy(_begin, _end);
+		_release();
+
+		_begin    = newBegin;
+		_end      = newEnd;
+		_capacity = newBegin + newCapacity;
+	}
+
+	void _steal(SmallVector& v)
+	{
+		if(v.isSmall())
+		{
+			for(T* element = v._begin; element != v._end; ++element, ++_end)
+			{
+				::new(static_cast<void*>(_end)) T(std::move(*element));
+			}
+
+			v.clear();
+		}
+		else
+		{
+			_begin    = v._begin;
+			_end      = v._end;
+			_capacity = v._capacity;
+
+			v._begin    = v._inline();
+			v._end      = v._inline();
+			v._capacity = v._inline() + N;
+		}
+	}
+
+	void _release()
+	{
+		if(!isSmall()) ::operator delete(_begin);
+	}
+
+	static void _destroy(T* begin, T* end)
+	{
+		for(; begin != end; ++begin)
+		{
+			begin->~T();
+		}
+	}
+
+private:
+	T* _begin;
+	T* _end;
+	T* _capacity;
+
+	alignas(T) unsigned char _storage[N * sizeof(T)];
+
+};
+
+}
+
+}
+
+
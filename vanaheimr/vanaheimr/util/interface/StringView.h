@@ -0,0 +1,154 @@
+/*! \file   StringView.h
+	\date   Friday October 16, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the StringView class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A non-owning reference to a range of characters
+
+	The referenced characters must outlive the view.
+*/
+class StringView
+{
+public:
+	typedef const char* iterator;
+	typedef const char* const_iterator;
+
+public:
+	static const size_t npos = (size_t)-1;
+
+public:
+	StringView()
+	: _begin(nullptr), _size(0)
+	{
+
+	}
+
+	StringView(const char* begin, size_t size)
+	: _begin(begin), _size(size)
+	{
+
+	}
+
+	StringView(const char* string)
+	: _begin(string), _size(std::strlen(string))
+	{
+
+	}
+
+	StringView(const std::string& string)
+	: _begin(string.data()), _size(string.size())
+	{
+
+	}
+
+public:
+	const char* data() const { return _begin;  }
+	size_t      size() const { return _size;   }
+	bool       empty() const { return _size == 0; }
+
+public:
+	const_iterator begin() const { return _begin;         }
+	const_iterator   end() const { return _begin + _size; }
+
+public:
+	char front() const { return _begin[0];         }
+	char  back() const { return _begin[_size - 1]; }
+
+	char operator[](size_t index) const { return _begin[index]; }
+
+public:
+	StringView substr(size_t position, size_t count = npos) const
+	{
+		position = std::min(position, _size);
+		count    = std::min(count, _size - position);
+
+		return StringView(_begin + position, count);
+	}
+
+	size_t find(char c, size_t position = 0) const
+	{
+		if(position > _size) return npos;
+
+		auto match = std::find(begin() + position, end(), c);
+
+		if(match == end()) return npos;
+
+		return match - begin();
+	}
+
+	size_t find(const StringView& string, size_t position = 0) const
+	{
+		if(position > _size) return npos;
+
+		auto match = std::search(begin() + position, end(),
+			string.begin(), string.end());
+
+		if(match == end() && !string.empty()) return npos;
+
+		return match - begin();
+	}
+
+	int compare(const StringView& string) const
+	{
+		int result = std::char_traits<char>::compare(_begin, string._begin,
+			std::min(_size, string._size));
+
+		if(result != 0) return result;
+
+		if(_size == string._size) return 0;
+
+		return _size < string._size ? -1 : 1;
+	}
+
+public:
+	std::string str() const
+	{
+		return std::string(_begin, _size);
+	}
+
+private:
+	const char* _begin;
+	size_t      _size;
+
+};
+
+inline bool operator==(const StringView& left, const StringView& right)
+{
+	return left.size() == right.size() &&
+		std::equal(left.begin(), left.end(), right.begin());
+}
+
+inline bool operator!=(const StringView& left, const StringView& right)
+{
+	return !(left == right);
+}
+
+inline bool operator<(const StringView& left, const StringView& right)
+{
+	return left.compare(right) < 0;
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const StringView& string)
+{
+	return stream.write(string.data(), string.size());
+}
+
+}
+
+}
+
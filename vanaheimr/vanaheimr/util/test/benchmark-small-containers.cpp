@@ -0,0 +1,259 @@
+/*! \file   benchmark-small-containers.cpp
+	\author Gregory Diamos <gregory.diamos@gatech.edu>
+	\date   Monday October 12, 2026
+	\brief  A benchmark comparing SmallSet/SmallMap against std::set/std::map.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/SmallSet.h>
+#include <vanaheimr/util/interface/SmallMap.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+
+// Standard Library Includes
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <set>
+#include <vector>
+
+// The replacement operators below pair malloc with free, gcc mistakes them
+//  for mismatched new and delete once they are inlined into callers
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Count every heap allocation made by the program
+static size_t allocationCount = 0;
+
+void* operator new(size_t bytes)
+{
+	++allocationCount;
+
+	void* memory = std::malloc(bytes == 0 ? 1 : bytes);
+
+	if(memory == nullptr) throw std::bad_alloc();
+
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+namespace test
+{
+
+typedef std::vector<unsigned int> KeyVector;
+
+class Measurement
+{
+public:
+	Measurement()
+	: seconds(0.0), allocations(0), checksum(0)
+	{
+
+	}
+
+public:
+	double seconds;
+	size_t allocations;
+	size_t checksum;
+};
+
+template<typename Set>
+static Measurement benchmarkSet(const KeyVector& keys, unsigned int elements,
+	unsigned int iterations)
+{
+	Measurement result;
+
+	size_t startingAllocations = allocationCount;
+	auto   start               = std::chrono::steady_clock::now();
+
+	for(unsigned int i = 0; i < iterations; ++i)
+	{
+		Set set;
+
+		auto begin = keys.begin() + (i % (keys.size() - elements));
+
+		// insert
+		for(auto key = begin; key != begin + elements; ++key)
+		{
+			set.insert(*key);
+		}
+
+		// lookup
+		for(auto key = begin; key != begin + elements; ++key)
+		{
+			result.checksum += set.count(*key + 1);
+		}
+
+		// iterate
+		for(auto value : set)
+		{
+			result.checksum += value;
+		}
+
+		// erase
+		set.erase(set.begin());
+
+		result.checksum += set.size();
+	}
+
+	auto finish = std::chrono::steady_clock::now();
+
+	result.seconds     = std::chrono::duration<double>(finish - start).count();
+	result.allocations = allocationCount - startingAllocations;
+
+	return result;
+}
+
+template<typename Map>
+static Measurement benchmarkMap(const KeyVector& keys, unsigned int elements,
+	unsigned int iterations)
+{
+	Measurement result;
+
+	size_t startingAllocations = allocationCount;
+	auto   start               = std::chrono::steady_clock::now();
+
+	for(unsigned int i = 0; i < iterations; ++i)
+	{
+		Map map;
+
+		auto begin = keys.begin() + (i % (keys.size() - elements));
+
+		for(auto key = begin; key != begin + elements; ++key)
+		{
+			map.insert(std::make_pair(*key, i));
+		}
+
+		for(auto key = begin; key != begin + elements; ++key)
+		{
+			auto position = map.find(*key);
+
+			if(position != map.end()) result.checksum += position->second;
+		}
+
+		for(auto& value : map)
+		{
+			result.checksum += value.first;
+		}
+	}
+
+	auto finish = std::chrono::steady_clock::now();
+
+	result.seconds     = std::chrono::duration<double>(finish - start).count();
+	result.allocations = allocationCount - startingAllocations;
+
+	return result;
+}
+
+static void printRow(const std::string& name, unsigned int elements,
+	const Measurement& measurement, unsigned int iterations)
+{
+	std::cout << "  " << std::setw(24) << std::left << name
+		<< std::setw(6) << std::right << elements
+		<< std::setw(14) << std::fixed << std::setprecision(1)
+		<< (measurement.seconds * 1.0e9) / iterations << " ns/iteration"
+		<< std::setw(10) << std::setprecision(2)
+		<< ((double)measurement.allocations) / iterations << " mallocs/iteration"
+		<< "\n";
+}
+
+static bool benchmarkSmallContainers(unsigned int iterations,
+	unsigned int seed)
+{
+	const unsigned int sizes[] = {2, 4, 8, 16, 64, 256};
+
+	std::default_random_engine generator(seed);
+	std::uniform_int_distribution<unsigned int> distribution(0, 1 << 20);
+
+	KeyVector keys(4096);
+
+	for(auto& key : keys)
+	{
+		key = distribution(generator);
+	}
+
+	bool passed = true;
+
+	for(auto elements : sizes)
+	{
+		auto stdSet   = benchmarkSet<std::set<unsigned int>>(
+			keys, elements, iterations);
+		auto smallSet = benchmarkSet<vanaheimr::util::SmallSet<unsigned int>>(
+			keys, elements, iterations);
+
+		printRow("std::set",  elements, stdSet,   iterations);
+		printRow("util::SmallSet", elements, smallSet, iterations);
+
+		auto stdMap   = benchmarkMap<std::map<unsigned int, unsigned int>>(
+			keys, elements, iterations);
+		auto smallMap = benchmarkMap<
+			vanaheimr::util::SmallMap<unsigned int, unsigned int>>(
+			keys, elements, iterations);
+
+		printRow("std::map",  elements, stdMap,   iterations);
+		printRow("util::SmallMap", elements, smallMap, iterations);
+
+		if(stdSet.checksum != smallSet.checksum ||
+			stdMap.checksum != smallMap.checksum)
+		{
+			std::cout << "  checksum mismatch at " << elements << " elements\n";
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	unsigned int iterations = 0;
+	unsigned int seed       = 0;
+
+	bool verbose = false;
+
+	parser.description("This program compares the performance and allocation "
+		"behavior of the vanaheimr small containers against std containers.");
+
+	parser.parse("-i", "--iterations", iterations, 100000,
+		"The number of times to run each benchmark.");
+	parser.parse("-s", "--seed", seed, 0,
+		"The seed for the random key generator.");
+	parser.parse("-v", "--verbose", verbose, false,
+		"Print out log messages during execution");
+	parser.parse();
+
+	if(verbose)
+	{
+		hydrazine::enableAllLogs();
+	}
+
+	if(!test::benchmarkSmallContainers(iterations, seed))
+	{
+		std::cout << "Small container benchmark Failed\n";
+		return -1;
+	}
+
+	std::cout << "Small container benchmark Passed\n";
+
+	return 0;
+}
+